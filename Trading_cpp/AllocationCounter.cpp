@@ -0,0 +1,40 @@
+#include "AllocationCounter.h"
+
+#ifdef TRADING_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local uint64_t tAllocations = 0;
+}
+
+// Plain replacements of the throwing/nothrow forms; the array forms forward
+// to these by default. Over-aligned allocations are not counted.
+void* operator new(std::size_t size) {
+    ++tAllocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++tAllocations;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace AllocationCounter {
+bool enabled() { return true; }
+uint64_t count() { return tAllocations; }
+}
+
+#else
+
+namespace AllocationCounter {
+bool enabled() { return false; }
+uint64_t count() { return 0; }
+}
+
+#endif
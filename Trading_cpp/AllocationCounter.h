@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocation counter, used to check that hot loops (backtest kernel,
+// incremental strategies) do not allocate per bar.
+//
+// Counting replaces the global operator new/delete, so it is only compiled in
+// when TRADING_COUNT_ALLOCATIONS is defined (see AllocationCounter.cpp).
+// Without it enabled() is false and every count reads zero.
+namespace AllocationCounter {
+    bool enabled();
+
+    // Allocations made by the calling thread so far
+    uint64_t count();
+}
+
+// Counts the calling thread's allocations while in scope
+class AllocationScope {
+public:
+    AllocationScope() : start_(AllocationCounter::count()) {}
+
+    uint64_t allocations() const { return AllocationCounter::count() - start_; }
+
+private:
+    uint64_t start_;
+};
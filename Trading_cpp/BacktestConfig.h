@@ -113,6 +113,12 @@ struct PositionSizing {
     }
 };
 
+// How much of a run BacktestResult keeps
+enum class ResultDetail {
+    Full,           // Trade log plus equity/return/drawdown curves
+    SummaryOnly     // Scalar metrics only, computed online (for large sweeps)
+};
+
 // Main backtest configuration
 struct BacktestConfig {
     // Capital
@@ -145,6 +151,10 @@ struct BacktestConfig {
     // Minimum bars between trades (to avoid overtrading)
     int minBarsBetweenTrades = 0;
 
+    // SummaryOnly skips the trade log and curves; risk metrics then come from
+    // MetricsAccumulator (VaR/CVaR are streaming estimates)
+    ResultDetail resultDetail = ResultDetail::Full;
+
     // Static factory methods for common configurations
     static BacktestConfig defaultConfig() {
         return BacktestConfig();
@@ -7,10 +7,11 @@
 
 // === LEGACY HELPER (for backward compatibility) ===
 // Simulates the original strategy decision logic
-static int simulateDecision(const std::vector<Candle>& history) {
+static int simulateDecision(CandleView history) {
     if (history.size() < 50) return 0;
 
     std::vector<double> closes;
+    closes.reserve(history.size());
     for (const auto& c : history) closes.push_back(c.close);
 
     BollingerBands bb = computeBollingerBands(closes, 20, 2.0);
@@ -41,10 +42,9 @@ BacktestResult Backtester::run(const std::vector<Candle>& candles) {
     double peakBalance = initialBalance;
 
     for (size_t i = 60; i < candles.size(); ++i) {
-        std::vector<Candle> history(candles.begin(), candles.begin() + i + 1);
         double price = candles[i].close;
 
-        int action = simulateDecision(history);
+        int action = simulateDecision(CandleView(candles.data(), i + 1));
 
         if (action == 1 && cash > 0) {
             holdings = cash / price;
@@ -98,243 +98,292 @@ BacktestResult Backtester::run(const std::vector<Candle>& candles) {
 // === INSTANCE METHOD: Run with Strategy ===
 BacktestResult Backtester::run(const std::vector<Candle>& candles, IStrategy& strategy) {
     int warmup = strategy.getWarmupPeriod();
-    return run(candles, [&strategy](const std::vector<Candle>& h, size_t idx) {
-        return strategy.generateSignal(h, idx);
-    }, warmup);
+    if ((int)candles.size() < warmup + 10) {
+        return BacktestResult();
+    }
+
+    // Phase one: the strategy's signals for the whole series, with its
+    // indicators computed once into a context shared by any sub-strategies
+    IndicatorContext indicators(candles);
+    SignalArray signals = strategy.generateSignals(indicators, warmup);
+
+    // Phase two: simulation over the precomputed arrays
+    return run(candles, signals);
 }
 
 // === INSTANCE METHOD: Run with Signal Function ===
 BacktestResult Backtester::run(const std::vector<Candle>& candles, SignalFunction signalFunc, int warmupPeriod) {
-    BacktestResult result;
-
     if ((int)candles.size() < warmupPeriod + 10) {
-        return result;
+        return BacktestResult();
     }
 
-    // Initialize state
-    float cash = config_.initialCapital;
-    float equity = cash;
-    float peakEquity = cash;
-    Position position;
-    int barsSinceLastTrade = config_.minBarsBetweenTrades;
-    int consecutiveWins = 0;
-    int consecutiveLosses = 0;
-    float grossProfit = 0.0f;
-    float grossLoss = 0.0f;
-    int drawdownStartBar = -1;
-    float longestDrawdown = 0.0f;
-
-    result.equityCurve.reserve(candles.size());
-    result.dailyReturns.reserve(candles.size());
-    result.drawdownCurve.reserve(candles.size());
-
-    // Main backtest loop
+    // Vector-based callbacks see a history buffer that grows by one bar per
+    // call instead of a fresh copy of the whole prefix.
+    CandleHistoryAdapter history(candles.size());
+    SignalArray signals(candles.size(), warmupPeriod);
     for (size_t i = warmupPeriod; i < candles.size(); ++i) {
-        const Candle& candle = candles[i];
-        double prevEquity = equity;
+        signals.set(i, signalFunc(history.sync(CandleView(candles.data(), i + 1)), i));
+    }
+    return run(candles, signals);
+}
 
-        // Update trailing stop if enabled and position is open
-        if (position.isOpen && config_.risk.enableTrailingStop) {
-            updateTrailingStop(position, candle);
-        }
+// === INSTANCE METHOD: Run over precomputed signals ===
+BacktestResult Backtester::run(const std::vector<Candle>& candles, const SignalArray& signals) {
+    BarColumns bars(candles);
+    BacktestResult result = simulate(bars, signals);
+    labelTrades(result, [&candles](size_t idx) { return candles[idx].date; });
+    return result;
+}
 
-        // Check stop-loss
-        double stopExitPrice = 0.0;
-        if (position.isOpen && config_.risk.enableStopLoss) {
-            if (checkStopLoss(position, candle, stopExitPrice)) {
-                TradeRecord trade = closePosition(position, candle, i, "stop_loss");
-                trade.exitPrice = stopExitPrice;
-                result.tradeLog.push_back(trade);
-                cash += trade.pnl + (trade.entryPrice * trade.quantity);
-
-                // Update statistics
-                if (trade.isWin()) {
-                    result.wins++;
-                    consecutiveWins++;
-                    consecutiveLosses = 0;
-                    grossProfit += trade.pnl;
-                    if (trade.side == "long") result.winningLongTrades++;
-                    else result.winningShortTrades++;
-                } else {
-                    consecutiveWins = 0;
-                    consecutiveLosses++;
-                    grossLoss += std::abs(trade.pnl);
-                }
-
-                result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, consecutiveWins);
-                result.maxConsecutiveLosses = std::max(result.maxConsecutiveLosses, consecutiveLosses);
-                result.largestWin = std::max(result.largestWin, trade.pnl);
-                result.largestLoss = std::min(result.largestLoss, trade.pnl);
-                result.totalCommissions += trade.transactionCost;
-                result.totalSlippage += trade.slippage;
-
-                position.isOpen = false;
-                barsSinceLastTrade = 0;
-            }
-        }
+BacktestResult Backtester::run(BarColumnsView bars, const SignalArray& signals) {
+    BacktestResult result = simulate(bars, signals);
+    labelTrades(result, [&bars](size_t idx) {
+        return std::to_string(TimeUtils::toUnixSeconds(bars.ts[idx]));
+    });
+    return result;
+}
+
+// === SIMULATION KERNEL ===
+BacktestResult Backtester::simulate(const BarColumnsView& bars, const SignalArray& signals) {
+    int warmupPeriod = (int)signals.firstBar;
+    if ((int)bars.size() < warmupPeriod + 10) {
+        return BacktestResult();
+    }
 
-        // Check take-profit
-        double tpExitPrice = 0.0;
-        if (position.isOpen && config_.risk.enableTakeProfit) {
-            if (checkTakeProfit(position, candle, tpExitPrice)) {
-                TradeRecord trade = closePosition(position, candle, i, "take_profit");
-                trade.exitPrice = tpExitPrice;
-                result.tradeLog.push_back(trade);
-                cash += trade.pnl + (trade.entryPrice * trade.quantity);
+    SimulationState st;
+    beginSimulation(st, bars.size(), signals);
+    for (size_t i = warmupPeriod; i < bars.size() && !st.stopped; ++i) {
+        simulateBar(st, bars, i, signals);
+    }
+    finishSimulation(st, bars, warmupPeriod);
+    return std::move(st.result);
+}
 
+void Backtester::beginSimulation(SimulationState& st, size_t totalBars,
+                                 const SignalArray& signals) const {
+    st = SimulationState();
+    st.cash = config_.initialCapital;
+    st.equity = st.cash;
+    st.barsSinceLastTrade = config_.minBarsBetweenTrades;
+    st.metrics.reset(config_.riskFreeRate / config_.tradingDaysPerYear);
+    st.metrics.startEquity(st.equity);
+    st.keepDetail = config_.resultDetail == ResultDetail::Full;
+    if (!st.keepDetail) return;
+
+    st.result.equityCurve.reserve(totalBars);
+    st.result.dailyReturns.reserve(totalBars);
+    st.result.drawdownCurve.reserve(totalBars);
+
+    // Every trade opens on a Buy/Sell bar, so this bounds the log and the
+    // per-bar loop never reallocates
+    st.result.tradeLog.reserve(signals.actionableCount());
+}
+
+void Backtester::recordTrade(SimulationState& st, const TradeRecord& trade) {
+    if (st.keepDetail) st.result.tradeLog.push_back(trade);
+    st.totalHolding += trade.holdingPeriod;
+    st.closedTrades++;
+}
+
+void Backtester::simulateBar(SimulationState& st, const BarColumnsView& bars, size_t i,
+                             const SignalArray& signals) {
+    BacktestResult& result = st.result;
+    Position& position = st.position;
+    double prevEquity = st.equity;
+
+    // Update trailing stop if enabled and position is open
+    if (position.isOpen && config_.risk.enableTrailingStop) {
+        updateTrailingStop(position, bars, i);
+    }
+
+    // Check stop-loss
+    double stopExitPrice = 0.0;
+    if (position.isOpen && config_.risk.enableStopLoss) {
+        if (checkStopLoss(position, bars, i, stopExitPrice)) {
+            TradeRecord trade = closePosition(position, bars, i, ExitReason::StopLoss);
+            trade.exitPrice = stopExitPrice;
+            recordTrade(st, trade);
+            st.cash += trade.pnl + (trade.entryPrice * trade.quantity);
+
+            // Update statistics
+            if (trade.isWin()) {
                 result.wins++;
-                consecutiveWins++;
-                consecutiveLosses = 0;
-                grossProfit += trade.pnl;
-                if (trade.side == "long") result.winningLongTrades++;
+                st.consecutiveWins++;
+                st.consecutiveLosses = 0;
+                st.grossProfit += trade.pnl;
+                if (trade.side == TradeSide::Long) result.winningLongTrades++;
                 else result.winningShortTrades++;
+            } else {
+                st.consecutiveWins = 0;
+                st.consecutiveLosses++;
+                st.grossLoss += std::abs(trade.pnl);
+            }
 
-                result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, consecutiveWins);
-                result.largestWin = std::max(result.largestWin, trade.pnl);
-                result.totalCommissions += trade.transactionCost;
-                result.totalSlippage += trade.slippage;
+            result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, st.consecutiveWins);
+            result.maxConsecutiveLosses = std::max(result.maxConsecutiveLosses, st.consecutiveLosses);
+            result.largestWin = std::max(result.largestWin, trade.pnl);
+            result.largestLoss = std::min(result.largestLoss, trade.pnl);
+            result.totalCommissions += trade.transactionCost;
+            result.totalSlippage += trade.slippage;
 
-                position.isOpen = false;
-                barsSinceLastTrade = 0;
-            }
+            position.isOpen = false;
+            st.barsSinceLastTrade = 0;
+        }
+    }
+
+    // Check take-profit
+    double tpExitPrice = 0.0;
+    if (position.isOpen && config_.risk.enableTakeProfit) {
+        if (checkTakeProfit(position, bars, i, tpExitPrice)) {
+            TradeRecord trade = closePosition(position, bars, i, ExitReason::TakeProfit);
+            trade.exitPrice = tpExitPrice;
+            recordTrade(st, trade);
+            st.cash += trade.pnl + (trade.entryPrice * trade.quantity);
+
+            result.wins++;
+            st.consecutiveWins++;
+            st.consecutiveLosses = 0;
+            st.grossProfit += trade.pnl;
+            if (trade.side == TradeSide::Long) result.winningLongTrades++;
+            else result.winningShortTrades++;
+
+            result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, st.consecutiveWins);
+            result.largestWin = std::max(result.largestWin, trade.pnl);
+            result.totalCommissions += trade.transactionCost;
+            result.totalSlippage += trade.slippage;
+
+            position.isOpen = false;
+            st.barsSinceLastTrade = 0;
+        }
+    }
+
+    // Precomputed signal for this bar
+    SignalType signal = signals.type[i];
+
+    // Process signal
+    if (!position.isOpen && st.barsSinceLastTrade >= config_.minBarsBetweenTrades) {
+        // Open new position
+        if (signal == SignalType::Buy && st.cash > 0) {
+            openPosition(position, bars, i, st.cash, signals, true);
+            st.cash -= position.quantity * position.entryPrice + position.entryCost;
+            result.longTrades++;
+            result.trades++;
+        } else if (signal == SignalType::Sell && config_.allowShort && st.cash > 0) {
+            openPosition(position, bars, i, st.cash, signals, false);
+            st.cash -= position.entryCost;  // For short, we receive proceeds later
+            result.shortTrades++;
+            result.trades++;
+        }
+    } else if (position.isOpen) {
+        // Check for signal-based exit
+        bool shouldClose = false;
+        if (position.isLong && signal == SignalType::Sell) {
+            shouldClose = true;
+        } else if (!position.isLong && signal == SignalType::Buy) {
+            shouldClose = true;
         }
 
-        // Generate signal if no position or checking for exits
-        std::vector<Candle> history(candles.begin(), candles.begin() + i + 1);
-        StrategySignal signal = signalFunc(history, i);
+        if (shouldClose) {
+            TradeRecord trade = closePosition(position, bars, i, ExitReason::Signal);
+            recordTrade(st, trade);
+            st.cash += trade.pnl + (trade.entryPrice * trade.quantity);
 
-        // Process signal
-        if (!position.isOpen && barsSinceLastTrade >= config_.minBarsBetweenTrades) {
-            // Open new position
-            if (signal.type == SignalType::Buy && cash > 0) {
-                openPosition(position, candle, i, cash, signal, true);
-                cash -= position.quantity * position.entryPrice + position.entryCost;
+            if (trade.isWin()) {
+                result.wins++;
+                st.consecutiveWins++;
+                st.consecutiveLosses = 0;
+                st.grossProfit += trade.pnl;
+                if (trade.side == TradeSide::Long) result.winningLongTrades++;
+                else result.winningShortTrades++;
+            } else {
+                st.consecutiveWins = 0;
+                st.consecutiveLosses++;
+                st.grossLoss += std::abs(trade.pnl);
+            }
+
+            result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, st.consecutiveWins);
+            result.maxConsecutiveLosses = std::max(result.maxConsecutiveLosses, st.consecutiveLosses);
+            result.largestWin = std::max(result.largestWin, trade.pnl);
+            result.largestLoss = std::min(result.largestLoss, trade.pnl);
+            result.totalCommissions += trade.transactionCost;
+            result.totalSlippage += trade.slippage;
+
+            position.isOpen = false;
+            st.barsSinceLastTrade = 0;
+
+            // Immediately open opposite position if signal warrants
+            if (signal == SignalType::Buy && st.cash > 0) {
+                openPosition(position, bars, i, st.cash, signals, true);
+                st.cash -= position.quantity * position.entryPrice + position.entryCost;
                 result.longTrades++;
                 result.trades++;
-            } else if (signal.type == SignalType::Sell && config_.allowShort && cash > 0) {
-                openPosition(position, candle, i, cash, signal, false);
-                cash -= position.entryCost;  // For short, we receive proceeds later
+            } else if (signal == SignalType::Sell && config_.allowShort && st.cash > 0) {
+                openPosition(position, bars, i, st.cash, signals, false);
+                st.cash -= position.entryCost;
                 result.shortTrades++;
                 result.trades++;
             }
-        } else if (position.isOpen) {
-            // Check for signal-based exit
-            bool shouldClose = false;
-            if (position.isLong && signal.type == SignalType::Sell) {
-                shouldClose = true;
-            } else if (!position.isLong && signal.type == SignalType::Buy) {
-                shouldClose = true;
-            }
-
-            if (shouldClose) {
-                TradeRecord trade = closePosition(position, candle, i, "signal");
-                result.tradeLog.push_back(trade);
-                cash += trade.pnl + (trade.entryPrice * trade.quantity);
-
-                if (trade.isWin()) {
-                    result.wins++;
-                    consecutiveWins++;
-                    consecutiveLosses = 0;
-                    grossProfit += trade.pnl;
-                    if (trade.side == "long") result.winningLongTrades++;
-                    else result.winningShortTrades++;
-                } else {
-                    consecutiveWins = 0;
-                    consecutiveLosses++;
-                    grossLoss += std::abs(trade.pnl);
-                }
-
-                result.maxConsecutiveWins = std::max(result.maxConsecutiveWins, consecutiveWins);
-                result.maxConsecutiveLosses = std::max(result.maxConsecutiveLosses, consecutiveLosses);
-                result.largestWin = std::max(result.largestWin, trade.pnl);
-                result.largestLoss = std::min(result.largestLoss, trade.pnl);
-                result.totalCommissions += trade.transactionCost;
-                result.totalSlippage += trade.slippage;
-
-                position.isOpen = false;
-                barsSinceLastTrade = 0;
-
-                // Immediately open opposite position if signal warrants
-                if (signal.type == SignalType::Buy && cash > 0) {
-                    openPosition(position, candle, i, cash, signal, true);
-                    cash -= position.quantity * position.entryPrice + position.entryCost;
-                    result.longTrades++;
-                    result.trades++;
-                } else if (signal.type == SignalType::Sell && config_.allowShort && cash > 0) {
-                    openPosition(position, candle, i, cash, signal, false);
-                    cash -= position.entryCost;
-                    result.shortTrades++;
-                    result.trades++;
-                }
-            }
         }
+    }
 
-        // Calculate current equity
-        if (position.isOpen) {
-            if (position.isLong) {
-                equity = cash + position.quantity * candle.close;
-            } else {
-                // For short: profit = entry - current
-                float shortPnL = (position.entryPrice - candle.close) * position.quantity;
-                equity = cash + shortPnL;
-            }
+    // Calculate current equity
+    double close = bars.close[i];
+    if (position.isOpen) {
+        if (position.isLong) {
+            st.equity = st.cash + position.quantity * close;
         } else {
-            equity = cash;
+            // For short: profit = entry - current
+            float shortPnL = (position.entryPrice - close) * position.quantity;
+            st.equity = st.cash + shortPnL;
         }
+    } else {
+        st.equity = st.cash;
+    }
 
-        // Track equity curve and returns
-        result.equityCurve.push_back(equity);
+    // Track equity curve and returns (stored, or folded into the accumulator)
+    if (st.keepDetail) result.equityCurve.push_back(st.equity);
 
-        if (prevEquity > 0) {
-            float dailyReturn = (equity - prevEquity) / prevEquity;
-            result.dailyReturns.push_back(dailyReturn);
-        }
+    if (prevEquity > 0) {
+        float dailyReturn = (st.equity - prevEquity) / prevEquity;
+        if (st.keepDetail) result.dailyReturns.push_back(dailyReturn);
+        else st.metrics.addReturn(dailyReturn);
+    }
 
-        // Track drawdown
-        if (equity > peakEquity) {
-            peakEquity = equity;
-            drawdownStartBar = -1;
-        }
-        float drawdown = (peakEquity - equity) / peakEquity;
-        result.drawdownCurve.push_back(drawdown);
+    // Track drawdown
+    float drawdown = st.metrics.addEquity(st.equity, (int)i);
+    if (st.keepDetail) result.drawdownCurve.push_back(drawdown);
 
-        if (drawdown > result.maxDrawdown) {
-            result.maxDrawdown = drawdown;
-        }
-
-        if (drawdown > 0 && drawdownStartBar < 0) {
-            drawdownStartBar = (int)i;
-        } else if (drawdown == 0 && drawdownStartBar >= 0) {
-            longestDrawdown = std::max(longestDrawdown, (float)(i - drawdownStartBar));
-            drawdownStartBar = -1;
+    // Check max drawdown circuit breaker
+    if (config_.risk.enableMaxDrawdownStop && drawdown >= config_.risk.maxDrawdownPercent) {
+        // Close position and stop trading
+        if (position.isOpen) {
+            TradeRecord trade = closePosition(position, bars, i, ExitReason::MaxDrawdown);
+            recordTrade(st, trade);
+            st.cash += trade.pnl + (trade.entryPrice * trade.quantity);
+            position.isOpen = false;
         }
+        st.stopped = true;  // Stop backtesting
+        return;
+    }
 
-        // Check max drawdown circuit breaker
-        if (config_.risk.enableMaxDrawdownStop && drawdown >= config_.risk.maxDrawdownPercent) {
-            // Close position and stop trading
-            if (position.isOpen) {
-                TradeRecord trade = closePosition(position, candle, i, "max_drawdown");
-                result.tradeLog.push_back(trade);
-                cash += trade.pnl + (trade.entryPrice * trade.quantity);
-                position.isOpen = false;
-            }
-            break;  // Stop backtesting
-        }
+    st.barsSinceLastTrade++;
+}
 
-        barsSinceLastTrade++;
-    }
+void Backtester::finishSimulation(SimulationState& st, const BarColumnsView& bars, int warmupPeriod) const {
+    BacktestResult& result = st.result;
+    Position& position = st.position;
 
     // Close any open position at end
     if (position.isOpen) {
-        TradeRecord trade = closePosition(position, candles.back(), candles.size() - 1, "end_of_data");
-        result.tradeLog.push_back(trade);
-        cash += trade.pnl + (trade.entryPrice * trade.quantity);
+        TradeRecord trade = closePosition(position, bars, bars.size() - 1, ExitReason::EndOfData);
+        recordTrade(st, trade);
+        st.cash += trade.pnl + (trade.entryPrice * trade.quantity);
 
         if (trade.isWin()) {
             result.wins++;
-            grossProfit += trade.pnl;
+            st.grossProfit += trade.pnl;
         } else {
-            grossLoss += std::abs(trade.pnl);
+            st.grossLoss += std::abs(trade.pnl);
         }
 
         result.totalCommissions += trade.transactionCost;
@@ -342,10 +391,10 @@ BacktestResult Backtester::run(const std::vector<Candle>& candles, SignalFunctio
     }
 
     // Calculate final equity
-    equity = cash;
+    st.equity = st.cash;
 
     // Calculate all metrics
-    result.totalReturn = (equity - config_.initialCapital) / config_.initialCapital;
+    result.totalReturn = (st.equity - config_.initialCapital) / config_.initialCapital;
     result.totalCosts = result.totalCommissions + result.totalSlippage;
 
     // Trade statistics
@@ -354,45 +403,41 @@ BacktestResult Backtester::run(const std::vector<Candle>& candles, SignalFunctio
 
         // Average win/loss
         int losses = result.trades - result.wins;
-        if (result.wins > 0) result.avgWin = grossProfit / result.wins;
-        if (losses > 0) result.avgLoss = grossLoss / losses;
+        if (result.wins > 0) result.avgWin = st.grossProfit / result.wins;
+        if (losses > 0) result.avgLoss = st.grossLoss / losses;
 
         // Profit factor
-        if (grossLoss > 0) result.profitFactor = grossProfit / grossLoss;
+        if (st.grossLoss > 0) result.profitFactor = st.grossProfit / st.grossLoss;
 
         // Expectancy
         result.expectancy = (result.winRate * result.avgWin) - ((1 - result.winRate) * result.avgLoss);
 
         // Average holding period
-        float totalHolding = 0;
-        for (const auto& trade : result.tradeLog) {
-            totalHolding += trade.holdingPeriod;
-        }
-        result.avgHoldingPeriod = totalHolding / result.tradeLog.size();
+        result.avgHoldingPeriod = st.totalHolding / st.closedTrades;
     }
 
     // Calculate risk metrics
-    calculateMetrics(result, result.dailyReturns, (int)(candles.size() - warmupPeriod));
-    result.maxDrawdownDuration = longestDrawdown;
-
-    return result;
+    result.maxDrawdown = st.metrics.maxDrawdown();
+    ReturnStats returns = st.keepDetail ? exactReturnStats(result.dailyReturns, 0.95)
+                                        : st.metrics.returnStats();
+    calculateMetrics(result, returns, (int)(bars.size() - warmupPeriod));
+    result.maxDrawdownDuration = st.metrics.longestDrawdown();
 }
 
 // === POSITION MANAGEMENT ===
-void Backtester::openPosition(Position& pos, const Candle& candle, size_t idx,
-                              double capitalAvailable, const StrategySignal& signal, bool isLong) {
+void Backtester::openPosition(Position& pos, const BarColumnsView& bars, size_t idx,
+                              double capitalAvailable, const SignalArray& signals, bool isLong) const {
     pos.isOpen = true;
     pos.isLong = isLong;
     pos.entryIndex = idx;
-    pos.entryDate = candle.date;
 
     // Apply slippage to entry price
-    double rawPrice = candle.close;
+    double rawPrice = bars.close[idx];
     pos.entryPrice = config_.costs.applySlippage(rawPrice, isLong);
     pos.entrySlippage = std::abs(pos.entryPrice - rawPrice);
 
     // Calculate position size (pass confidence for ConfidenceWeighted sizing)
-    float fraction = config_.sizing.calculateFraction(0.5, 1.0, 0.0, 0.0, signal.confidence);
+    float fraction = config_.sizing.calculateFraction(0.5, 1.0, 0.0, 0.0, signals.confidence[idx]);
     float positionValue = capitalAvailable * fraction;
 
     // Calculate transaction cost
@@ -412,8 +457,8 @@ void Backtester::openPosition(Position& pos, const Candle& candle, size_t idx,
     }
 
     // Override with signal's stop-loss if provided
-    if (signal.stopLossPrice > 0) {
-        pos.stopLossPrice = signal.stopLossPrice;
+    if (signals.stopLossPrice[idx] > 0) {
+        pos.stopLossPrice = signals.stopLossPrice[idx];
     }
 
     // Set take-profit
@@ -426,30 +471,28 @@ void Backtester::openPosition(Position& pos, const Candle& candle, size_t idx,
     }
 
     // Override with signal's take-profit if provided
-    if (signal.takeProfitPrice > 0) {
-        pos.takeProfitPrice = signal.takeProfitPrice;
+    if (signals.takeProfitPrice[idx] > 0) {
+        pos.takeProfitPrice = signals.takeProfitPrice[idx];
     }
 
     // Initialize trailing stop tracking
-    pos.highWaterMark = candle.high;
-    pos.lowWaterMark = candle.low;
+    pos.highWaterMark = bars.high[idx];
+    pos.lowWaterMark = bars.low[idx];
 }
 
-TradeRecord Backtester::closePosition(Position& pos, const Candle& candle, size_t idx,
-                                       const std::string& reason) {
+TradeRecord Backtester::closePosition(Position& pos, const BarColumnsView& bars, size_t idx,
+                                       ExitReason reason) const {
     TradeRecord trade;
     trade.entryIndex = pos.entryIndex;
     trade.exitIndex = idx;
-    trade.entryDate = pos.entryDate;
-    trade.exitDate = candle.date;
     trade.entryPrice = pos.entryPrice;
     trade.quantity = pos.quantity;
-    trade.side = pos.isLong ? "long" : "short";
+    trade.side = pos.isLong ? TradeSide::Long : TradeSide::Short;
     trade.exitReason = reason;
     trade.holdingPeriod = (int)(idx - pos.entryIndex);
 
     // Apply slippage to exit
-    float rawExitPrice = candle.close;
+    float rawExitPrice = bars.close[idx];
     trade.exitPrice = config_.costs.applySlippage(rawExitPrice, !pos.isLong);  // Opposite of entry
     float exitSlippage = std::abs(trade.exitPrice - rawExitPrice);
 
@@ -471,16 +514,17 @@ TradeRecord Backtester::closePosition(Position& pos, const Candle& candle, size_
     return trade;
 }
 
-bool Backtester::checkStopLoss(const Position& pos, const Candle& candle, double& exitPrice) const {
+bool Backtester::checkStopLoss(const Position& pos, const BarColumnsView& bars, size_t idx,
+                               double& exitPrice) const {
     if (pos.stopLossPrice <= 0) return false;
 
     if (pos.isLong) {
-        if (candle.low <= pos.stopLossPrice) {
+        if (bars.low[idx] <= pos.stopLossPrice) {
             exitPrice = pos.stopLossPrice;  // Assume execution at stop price
             return true;
         }
     } else {
-        if (candle.high >= pos.stopLossPrice) {
+        if (bars.high[idx] >= pos.stopLossPrice) {
             exitPrice = pos.stopLossPrice;
             return true;
         }
@@ -488,16 +532,17 @@ bool Backtester::checkStopLoss(const Position& pos, const Candle& candle, double
     return false;
 }
 
-bool Backtester::checkTakeProfit(const Position& pos, const Candle& candle, double& exitPrice) const {
+bool Backtester::checkTakeProfit(const Position& pos, const BarColumnsView& bars, size_t idx,
+                                 double& exitPrice) const {
     if (pos.takeProfitPrice <= 0) return false;
 
     if (pos.isLong) {
-        if (candle.high >= pos.takeProfitPrice) {
+        if (bars.high[idx] >= pos.takeProfitPrice) {
             exitPrice = pos.takeProfitPrice;
             return true;
         }
     } else {
-        if (candle.low <= pos.takeProfitPrice) {
+        if (bars.low[idx] <= pos.takeProfitPrice) {
             exitPrice = pos.takeProfitPrice;
             return true;
         }
@@ -505,11 +550,11 @@ bool Backtester::checkTakeProfit(const Position& pos, const Candle& candle, doub
     return false;
 }
 
-void Backtester::updateTrailingStop(Position& pos, const Candle& candle) {
+void Backtester::updateTrailingStop(Position& pos, const BarColumnsView& bars, size_t idx) const {
     if (pos.isLong) {
         // Update high water mark
-        if (candle.high > pos.highWaterMark) {
-            pos.highWaterMark = candle.high;
+        if (bars.high[idx] > pos.highWaterMark) {
+            pos.highWaterMark = bars.high[idx];
             // Update trailing stop
             float newStop = pos.highWaterMark * (1.0f - config_.risk.trailingStopPercent);
             if (newStop > pos.stopLossPrice) {
@@ -518,8 +563,8 @@ void Backtester::updateTrailingStop(Position& pos, const Candle& candle) {
         }
     } else {
         // Update low water mark for short
-        if (candle.low < pos.lowWaterMark) {
-            pos.lowWaterMark = candle.low;
+        if (bars.low[idx] < pos.lowWaterMark) {
+            pos.lowWaterMark = bars.low[idx];
             float newStop = pos.lowWaterMark * (1.0f + config_.risk.trailingStopPercent);
             if (newStop < pos.stopLossPrice || pos.stopLossPrice <= 0) {
                 pos.stopLossPrice = newStop;
@@ -529,15 +574,15 @@ void Backtester::updateTrailingStop(Position& pos, const Candle& candle) {
 }
 
 // === METRIC CALCULATIONS ===
-void Backtester::calculateMetrics(BacktestResult& result, const std::vector<double>& dailyReturns,
+void Backtester::calculateMetrics(BacktestResult& result, const ReturnStats& returns,
                                    int totalBars) const {
-    if (dailyReturns.empty()) return;
+    if (returns.count == 0) return;
 
     // Sharpe Ratio
-    result.sharpeRatio = calculateSharpeRatio(dailyReturns);
+    result.sharpeRatio = calculateSharpeRatio(returns);
 
     // Sortino Ratio
-    result.sortinoRatio = calculateSortinoRatio(dailyReturns);
+    result.sortinoRatio = calculateSortinoRatio(returns);
 
     // Annualized Return (CAGR)
     double years = (double)totalBars / config_.tradingDaysPerYear;
@@ -551,34 +596,18 @@ void Backtester::calculateMetrics(BacktestResult& result, const std::vector<doub
     }
 
     // Volatility
-    double meanRet = std::accumulate(dailyReturns.begin(), dailyReturns.end(), 0.0) / dailyReturns.size();
-    double variance = 0.0;
-    for (double r : dailyReturns) {
-        variance += (r - meanRet) * (r - meanRet);
-    }
-    if (dailyReturns.size() > 1) {
-        variance /= (dailyReturns.size() - 1);
-    }
+    double variance = returns.count > 1 ? returns.sampleVariance() : returns.sumSquaredDeviation;
     result.volatility = std::sqrt(variance) * std::sqrt((double)config_.tradingDaysPerYear);
 
     // Downside deviation
-    double sumDownside = 0.0;
-    int countDownside = 0;
-    double dailyRiskFree = config_.riskFreeRate / config_.tradingDaysPerYear;
-    for (double r : dailyReturns) {
-        if (r < dailyRiskFree) {
-            sumDownside += (r - dailyRiskFree) * (r - dailyRiskFree);
-            countDownside++;
-        }
-    }
-    if (countDownside > 1) {
-        result.downsideDeviation = std::sqrt(sumDownside / (countDownside - 1)) *
+    if (returns.downsideCount > 1) {
+        result.downsideDeviation = std::sqrt(returns.downsideSumSquared / (returns.downsideCount - 1)) *
                                    std::sqrt((double)config_.tradingDaysPerYear);
     }
 
     // VaR and CVaR
-    result.valueAtRisk95 = calculateVaR(dailyReturns, 0.95);
-    result.cvar95 = calculateCVaR(dailyReturns, 0.95);
+    result.valueAtRisk95 = returns.valueAtRisk;
+    result.cvar95 = returns.conditionalVaR;
 
     // Cost impact (compare return with vs without costs)
     if (result.totalCosts > 0 && config_.initialCapital > 0) {
@@ -586,45 +615,28 @@ void Backtester::calculateMetrics(BacktestResult& result, const std::vector<doub
     }
 }
 
-double Backtester::calculateSharpeRatio(const std::vector<double>& returns) const {
-    if (returns.size() < 2) return 0.0;
+double Backtester::calculateSharpeRatio(const ReturnStats& returns) const {
+    if (returns.count < 2) return 0.0;
 
     double dailyRiskFree = config_.riskFreeRate / config_.tradingDaysPerYear;
-    double meanRet = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double excessReturn = meanRet - dailyRiskFree;
+    double excessReturn = returns.mean - dailyRiskFree;
 
-    double variance = 0.0;
-    for (double r : returns) {
-        variance += (r - meanRet) * (r - meanRet);
-    }
-    variance /= (returns.size() - 1);  // Sample variance
-
-    double stdDev = std::sqrt(variance);
+    double stdDev = std::sqrt(returns.sampleVariance());
     if (stdDev < 1e-9) return 0.0;
 
     return (excessReturn / stdDev) * std::sqrt((double)config_.tradingDaysPerYear);
 }
 
-double Backtester::calculateSortinoRatio(const std::vector<double>& returns) const {
-    if (returns.size() < 2) return 0.0;
+double Backtester::calculateSortinoRatio(const ReturnStats& returns) const {
+    if (returns.count < 2) return 0.0;
 
     double dailyRiskFree = config_.riskFreeRate / config_.tradingDaysPerYear;
-    double meanRet = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double excessReturn = meanRet - dailyRiskFree;
-
-    // Downside deviation (only negative returns)
-    double sumSquaredDownside = 0.0;
-    int countDownside = 0;
-    for (double r : returns) {
-        if (r < dailyRiskFree) {
-            sumSquaredDownside += (r - dailyRiskFree) * (r - dailyRiskFree);
-            countDownside++;
-        }
-    }
+    double excessReturn = returns.mean - dailyRiskFree;
 
-    if (countDownside < 2) return 0.0;
+    // Downside deviation (only returns below the risk-free rate)
+    if (returns.downsideCount < 2) return 0.0;
 
-    double downsideStd = std::sqrt(sumSquaredDownside / (countDownside - 1));
+    double downsideStd = std::sqrt(returns.downsideSumSquared / (returns.downsideCount - 1));
     if (downsideStd < 1e-9) return 0.0;
 
     return (excessReturn / downsideStd) * std::sqrt((double)config_.tradingDaysPerYear);
@@ -660,27 +672,38 @@ double Backtester::calculateMaxDrawdown(const std::vector<double>& equityCurve,
     return maxDD;
 }
 
-double Backtester::calculateVaR(std::vector<double> returns, double confidence) const {
-    if (returns.empty()) return 0.0;
+// Exact statistics from a stored return curve (ResultDetail::Full)
+ReturnStats Backtester::exactReturnStats(const std::vector<double>& returns, double confidence) const {
+    ReturnStats stats;
+    stats.count = returns.size();
+    if (returns.empty()) return stats;
 
-    std::sort(returns.begin(), returns.end());
+    stats.mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+    double dailyRiskFree = config_.riskFreeRate / config_.tradingDaysPerYear;
+    for (double r : returns) {
+        stats.sumSquaredDeviation += (r - stats.mean) * (r - stats.mean);
+        if (r < dailyRiskFree) {
+            stats.downsideSumSquared += (r - dailyRiskFree) * (r - dailyRiskFree);
+            stats.downsideCount++;
+        }
+    }
+
+    // VaR is the return at the tail index, CVaR the mean of the returns below
+    // it. Only that prefix needs ordering, so one partial sort covers both.
     size_t index = (size_t)((1.0 - confidence) * returns.size());
     if (index >= returns.size()) index = returns.size() - 1;
+    size_t cutoff = std::max<size_t>(1, (size_t)((1.0 - confidence) * returns.size()));
 
-    return -returns[index];  // Return as positive number (loss)
-}
+    std::vector<double> tail(returns);
+    size_t sorted = std::min(returns.size(), std::max(index, cutoff - 1) + 1);
+    std::partial_sort(tail.begin(), tail.begin() + sorted, tail.end());
 
-double Backtester::calculateCVaR(std::vector<double> returns, double confidence) const {
-    if (returns.empty()) return 0.0;
-
-    std::sort(returns.begin(), returns.end());
-    size_t cutoff = (size_t)((1.0 - confidence) * returns.size());
-    if (cutoff == 0) cutoff = 1;
+    stats.valueAtRisk = -tail[index];  // Positive number (loss)
 
     double sum = 0.0;
     for (size_t i = 0; i < cutoff; ++i) {
-        sum += returns[i];
+        sum += tail[i];
     }
-
-    return -sum / cutoff;  // Return as positive number (expected loss)
+    stats.conditionalVaR = -sum / cutoff;  // Positive number (expected loss)
+    return stats;
 }
@@ -3,9 +3,41 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <cstdint>
 #include "MarketData.h"
 #include "BacktestConfig.h"
 #include "IStrategy.h"
+#include "BarColumns.h"
+#include "MetricsAccumulator.h"
+
+// Trade direction and exit cause, kept as codes so the simulation loop never
+// builds strings; toString() gives the text for reports.
+enum class TradeSide : uint8_t { Long, Short };
+
+enum class ExitReason : uint8_t {
+    Signal,         // Opposite strategy signal
+    StopLoss,       // Stop-loss hit (fixed or trailing)
+    TakeProfit,     // Take-profit hit
+    TrailingStop,   // Reserved for engines that report trailing stops separately
+    MaxDrawdown,    // Max-drawdown circuit breaker
+    EndOfData       // Closed on the last bar
+};
+
+inline const char* toString(TradeSide side) {
+    return side == TradeSide::Long ? "long" : "short";
+}
+
+inline const char* toString(ExitReason reason) {
+    switch (reason) {
+        case ExitReason::Signal: return "signal";
+        case ExitReason::StopLoss: return "stop_loss";
+        case ExitReason::TakeProfit: return "take_profit";
+        case ExitReason::TrailingStop: return "trailing_stop";
+        case ExitReason::MaxDrawdown: return "max_drawdown";
+        case ExitReason::EndOfData: return "end_of_data";
+    }
+    return "";
+}
 
 // Record of a single trade for detailed analysis
 struct TradeRecord {
@@ -20,8 +52,8 @@ struct TradeRecord {
     double pnlPercent = 0.0;        // Profit/loss as percentage
     double transactionCost = 0.0;   // Total transaction costs
     double slippage = 0.0;          // Total slippage cost
-    std::string side;               // "long" or "short"
-    std::string exitReason;         // "signal", "stop_loss", "take_profit", "trailing_stop", "end_of_data"
+    TradeSide side = TradeSide::Long;
+    ExitReason exitReason = ExitReason::Signal;
     int holdingPeriod = 0;          // Number of bars held
 
     bool isWin() const { return pnl > 0; }
@@ -74,7 +106,7 @@ struct BacktestResult {
     int maxConsecutiveWins = 0;
     int maxConsecutiveLosses = 0;
 
-    // === NEW: Detailed Records ===
+    // === NEW: Detailed Records (empty with ResultDetail::SummaryOnly) ===
     std::vector<TradeRecord> tradeLog;
     std::vector<double> equityCurve;     // Equity value at each bar
     std::vector<double> dailyReturns;    // Returns per bar
@@ -115,6 +147,14 @@ public:
     using SignalFunction = std::function<StrategySignal(const std::vector<Candle>&, size_t)>;
     BacktestResult run(const std::vector<Candle>& candles, SignalFunction signalFunc, int warmupPeriod = 60);
 
+    // Two-phase mode: phase one computes a SignalArray for the whole series
+    // (IStrategy::generateSignals), phase two is the simulation kernel below,
+    // which applies costs, stops and sizing over plain price/signal arrays.
+    // The same SignalArray can be re-simulated under many configs (setConfig)
+    // without evaluating the strategy again. signals.firstBar is the warmup.
+    BacktestResult run(const std::vector<Candle>& candles, const SignalArray& signals);
+    BacktestResult run(BarColumnsView bars, const SignalArray& signals);
+
     // Get/set configuration
     const BacktestConfig& getConfig() const { return config_; }
     void setConfig(const BacktestConfig& config) { config_ = config; }
@@ -124,22 +164,58 @@ public:
     static BacktestResult run(const std::vector<Candle>& candles);
 
 private:
+    friend class BatchBacktester;   // Drives the per-bar kernel for many configs
+
     BacktestConfig config_;
 
+    // Portfolio state of one simulation (one config over one series)
+    struct SimulationState {
+        BacktestResult result;
+        float cash = 0.0f;
+        float equity = 0.0f;
+        Position position;
+        int barsSinceLastTrade = 0;
+        int consecutiveWins = 0;
+        int consecutiveLosses = 0;
+        float grossProfit = 0.0f;
+        float grossLoss = 0.0f;
+        float totalHolding = 0.0f;      // Sum of holding periods of closed trades
+        int closedTrades = 0;
+        MetricsAccumulator metrics;     // Drawdown always; returns in SummaryOnly mode
+        bool keepDetail = true;         // Store trade log and curves
+        bool stopped = false;           // Max-drawdown circuit breaker tripped
+    };
+
+    // Simulation kernel, split per bar so several states can be advanced in
+    // lockstep over the same bars
+    void beginSimulation(SimulationState& st, size_t totalBars, const SignalArray& signals) const;
+    void simulateBar(SimulationState& st, const BarColumnsView& bars, size_t i,
+                     const SignalArray& signals);
+    void finishSimulation(SimulationState& st, const BarColumnsView& bars, int warmupPeriod) const;
+    BacktestResult simulate(const BarColumnsView& bars, const SignalArray& signals);
+
+    // Trade dates are filled in after simulation, only for the recorded trades
+    template <typename DateFn>
+    static void labelTrades(BacktestResult& result, DateFn dateAt) {
+        for (auto& trade : result.tradeLog) {
+            trade.entryDate = dateAt(trade.entryIndex);
+            trade.exitDate = dateAt(trade.exitIndex);
+        }
+    }
+
     // Internal helpers
-    void openPosition(Position& pos, const Candle& candle, size_t idx,
-                     double capitalAvailable, const StrategySignal& signal, bool isLong);
-    TradeRecord closePosition(Position& pos, const Candle& candle, size_t idx,
-                             const std::string& reason);
-    bool checkStopLoss(const Position& pos, const Candle& candle, double& exitPrice) const;
-    bool checkTakeProfit(const Position& pos, const Candle& candle, double& exitPrice) const;
-    void updateTrailingStop(Position& pos, const Candle& candle);
-    void calculateMetrics(BacktestResult& result, const std::vector<double>& dailyReturns,
-                         int totalBars) const;
-    double calculateSharpeRatio(const std::vector<double>& returns) const;
-    double calculateSortinoRatio(const std::vector<double>& returns) const;
+    static void recordTrade(SimulationState& st, const TradeRecord& trade);
+    void openPosition(Position& pos, const BarColumnsView& bars, size_t idx,
+                     double capitalAvailable, const SignalArray& signals, bool isLong) const;
+    TradeRecord closePosition(Position& pos, const BarColumnsView& bars, size_t idx,
+                             ExitReason reason) const;
+    bool checkStopLoss(const Position& pos, const BarColumnsView& bars, size_t idx, double& exitPrice) const;
+    bool checkTakeProfit(const Position& pos, const BarColumnsView& bars, size_t idx, double& exitPrice) const;
+    void updateTrailingStop(Position& pos, const BarColumnsView& bars, size_t idx) const;
+    void calculateMetrics(BacktestResult& result, const ReturnStats& returns, int totalBars) const;
+    double calculateSharpeRatio(const ReturnStats& returns) const;
+    double calculateSortinoRatio(const ReturnStats& returns) const;
     double calculateMaxDrawdown(const std::vector<double>& equityCurve,
                               double& maxDuration) const;
-    double calculateVaR(std::vector<double> returns, double confidence) const;
-    double calculateCVaR(std::vector<double> returns, double confidence) const;
+    ReturnStats exactReturnStats(const std::vector<double>& returns, double confidence) const;
 };
@@ -0,0 +1,279 @@
+#include "BarArchive.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+#include <cctype>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Timestamps are stored as int64 unix seconds and exposed in place as TimePoint
+static_assert(sizeof(TimePoint) == sizeof(int64_t) && std::is_trivially_copyable_v<TimePoint>,
+              "TimePoint must be layout-compatible with int64 seconds");
+
+namespace {
+
+constexpr char kMagic[4] = {'T', 'B', 'A', 'R'};
+
+// A temporary name next to path that no other write uses, in this process or
+// another, so concurrent writers of one archive never share a file
+std::string tempPathFor(const std::string& path) {
+    static std::atomic<uint64_t> writes{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    long pid = static_cast<long>(getpid());
+#endif
+    return path + "." + std::to_string(pid) + "." + std::to_string(writes++) + ".tmp";
+}
+
+size_t fileSizeFor(uint64_t barCount) {
+    return sizeof(BarArchiveHeader) + static_cast<size_t>(barCount) * BarArchive::kColumnCount * 8;
+}
+
+std::string intervalLabel(int64_t seconds) {
+    if (seconds > 0 && seconds % 86400 == 0) return std::to_string(seconds / 86400) + "d";
+    if (seconds > 0 && seconds % 3600 == 0) return std::to_string(seconds / 3600) + "h";
+    if (seconds > 0 && seconds % 60 == 0) return std::to_string(seconds / 60) + "m";
+    return std::to_string(seconds) + "s";
+}
+
+template <typename T>
+void writeColumn(std::ofstream& ofs, std::span<const T> column) {
+    ofs.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size_bytes()));
+}
+
+} // namespace
+
+// --- MappedBarFile ---
+
+Result<MappedBarFile> MappedBarFile::open(const std::string& path) {
+    MappedBarFile file;
+
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) {
+        return Result<MappedBarFile>::err(Error::notFound(path));
+    }
+    file.fileHandle_ = fh;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fh, &size)) {
+        return Result<MappedBarFile>::err(Error::internal("Cannot stat " + path));
+    }
+    file.length_ = static_cast<size_t>(size.QuadPart);
+    if (file.length_ < sizeof(BarArchiveHeader)) {
+        return Result<MappedBarFile>::err(Error::parse("Truncated bar archive: " + path));
+    }
+
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) {
+        return Result<MappedBarFile>::err(Error::internal("Cannot map " + path));
+    }
+    file.mappingHandle_ = mh;
+
+    file.data_ = static_cast<const char*>(MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0));
+    if (!file.data_) {
+        return Result<MappedBarFile>::err(Error::internal("Cannot map " + path));
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Result<MappedBarFile>::err(Error::notFound(path));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return Result<MappedBarFile>::err(Error::internal("Cannot stat " + path));
+    }
+    file.length_ = static_cast<size_t>(st.st_size);
+    if (file.length_ < sizeof(BarArchiveHeader)) {
+        ::close(fd);
+        return Result<MappedBarFile>::err(Error::parse("Truncated bar archive: " + path));
+    }
+
+    void* addr = mmap(nullptr, file.length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps its own reference to the file
+    if (addr == MAP_FAILED) {
+        file.length_ = 0;
+        return Result<MappedBarFile>::err(Error::internal("Cannot map " + path));
+    }
+    file.data_ = static_cast<const char*>(addr);
+#endif
+
+    BarArchiveHeader header;
+    std::memcpy(&header, file.data_, sizeof(header));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return Result<MappedBarFile>::err(Error::parse("Not a bar archive: " + path));
+    }
+    if (header.version != BarArchive::kVersion || header.headerSize != sizeof(BarArchiveHeader) ||
+        header.columnCount != BarArchive::kColumnCount) {
+        return Result<MappedBarFile>::err(Error::parse(
+            "Unsupported bar archive version " + std::to_string(header.version) + ": " + path));
+    }
+    if (file.length_ != fileSizeFor(header.barCount)) {
+        return Result<MappedBarFile>::err(Error::parse("Bar archive size mismatch: " + path));
+    }
+
+    size_t n = static_cast<size_t>(header.barCount);
+    const char* col = file.data_ + sizeof(BarArchiveHeader);
+    auto doubles = [&](size_t k) {
+        return std::span<const double>(reinterpret_cast<const double*>(col + k * n * 8), n);
+    };
+    file.view_.ts = std::span<const TimePoint>(reinterpret_cast<const TimePoint*>(col), n);
+    file.view_.open = doubles(1);
+    file.view_.high = doubles(2);
+    file.view_.low = doubles(3);
+    file.view_.close = doubles(4);
+    file.view_.volume = std::span<const int64_t>(reinterpret_cast<const int64_t*>(col + 5 * n * 8), n);
+
+    file.symbol_ = std::string(header.symbol, strnlen(header.symbol, sizeof(header.symbol)));
+    file.intervalSeconds_ = header.intervalSeconds;
+    file.writtenAt_ = TimeUtils::fromUnixSeconds(header.writtenAt);
+
+    return Result<MappedBarFile>::ok(std::move(file));
+}
+
+MappedBarFile::MappedBarFile(MappedBarFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedBarFile& MappedBarFile::operator=(MappedBarFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        length_ = other.length_;
+#ifdef _WIN32
+        fileHandle_ = other.fileHandle_;
+        mappingHandle_ = other.mappingHandle_;
+        other.fileHandle_ = nullptr;
+        other.mappingHandle_ = nullptr;
+#endif
+        view_ = other.view_;
+        symbol_ = std::move(other.symbol_);
+        intervalSeconds_ = other.intervalSeconds_;
+        writtenAt_ = other.writtenAt_;
+
+        other.data_ = nullptr;
+        other.length_ = 0;
+        other.view_ = BarColumnsView();
+    }
+    return *this;
+}
+
+MappedBarFile::~MappedBarFile() {
+    release();
+}
+
+void MappedBarFile::release() {
+#ifdef _WIN32
+    if (data_) UnmapViewOfFile(data_);
+    if (mappingHandle_) CloseHandle(mappingHandle_);
+    if (fileHandle_) CloseHandle(fileHandle_);
+    mappingHandle_ = nullptr;
+    fileHandle_ = nullptr;
+#else
+    if (data_) munmap(const_cast<char*>(data_), length_);
+#endif
+    data_ = nullptr;
+    length_ = 0;
+}
+
+BarColumns MappedBarFile::toColumns() const {
+    BarColumns cols;
+    cols.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        Candle c;
+        c.ts = view_.ts[i];
+        c.open = view_.open[i];
+        c.high = view_.high[i];
+        c.low = view_.low[i];
+        c.close = view_.close[i];
+        c.volume = view_.volume[i];
+        cols.push_back(c);
+    }
+    return cols;
+}
+
+// --- BarArchive ---
+
+namespace BarArchive {
+
+std::string pathFor(const std::string& symbol, int64_t intervalSeconds, const std::string& directory) {
+    // Keep file names portable: "^VIX" -> "_VIX", "EUR=X" -> "EUR_X"
+    std::string name;
+    for (char ch : symbol) {
+        bool safe = std::isalnum(static_cast<unsigned char>(ch)) || ch == '-' || ch == '.' || ch == '_';
+        name += safe ? ch : '_';
+    }
+    return directory + "/" + name + "_" + intervalLabel(intervalSeconds) + ".bars";
+}
+
+Result<void> write(const std::string& path, BarColumnsView bars,
+                   const std::string& symbol, int64_t intervalSeconds) {
+    std::error_code ec;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+        if (ec) {
+            return Result<void>::err(Error::internal("Cannot create " + target.parent_path().string()));
+        }
+    }
+
+    BarArchiveHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(BarArchiveHeader);
+    header.columnCount = kColumnCount;
+    header.barCount = bars.size();
+    header.intervalSeconds = intervalSeconds;
+    header.writtenAt = TimeUtils::toUnixSeconds(TimeUtils::now());
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol)));
+
+    std::string tmpPath = tempPathFor(path);
+    {
+        std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!ofs) {
+            return Result<void>::err(Error::internal("Cannot open " + tmpPath));
+        }
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeColumn(ofs, bars.ts);
+        writeColumn(ofs, bars.open);
+        writeColumn(ofs, bars.high);
+        writeColumn(ofs, bars.low);
+        writeColumn(ofs, bars.close);
+        writeColumn(ofs, bars.volume);
+        if (!ofs) {
+            return Result<void>::err(Error::internal("Write failed: " + tmpPath));
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return Result<void>::err(Error::internal("Cannot replace " + path));
+    }
+    return Result<void>::ok();
+}
+
+Result<MappedBarFile> openSymbol(const std::string& symbol, int64_t intervalSeconds) {
+    return MappedBarFile::open(pathFor(symbol, intervalSeconds));
+}
+
+} // namespace BarArchive
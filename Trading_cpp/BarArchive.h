@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include "BarColumns.h"
+#include "Result.h"
+
+// Binary bar archive: one file per symbol/interval holding the bars in the
+// same column layout as BarColumns, so a file can be memory-mapped and read
+// in place without any parsing.
+//
+// Layout (native byte order, every field 8-byte aligned):
+//   BarArchiveHeader (64 bytes)
+//   int64  ts[barCount]        unix seconds
+//   double open[barCount]
+//   double high[barCount]
+//   double low[barCount]
+//   double close[barCount]
+//   int64  volume[barCount]
+struct BarArchiveHeader {
+    char magic[4];              // "TBAR"
+    uint32_t version;           // BarArchive::kVersion
+    uint32_t headerSize;        // sizeof(BarArchiveHeader)
+    uint32_t columnCount;       // BarArchive::kColumnCount
+    uint64_t barCount;
+    int64_t intervalSeconds;    // Bar size (86400 = daily)
+    int64_t writtenAt;          // Unix seconds when the file was written
+    char symbol[24];            // NUL-padded, truncated if longer
+};
+static_assert(sizeof(BarArchiveHeader) == 64, "BarArchiveHeader must stay 64 bytes");
+
+// Read-only memory mapping of an archive file. view() points straight into
+// the mapping and stays valid for the lifetime of this object.
+class MappedBarFile {
+public:
+    static Result<MappedBarFile> open(const std::string& path);
+
+    MappedBarFile(MappedBarFile&& other) noexcept;
+    MappedBarFile& operator=(MappedBarFile&& other) noexcept;
+    MappedBarFile(const MappedBarFile&) = delete;
+    MappedBarFile& operator=(const MappedBarFile&) = delete;
+    ~MappedBarFile();
+
+    BarColumnsView view() const { return view_; }
+    size_t size() const { return view_.size(); }
+    const std::string& symbol() const { return symbol_; }
+    int64_t intervalSeconds() const { return intervalSeconds_; }
+    TimePoint writtenAt() const { return writtenAt_; }
+
+    // Owning copy (e.g. to keep appending bars)
+    BarColumns toColumns() const;
+
+private:
+    MappedBarFile() = default;
+    void release();
+
+    const char* data_ = nullptr;
+    size_t length_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+
+    BarColumnsView view_;
+    std::string symbol_;
+    int64_t intervalSeconds_ = 0;
+    TimePoint writtenAt_{};
+};
+
+namespace BarArchive {
+    constexpr uint32_t kVersion = 1;
+    constexpr uint32_t kColumnCount = 6;
+    constexpr int64_t kDailySeconds = 86400;
+
+    // Archive location for a symbol/interval, e.g. ".cache/bars/AAPL_1d.bars"
+    std::string pathFor(const std::string& symbol, int64_t intervalSeconds = kDailySeconds,
+                        const std::string& directory = ".cache/bars");
+
+    // Write (or replace) an archive. The file is written to a temporary name
+    // and renamed into place, so readers never observe a partial file.
+    Result<void> write(const std::string& path, BarColumnsView bars,
+                       const std::string& symbol, int64_t intervalSeconds = kDailySeconds);
+
+    // Map the archive for a symbol (any age)
+    Result<MappedBarFile> openSymbol(const std::string& symbol,
+                                     int64_t intervalSeconds = kDailySeconds);
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include "MarketData.h"
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <string>
+#include <cstdint>
+#include <utility>
+
+// Read-only view over a column store (or a window of one). Every column has
+// the same length; index 0 is the oldest bar. Cheap to pass by value.
+struct BarColumnsView {
+    std::span<const TimePoint> ts;
+    std::span<const double> open;
+    std::span<const double> high;
+    std::span<const double> low;
+    std::span<const double> close;
+    std::span<const int64_t> volume;
+
+    size_t size() const { return close.size(); }
+    bool empty() const { return close.empty(); }
+
+    // First n bars (e.g. the history up to and including bar n - 1)
+    BarColumnsView first(size_t n) const {
+        return {ts.first(n), open.first(n), high.first(n),
+                low.first(n), close.first(n), volume.first(n)};
+    }
+
+    // Last n bars
+    BarColumnsView last(size_t n) const {
+        return {ts.last(n), open.last(n), high.last(n),
+                low.last(n), close.last(n), volume.last(n)};
+    }
+
+    // Materialize a single bar (date is rebuilt as unix seconds, as fetchCandles does)
+    Candle candle(size_t i) const {
+        Candle c;
+        c.ts = ts[i];
+        c.date = std::to_string(TimeUtils::toUnixSeconds(ts[i]));
+        c.open = open[i];
+        c.high = high[i];
+        c.low = low[i];
+        c.close = close[i];
+        c.volume = volume[i];
+        return c;
+    }
+};
+
+// BarColumns: Structure-of-arrays bar store
+// Keeps timestamps, OHLC and volume in separate contiguous arrays so indicator
+// code can read e.g. closes() directly instead of extracting them from a
+// std::vector<Candle> (whose per-bar date string spreads the prices over many
+// cache lines) into a fresh vector on every call.
+class BarColumns {
+public:
+    BarColumns() = default;
+
+    explicit BarColumns(CandleView candles) { append(candles); }
+
+    // Adopt columns filled elsewhere (all the same length), without copying
+    BarColumns(std::vector<TimePoint> ts, std::vector<double> open, std::vector<double> high,
+               std::vector<double> low, std::vector<double> close, std::vector<int64_t> volume)
+        : ts_(std::move(ts)), open_(std::move(open)), high_(std::move(high)),
+          low_(std::move(low)), close_(std::move(close)), volume_(std::move(volume)) {}
+
+    void reserve(size_t n) {
+        ts_.reserve(n);
+        open_.reserve(n);
+        high_.reserve(n);
+        low_.reserve(n);
+        close_.reserve(n);
+        volume_.reserve(n);
+    }
+
+    void push_back(const Candle& c) {
+        ts_.push_back(c.ts);
+        open_.push_back(c.open);
+        high_.push_back(c.high);
+        low_.push_back(c.low);
+        close_.push_back(c.close);
+        volume_.push_back(c.volume);
+    }
+
+    void append(CandleView candles) {
+        reserve(size() + candles.size());
+        for (const auto& c : candles) push_back(c);
+    }
+
+    // Append the bars newer than the last one held, in order, with
+    // BarSeries::tryAppend semantics (duplicates and older bars are
+    // rejected). Returns how many were appended.
+    size_t appendNewer(BarColumnsView bars) {
+        size_t appended = 0;
+        for (size_t i = 0; i < bars.size(); ++i) {
+            if (!empty() && bars.ts[i] <= ts_.back()) continue;
+            ts_.push_back(bars.ts[i]);
+            open_.push_back(bars.open[i]);
+            high_.push_back(bars.high[i]);
+            low_.push_back(bars.low[i]);
+            close_.push_back(bars.close[i]);
+            volume_.push_back(bars.volume[i]);
+            ++appended;
+        }
+        return appended;
+    }
+
+    // Drop the newest bar
+    void pop_back() {
+        ts_.pop_back();
+        open_.pop_back();
+        high_.pop_back();
+        low_.pop_back();
+        close_.pop_back();
+        volume_.pop_back();
+    }
+
+    void clear() {
+        ts_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+    }
+
+    // Drop the oldest bars so that at most n remain
+    void trimToLast(size_t n) {
+        if (size() <= n) return;
+        size_t drop = size() - n;
+        ts_.erase(ts_.begin(), ts_.begin() + drop);
+        open_.erase(open_.begin(), open_.begin() + drop);
+        high_.erase(high_.begin(), high_.begin() + drop);
+        low_.erase(low_.begin(), low_.begin() + drop);
+        close_.erase(close_.begin(), close_.begin() + drop);
+        volume_.erase(volume_.begin(), volume_.begin() + drop);
+    }
+
+    // Drop the bars older than `from`
+    void trimBefore(TimePoint from) {
+        auto first = std::lower_bound(ts_.begin(), ts_.end(), from);
+        trimToLast(static_cast<size_t>(ts_.end() - first));
+    }
+
+    size_t size() const { return close_.size(); }
+    bool empty() const { return close_.empty(); }
+
+    // Column accessors (no copies)
+    std::span<const TimePoint> timestamps() const { return ts_; }
+    std::span<const double> opens() const { return open_; }
+    std::span<const double> highs() const { return high_; }
+    std::span<const double> lows() const { return low_; }
+    std::span<const double> closes() const { return close_; }
+    std::span<const int64_t> volumes() const { return volume_; }
+
+    BarColumnsView view() const {
+        return {ts_, open_, high_, low_, close_, volume_};
+    }
+    operator BarColumnsView() const { return view(); }
+
+    Candle candle(size_t i) const { return view().candle(i); }
+
+    std::vector<Candle> toCandles() const {
+        std::vector<Candle> out;
+        out.reserve(size());
+        for (size_t i = 0; i < size(); ++i) out.push_back(candle(i));
+        return out;
+    }
+
+private:
+    std::vector<TimePoint> ts_;
+    std::vector<double> open_;
+    std::vector<double> high_;
+    std::vector<double> low_;
+    std::vector<double> close_;
+    std::vector<int64_t> volume_;
+};
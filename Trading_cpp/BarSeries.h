@@ -1,5 +1,6 @@
 #pragma once
 #include "MarketData.h"
+#include "BarColumns.h"
 #include <vector>
 #include <optional>
 #include <algorithm>
@@ -28,6 +29,16 @@ public:
     // Get all bars (read-only)
     const std::vector<Candle>& bars() const { return bars_; }
 
+    // Same bars in column (SoA) form. Built on first use and extended with
+    // the bars appended since, so only series that are read this way hold
+    // the columns. Like tryAppend, not for use from several threads at once.
+    const BarColumns& columns() const {
+        if (columns_.size() < bars_.size()) {
+            columns_.append(CandleView(bars_).subspan(columns_.size()));
+        }
+        return columns_;
+    }
+
     // Get number of bars
     size_t size() const { return bars_.size(); }
 
@@ -64,27 +75,33 @@ public:
     }
 
     // Clear all bars
-    void clear() { bars_.clear(); }
+    void clear() {
+        bars_.clear();
+        columns_.clear();
+    }
 
     // Keep only the last N bars (for memory management in live trading)
     void trimToLast(size_t n) {
         if (bars_.size() > n) {
+            // Columns already built cover the oldest bars; keep what remains of them
+            size_t drop = bars_.size() - n;
             bars_.erase(bars_.begin(), bars_.end() - n);
+            columns_.trimToLast(columns_.size() > drop ? columns_.size() - drop : 0);
         }
     }
 
     // Extract close prices for indicator calculations
+    // (prefer columns().closes() when a read-only span is enough)
     std::vector<double> closePrices() const {
         std::vector<double> closes;
         closes.reserve(bars_.size());
-        for (const auto& bar : bars_) {
-            closes.push_back(bar.close);
-        }
+        for (const auto& bar : bars_) closes.push_back(bar.close);
         return closes;
     }
 
 private:
     std::vector<Candle> bars_;
+    mutable BarColumns columns_;  // Cache of the first columns_.size() bars
 
     void sortBars() {
         std::sort(bars_.begin(), bars_.end(),
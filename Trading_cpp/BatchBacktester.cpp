@@ -0,0 +1,69 @@
+#include "BatchBacktester.h"
+
+BatchBacktester::BatchBacktester(const std::vector<BacktestConfig>& configs) {
+    backtesters_.reserve(configs.size());
+    for (const auto& config : configs) {
+        backtesters_.emplace_back(config);
+    }
+}
+
+std::vector<BacktestResult> BatchBacktester::run(const std::vector<Candle>& candles, const SignalArray& signals) {
+    BarColumns bars(candles);
+    std::vector<BacktestResult> results = simulate(bars, signals);
+    for (auto& result : results) {
+        Backtester::labelTrades(result, [&candles](size_t idx) { return candles[idx].date; });
+    }
+    return results;
+}
+
+std::vector<BacktestResult> BatchBacktester::run(BarColumnsView bars, const SignalArray& signals) {
+    std::vector<BacktestResult> results = simulate(bars, signals);
+    for (auto& result : results) {
+        Backtester::labelTrades(result, [&bars](size_t idx) {
+            return std::to_string(TimeUtils::toUnixSeconds(bars.ts[idx]));
+        });
+    }
+    return results;
+}
+
+std::vector<BacktestResult> BatchBacktester::run(const std::vector<Candle>& candles, IStrategy& strategy) {
+    int warmup = strategy.getWarmupPeriod();
+    if ((int)candles.size() < warmup + 10) {
+        return std::vector<BacktestResult>(backtesters_.size());
+    }
+    IndicatorContext indicators(candles);
+    return run(candles, strategy.generateSignals(indicators, warmup));
+}
+
+std::vector<BacktestResult> BatchBacktester::simulate(const BarColumnsView& bars, const SignalArray& signals) {
+    size_t n = backtesters_.size();
+    int warmupPeriod = (int)signals.firstBar;
+    if ((int)bars.size() < warmupPeriod + 10) {
+        return std::vector<BacktestResult>(n);
+    }
+
+    // Portfolio states side by side, one per config
+    std::vector<Backtester::SimulationState> states(n);
+    for (size_t k = 0; k < n; ++k) {
+        backtesters_[k].beginSimulation(states[k], bars.size(), signals);
+    }
+
+    // Bars outer, configs inner: each bar is touched once for all configs.
+    // Configs whose drawdown breaker tripped drop out of the loop.
+    size_t active = n;
+    for (size_t i = warmupPeriod; i < bars.size() && active > 0; ++i) {
+        for (size_t k = 0; k < n; ++k) {
+            if (states[k].stopped) continue;
+            backtesters_[k].simulateBar(states[k], bars, i, signals);
+            if (states[k].stopped) active--;
+        }
+    }
+
+    std::vector<BacktestResult> results;
+    results.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        backtesters_[k].finishSimulation(states[k], bars, warmupPeriod);
+        results.push_back(std::move(states[k].result));
+    }
+    return results;
+}
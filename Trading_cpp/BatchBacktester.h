@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include "Backtester.h"
+
+// Runs one signal stream through N backtest configurations in a single pass
+// over the bars. Each bar's prices and signal are loaded once and every
+// config's portfolio state is advanced against them before moving on, so a
+// parameter sweep (costs, stop percents, trailing stops, sizing, ...) costs
+// one strategy evaluation and one sweep over market data instead of N.
+//
+// Results are identical to calling Backtester::run with each config.
+class BatchBacktester {
+public:
+    explicit BatchBacktester(const std::vector<BacktestConfig>& configs);
+
+    // One result per config, in the order the configs were given
+    std::vector<BacktestResult> run(const std::vector<Candle>& candles, const SignalArray& signals);
+    std::vector<BacktestResult> run(BarColumnsView bars, const SignalArray& signals);
+
+    // Evaluates the strategy once (IStrategy::generateSignals) and shares
+    // the signals across all configs
+    std::vector<BacktestResult> run(const std::vector<Candle>& candles, IStrategy& strategy);
+
+    size_t size() const { return backtesters_.size(); }
+    const BacktestConfig& getConfig(size_t i) const { return backtesters_[i].getConfig(); }
+
+private:
+    std::vector<Backtester> backtesters_;
+
+    std::vector<BacktestResult> simulate(const BarColumnsView& bars, const SignalArray& signals);
+};
@@ -1,223 +1,317 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <map>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <chrono>
 #include <optional>
 #include <string>
 #include <functional>
 #include <thread>
+#include <future>
+#include <exception>
+#include <cstdint>
 
 // Thread-safe LRU Cache with TTL support
+// Keys are hashed over a power-of-two number of shards, each an independent
+// LRU (hash map + recency list, O(1) get/put) under its own lock, so
+// concurrent callers rarely contend. Values are stored as
+// shared_ptr<const Value> and handed out without copying. Expired entries
+// are found through a per-shard expiry wheel (one slot per second) rather
+// than by scanning the whole map.
 template<typename Key, typename Value>
 class LRUCache {
-private:
-    struct CacheEntry {
-        Value value;
-        std::chrono::steady_clock::time_point expiry;
-    };
-
-    size_t capacity_;
-    std::chrono::seconds ttl_;
-
-    // LRU list: front = most recently used, back = least recently used
-    std::list<Key> lruList_;
-
-    // Map from key to (iterator in list, cached value)
-    std::map<Key, std::pair<typename std::list<Key>::iterator, CacheEntry>> cacheMap_;
-
-    mutable std::mutex mutex_;
-
-    void evictExpired() {
-        auto now = std::chrono::steady_clock::now();
-        auto it = cacheMap_.begin();
-        while (it != cacheMap_.end()) {
-            if (it->second.second.expiry < now) {
-                lruList_.erase(it->second.first);
-                it = cacheMap_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-
-    void evictLRU() {
-        while (cacheMap_.size() >= capacity_ && !lruList_.empty()) {
-            const Key& lruKey = lruList_.back();
-            cacheMap_.erase(lruKey);
-            lruList_.pop_back();
-        }
+public:
+    using Clock = std::chrono::steady_clock;
+    using ValuePtr = std::shared_ptr<const Value>;
+
+    static constexpr size_t kMinShardCapacity = 64;
+
+    // Constructor with capacity and TTL (time-to-live in seconds). Capacity is
+    // split evenly over the shards. shardCount is rounded down to a power of
+    // two, and lowered so each shard keeps at least kMinShardCapacity entries
+    // (small shards would evict hot keys that hash together).
+    LRUCache(size_t capacity = 100, std::chrono::seconds ttl = std::chrono::seconds(300), size_t shardCount = 16)
+        : capacity_(capacity), ttl_(ttl.count()) {
+        size_t n = std::bit_floor(std::max<size_t>(1, std::min(shardCount, capacity / kMinShardCapacity)));
+        shardMask_ = n - 1;
+        shards_ = std::make_unique<Shard[]>(n);
+        for (size_t i = 0; i < n; ++i) shards_[i].capacity = shardCapacity(i);
     }
 
-public:
-    // Constructor with capacity and TTL (time-to-live in seconds)
-    LRUCache(size_t capacity = 100, std::chrono::seconds ttl = std::chrono::seconds(300))
-        : capacity_(capacity), ttl_(ttl) {}
+    // Get value from cache (nullptr when missing or expired)
+    ValuePtr get(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-    // Get value from cache
-    std::optional<Value> get(const Key& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        auto it = cacheMap_.find(key);
-        if (it == cacheMap_.end()) {
-            return std::nullopt;  // Not found
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            ++shard.misses;
+            return nullptr;
         }
-
-        // Check if expired
-        auto now = std::chrono::steady_clock::now();
-        if (it->second.second.expiry < now) {
-            // Expired, remove and return nullopt
-            lruList_.erase(it->second.first);
-            cacheMap_.erase(it);
-            return std::nullopt;
+        if (it->second->expiry < Clock::now()) {
+            shard.erase(it);
+            ++shard.expirations;
+            ++shard.misses;
+            return nullptr;
         }
 
         // Move to front of LRU list (most recently used)
-        lruList_.erase(it->second.first);
-        lruList_.push_front(key);
-        it->second.first = lruList_.begin();
-
-        return it->second.second.value;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        ++shard.hits;
+        return it->second->value;
     }
 
     // Put value into cache
-    void put(const Key& key, const Value& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        auto now = std::chrono::steady_clock::now();
-        auto expiry = now + ttl_;
-
-        auto it = cacheMap_.find(key);
-        if (it != cacheMap_.end()) {
-            // Update existing entry
-            it->second.second.value = value;
-            it->second.second.expiry = expiry;
-
-            // Move to front
-            lruList_.erase(it->second.first);
-            lruList_.push_front(key);
-            it->second.first = lruList_.begin();
-        } else {
-            // Evict if needed
-            evictExpired();
-            evictLRU();
-
-            // Insert new entry
-            lruList_.push_front(key);
-            CacheEntry entry{value, expiry};
-            cacheMap_[key] = {lruList_.begin(), entry};
-        }
+    void put(const Key& key, Value value) {
+        put(key, std::make_shared<const Value>(std::move(value)), std::chrono::seconds(ttl_.load()));
     }
 
     // Put with custom TTL
-    void put(const Key& key, const Value& value, std::chrono::seconds customTTL) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    void put(const Key& key, Value value, std::chrono::seconds customTTL) {
+        put(key, std::make_shared<const Value>(std::move(value)), customTTL);
+    }
 
-        auto now = std::chrono::steady_clock::now();
+    // Put an already shared value
+    void put(const Key& key, ValuePtr value, std::chrono::seconds customTTL) {
+        Shard& shard = shardFor(key);
+        auto now = Clock::now();
         auto expiry = now + customTTL;
 
-        auto it = cacheMap_.find(key);
-        if (it != cacheMap_.end()) {
-            it->second.second.value = value;
-            it->second.second.expiry = expiry;
-            lruList_.erase(it->second.first);
-            lruList_.push_front(key);
-            it->second.first = lruList_.begin();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.expireUntil(now);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            // Update existing entry
+            it->second->value = std::move(value);
+            it->second->expiry = expiry;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
         } else {
-            evictExpired();
-            evictLRU();
-            lruList_.push_front(key);
-            CacheEntry entry{value, expiry};
-            cacheMap_[key] = {lruList_.begin(), entry};
+            // Evict if needed, then insert new entry
+            shard.evictTo(shard.capacity > 0 ? shard.capacity - 1 : 0);
+            if (shard.capacity == 0) return;
+            shard.lru.push_front(Entry{key, std::move(value), expiry});
+            shard.index.emplace(key, shard.lru.begin());
         }
+        shard.schedule(key, expiry);
     }
 
     // Check if key exists and is not expired
     bool contains(const Key& key) const {
-        std::lock_guard<std::mutex> lock(mutex_);
+        const Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = cacheMap_.find(key);
-        if (it == cacheMap_.end()) {
-            return false;
-        }
-
-        auto now = std::chrono::steady_clock::now();
-        return it->second.second.expiry >= now;
+        auto it = shard.index.find(key);
+        return it != shard.index.end() && it->second->expiry >= Clock::now();
     }
 
     // Remove a specific key
     bool remove(const Key& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = cacheMap_.find(key);
-        if (it != cacheMap_.end()) {
-            lruList_.erase(it->second.first);
-            cacheMap_.erase(it);
-            return true;
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
         }
-        return false;
+        shard.erase(it);
+        return true;
     }
 
     // Clear all entries
     void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cacheMap_.clear();
-        lruList_.clear();
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].index.clear();
+            shards_[i].lru.clear();
+            for (auto& slot : shards_[i].wheel) slot.clear();
+        }
     }
 
     // Get current size
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return cacheMap_.size();
+        size_t total = 0;
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            total += shards_[i].index.size();
+        }
+        return total;
     }
 
     // Get capacity
     size_t capacity() const {
-        return capacity_;
+        return capacity_.load();
     }
 
     // Set new capacity (may trigger evictions)
     void setCapacity(size_t newCapacity) {
-        std::lock_guard<std::mutex> lock(mutex_);
         capacity_ = newCapacity;
-        evictLRU();
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].capacity = shardCapacity(i);
+            shards_[i].evictTo(shards_[i].capacity);
+        }
     }
 
     // Set new TTL (affects new entries only)
     void setTTL(std::chrono::seconds newTTL) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        ttl_ = newTTL;
+        ttl_ = newTTL.count();
     }
 
     // Get or compute: if key exists return cached value, otherwise compute and cache
-    Value getOrCompute(const Key& key, std::function<Value()> compute) {
-        auto cached = get(key);
-        if (cached) {
-            return *cached;
+    ValuePtr getOrCompute(const Key& key, std::function<Value()> compute) {
+        if (auto cached = get(key)) {
+            return cached;
         }
 
-        Value value = compute();
-        put(key, value);
+        auto value = std::make_shared<const Value>(compute());
+        put(key, value, std::chrono::seconds(ttl_.load()));
         return value;
     }
 
     // Clean up expired entries
     void cleanup() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        evictExpired();
+        auto now = Clock::now();
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].expireUntil(now);
+        }
     }
 
     // Get statistics
     struct Stats {
-        size_t size;
-        size_t capacity;
-        std::chrono::seconds ttl;
+        size_t size = 0;
+        size_t capacity = 0;
+        std::chrono::seconds ttl{0};
+        uint64_t hits = 0;
+        uint64_t misses = 0;         // Includes lookups that found an expired entry
+        uint64_t evictions = 0;      // Dropped for capacity
+        uint64_t expirations = 0;    // Dropped because their TTL passed
+
+        double hitRate() const {
+            uint64_t lookups = hits + misses;
+            return lookups > 0 ? (double)hits / (double)lookups : 0.0;
+        }
     };
 
     Stats getStats() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return Stats{cacheMap_.size(), capacity_, ttl_};
+        Stats stats;
+        stats.capacity = capacity_.load();
+        stats.ttl = std::chrono::seconds(ttl_.load());
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            const Shard& shard = shards_[i];
+            stats.size += shard.index.size();
+            stats.hits += shard.hits;
+            stats.misses += shard.misses;
+            stats.evictions += shard.evictions;
+            stats.expirations += shard.expirations;
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        ValuePtr value;
+        Clock::time_point expiry;
+    };
+    using EntryList = std::list<Entry>;
+
+    // Expiry wheel: slot (expiry second % kWheelSlots) lists the keys that
+    // may expire in that second. Slots hold (key, expiry) pairs and are not
+    // updated when an entry is replaced or removed; a stale pair is dropped
+    // when its slot is swept. Entries more than one turn ahead stay in their
+    // slot until the turn they expire in.
+    static constexpr size_t kWheelSlots = 256;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        EntryList lru;  // Front = most recently used
+        std::unordered_map<Key, typename EntryList::iterator> index;
+        std::array<std::vector<std::pair<Key, Clock::time_point>>, kWheelSlots> wheel;
+        int64_t sweptSecond = -1;  // Last second whose slot was swept
+        size_t capacity = 0;
+
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t expirations = 0;
+
+        static int64_t secondOf(Clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+        }
+
+        void erase(typename std::unordered_map<Key, typename EntryList::iterator>::iterator it) {
+            lru.erase(it->second);
+            index.erase(it);
+        }
+
+        void schedule(const Key& key, Clock::time_point expiry) {
+            wheel[(size_t)secondOf(expiry) % kWheelSlots].emplace_back(key, expiry);
+        }
+
+        // Sweep the slots of the seconds that ended since the last sweep
+        // (at most one turn of the wheel)
+        void expireUntil(Clock::time_point now) {
+            int64_t current = secondOf(now) - 1;  // Last fully elapsed second
+            if (sweptSecond < 0) sweptSecond = current;
+            int64_t from = std::max(sweptSecond + 1, current - (int64_t)kWheelSlots + 1);
+            for (int64_t s = from; s <= current; ++s) {
+                auto& slot = wheel[(size_t)s % kWheelSlots];
+                size_t kept = 0;
+                for (auto& pending : slot) {
+                    if (pending.second >= now) {
+                        slot[kept++] = std::move(pending);  // A later turn
+                        continue;
+                    }
+                    auto it = index.find(pending.first);
+                    if (it != index.end() && it->second->expiry == pending.second) {
+                        erase(it);
+                        ++expirations;
+                    }
+                }
+                slot.resize(kept);
+            }
+            sweptSecond = std::max(sweptSecond, current);
+        }
+
+        void evictTo(size_t limit) {
+            while (index.size() > limit && !lru.empty()) {
+                index.erase(lru.back().key);
+                lru.pop_back();
+                ++evictions;
+            }
+        }
+    };
+
+    Shard& shardFor(const Key& key) { return shards_[shardIndex(key)]; }
+    const Shard& shardFor(const Key& key) const { return shards_[shardIndex(key)]; }
+
+    size_t shardIndex(const Key& key) const {
+        // Fibonacci hashing spreads weak hashes (e.g. identity for integers)
+        uint64_t h = (uint64_t)std::hash<Key>{}(key) * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h >> 32) & shardMask_;
+    }
+
+    // Even split of the capacity; the first shards take the remainder
+    size_t shardCapacity(size_t shard) const {
+        size_t n = shardMask_ + 1;
+        size_t total = capacity_.load();
+        return total / n + (shard < total % n ? 1 : 0);
     }
+
+    std::atomic<size_t> capacity_;
+    std::atomic<std::chrono::seconds::rep> ttl_;
+    size_t shardMask_ = 0;
+    std::unique_ptr<Shard[]> shards_;
 };
 
 // Specialized string cache for API responses
@@ -234,110 +328,177 @@ public:
 };
 
 // Rate limiter for API calls
+// One token bucket per domain: a domain may burst up to `burst` requests and
+// then gets `ratePerSecond` more each second. Acquiring reports the exact
+// time until the next token instead of making the caller poll. Domains without
+// their own limit use the default one.
 class RateLimiter {
-private:
-    struct DomainState {
-        std::chrono::steady_clock::time_point lastRequest;
-        int requestCount;
-        std::chrono::steady_clock::time_point windowStart;
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limit {
+        double ratePerSecond = 1.0;
+        double burst = 10.0;
     };
 
-    std::map<std::string, DomainState> domainStates_;
-    int maxRequestsPerWindow_;
-    std::chrono::seconds windowDuration_;
-    std::chrono::milliseconds minInterval_;
-    mutable std::mutex mutex_;
+    explicit RateLimiter(Limit defaultLimit) : defaultLimit_(defaultLimit) {}
 
-public:
+    // Window form: maxRequestsPerWindow per windowDuration on average, with
+    // bursts limited to one request per minInterval's worth of a second
     RateLimiter(int maxRequestsPerWindow = 60,
                 std::chrono::seconds windowDuration = std::chrono::seconds(60),
                 std::chrono::milliseconds minInterval = std::chrono::milliseconds(100))
-        : maxRequestsPerWindow_(maxRequestsPerWindow),
-          windowDuration_(windowDuration),
-          minInterval_(minInterval) {}
+        : defaultLimit_{(double)maxRequestsPerWindow / (double)std::max<int64_t>(1, windowDuration.count()),
+                        std::clamp(1000.0 / (double)std::max<int64_t>(1, minInterval.count()), 1.0,
+                                   (double)std::max(1, maxRequestsPerWindow))} {}
 
-    // Check if request is allowed (and record it)
-    bool allowRequest(const std::string& domain) {
+    // Override the limit of one domain (its bucket starts full)
+    void setLimit(const std::string& domain, Limit limit) {
         std::lock_guard<std::mutex> lock(mutex_);
+        limits_[domain] = limit;
+        buckets_.erase(domain);
+    }
 
-        auto now = std::chrono::steady_clock::now();
+    // Take a token if one is available: returns zero when the request may go
+    // now, otherwise how long until a token is available (nothing is taken)
+    Clock::duration tryAcquire(const std::string& domain, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Bucket& bucket = refill(domain, now);
+        if (bucket.tokens >= 1.0) {
+            bucket.tokens -= 1.0;
+            return Clock::duration::zero();
+        }
+        return untilToken(bucket, limitFor(domain));
+    }
 
-        auto& state = domainStates_[domain];
+    // Check if request is allowed (and record it)
+    bool allowRequest(const std::string& domain) {
+        return tryAcquire(domain) == Clock::duration::zero();
+    }
 
-        // Check minimum interval
-        if (state.lastRequest.time_since_epoch().count() > 0) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - state.lastRequest);
-            if (elapsed < minInterval_) {
-                return false;
-            }
+    // Wait until request is allowed (sleeps exactly until the next token;
+    // asynchronous callers use tryAcquire and schedule instead)
+    void waitForAllowance(const std::string& domain) {
+        for (auto wait = tryAcquire(domain); wait > Clock::duration::zero(); wait = tryAcquire(domain)) {
+            std::this_thread::sleep_for(wait);
         }
+    }
 
-        // Reset window if expired
-        if (state.windowStart.time_since_epoch().count() == 0 ||
-            now - state.windowStart > windowDuration_) {
-            state.windowStart = now;
-            state.requestCount = 0;
-        }
+    // Get wait time until next request is allowed (in milliseconds, rounded up)
+    std::chrono::milliseconds getWaitTime(const std::string& domain, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Bucket& bucket = refill(domain, now);
+        if (bucket.tokens >= 1.0) return std::chrono::milliseconds(0);
+        return std::chrono::ceil<std::chrono::milliseconds>(untilToken(bucket, limitFor(domain)));
+    }
 
-        // Check rate limit
-        if (state.requestCount >= maxRequestsPerWindow_) {
-            return false;
-        }
+    // Reset state for a domain
+    void reset(const std::string& domain) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buckets_.erase(domain);
+    }
 
-        // Record request
-        state.lastRequest = now;
-        state.requestCount++;
+    // Reset all
+    void resetAll() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buckets_.clear();
+    }
 
-        return true;
+private:
+    struct Bucket {
+        double tokens;
+        Clock::time_point updated;
+    };
+
+    const Limit& limitFor(const std::string& domain) const {
+        auto it = limits_.find(domain);
+        return it != limits_.end() ? it->second : defaultLimit_;
     }
 
-    // Wait until request is allowed
-    void waitForAllowance(const std::string& domain) {
-        while (!allowRequest(domain)) {
-            std::this_thread::sleep_for(minInterval_);
+    // Bucket of a domain with the tokens earned since its last update
+    Bucket& refill(const std::string& domain, Clock::time_point now) {
+        const Limit& limit = limitFor(domain);
+        auto [it, inserted] = buckets_.try_emplace(domain, Bucket{limit.burst, now});
+        Bucket& bucket = it->second;
+        if (!inserted && now > bucket.updated) {
+            double earned = std::chrono::duration<double>(now - bucket.updated).count() * limit.ratePerSecond;
+            bucket.tokens = std::min(limit.burst, bucket.tokens + earned);
+            bucket.updated = now;
         }
+        return bucket;
     }
 
-    // Get wait time until next request is allowed (in milliseconds)
-    std::chrono::milliseconds getWaitTime(const std::string& domain) const {
-        std::lock_guard<std::mutex> lock(mutex_);
+    static Clock::duration untilToken(const Bucket& bucket, const Limit& limit) {
+        if (limit.ratePerSecond <= 0.0) return Clock::duration::max();
+        auto wait = std::chrono::duration<double>((1.0 - bucket.tokens) / limit.ratePerSecond);
+        return std::max(Clock::duration(1), std::chrono::ceil<Clock::duration>(wait));
+    }
 
-        auto it = domainStates_.find(domain);
-        if (it == domainStates_.end()) {
-            return std::chrono::milliseconds(0);
-        }
+    Limit defaultLimit_;
+    std::map<std::string, Limit> limits_;
+    std::map<std::string, Bucket> buckets_;
+    mutable std::mutex mutex_;
+};
 
-        auto now = std::chrono::steady_clock::now();
-        const auto& state = it->second;
+// Single-flight call deduplication
+// The first caller for a key runs the call; callers arriving for the same key
+// while it runs wait on its shared future instead of repeating it. The key is
+// released as soon as the call finishes, so later callers run again (results
+// are meant to be cached by the call itself).
+template<typename Key, typename Value>
+class SingleFlight {
+public:
+    struct Stats {
+        uint64_t calls = 0;      // Calls that ran
+        uint64_t coalesced = 0;  // Callers served by another caller's call
+    };
 
-        // Check if we need to wait for window reset
-        if (state.requestCount >= maxRequestsPerWindow_) {
-            auto windowEnd = state.windowStart + windowDuration_;
-            if (windowEnd > now) {
-                return std::chrono::duration_cast<std::chrono::milliseconds>(windowEnd - now);
-            }
+    template<typename F>
+    Value run(const Key& key, F&& call) {
+        std::promise<Value> promise;
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(key);
+        if (it != inFlight_.end()) {
+            ++stats_.coalesced;
+            std::shared_future<Value> pending = it->second;
+            lock.unlock();
+            return pending.get();
         }
-
-        // Check minimum interval
-        auto timeSinceLast = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - state.lastRequest);
-        if (timeSinceLast < minInterval_) {
-            return minInterval_ - timeSinceLast;
+        inFlight_.emplace(key, promise.get_future().share());
+        ++stats_.calls;
+        lock.unlock();
+
+        std::optional<Value> value;
+        std::exception_ptr error;
+        try {
+            value.emplace(call());
+        } catch (...) {
+            error = std::current_exception();
         }
 
-        return std::chrono::milliseconds(0);
+        lock.lock();
+        inFlight_.erase(key);
+        lock.unlock();
+        if (error) {
+            promise.set_exception(error);
+            std::rethrow_exception(error);
+        }
+        promise.set_value(*value);
+        return std::move(*value);
     }
 
-    // Reset state for a domain
-    void reset(const std::string& domain) {
+    Stats stats() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        domainStates_.erase(domain);
+        return stats_;
     }
 
-    // Reset all
-    void resetAll() {
+    void resetStats() {
         std::lock_guard<std::mutex> lock(mutex_);
-        domainStates_.clear();
+        stats_ = Stats{};
     }
+
+private:
+    std::map<Key, std::shared_future<Value>> inFlight_;
+    Stats stats_;
+    mutable std::mutex mutex_;
 };
@@ -0,0 +1,330 @@
+#include "CrossSectionEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include "RollingKernels.h"
+
+// SSE2 is part of the x86-64 baseline, so the vector kernel needs no special
+// flags; RollingKernels::setSimdLevel(Scalar) selects the portable one.
+#if defined(__x86_64__) || defined(_M_X64)
+#define CROSS_SECTION_X86 1
+#include <immintrin.h>
+#endif
+
+std::vector<double> PanelMatrix::row(size_t bar) const {
+    std::vector<double> out(symbols_);
+    for (size_t j = 0; j < symbols_; ++j) out[j] = at(bar, j);
+    return out;
+}
+
+std::vector<double> PanelMatrix::column(size_t symbol) const {
+    std::vector<double> out(bars_);
+    for (size_t t = 0; t < bars_; ++t) out[t] = at(t, symbol);
+    return out;
+}
+
+CrossSectionPanel CrossSectionPanel::fromSeries(const std::vector<std::pair<std::string, BarColumnsView>>& series,
+                                                size_t bars) {
+    CrossSectionPanel panel;
+    std::vector<const BarColumnsView*> included;
+    for (const auto& [symbol, view] : series) {
+        if (bars == 0 || view.size() < bars) continue;
+        panel.symbols.push_back(symbol);
+        included.push_back(&view);
+    }
+
+    size_t symbols = included.size();
+    panel.high = PanelMatrix(bars, symbols);
+    panel.low = PanelMatrix(bars, symbols);
+    panel.close = PanelMatrix(bars, symbols);
+    for (size_t j = 0; j < symbols; ++j) {
+        const BarColumnsView& view = *included[j];
+        size_t offset = view.size() - bars;
+        for (size_t t = 0; t < bars; ++t) {
+            panel.high.at(t, j) = view.high[offset + t];
+            panel.low.at(t, j) = view.low[offset + t];
+            panel.close.at(t, j) = view.close[offset + t];
+        }
+    }
+    return panel;
+}
+
+CrossSectionIndicators CrossSectionEngine::compute(const CrossSectionPanel& panel) const {
+    CrossSectionIndicators out;
+    compute(panel, out);
+    return out;
+}
+
+void CrossSectionEngine::compute(const CrossSectionPanel& panel, CrossSectionIndicators& out) const {
+    size_t bars = panel.bars();
+    size_t symbols = panel.size();
+
+    for (PanelMatrix* m : {&out.rsi, &out.atr, &out.bollingerUpper, &out.bollingerMiddle, &out.bollingerLower,
+                           &out.bollingerBandwidth, &out.adx, &out.plusDI, &out.minusDI}) {
+        m->assign(bars, symbols);
+    }
+    if (bars == 0 || symbols == 0) return;
+
+    // Tasks take whole tiles and write disjoint tiles of the outputs
+    size_t tiles = panel.close.tiles();
+    size_t block = std::max<size_t>(1, config_.symbolsPerTask / PanelMatrix::kLaneWidth);
+    auto runBlock = [this, &panel, &out, tiles](size_t begin, size_t end) {
+        for (size_t tile = begin; tile < std::min(end, tiles); ++tile) computeTile(panel, tile, out);
+    };
+
+    if (!pool_ || tiles <= block) {
+        runBlock(0, tiles);
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    for (size_t begin = 0; begin < tiles; begin += block) {
+        tasks.push_back(pool_->submit(runBlock, begin, begin + block));
+    }
+    for (auto& task : tasks) task.get();
+}
+
+namespace {
+
+constexpr size_t kLanes = PanelMatrix::kLaneWidth;
+
+// Lane operations for the tile kernel. Each one is the scalar expression it
+// replaces (comparisons give masks, ?: becomes select), so every lane runs
+// the arithmetic of TechnicalAnalysis.cpp exactly, as in RollingKernels.
+struct ScalarLanes {
+    using V = double;
+    using M = bool;
+    static constexpr size_t kWidth = 1;
+
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V set(double x) { return x; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V abs(V a) { return std::abs(a); }
+    static V max(V a, V b) { return std::max(a, b); }
+    static M gt(V a, V b) { return a > b; }
+    static M eq(V a, V b) { return a == b; }
+    static M both(M a, M b) { return a && b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if defined(CROSS_SECTION_X86)
+struct SSE2Lanes {
+    using V = __m128d;
+    using M = __m128d;
+    static constexpr size_t kWidth = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V set(double x) { return _mm_set1_pd(x); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    // std::max(a, b) is a < b ? b : a; max_pd(b, a) is b > a ? b : a
+    static V max(V a, V b) { return _mm_max_pd(b, a); }
+    static M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static M eq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static M both(M a, M b) { return _mm_and_pd(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+#endif
+
+// One pass over the bars for the kLanes symbols of a tile, kLanes / kWidth
+// vectors at a time. Branches depend only on the bar index, which is the
+// same for every symbol of a panel. Padding lanes compute on zeros and are
+// never read.
+template <typename L>
+void computeTileLanes(const CrossSectionConfig& config, const CrossSectionPanel& panel, size_t tile,
+                      CrossSectionIndicators& out) {
+    using V = typename L::V;
+    using M = typename L::M;
+    constexpr size_t kVectors = kLanes / L::kWidth;
+
+    const size_t n = panel.bars();
+    const size_t rsiPeriod = config.rsiPeriod;
+    const size_t atrPeriod = config.atrPeriod;
+    const size_t bbPeriod = config.bollingerPeriod;
+    const size_t adxPeriod = config.adxPeriod;
+
+    const V zero = L::set(0.0);
+    const V hundred = L::set(100.0);
+    const V multiplier = L::set(config.bollingerMultiplier);
+    const V rsiN = L::set((double)rsiPeriod), rsiN1 = L::set((double)(rsiPeriod - 1));
+    const V atrN = L::set((double)atrPeriod), atrN1 = L::set((double)(atrPeriod - 1));
+    const V bbN = L::set((double)bbPeriod);
+    const V adxN = L::set((double)adxPeriod), adxN1 = L::set((double)(adxPeriod - 1));
+
+    V avgUp[kVectors], avgDown[kVectors], atr[kVectors];
+    V smoothTR[kVectors], smoothPlusDM[kVectors], smoothMinusDM[kVectors];
+    V pDI[kVectors], mDI[kVectors], adxSum[kVectors], adx[kVectors];
+    for (size_t k = 0; k < kVectors; ++k) {
+        avgUp[k] = avgDown[k] = atr[k] = zero;
+        smoothTR[k] = smoothPlusDM[k] = smoothMinusDM[k] = zero;
+        pDI[k] = mDI[k] = adxSum[k] = adx[k] = zero;
+    }
+    size_t dxCount = 0;
+
+    for (size_t t = 0; t < n; ++t) {
+        for (size_t k = 0; k < kVectors; ++k) {
+            const size_t lane = k * L::kWidth;
+            auto in = [&](const PanelMatrix& m, size_t bar) { return L::load(m.lanes(tile, bar) + lane); };
+            auto put = [&](PanelMatrix& m, V v) { L::store(m.lanes(tile, t) + lane, v); };
+
+            V high = in(panel.high, t), low = in(panel.low, t), close = in(panel.close, t);
+
+            // True range and directional movement
+            V tr = L::sub(high, low), plusDM = zero, minusDM = zero, diff = zero;
+            if (t > 0) {
+                V prevHigh = in(panel.high, t - 1), prevLow = in(panel.low, t - 1);
+                V prevClose = in(panel.close, t - 1);
+                V highDiff = L::sub(high, prevHigh);
+                V lowDiff = L::sub(prevLow, low);
+                plusDM = L::select(L::both(L::gt(highDiff, lowDiff), L::gt(highDiff, zero)), highDiff, zero);
+                minusDM = L::select(L::both(L::gt(lowDiff, highDiff), L::gt(lowDiff, zero)), lowDiff, zero);
+
+                V hpc = L::abs(L::sub(high, prevClose));
+                V lpc = L::abs(L::sub(low, prevClose));
+                tr = L::max(L::max(tr, hpc), lpc);
+                diff = L::sub(close, prevClose);
+            }
+
+            // --- RSI (as computeRSISeries): 50 until period + 1 bars ---
+            if (n > rsiPeriod && t > 0) {
+                M rising = L::gt(diff, zero);
+                if (t <= rsiPeriod) {
+                    avgUp[k] = L::add(avgUp[k], L::select(rising, diff, zero));
+                    avgDown[k] = L::sub(avgDown[k], L::select(rising, zero, diff));
+                    if (t == rsiPeriod) {
+                        avgUp[k] = L::div(avgUp[k], rsiN);
+                        avgDown[k] = L::div(avgDown[k], rsiN);
+                    }
+                } else {
+                    V up = L::select(rising, diff, zero);
+                    V down = L::select(L::gt(zero, diff), L::sub(zero, diff), zero);
+                    avgUp[k] = L::div(L::add(L::mul(avgUp[k], rsiN1), up), rsiN);
+                    avgDown[k] = L::div(L::add(L::mul(avgDown[k], rsiN1), down), rsiN);
+                }
+            }
+            if (n <= rsiPeriod || t < rsiPeriod) {
+                put(out.rsi, L::set(50.0));
+            } else {
+                V rs = L::div(avgUp[k], avgDown[k]);
+                V rsi = L::sub(hundred, L::div(hundred, L::add(L::set(1.0), rs)));
+                put(out.rsi, L::select(L::eq(avgDown[k], zero), hundred, rsi));
+            }
+
+            // --- ATR (as computeATRSeries): 0 until period + 1 bars ---
+            if (n > atrPeriod) {
+                if (t < atrPeriod) {
+                    atr[k] = L::add(atr[k], tr);
+                    if (t + 1 == atrPeriod) atr[k] = L::div(atr[k], atrN);
+                } else {
+                    atr[k] = L::div(L::add(L::mul(atr[k], atrN1), tr), atrN);
+                    put(out.atr, atr[k]);
+                }
+            }
+
+            // --- Bollinger Bands (as computeBollingerBandsSeries): 0 until period bars ---
+            if (bbPeriod > 0 && t + 1 >= bbPeriod) {
+                // Two passes over the window, oldest bar first
+                V sum = zero;
+                for (size_t bar = t + 1 - bbPeriod; bar <= t; ++bar) sum = L::add(sum, in(panel.close, bar));
+                V middle = L::div(sum, bbN);
+                V varSum = zero;
+                for (size_t bar = t + 1 - bbPeriod; bar <= t; ++bar) {
+                    V d = L::sub(in(panel.close, bar), middle);
+                    varSum = L::add(varSum, L::mul(d, d));
+                }
+                V width = L::mul(multiplier, L::sqrt(L::div(varSum, bbN)));
+                V upper = L::add(middle, width);
+                V lower = L::sub(middle, width);
+                V bandwidth = L::div(L::sub(upper, lower), middle);
+                put(out.bollingerUpper, upper);
+                put(out.bollingerMiddle, middle);
+                put(out.bollingerLower, lower);
+                put(out.bollingerBandwidth, L::select(L::gt(middle, zero), bandwidth, zero));
+            }
+
+            // --- ADX with +DI/-DI (as computeADXSeries): zeros until 2 * period bars ---
+            if (t > 0 && t <= adxPeriod) {
+                smoothTR[k] = L::add(smoothTR[k], tr);
+                smoothPlusDM[k] = L::add(smoothPlusDM[k], plusDM);
+                smoothMinusDM[k] = L::add(smoothMinusDM[k], minusDM);
+            } else if (t > adxPeriod) {
+                smoothTR[k] = L::add(L::sub(smoothTR[k], L::div(smoothTR[k], adxN)), tr);
+                smoothPlusDM[k] = L::add(L::sub(smoothPlusDM[k], L::div(smoothPlusDM[k], adxN)), plusDM);
+                smoothMinusDM[k] = L::add(L::sub(smoothMinusDM[k], L::div(smoothMinusDM[k], adxN)), minusDM);
+
+                M flat = L::eq(smoothTR[k], zero);
+                pDI[k] = L::select(flat, zero, L::div(L::mul(hundred, smoothPlusDM[k]), smoothTR[k]));
+                mDI[k] = L::select(flat, zero, L::div(L::mul(hundred, smoothMinusDM[k]), smoothTR[k]));
+
+                V diSum = L::add(pDI[k], mDI[k]);
+                V dx = L::div(L::mul(hundred, L::abs(L::sub(pDI[k], mDI[k]))), diSum);
+                dx = L::select(L::eq(diSum, zero), zero, dx);
+
+                if (dxCount < adxPeriod) {
+                    adxSum[k] = L::add(adxSum[k], dx);
+                    if (dxCount == adxPeriod - 1) adx[k] = L::div(adxSum[k], adxN);
+                } else {
+                    adx[k] = L::div(L::add(L::mul(adx[k], adxN1), dx), adxN);
+                }
+            }
+            if (t + 1 >= adxPeriod * 2) {
+                bool adxReady = dxCount + (t > adxPeriod ? 1 : 0) >= adxPeriod;
+                if (adxReady) put(out.adx, adx[k]);
+                put(out.plusDI, pDI[k]);
+                put(out.minusDI, mDI[k]);
+            }
+        }
+        if (t > adxPeriod) ++dxCount;
+    }
+}
+
+}  // namespace
+
+void CrossSectionEngine::computeTile(const CrossSectionPanel& panel, size_t tile,
+                                     CrossSectionIndicators& out) const {
+#if defined(CROSS_SECTION_X86)
+    if (RollingKernels::activeSimdLevel() != RollingKernels::SimdLevel::Scalar) {
+        computeTileLanes<SSE2Lanes>(config_, panel, tile, out);
+        return;
+    }
+#endif
+    computeTileLanes<ScalarLanes>(config_, panel, tile, out);
+}
+
+namespace CrossSection {
+
+std::vector<double> meanRange(const CrossSectionPanel& panel, int window) {
+    size_t symbols = panel.size();
+    std::vector<double> range(symbols, 0.0);
+    size_t bars = std::min(panel.bars(), (size_t)std::max(0, window));
+    if (bars == 0) return range;
+
+    for (size_t j = 0; j < symbols; ++j) {
+        for (size_t t = panel.bars() - bars; t < panel.bars(); ++t) range[j] += panel.high.at(t, j) - panel.low.at(t, j);
+    }
+    for (double& r : range) r /= (double)bars;
+    return range;
+}
+
+std::vector<size_t> topK(std::span<const double> values, size_t k) {
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    k = std::min(k, order.size());
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](size_t a, size_t b) {
+        return values[a] > values[b] || (values[a] == values[b] && a < b);
+    });
+    order.resize(k);
+    return order;
+}
+
+}  // namespace CrossSection
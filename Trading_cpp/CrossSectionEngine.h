@@ -0,0 +1,141 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BarColumns.h"
+#include "ThreadPool.h"
+
+// Cross-sectional indicator engine for whole-universe scans.
+//
+// Instead of computing RSI / ATR / Bollinger / ADX symbol by symbol, the
+// engine takes a bars x symbols panel of highs, lows and closes and advances
+// a tile of PanelMatrix::kLaneWidth symbols through all four indicators in
+// one pass over the bars. Each step reads one cache line per input and runs
+// the tile's lanes as SSE2 vectors (the scalar fallback follows
+// RollingKernels::activeSimdLevel()). Blocks of tiles run as ThreadPool tasks.
+//
+// Every symbol in a panel covers the same bars, so all symbols are in the
+// same warmup phase at each bar, and each one goes through exactly the
+// arithmetic of the ...Series functions in TechnicalAnalysis.h: column j of
+// every output equals the series function over symbol j's bars.
+
+// bars x symbols matrix of doubles, stored as tiles of kLaneWidth symbols:
+// tile g holds symbols [g * kLaneWidth, (g + 1) * kLaneWidth) bar by bar, so
+// one bar of a tile is kLaneWidth adjacent doubles and a tile's whole history
+// is contiguous. The last tile is padded; padding is never exposed.
+class PanelMatrix {
+public:
+    static constexpr size_t kLaneWidth = 8;
+
+    PanelMatrix() = default;
+    PanelMatrix(size_t bars, size_t symbols, double fill = 0.0) { assign(bars, symbols, fill); }
+
+    // Reshape and fill, keeping the allocation when it is large enough
+    void assign(size_t bars, size_t symbols, double fill = 0.0) {
+        bars_ = bars;
+        symbols_ = symbols;
+        data_.assign(tiles() * bars * kLaneWidth, fill);
+    }
+
+    size_t bars() const { return bars_; }
+    size_t symbols() const { return symbols_; }
+    size_t tiles() const { return (symbols_ + kLaneWidth - 1) / kLaneWidth; }
+
+    double& at(size_t bar, size_t symbol) { return data_[index(bar, symbol)]; }
+    double at(size_t bar, size_t symbol) const { return data_[index(bar, symbol)]; }
+
+    // All symbols at one bar (a cross-section)
+    std::vector<double> row(size_t bar) const;
+
+    // All symbols at the newest bar
+    std::vector<double> lastRow() const { return row(bars_ - 1); }
+
+    // One symbol's series
+    std::vector<double> column(size_t symbol) const;
+
+    // The kLaneWidth values of one tile at one bar
+    double* lanes(size_t tile, size_t bar) { return data_.data() + (tile * bars_ + bar) * kLaneWidth; }
+    const double* lanes(size_t tile, size_t bar) const { return data_.data() + (tile * bars_ + bar) * kLaneWidth; }
+
+private:
+    size_t index(size_t bar, size_t symbol) const {
+        return ((symbol / kLaneWidth) * bars_ + bar) * kLaneWidth + symbol % kLaneWidth;
+    }
+
+    size_t bars_ = 0;
+    size_t symbols_ = 0;
+    std::vector<double> data_;
+};
+
+// Aligned price history for a universe: the last bars() bars of each symbol
+struct CrossSectionPanel {
+    std::vector<std::string> symbols;
+    PanelMatrix high;
+    PanelMatrix low;
+    PanelMatrix close;
+
+    size_t bars() const { return close.bars(); }
+    size_t size() const { return symbols.size(); }
+
+    // Last `bars` bars of every series with at least that many; shorter
+    // series are left out (symbols keeps the order of the included ones)
+    static CrossSectionPanel fromSeries(const std::vector<std::pair<std::string, BarColumnsView>>& series,
+                                        size_t bars);
+};
+
+struct CrossSectionConfig {
+    int rsiPeriod = 14;
+    int atrPeriod = 14;
+    int bollingerPeriod = 20;
+    double bollingerMultiplier = 2.0;
+    int adxPeriod = 14;
+    size_t symbolsPerTask = 256;  // Symbols per ThreadPool task
+};
+
+// Indicator values for every (bar, symbol) of a panel
+struct CrossSectionIndicators {
+    PanelMatrix rsi;
+    PanelMatrix atr;
+    PanelMatrix bollingerUpper;
+    PanelMatrix bollingerMiddle;
+    PanelMatrix bollingerLower;
+    PanelMatrix bollingerBandwidth;
+    PanelMatrix adx;
+    PanelMatrix plusDI;
+    PanelMatrix minusDI;
+};
+
+class CrossSectionEngine {
+public:
+    // Periods must be positive. Without a pool the blocks run on the calling
+    // thread.
+    explicit CrossSectionEngine(CrossSectionConfig config = {}, ThreadPool* pool = nullptr)
+        : config_(config), pool_(pool) {}
+
+    CrossSectionIndicators compute(const CrossSectionPanel& panel) const;
+
+    // Same, reusing the matrices of a previous result (repeated scans over
+    // panels of the same shape allocate nothing)
+    void compute(const CrossSectionPanel& panel, CrossSectionIndicators& out) const;
+
+    const CrossSectionConfig& config() const { return config_; }
+
+private:
+    void computeTile(const CrossSectionPanel& panel, size_t tile, CrossSectionIndicators& out) const;
+
+    CrossSectionConfig config_;
+    ThreadPool* pool_ = nullptr;
+};
+
+// Column operations for scan ranking
+namespace CrossSection {
+
+// Mean high - low over the last `window` bars, per symbol (oldest first)
+std::vector<double> meanRange(const CrossSectionPanel& panel, int window);
+
+// Indices of the k largest values, largest first; ties keep index order
+std::vector<size_t> topK(std::span<const double> values, size_t k);
+
+}  // namespace CrossSection
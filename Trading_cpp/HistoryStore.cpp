@@ -0,0 +1,72 @@
+#include "HistoryStore.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// Prices printed and parsed again may differ in the last digits
+bool samePrice(double a, double b) {
+    return std::abs(a - b) <= 1e-6 * std::max(std::abs(a), std::abs(b));
+}
+
+void archive(const std::string& symbol, int64_t intervalSeconds, const BarColumns& bars,
+             const std::string& directory) {
+    if (bars.empty()) return;
+    auto written = BarArchive::write(BarArchive::pathFor(symbol, intervalSeconds, directory), bars, symbol,
+                                     intervalSeconds);
+    if (written.isError()) {
+        std::cerr << "[BarArchive] " << written.error().toString() << std::endl;
+    }
+}
+
+} // namespace
+
+namespace HistoryStore {
+
+Plan plan(const std::string& symbol, int64_t intervalSeconds, TimePoint coverFrom, const std::string& directory) {
+    Plan plan;
+    auto archived = MappedBarFile::open(BarArchive::pathFor(symbol, intervalSeconds, directory));
+    if (archived.isError() || archived.value().intervalSeconds() != intervalSeconds) return plan;
+
+    // Two bars at least: the anchor and the (possibly forming) newest one
+    BarColumnsView bars = archived.value().view();
+    if (bars.size() < 2 || bars.ts.front() > coverFrom + std::chrono::seconds(kCoverageSlackSeconds)) {
+        return plan;
+    }
+
+    plan.stored = archived.value().toColumns();
+    plan.anchor = bars.ts[bars.size() - 2];
+    // Half a bar early, so the anchor is in the delta however the provider
+    // treats the start of the range
+    plan.fetchFrom = plan.anchor - std::chrono::seconds(intervalSeconds / 2);
+    return plan;
+}
+
+std::optional<BarColumns> merge(const std::string& symbol, int64_t intervalSeconds, Plan plan,
+                                BarColumnsView delta, TimePoint keepFrom, const std::string& directory) {
+    BarColumns& bars = plan.stored;
+    if (!plan.isDelta() || bars.size() < 2) return std::nullopt;
+
+    auto anchor = std::lower_bound(delta.ts.begin(), delta.ts.end(), plan.anchor);
+    if (anchor == delta.ts.end() || *anchor != plan.anchor) return std::nullopt;
+    size_t at = static_cast<size_t>(anchor - delta.ts.begin());
+    if (!samePrice(delta.close[at], bars.closes()[bars.size() - 2])) return std::nullopt;
+
+    // The newest stored bar may have been incomplete: the delta's version
+    // (or its absence) wins
+    bars.pop_back();
+    bars.appendNewer(delta);
+    bars.trimBefore(keepFrom);
+    archive(symbol, intervalSeconds, bars, directory);
+    return std::move(bars);
+}
+
+BarColumns replace(const std::string& symbol, int64_t intervalSeconds, BarColumns bars, TimePoint keepFrom,
+                   const std::string& directory) {
+    bars.trimBefore(keepFrom);
+    archive(symbol, intervalSeconds, bars, directory);
+    return bars;
+}
+
+} // namespace HistoryStore
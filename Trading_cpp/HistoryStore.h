@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <optional>
+#include "BarArchive.h"
+#include "BarColumns.h"
+
+// Local per-symbol bar history, refreshed by delta.
+//
+// The bar archive (BarArchive.h) keeps what was already fetched, so a
+// refresh only asks the provider for the bars from the last complete stored
+// bar on and merges them in with BarSeries::tryAppend semantics. The newest
+// stored bar is always fetched again, since it may have been stored while it
+// was still forming; the bar before it (the anchor) must come back unchanged,
+// otherwise the provider has revised its history (e.g. after a split) and
+// everything is fetched again.
+//
+// A refresh is: plan(), fetch the bars from plan.fetchFrom to now (or the
+// full history when there is no fetchFrom), then merge() or replace().
+// Callers that share a symbol's archive must build its bars the same way
+// (for Yahoo: YahooChart::kArchivedNullPrices and an uppercase symbol).
+namespace HistoryStore {
+    // A stored history only counts as reaching back to coverFrom if its first
+    // bar is at most this much later (weekends, holidays, listing gaps)
+    constexpr int64_t kCoverageSlackSeconds = 7 * 86400;
+
+    struct Plan {
+        BarColumns stored;                  // History to extend (empty: none usable)
+        std::optional<TimePoint> fetchFrom; // Request bars from here on; nullopt: full history
+        TimePoint anchor{};                 // Last complete stored bar, expected again in the delta
+
+        bool isDelta() const { return fetchFrom.has_value(); }
+    };
+
+    // What to request so the history of symbol/interval covers coverFrom..now
+    Plan plan(const std::string& symbol, int64_t intervalSeconds, TimePoint coverFrom,
+              const std::string& directory = ".cache/bars");
+
+    // Merge delta (sorted bars from plan.fetchFrom on) into the planned
+    // history, drop the bars before keepFrom and archive the result.
+    // nullopt when the delta does not reproduce the anchor bar: fetch the
+    // full history and replace() instead.
+    std::optional<BarColumns> merge(const std::string& symbol, int64_t intervalSeconds, Plan plan,
+                                    BarColumnsView delta, TimePoint keepFrom,
+                                    const std::string& directory = ".cache/bars");
+
+    // Archive a full history (from keepFrom on)
+    BarColumns replace(const std::string& symbol, int64_t intervalSeconds, BarColumns bars,
+                       TimePoint keepFrom, const std::string& directory = ".cache/bars");
+}
@@ -0,0 +1,321 @@
+#include "HttpEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "RequestScheduler.h"
+
+#ifdef ENABLE_CURL
+#include <curl/curl.h>
+#endif
+
+#ifdef ENABLE_CURL
+
+namespace {
+
+// One request in flight: owns everything curl points into
+struct Transfer {
+    HttpRequest request;
+    HttpEngine::Callback done;
+    std::string body;
+    curl_slist* headers = nullptr;
+    int attempt = 0;
+};
+
+size_t appendBody(char* data, size_t size, size_t nmemb, void* userp) {
+    static_cast<std::string*>(userp)->append(data, size * nmemb);
+    return size * nmemb;
+}
+
+Result<std::string> toResult(CURLcode code, long httpCode, std::string body, const std::string& url) {
+    if (code != CURLE_OK) {
+        if (code == CURLE_OPERATION_TIMEDOUT) {
+            return Result<std::string>::err(Error::timeout(url));
+        }
+        return Result<std::string>::err(Error::network(curl_easy_strerror(code)));
+    }
+
+    if (httpCode == 429) {
+        return Result<std::string>::err(Error::rateLimit("HTTP 429 received"));
+    }
+
+    if (httpCode == 401 || httpCode == 403) {
+        return Result<std::string>::err(Error::auth("HTTP " + std::to_string(httpCode)));
+    }
+
+    if (httpCode >= 400) {
+        return Result<std::string>::err(Error::network("HTTP " + std::to_string(httpCode)));
+    }
+
+    return Result<std::string>::ok(std::move(body));
+}
+
+// Poll timeout until the scheduler's next release (at most 1 s)
+int pollTimeoutMs(std::chrono::steady_clock::duration wait) {
+    if (wait >= std::chrono::seconds(1)) return 1000;
+    return (int)std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+}
+
+}  // namespace
+
+struct HttpEngine::Impl {
+    explicit Impl(HttpEngineConfig cfg) : config(std::move(cfg)), limiter(config.rateLimit), scheduler(limiter) {
+        static std::once_flag globalInit;
+        std::call_once(globalInit, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+        multi = curl_multi_init();
+        curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, config.maxConnections);
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, config.maxHostConnections);
+        curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, config.maxConnections);
+
+        // Only the I/O thread touches the share handle, so it needs no locks
+        share = curl_share_init();
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+        io = std::thread([this] { run(); });
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        curl_multi_wakeup(multi);
+        io.join();
+
+        for (CURL* easy : idle) curl_easy_cleanup(easy);
+        curl_multi_cleanup(multi);
+        curl_share_cleanup(share);
+    }
+
+    void submit(HttpRequest request, Callback done) {
+        auto* transfer = new Transfer{std::move(request), std::move(done), {}, nullptr, 0};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            incoming.push_back(transfer);
+        }
+        ++submitted;
+        curl_multi_wakeup(multi);
+    }
+
+    // I/O thread: queue submitted transfers in the scheduler, drive the
+    // multi handle, complete finished ones and start those the scheduler
+    // releases; poll() sleeps until socket activity, a wakeup or the next
+    // release. After stop, what is in flight is drained and the queue fails.
+    void run() {
+        std::vector<Transfer*> submitted;
+        std::vector<Transfer*> ready;
+        int running = 0;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                submitted.swap(incoming);
+                stopping = stop;
+            }
+            for (Transfer* transfer : submitted) scheduler.push(transfer->request.rateDomain, transfer);
+            submitted.clear();
+
+            curl_multi_perform(multi, &running);
+
+            int queued = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+                if (msg->msg == CURLMSG_DONE) finish(msg->easy_handle, msg->data.result);
+            }
+
+            if (stopping) {
+                scheduler.drain(ready);
+                for (Transfer* transfer : ready) {
+                    complete(transfer, Result<std::string>::err(Error::internal("HttpEngine stopped")));
+                }
+                ready.clear();
+                if (running == 0) break;
+                curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+                continue;
+            }
+
+            auto wait = scheduler.release(std::chrono::steady_clock::now(), ready);
+            for (Transfer* transfer : ready) start(transfer);
+            ready.clear();
+            curl_multi_poll(multi, nullptr, 0, pollTimeoutMs(wait), nullptr);
+        }
+    }
+
+    void start(Transfer* transfer) {
+        CURL* easy = nullptr;
+        if (!idle.empty()) {
+            easy = idle.back();
+            idle.pop_back();
+        } else {
+            easy = curl_easy_init();
+        }
+        if (!easy) {
+            complete(transfer, Result<std::string>::err(Error::internal("Failed to initialize CURL")));
+            return;
+        }
+
+        for (const auto& h : transfer->request.headers) {
+            transfer->headers = curl_slist_append(transfer->headers, h.c_str());
+        }
+        if (transfer->headers) {
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+        }
+
+        curl_easy_setopt(easy, CURLOPT_URL, transfer->request.url.c_str());
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, appendBody);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->body);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer);
+        curl_easy_setopt(easy, CURLOPT_SHARE, share);
+        curl_easy_setopt(easy, CURLOPT_USERAGENT, config.userAgent.c_str());
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT, config.timeoutSeconds);
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT, config.connectTimeoutSeconds);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, config.verifyPeer ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        // Over TLS, wait for a connection that may turn out to multiplex
+        // (HTTP/2) rather than opening another; plain http never does
+        if (transfer->request.url.rfind("https://", 0) == 0) {
+            curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+        }
+        if (config.compressed) {
+            curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");  // Every encoding curl can decode
+        }
+
+        if (transfer->request.post) {
+            curl_easy_setopt(easy, CURLOPT_POST, 1L);
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->request.payload.c_str());
+        }
+
+        curl_multi_add_handle(multi, easy);
+    }
+
+    void finish(CURL* easy, CURLcode code) {
+        Transfer* transfer = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &transfer);
+
+        long httpCode = 0;
+        long connects = 0;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &httpCode);
+        curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects);
+        connectionsOpened += (uint64_t)connects;
+
+        curl_multi_remove_handle(multi, easy);
+        curl_easy_reset(easy);
+        if ((long)idle.size() < config.maxConnections) {
+            idle.push_back(easy);
+        } else {
+            curl_easy_cleanup(easy);
+        }
+
+        auto result = toResult(code, httpCode, std::move(transfer->body), transfer->request.url);
+        if (result.isError() && result.error().code != Error::AuthError &&
+            transfer->attempt + 1 < transfer->request.maxAttempts && !stopping) {
+            // Back off without holding a thread: the scheduler releases the
+            // retry when its time comes (and the rate limit allows)
+            auto backoff = config.retryBackoff * (1 << std::min(transfer->attempt, 16));
+            ++transfer->attempt;
+            ++retries;
+            transfer->body.clear();
+            if (transfer->headers) curl_slist_free_all(transfer->headers);
+            transfer->headers = nullptr;
+            scheduler.push(transfer->request.rateDomain, transfer, std::chrono::steady_clock::now() + backoff);
+            return;
+        }
+        complete(transfer, std::move(result));
+    }
+
+    void complete(Transfer* transfer, Result<std::string> result) {
+        if (transfer->headers) curl_slist_free_all(transfer->headers);
+        ++completed;
+        try {
+            transfer->done(std::move(result));
+        } catch (...) {
+            // A throwing callback must not take the I/O thread down
+        }
+        delete transfer;
+    }
+
+    HttpEngineConfig config;
+    RateLimiter limiter;
+    RequestScheduler<Transfer*> scheduler;  // I/O thread only
+    bool stopping = false;                  // I/O thread's copy of stop
+    CURLM* multi = nullptr;
+    CURLSH* share = nullptr;
+    std::vector<CURL*> idle;  // Reset easy handles, I/O thread only
+
+    std::mutex mutex;
+    std::vector<Transfer*> incoming;
+    bool stop = false;
+    std::thread io;
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> connectionsOpened{0};
+    std::atomic<uint64_t> retries{0};
+};
+
+#else
+
+// Stub for when CURL is not enabled
+struct HttpEngine::Impl {
+    explicit Impl(HttpEngineConfig cfg) : limiter(cfg.rateLimit) {}
+
+    void submit(HttpRequest, Callback done) {
+        ++submitted;
+        ++completed;
+        done(Result<std::string>::err(Error::internal("CURL not enabled")));
+    }
+
+    RateLimiter limiter;
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> connectionsOpened{0};
+    std::atomic<uint64_t> retries{0};
+};
+
+#endif
+
+HttpEngine::HttpEngine(HttpEngineConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+HttpEngine::~HttpEngine() = default;
+
+void HttpEngine::submit(HttpRequest request, Callback done) {
+    impl_->submit(std::move(request), std::move(done));
+}
+
+std::future<Result<std::string>> HttpEngine::fetch(HttpRequest request) {
+    auto promise = std::make_shared<std::promise<Result<std::string>>>();
+    auto future = promise->get_future();
+    submit(std::move(request), [promise](Result<std::string> result) { promise->set_value(std::move(result)); });
+    return future;
+}
+
+std::vector<Result<std::string>> HttpEngine::fetchAll(std::vector<HttpRequest> requests) {
+    std::vector<std::future<Result<std::string>>> pending;
+    pending.reserve(requests.size());
+    for (auto& request : requests) pending.push_back(fetch(std::move(request)));
+
+    std::vector<Result<std::string>> results;
+    results.reserve(pending.size());
+    for (auto& f : pending) results.push_back(f.get());
+    return results;
+}
+
+void HttpEngine::setRateLimit(const std::string& domain, RateLimiter::Limit limit) {
+    impl_->limiter.setLimit(domain, limit);
+}
+
+HttpEngineStats HttpEngine::stats() const {
+    HttpEngineStats s;
+    s.submitted = impl_->submitted.load();
+    s.completed = impl_->completed.load();
+    s.connectionsOpened = impl_->connectionsOpened.load();
+    s.retries = impl_->retries.load();
+    return s;
+}
+
+HttpEngine& HttpEngine::shared() {
+    static HttpEngine engine;
+    return engine;
+}
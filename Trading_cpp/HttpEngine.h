@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Cache.h"
+#include "Result.h"
+
+// Concurrent HTTP engine on the curl multi interface.
+//
+// One I/O thread drives every transfer through a single multi handle, so
+// any number of requests can be in flight without a thread each. The multi
+// handle keeps finished connections open and hands them to the next request
+// for the same host (no new TCP/TLS handshake), easy handles are recycled,
+// and a share handle keeps DNS lookups and TLS sessions across transfers.
+// Responses are requested compressed (gzip/deflate) and decoded by curl.
+//
+// Requests that name a rateDomain wait in a RequestScheduler until that
+// domain's token bucket allows them, and failed attempts are re-queued with
+// exponential backoff: the I/O thread sleeps in poll() until the next
+// release is due, and no thread sleeps on a limiter or between retries.
+//
+// HTTP status codes map to errors the same way NetworkUtils always has:
+// 429 -> RateLimitError, 401/403 -> AuthError, other >= 400 -> NetworkError.
+// Without ENABLE_CURL every request fails with InternalError.
+
+struct HttpRequest {
+    std::string url;
+    std::vector<std::string> headers;  // "Name: value"
+    bool post = false;
+    std::string payload;               // POST body
+    std::string rateDomain;            // Token bucket to draw from; empty = not limited
+    int maxAttempts = 1;               // Failures other than AuthError are retried up to this
+};
+
+struct HttpEngineConfig {
+    long maxConnections = 64;          // Open connections across all hosts
+    long maxHostConnections = 8;       // Per host; further requests queue for a free one
+    long timeoutSeconds = 15;
+    long connectTimeoutSeconds = 10;
+    bool compressed = true;            // Send Accept-Encoding and decode the body
+    bool verifyPeer = true;
+    RateLimiter::Limit rateLimit;      // Default bucket per rateDomain
+    std::chrono::milliseconds retryBackoff{1000};  // Doubles with each further retry
+    std::string userAgent =
+        "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36";
+};
+
+struct HttpEngineStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t connectionsOpened = 0;    // New connections; the rest were reused
+    uint64_t retries = 0;              // Attempts re-queued after a failure
+};
+
+class HttpEngine {
+public:
+    using Callback = std::function<void(Result<std::string>)>;
+
+    explicit HttpEngine(HttpEngineConfig config = {});
+
+    // Finishes the transfers in flight, then stops the I/O thread; requests
+    // still queued (behind a rate limit or a retry backoff) fail
+    ~HttpEngine();
+
+    HttpEngine(const HttpEngine&) = delete;
+    HttpEngine& operator=(const HttpEngine&) = delete;
+
+    // Queue a request; `done` runs on the I/O thread when it completes, so it
+    // should hand the result off rather than do heavy work
+    void submit(HttpRequest request, Callback done);
+
+    std::future<Result<std::string>> fetch(HttpRequest request);
+
+    // All requests in flight at once; results in request order
+    std::vector<Result<std::string>> fetchAll(std::vector<HttpRequest> requests);
+
+    // Token bucket for one rateDomain (others use config.rateLimit)
+    void setRateLimit(const std::string& domain, RateLimiter::Limit limit);
+
+    HttpEngineStats stats() const;
+
+    // Process-wide engine used by NetworkUtils
+    static HttpEngine& shared();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
@@ -3,6 +3,8 @@
 #include <string>
 #include <memory>
 #include "MarketData.h"
+#include "SignalReason.h"
+#include "IndicatorContext.h"
 
 // Signal types for strategy decisions
 enum class SignalType {
@@ -20,6 +22,20 @@ struct StrategySignal {
     double confidence = 0.5;      // Confidence in signal (0 to 1)
     std::string reason;           // Human-readable reason for the signal
 
+    // Structured reason (see SignalReason.h). Built-in strategies set these
+    // instead of reason so no text is formatted per bar; reasonText() renders
+    // them when needed.
+    SignalReason reasonCode = SignalReason::None;
+    uint32_t reasonFlags = 0;     // SignalReasonFlag bits
+    double reasonValues[3] = {0.0, 0.0, 0.0};
+
+    // Text for reports and live output. Free text in reason takes precedence
+    // (e.g. when a wrapper strategy has annotated the signal).
+    std::string reasonText() const {
+        if (!reason.empty() || reasonCode == SignalReason::None) return reason;
+        return formatSignalReason(reasonCode, reasonFlags, reasonValues);
+    }
+
     // Helper to check if signal is actionable
     bool isActionable() const {
         return type != SignalType::Hold;
@@ -59,6 +75,78 @@ struct StrategySignal {
         sig.reason = reason;
         return sig;
     }
+
+    // Coded-reason variants (no string formatting)
+    static StrategySignal buy(double strength, SignalReason code, double v0 = 0.0, double v1 = 0.0) {
+        StrategySignal sig = buy(strength);
+        sig.setReason(code, v0, v1);
+        return sig;
+    }
+
+    static StrategySignal sell(double strength, SignalReason code, double v0 = 0.0, double v1 = 0.0) {
+        StrategySignal sig = sell(strength);
+        sig.setReason(code, v0, v1);
+        return sig;
+    }
+
+    static StrategySignal hold(SignalReason code, double v0 = 0.0, double v1 = 0.0, double v2 = 0.0) {
+        StrategySignal sig = hold();
+        sig.setReason(code, v0, v1, v2);
+        return sig;
+    }
+
+    void setReason(SignalReason code, double v0 = 0.0, double v1 = 0.0, double v2 = 0.0) {
+        reasonCode = code;
+        reasonValues[0] = v0;
+        reasonValues[1] = v1;
+        reasonValues[2] = v2;
+    }
+};
+
+// Per-bar strategy output for a whole series in structure-of-arrays form.
+// Entry i is the signal as of bar i; bars before firstBar are left as Hold.
+// Reasons are not kept: the array feeds simulation, not reporting.
+struct SignalArray {
+    size_t firstBar = 0;
+    std::vector<SignalType> type;
+    std::vector<double> strength;
+    std::vector<double> stopLossPrice;
+    std::vector<double> takeProfitPrice;
+    std::vector<double> confidence;
+
+    SignalArray() = default;
+    SignalArray(size_t bars, size_t first)
+        : firstBar(first), type(bars, SignalType::Hold), strength(bars, 0.0),
+          stopLossPrice(bars, 0.0), takeProfitPrice(bars, 0.0), confidence(bars, 0.5) {}
+
+    size_t size() const { return type.size(); }
+
+    // Number of Buy/Sell entries: an upper bound on the trades they can open
+    size_t actionableCount() const {
+        size_t n = 0;
+        for (size_t i = firstBar; i < type.size(); ++i) {
+            if (type[i] != SignalType::Hold) ++n;
+        }
+        return n;
+    }
+
+    void set(size_t i, const StrategySignal& sig) {
+        type[i] = sig.type;
+        strength[i] = sig.strength;
+        stopLossPrice[i] = sig.stopLossPrice;
+        takeProfitPrice[i] = sig.takeProfitPrice;
+        confidence[i] = sig.confidence;
+    }
+
+    StrategySignal at(size_t i) const {
+        StrategySignal sig;
+        sig.type = type[i];
+        sig.strength = strength[i];
+        sig.stopLossPrice = stopLossPrice[i];
+        sig.takeProfitPrice = takeProfitPrice[i];
+        sig.confidence = confidence[i];
+        return sig;
+    }
 };
 
 // Strategy parameters structure for optimization
@@ -73,6 +161,39 @@ struct StrategyParams {
         : name(n), value(v), minValue(minV), maxValue(maxV), step(s) {}
 };
 
+// Maintains a std::vector<Candle> mirror of a CandleView that grows with the
+// view. Used to feed vector-based strategy code from zero-copy backtest loops:
+// consecutive calls over the same series only append the bars not seen yet, so
+// each candle is copied once per series instead of once per bar.
+class CandleHistoryAdapter {
+public:
+    explicit CandleHistoryAdapter(size_t reserveBars = 0) { buffer_.reserve(reserveBars); }
+
+    const std::vector<Candle>& sync(CandleView view) {
+        size_t have = buffer_.size();
+        bool continues = view.data() == source_ && have <= view.size() &&
+            (have == 0 || (view[have - 1].ts == buffer_.back().ts &&
+                           view[have - 1].close == buffer_.back().close));
+        if (continues) {
+            buffer_.insert(buffer_.end(), view.begin() + have, view.end());
+        } else {
+            // Different series (or rewritten in place): start over
+            buffer_.assign(view.begin(), view.end());
+        }
+        source_ = view.data();
+        return buffer_;
+    }
+
+    void clear() {
+        buffer_.clear();
+        source_ = nullptr;
+    }
+
+private:
+    std::vector<Candle> buffer_;
+    const Candle* source_ = nullptr;
+};
+
 // Abstract strategy interface
 class IStrategy {
 public:
@@ -83,9 +204,62 @@ public:
     // idx: Current bar index (always history.size() - 1 for live, variable for backtest)
     virtual StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) = 0;
 
+    // Zero-copy variant: history is a view over the caller's series ending at
+    // the current bar. Built-in strategies implement this natively; the
+    // default copies the view and calls the vector overload above, so existing
+    // strategies keep working unchanged. Bar-by-bar callers that may hit that
+    // default keep a CandleHistoryAdapter of their own instead (see
+    // Backtester::run), so the strategy itself holds no history.
+    virtual StrategySignal generateSignal(CandleView history, size_t idx) {
+        return generateSignal(std::vector<Candle>(history.begin(), history.end()), idx);
+    }
+
+    // Bulk variant: signals for every bar from firstBar to the end of the
+    // series, computed in one pass ahead of simulation (see Backtester). The
+    // default drives onBar() when incremental mode is supported and otherwise
+    // calls generateSignal() on each prefix, so results match bar-by-bar use.
+    // Strategies that can work from full-series indicators may override this.
+    virtual SignalArray generateSignals(CandleView candles, size_t firstBar) {
+        SignalArray out(candles.size(), firstBar);
+        if (supportsIncremental()) {
+            reset();
+            for (size_t i = 0; i < candles.size(); ++i) {
+                onBar(candles[i]);
+                if (i >= firstBar) out.set(i, currentSignal());
+            }
+        } else {
+            CandleHistoryAdapter history(candles.size());
+            for (size_t i = firstBar; i < candles.size(); ++i) {
+                out.set(i, generateSignal(history.sync(candles.first(i + 1)), i));
+            }
+        }
+        return out;
+    }
+
+    // Shared-indicator variants: the same signals, computed from the series
+    // cached in an IndicatorContext over the whole history (see
+    // IndicatorContext.h), so strategies run on the same bars share their
+    // indicator work. idx is the current bar; the history is bars 0..idx of
+    // context.candles(). The defaults ignore the cache and call the
+    // overloads above.
+    virtual StrategySignal generateSignal(IndicatorContext& context, size_t idx) {
+        return generateSignal(context.candles().first(idx + 1), idx);
+    }
+
+    virtual SignalArray generateSignals(IndicatorContext& context, size_t firstBar) {
+        return generateSignals(context.candles(), firstBar);
+    }
+
     // Get the strategy name for logging/reporting
     virtual std::string getName() const = 0;
 
+    // Reason text for a signal produced by this strategy (reports, live
+    // output). Strategies whose coded reasons refer to their own state, such
+    // as the ensemble naming its children, override this.
+    virtual std::string describeSignal(const StrategySignal& signal) const {
+        return signal.reasonText();
+    }
+
     // Get the warmup period (number of bars needed before strategy can generate signals)
     virtual int getWarmupPeriod() const = 0;
 
@@ -105,6 +279,21 @@ public:
         // Default: do nothing
     }
 
+    // Optional incremental interface: strategies backed by rolling indicator
+    // state can be driven one bar at a time. Callers check
+    // supportsIncremental(), call reset(), then feed every bar in order with
+    // onBar() and read currentSignal() after each one. Per-bar cost is then
+    // independent of the history length.
+    virtual bool supportsIncremental() const { return false; }
+
+    virtual void onBar(const Candle& bar) {
+        (void)bar;
+    }
+
+    virtual StrategySignal currentSignal() const {
+        return StrategySignal::hold(SignalReason::IncrementalUnsupported);
+    }
+
     // Optional: Called when a trade is executed (for learning strategies)
     virtual void onTradeExecuted(double entryPrice, double exitPrice, bool isWin) {
         // Default: do nothing
@@ -135,6 +324,13 @@ public:
         return params_;
     }
 
+    void reset() override {
+        barsSeen_ = 0;
+        currentSignal_ = StrategySignal();
+    }
+
+    StrategySignal currentSignal() const override { return currentSignal_; }
+
     void setParameters(const std::vector<StrategyParams>& params) override {
         for (const auto& newParam : params) {
             for (auto& existing : params_) {
@@ -148,9 +344,26 @@ public:
     }
 
 protected:
+    // Incremental mode state (see IStrategy::onBar)
+    size_t barsSeen_ = 0;               // Bars consumed since reset()
+    StrategySignal currentSignal_;      // Signal as of the latest bar
+
     // Override this to respond to parameter changes
     virtual void onParametersChanged() {}
 
+    // generateSignals() for strategies that implement generateSignal(context,
+    // idx): reset, then evaluate every bar in order so stateful rules see the
+    // same sequence as in incremental mode.
+    SignalArray generateSignalsFromContext(IndicatorContext& context, size_t firstBar) {
+        SignalArray out(context.size(), firstBar);
+        reset();
+        for (size_t i = 0; i < context.size(); ++i) {
+            StrategySignal sig = generateSignal(context, i);
+            if (i >= firstBar) out.set(i, sig);
+        }
+        return out;
+    }
+
     // Helper to get parameter value by name
     double getParamValue(const std::string& name) const {
         for (const auto& p : params_) {
@@ -0,0 +1,194 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <utility>
+#include "MarketData.h"
+#include "TechnicalAnalysis.h"
+#include "RollingKernels.h"
+
+// Per-bar views of the multi-output indicators. Entry i is the value as of
+// bar i (i.e. over bars 0..i), exactly what the matching batch function in
+// TechnicalAnalysis.h returns for the first i + 1 bars.
+struct BollingerView {
+    std::span<const double> upper;
+    std::span<const double> middle;
+    std::span<const double> lower;
+    std::span<const double> bandwidth;
+
+    BollingerBands at(size_t i) const { return {upper[i], middle[i], lower[i], bandwidth[i]}; }
+};
+
+struct ADXView {
+    std::span<const double> adx;
+    std::span<const double> plusDI;
+    std::span<const double> minusDI;
+
+    ADXResult at(size_t i) const { return {adx[i], plusDI[i], minusDI[i]}; }
+};
+
+struct MACDView {
+    std::span<const double> macd;
+    std::span<const double> signal;
+
+    std::pair<double, double> at(size_t i) const { return {macd[i], signal[i]}; }
+};
+
+// IndicatorContext: shared indicator cache for one bar series
+//
+// Strategies that run on the same history (ensemble children, the regime
+// switcher's sub-strategies, the live signal generator) ask the context for
+// the indicators they need instead of each recomputing them. Every series is
+// keyed by indicator type and parameters, computed once over the whole
+// series on first request, and handed out as a read-only view; later requests
+// for the same key are lookups.
+//
+// Series come from the ...Series functions in TechnicalAnalysis.h (SMA from
+// the rolling mean kernel), so values match both the batch functions and the
+// strategies' incremental mode. The candles must outlive the context.
+// Requests may come from several threads; returned views stay valid for the
+// context's lifetime.
+class IndicatorContext {
+public:
+    explicit IndicatorContext(CandleView candles) : candles_(candles) {
+        closes_.reserve(candles.size());
+        for (const auto& c : candles) closes_.push_back(c.close);
+    }
+
+    IndicatorContext(const IndicatorContext&) = delete;
+    IndicatorContext& operator=(const IndicatorContext&) = delete;
+
+    CandleView candles() const { return candles_; }
+    size_t size() const { return candles_.size(); }
+    const std::vector<double>& closes() const { return closes_; }
+
+    // Simple moving average (running sums, see RollingKernels.h); 0 until `period` bars
+    std::span<const double> sma(int period) {
+        period = std::max(1, period);
+        return single(Kind::SMA, period, 0.0, [&](std::vector<double>& out) {
+            if (closes_.size() < (size_t)period) return;
+            size_t first = period - 1;
+            RollingKernels::rollingMean(closes_, first, period, std::span<double>(out).subspan(first));
+        });
+    }
+
+    // Wilder RSI; 50 until period + 1 bars
+    std::span<const double> rsi(int period) {
+        return single(Kind::RSI, period, 0.0, [&](std::vector<double>& out) {
+            out = computeRSISeries(closes_, period);
+        });
+    }
+
+    // Wilder ATR; 0 until period + 1 bars
+    std::span<const double> atr(int period) {
+        return single(Kind::ATR, period, 0.0, [&](std::vector<double>& out) {
+            out = computeATRSeries(candles_, period);
+        });
+    }
+
+    // Volatility squeeze flag as 1.0 / 0.0
+    std::span<const double> squeeze(int lookback, double percentile) {
+        return single(Kind::Squeeze, lookback, percentile, [&](std::vector<double>& out) {
+            std::vector<bool> flags = checkVolatilitySqueezeSeries(closes_, lookback, percentile);
+            for (size_t i = 0; i < flags.size(); ++i) out[i] = flags[i] ? 1.0 : 0.0;
+        });
+    }
+
+    BollingerView bollinger(int period, double multiplier) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cols = columns(Kind::Bollinger, period, multiplier, 4, [&](std::vector<double>* out) {
+            BollingerSeries series = computeBollingerBandsSeries(closes_, period, multiplier);
+            out[0] = std::move(series.upper);
+            out[1] = std::move(series.middle);
+            out[2] = std::move(series.lower);
+            out[3] = std::move(series.bandwidth);
+        });
+        return {cols[0], cols[1], cols[2], cols[3]};
+    }
+
+    ADXView adx(int period) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cols = columns(Kind::ADX, period, 0.0, 3, [&](std::vector<double>* out) {
+            ADXSeries series = computeADXSeries(candles_, period);
+            out[0] = std::move(series.adx);
+            out[1] = std::move(series.plusDI);
+            out[2] = std::move(series.minusDI);
+        });
+        return {cols[0], cols[1], cols[2]};
+    }
+
+    // MACD(12, 26, 9) line and signal
+    MACDView macd() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cols = columns(Kind::MACD, 0, 0.0, 2, [&](std::vector<double>* out) {
+            MACDSeries series = computeMACDSeries(closes_);
+            out[0] = std::move(series.macd);
+            out[1] = std::move(series.signal);
+        });
+        return {cols[0], cols[1]};
+    }
+
+    // Candlestick pattern bits and scores at every bar
+    const CandlePatternSeries& candlePatterns() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!patterns_) {
+            patterns_ = std::make_unique<CandlePatternSeries>(scanCandlestickPatterns(candles_));
+            ++computed_;
+        }
+        return *patterns_;
+    }
+
+    // Number of indicator series computed so far (a multi-output indicator
+    // counts once)
+    size_t computedSeries() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return computed_;
+    }
+
+private:
+    enum class Kind { SMA, RSI, ATR, Squeeze, Bollinger, ADX, MACD };
+
+    // Indicator type, parameters and output column
+    using Key = std::tuple<Kind, int, double, int>;
+
+    static constexpr int kMaxOutputs = 4;
+
+    template <typename Fill>
+    std::span<const double> single(Kind kind, int period, double param, Fill&& fill) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cols = columns(kind, period, param, 1, [&](std::vector<double>* out) { fill(out[0]); });
+        return cols[0];
+    }
+
+    // Look up (or compute) the `outputs` columns of one indicator. Caller
+    // holds mutex_. std::map nodes never move, so views stay valid.
+    template <typename Fill>
+    std::array<std::span<const double>, kMaxOutputs> columns(Kind kind, int period, double param,
+                                                             int outputs, Fill&& fill) {
+        std::array<std::span<const double>, kMaxOutputs> views;
+        auto found = cache_.find(Key{kind, period, param, 0});
+        if (found == cache_.end()) {
+            std::vector<double> out[kMaxOutputs];
+            for (int k = 0; k < outputs; ++k) out[k].assign(candles_.size(), 0.0);
+            fill(out);
+            for (int k = 0; k < outputs; ++k) {
+                cache_.emplace(Key{kind, period, param, k}, std::move(out[k]));
+            }
+            ++computed_;
+        }
+        for (int k = 0; k < outputs; ++k) views[k] = cache_.at(Key{kind, period, param, k});
+        return views;
+    }
+
+    CandleView candles_;
+    std::vector<double> closes_;
+    mutable std::mutex mutex_;
+    std::map<Key, std::vector<double>> cache_;
+    std::unique_ptr<CandlePatternSeries> patterns_;
+    size_t computed_ = 0;
+};
@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "MarketData.h"
+#include "BarColumns.h"
+#include "TechnicalAnalysis.h"
+#include "RollingIndicators.h"
+
+// Compile-time fused indicator pipelines.
+//
+// A Pipeline<Stages...> feeds every bar to all of its stages in a single pass,
+// e.g. Pipeline<SMA<10>, SMA<30>, ADX<14>, ATR<14>> reads each high/low/close
+// once instead of once per indicator. Periods are template arguments, so
+// window buffers are std::arrays inside the pipeline (no heap, no per-stage
+// indirection) and the whole per-bar update inlines into the caller's loop.
+//
+// Each stage repeats the recursion of the runtime class of the same name in
+// RollingIndicators.h, so values are bit-identical to those classes (and,
+// like them, to the ...Series and batch functions, up to rounding for the
+// running-sum SMA). Strategies whose parameters
+// are not compile-time constants (optimizer sweeps) keep using the runtime
+// classes or IndicatorContext.
+namespace Fused {
+
+// Simple moving average; value() is 0 until the window is full
+template <int Period>
+class SMA {
+    static_assert(Period >= 1, "SMA period must be positive");
+
+public:
+    static constexpr int kWarmup = Period;
+
+    void update(double, double, double close) {
+        previous_ = value_;
+        if (count_ < Period) {
+            window_[head_] = close;
+            moments_.add(close);
+            ++count_;
+        } else {
+            // Running sums as RollingSMA (MomentWindow), re-added oldest-first
+            // (head_ onwards, then the wrapped part) once per window
+            double leaving = window_[head_];
+            window_[head_] = close;
+            moments_.replace(leaving, close);
+        }
+        head_ = head_ + 1 == Period ? 0 : head_ + 1;
+        if (count_ < Period) return;
+        if (moments_.resumDue(Period)) {
+            moments_.resum(Period, [this](size_t i) { return window_[(head_ + i) % Period]; });
+        }
+        value_ = moments_.mean();
+    }
+
+    bool ready() const { return count_ == Period; }
+    double value() const { return value_; }
+    double previous() const { return previous_; }  // Value before the last update
+
+private:
+    std::array<double, Period> window_{};
+    WindowMoments moments_;
+    int head_ = 0;
+    int count_ = 0;
+    double value_ = 0.0;
+    double previous_ = 0.0;
+};
+
+// EMA seeded with the SMA of the first Period values (as RollingEMA)
+template <int Period>
+class EMA {
+    static_assert(Period >= 1, "EMA period must be positive");
+
+public:
+    static constexpr int kWarmup = Period;
+
+    void update(double, double, double close) { update(close); }
+
+    void update(double x) {
+        if (count_ < Period) {
+            sum_ += x;
+            if (count_ == Period - 1) value_ = sum_ / Period;
+            ++count_;
+        } else {
+            value_ = (x - value_) * kMultiplier + value_;
+        }
+    }
+
+    bool ready() const { return count_ == Period; }
+    double value() const { return value_; }
+
+private:
+    static constexpr double kMultiplier = 2.0 / (Period + 1.0);
+
+    int count_ = 0;
+    double sum_ = 0.0;
+    double value_ = 0.0;
+};
+
+// Wilder ATR (as RollingATR): 0 until Period + 1 bars
+template <int Period>
+class ATR {
+    static_assert(Period >= 1, "ATR period must be positive");
+
+public:
+    static constexpr int kWarmup = Period + 1;
+
+    void update(double high, double low, double close) {
+        double tr = high - low;
+        if (count_ > 0) {
+            double hpc = std::abs(high - prevClose_);
+            double lpc = std::abs(low - prevClose_);
+            tr = std::max({tr, hpc, lpc});
+        }
+        if (count_ < Period) {
+            atr_ += tr;
+            if (count_ == Period - 1) atr_ /= Period;
+        } else {
+            atr_ = (atr_ * (Period - 1) + tr) / Period;
+        }
+        prevClose_ = close;
+        if (count_ <= Period) ++count_;
+    }
+
+    double value() const { return count_ > Period ? atr_ : 0.0; }
+
+private:
+    int count_ = 0;
+    double prevClose_ = 0.0;
+    double atr_ = 0.0;
+};
+
+// Wilder ADX with +DI/-DI (as RollingADX): zeros until 2 * Period bars
+template <int Period>
+class ADX {
+    static_assert(Period >= 1, "ADX period must be positive");
+
+public:
+    static constexpr int kWarmup = 2 * Period;
+
+    void update(double high, double low, double close) {
+        if (count_ > 0) {
+            double highDiff = high - prevHigh_;
+            double lowDiff = prevLow_ - low;
+            double plusDM = (highDiff > lowDiff && highDiff > 0) ? highDiff : 0.0;
+            double minusDM = (lowDiff > highDiff && lowDiff > 0) ? lowDiff : 0.0;
+
+            double hl = high - low;
+            double hpc = std::abs(high - prevClose_);
+            double lpc = std::abs(low - prevClose_);
+            double tr = std::max({hl, hpc, lpc});
+
+            if (count_ <= Period) {
+                smoothTR_ += tr;
+                smoothPlusDM_ += plusDM;
+                smoothMinusDM_ += minusDM;
+            } else {
+                smoothTR_ = smoothTR_ - (smoothTR_ / Period) + tr;
+                smoothPlusDM_ = smoothPlusDM_ - (smoothPlusDM_ / Period) + plusDM;
+                smoothMinusDM_ = smoothMinusDM_ - (smoothMinusDM_ / Period) + minusDM;
+
+                plusDI_ = (smoothTR_ == 0) ? 0 : (100.0 * smoothPlusDM_ / smoothTR_);
+                minusDI_ = (smoothTR_ == 0) ? 0 : (100.0 * smoothMinusDM_ / smoothTR_);
+
+                double diSum = plusDI_ + minusDI_;
+                double dx = (diSum == 0) ? 0 : (100.0 * std::abs(plusDI_ - minusDI_) / diSum);
+
+                if (dxCount_ < Period) {
+                    adx_ += dx;
+                    if (dxCount_ == Period - 1) adx_ /= Period;
+                    ++dxCount_;
+                } else {
+                    adx_ = ((adx_ * (Period - 1)) + dx) / Period;
+                }
+            }
+        }
+        prevHigh_ = high;
+        prevLow_ = low;
+        prevClose_ = close;
+        if (count_ < kWarmup) ++count_;
+    }
+
+    ADXResult value() const {
+        ADXResult res = {0.0, 0.0, 0.0};
+        if (count_ < kWarmup) return res;
+        res.plusDI = plusDI_;
+        res.minusDI = minusDI_;
+        if (dxCount_ >= Period) res.adx = adx_;
+        return res;
+    }
+
+private:
+    int count_ = 0;   // Saturates at kWarmup; only the phase matters after that
+    double prevHigh_ = 0.0, prevLow_ = 0.0, prevClose_ = 0.0;
+    double smoothTR_ = 0.0, smoothPlusDM_ = 0.0, smoothMinusDM_ = 0.0;
+    double plusDI_ = 0.0, minusDI_ = 0.0;
+    int dxCount_ = 0;
+    double adx_ = 0.0;
+};
+
+// MACD line and signal (as RollingMACD for the default 12/26/9)
+template <int Fast = 12, int Slow = 26, int Signal = 9>
+class MACD {
+public:
+    static constexpr int kWarmup = Slow + Signal - 1;
+
+    void update(double, double, double close) {
+        fast_.update(close);
+        slow_.update(close);
+        if (slow_.ready()) {
+            macd_ = fast_.value() - slow_.value();
+            signal_.update(macd_);
+        }
+    }
+
+    // {macd, signal}; zeros until the signal line has Signal MACD values
+    std::pair<double, double> value() const {
+        if (!signal_.ready()) return {0.0, 0.0};
+        return {macd_, signal_.value()};
+    }
+
+private:
+    EMA<Fast> fast_;
+    EMA<Slow> slow_;
+    EMA<Signal> signal_;
+    double macd_ = 0.0;
+};
+
+// All stages advanced together, one bar at a time
+template <typename... Stages>
+class Pipeline {
+public:
+    static constexpr size_t kStages = sizeof...(Stages);
+
+    // Bars before every stage has a value
+    static constexpr int kWarmup = std::max({0, Stages::kWarmup...});
+
+    void update(double high, double low, double close) {
+        std::apply([&](auto&... stage) { (stage.update(high, low, close), ...); }, stages_);
+    }
+    void update(const Candle& c) { update(c.high, c.low, c.close); }
+
+    // Stage by position, e.g. get<0>() for the first SMA
+    template <size_t I>
+    const auto& get() const { return std::get<I>(stages_); }
+
+    // One pass over the bars: update, then onBar(i, *this) with the values
+    // as of bar i
+    template <typename OnBar>
+    void run(const BarColumnsView& bars, OnBar&& onBar) {
+        size_t n = bars.size();
+        const double* high = bars.high.data();
+        const double* low = bars.low.data();
+        const double* close = bars.close.data();
+        for (size_t i = 0; i < n; ++i) {
+            update(high[i], low[i], close[i]);
+            onBar(i, std::as_const(*this));
+        }
+    }
+
+    template <typename OnBar>
+    void run(CandleView candles, OnBar&& onBar) {
+        for (size_t i = 0; i < candles.size(); ++i) {
+            update(candles[i]);
+            onBar(i, std::as_const(*this));
+        }
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+};
+
+}  // namespace Fused
@@ -4,6 +4,7 @@
 #include "TradingStrategy.h"
 #include "TechnicalAnalysis.h"
 #include "RegimeDetector.h"
+#include "CrossSectionEngine.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -16,7 +17,8 @@ LiveSignalsRunner::LiveSignalsRunner(const LiveSignalsConfig& config)
     sentimentProvider_ = std::make_unique<CachedSentimentProvider>();
     pool_ = std::make_unique<ThreadPool>(config.numWorkers);
 
-    // Use a placeholder strategy - we'll use TradingStrategy::generateSignal directly
+    // Confirmation strategy run alongside TradingStrategy::generateSignal;
+    // cloned per symbol in warmupSymbol()
     strategy_ = std::make_unique<MeanReversionStrategy>();
 
     std::string token = Environment::get("STOCK_TELEGRAM_BOT_TOKEN");
@@ -166,9 +168,24 @@ void LiveSignalsRunner::warmupSymbol(const std::string& symbol, const std::strin
     auto now = TimeUtils::now();
     auto start = now - std::chrono::hours(24 * config_.warmupDays);
 
+    // Read from the local history; only the bars since the last run are fetched
     auto result = priceProvider_->getHistory(symbol, barSize, start, now);
     if (result.isOk()) {
         BarSeries series(result.value());
+
+        // Prime a per-symbol strategy with the warmup history so each new bar
+        // is an O(1) update rather than a full recompute
+        auto strategy = strategy_->clone();
+        if (strategy->supportsIncremental()) {
+            strategy->reset();
+            for (const auto& bar : series.bars()) strategy->onBar(bar);
+        }
+        symbolStrategies_[symbol] = std::move(strategy);
+
+        SymbolLevels levels;
+        for (double close : series.columns().closes()) levels.update(close);
+        symbolLevels_[symbol] = std::move(levels);
+
         seriesMap_[symbol] = series;
         std::cout << "  " << symbol << ": " << series.size() << " bars loaded" << std::endl;
     } else {
@@ -278,6 +295,29 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
     // Try to append the new bar (only if not already processed)
     bool isNewBar = series.tryAppend(*completedBar);
 
+    // Indicators shared by the symbol's strategy and the native signal below
+    IndicatorContext indicators(series.bars());
+
+    // Keep the per-symbol strategy in step with the series
+    StrategySignal strategySignal;
+    std::string strategyName;
+    std::string strategyReason;
+    auto levelsIt = symbolLevels_.find(symbol);
+    if (levelsIt != symbolLevels_.end() && isNewBar) levelsIt->second.update(completedBar->close);
+
+    auto stratIt = symbolStrategies_.find(symbol);
+    if (stratIt != symbolStrategies_.end() && series.size() > 0) {
+        IStrategy& strategy = *stratIt->second;
+        strategyName = strategy.getName();
+        if (strategy.supportsIncremental()) {
+            if (isNewBar) strategy.onBar(*completedBar);
+            strategySignal = strategy.currentSignal();
+        } else {
+            strategySignal = strategy.generateSignal(indicators, series.size() - 1);
+        }
+        strategyReason = strategy.describeSignal(strategySignal);
+    }
+
     // Set timestamp
     row.timestamp = TimeUtils::formatTimeET(completedBar->ts);
     row.lastClose = completedBar->close;
@@ -325,9 +365,6 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
 
     // Use native C++ signal generation if Python failed or not selected
     if (!usedPythonSignal) {
-        // Extract close prices
-        auto closes = series.closePrices();
-
         // Fetch fundamentals for signal generation
         // Use tickers list to find the type for this symbol
         std::string type = "stock";
@@ -343,12 +380,13 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
             onChain = fetchOnChainData(symbol);
         }
 
-        auto levels = identifyLevels(closes, 60);
+        auto levels = levelsIt != symbolLevels_.end() ? levelsIt->second.levels.value()
+                                                       : identifyLevels(series.columns().closes(), 60);
 
         // Fetch VIX data for volatility analysis
         VIXData vix = fetchVIXData();
 
-        sig = generateSignal(symbol, series.bars(), row.sentiment, fund, onChain, levels, mlModel_, vix);
+        sig = generateSignal(symbol, indicators, row.sentiment, fund, onChain, levels, mlModel_, vix);
     }
 
     // Map signal to output
@@ -363,6 +401,11 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
     row.strength = std::abs(sig.confidence);
     row.confidence = sig.confidence;
     row.reason = sig.reason;
+    if (strategySignal.isActionable()) {
+        row.strategySignal = strategyName + ": " +
+            (strategySignal.type == SignalType::Buy ? "BUY" : "SELL") +
+            " (" + strategyReason + ")";
+    }
     row.limitPrice = sig.entry;
     row.stopLoss = sig.stopLoss;
     row.takeProfit = sig.takeProfit;
@@ -372,7 +415,8 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
     row.regime = detectRegime(closes);
 
     // Build targets string
-    std::vector<double> extrema = findLocalExtrema(closes, 60, true);
+    std::vector<double> extrema = levelsIt != symbolLevels_.end() ? levelsIt->second.extrema.targets(true)
+                                                                  : findLocalExtrema(series.columns().closes(), 60, true);
     std::ostringstream targetsStream;
     for (size_t i = 0; i < extrema.size() && i < 3; ++i) {
         if (i > 0) targetsStream << ";";
@@ -385,7 +429,7 @@ LiveSignalRow LiveSignalsRunner::processSymbol(const std::string& symbol) {
 
 void LiveSignalsRunner::writeHeader() {
     outputFile_ << "timestamp,symbol,lastClose,regime,action,strength,confidence,"
-                << "limitPrice,stopLoss,takeProfit,targets,sentiment,reason" << std::endl;
+                << "limitPrice,stopLoss,takeProfit,targets,sentiment,reason,strategySignal" << std::endl;
     headerWritten_ = true;
 }
 
@@ -402,7 +446,8 @@ void LiveSignalsRunner::writeRow(const LiveSignalRow& row) {
                 << row.takeProfit << ","
                 << "\"" << row.targets << "\","
                 << std::setprecision(3) << row.sentiment << ","
-                << "\"" << row.reason << "\""
+                << "\"" << row.reason << "\","
+                << "\"" << row.strategySignal << "\""
                 << std::endl;
 
     // Also log to console
@@ -601,43 +646,43 @@ void LiveSignalsRunner::selectHotTickers() {
     // Select up to maxPythonModels_ tickers based on volatility and news sentiment
     std::cout << "[PythonSignals] Selecting hot tickers..." << std::endl;
 
-    struct TickerScore {
-        std::string symbol;
-        double volatility;
-        double sentiment;
-        double totalScore;
-    };
-
-    std::vector<TickerScore> scores;
-
+    // Volatility: mean high - low over the last 14 bars as a percentage of
+    // the close, one column operation over every ticker with enough history
+    const int volatilityWindow = 14;
+    std::vector<std::pair<std::string, BarColumnsView>> histories;
     for (const auto& [symbol, type] : tickers_) {
-        double volatility = calculateVolatility(symbol);
-        double sentiment = getNewsSentiment(symbol);
+        auto it = seriesMap_.find(symbol);
+        if (it != seriesMap_.end()) histories.emplace_back(symbol, it->second.columns().view());
+    }
+    CrossSectionPanel panel = CrossSectionPanel::fromSeries(histories, volatilityWindow);
+    std::vector<double> range = CrossSection::meanRange(panel, volatilityWindow);
+    std::vector<double> lastClose = panel.close.lastRow();
 
-        // Score: higher volatility + positive sentiment = higher priority
-        // Also favor tickers with recent news
-        double totalScore = volatility * 0.6 + (sentiment + 1.0) * 0.4;
+    std::map<std::string, double> panelVolatility;
+    for (size_t j = 0; j < panel.size(); ++j) {
+        panelVolatility[panel.symbols[j]] = lastClose[j] > 0 ? (range[j] / lastClose[j]) * 100.0 : 0.5;
+    }
 
-        scores.push_back({symbol, volatility, sentiment, totalScore});
+    size_t count = tickers_.size();
+    std::vector<double> volatility(count), sentiment(count), score(count);
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& symbol = tickers_[i].first;
+        auto vol = panelVolatility.find(symbol);
+        volatility[i] = vol != panelVolatility.end() ? vol->second : 0.5;  // Default medium volatility
+        sentiment[i] = getNewsSentiment(symbol);
     }
 
-    // Sort by total score (highest first)
-    std::sort(scores.begin(), scores.end(),
-        [](const TickerScore& a, const TickerScore& b) {
-            return a.totalScore > b.totalScore;
-        });
+    // Score: higher volatility + positive sentiment = higher priority
+    for (size_t i = 0; i < count; ++i) score[i] = volatility[i] * 0.6 + (sentiment[i] + 1.0) * 0.4;
 
-    // Select top N
-    int count = std::min(maxPythonModels_, static_cast<int>(scores.size()));
+    std::vector<size_t> top = CrossSection::topK(score, std::max(0, maxPythonModels_));
     selectedTickers_.clear();
-    for (int i = 0; i < count; ++i) {
-        selectedTickers_.push_back(scores[i].symbol);
-    }
+    for (size_t i : top) selectedTickers_.push_back(tickers_[i].first);
 
     std::cout << "[PythonSignals] Selected " << selectedTickers_.size() << " hot tickers:" << std::endl;
     for (size_t i = 0; i < selectedTickers_.size(); ++i) {
         std::cout << "  " << (i+1) << ". " << selectedTickers_[i]
-                  << " (vol: " << scores[i].volatility << ", sent: " << scores[i].sentiment << ")" << std::endl;
+                  << " (vol: " << volatility[top[i]] << ", sent: " << sentiment[top[i]] << ")" << std::endl;
     }
 
     // Report selected tickers to Python API
@@ -652,35 +697,6 @@ void LiveSignalsRunner::selectHotTickers() {
     }
 }
 
-double LiveSignalsRunner::calculateVolatility(const std::string& symbol) {
-    // Calculate volatility using ATR (Average True Range)
-    auto it = seriesMap_.find(symbol);
-    if (it == seriesMap_.end() || it->second.size() < 14) {
-        return 0.5; // Default medium volatility
-    }
-
-    const auto& bars = it->second.bars();
-    if (bars.size() < 14) {
-        return 0.5;
-    }
-
-    // Calculate ATR manually
-    double atr = 0.0;
-    for (size_t i = bars.size() - 14; i < bars.size(); ++i) {
-        double tr = bars[i].high - bars[i].low;
-        atr += tr;
-    }
-    atr /= 14.0;
-
-    // Normalize by current price to get percentage volatility
-    double currentPrice = bars.back().close;
-    if (currentPrice > 0) {
-        return (atr / currentPrice) * 100.0; // As percentage
-    }
-
-    return 0.5;
-}
-
 double LiveSignalsRunner::getNewsSentiment(const std::string& symbol) {
     // Get sentiment from sentiment provider
     auto result = sentimentProvider_->getSentiment(symbol);
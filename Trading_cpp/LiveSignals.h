@@ -9,6 +9,7 @@
 #include "RiskManagement.h"
 #include "IStrategy.h"
 #include "TechnicalAnalysis.h"
+#include "RollingIndicators.h"
 #include "Config.h"
 #include "TelegramNotifier.h"
 #include "TradingStrategy.h"
@@ -36,6 +37,7 @@ struct LiveSignalRow {
     std::string targets;        // Comma-separated targets
     double sentiment;
     std::string reason;
+    std::string strategySignal; // "<strategy>: BUY/SELL (<reason>)"; empty on hold
 };
 
 // Configuration for live signals mode
@@ -99,8 +101,22 @@ private:
     // Telegram notifier
     std::unique_ptr<TelegramNotifier> telegramNotifier_;
 
-    // Strategy
+    // Strategy (prototype) and per-symbol instances fed bar by bar
     std::unique_ptr<IStrategy> strategy_;
+    std::map<std::string, std::unique_ptr<IStrategy>> symbolStrategies_;
+
+    // Per-symbol support/resistance and price targets over the last 60
+    // closes, updated once per new bar instead of rescanning the series
+    struct SymbolLevels {
+        RollingLevels levels{60};
+        RollingExtrema extrema{60};
+
+        void update(double close) {
+            levels.update(close);
+            extrema.update(close);
+        }
+    };
+    std::map<std::string, SymbolLevels> symbolLevels_;
 
     // Regime detector (HMM-based)
     RegimeDetection::RegimeDetector regimeDetector_;
@@ -119,7 +135,6 @@ private:
 
     // Helper methods for ticker selection
     void selectHotTickers();
-    double calculateVolatility(const std::string& symbol);
     double getNewsSentiment(const std::string& symbol);
 
     // Output file
@@ -1,9 +1,13 @@
 #include "MarketData.h"
 #include "NetworkUtils.h"
+#include "BarArchive.h"
+#include "HistoryStore.h"
+#include "YahooChartParser.h"
 #include "json.hpp"
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <optional>
 
 using json = nlohmann::json;
 
@@ -14,13 +18,13 @@ std::string getCoinApiKey() {
 }
 
 std::string formatSymbol(const std::string& symbol, const std::string& type) {
+    // Uppercase, as YahooPriceProvider does, so both name the same history archive
     std::string s = symbol;
+    std::transform(s.begin(), s.end(), s.begin(), ::toupper);
     if (type == "crypto") {
         // Yahoo uses "BTC-USD" format for crypto, which matches our input usually.
         // If input is "bitcoin" (CoinGecko style), we might need mapping, 
         // but assuming input "BTC-USD" for Yahoo is correct.
-        // Ensure it's uppercase
-        std::transform(s.begin(), s.end(), s.begin(), ::toupper);
         if (s.find("-USD") == std::string::npos && s.length() <= 5) {
             s += "-USD";
         }
@@ -30,69 +34,127 @@ std::string formatSymbol(const std::string& symbol, const std::string& type) {
 
 // --- Implementation ---
 
-std::vector<Candle> fetchCandles(const std::string& symbol, const std::string& type) {
-    std::vector<Candle> candles;
-    std::string ySymbol = formatSymbol(symbol, type);
+// Daily history archived by fetchBarColumns is reused for this long before the
+// chart endpoint is queried (and its JSON parsed) again
+static constexpr int64_t kCandleArchiveMaxAgeSeconds = 3600;
+
+// Columns of a recent binary archive, if there is one
+static std::optional<BarColumns> freshArchive(const std::string& archivePath) {
+    auto archived = MappedBarFile::open(archivePath);
+    if (archived.isOk()) {
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(
+            TimeUtils::now() - archived.value().writtenAt()).count();
+        if (age >= 0 && age < kCandleArchiveMaxAgeSeconds && archived.value().size() > 0) {
+            BarColumnsView bars = archived.value().view();
+            return BarColumns({bars.ts.begin(), bars.ts.end()}, {bars.open.begin(), bars.open.end()},
+                              {bars.high.begin(), bars.high.end()}, {bars.low.begin(), bars.low.end()},
+                              {bars.close.begin(), bars.close.end()},
+                              {bars.volume.begin(), bars.volume.end()});
+        }
+    }
+    return std::nullopt;
+}
+
+// Daily history is kept for two years (what range=2y used to return)
+static constexpr int64_t kHistorySeconds = 730 * 86400;
+
+static TimePoint historyStart() {
+    return TimeUtils::now() - std::chrono::seconds(kHistorySeconds);
+}
 
-    // Yahoo Chart API v8 - include crumb for authentication
+// Yahoo Chart API v8 - include crumb for authentication. With `from`, only
+// the bars since then (a delta refresh); otherwise the full two years.
+static std::string chartUrl(const std::string& ySymbol, std::optional<TimePoint> from = std::nullopt) {
     std::string crumb = NetworkUtils::getYahooCrumb();
-    std::string url = "https://query1.finance.yahoo.com/v8/finance/chart/" + ySymbol + "?interval=1d&range=2y";
+    std::string url = "https://query1.finance.yahoo.com/v8/finance/chart/" + ySymbol + "?interval=1d";
+    if (from) {
+        url += "&period1=" + std::to_string(TimeUtils::toUnixSeconds(*from)) +
+               "&period2=" + std::to_string(TimeUtils::toUnixSeconds(TimeUtils::now()));
+    } else {
+        url += "&range=2y";
+    }
     if (!crumb.empty()) {
         url += "&crumb=" + crumb;
     }
-    // std::cout << std::endl << "URL: " << url << std::endl;
+    return url;
+}
 
-    std::string response = NetworkUtils::fetchData(url);
-    if (response.empty()) return candles;
+// Chart responses are not kept in the response cache: the bar archive holds
+// their contents already
+static constexpr int kChartCacheSeconds = 0;
 
-    try {
-        json data = json::parse(response);
-        if (data.contains("chart") && data["chart"].contains("result")) {
-            auto result = data["chart"]["result"];
-            if (!result.is_null() && !result.empty()) {
-                auto quoteData = result[0];
-                if (quoteData.contains("timestamp") && quoteData.contains("indicators")) {
-                    auto timestamps = quoteData["timestamp"];
-                    auto indicators = quoteData["indicators"]["quote"][0];
-                    
-                    if (timestamps.is_array() && indicators.contains("close")) {
-                        size_t len = timestamps.size();
-                        auto closes = indicators["close"];
-                        auto opens = indicators.contains("open") ? indicators["open"] : closes;
-                        auto highs = indicators.contains("high") ? indicators["high"] : closes;
-                        auto lows = indicators.contains("low") ? indicators["low"] : closes;
-                        auto volumes = indicators.contains("volume") ? indicators["volume"] : json::array();
-
-                        for (size_t i = 0; i < len; ++i) {
-                            if (closes[i].is_null()) continue;
-
-                            Candle c;
-                            int64_t tsValue = timestamps[i].get<int64_t>();
-                            c.ts = TimeUtils::fromUnixSeconds(tsValue);
-                            c.date = std::to_string(tsValue);  // Keep for backward compatibility
-                            c.close = closes[i].get<double>();
-                            c.open = !opens[i].is_null() ? opens[i].get<double>() : c.close;
-                            c.high = !highs[i].is_null() ? highs[i].get<double>() : c.close;
-                            c.low = !lows[i].is_null() ? lows[i].get<double>() : c.close;
-
-                            if (!volumes.empty() && i < volumes.size() && !volumes[i].is_null()) {
-                                c.volume = volumes[i].get<int64_t>();
-                            } else {
-                                c.volume = 0;
-                            }
-
-                            candles.push_back(c);
-                        }
-                    }
-                }
-            }
+static std::optional<BarColumns> parseChart(const std::string& symbol, const std::string& response) {
+    // Streamed straight into columns (no DOM); null o/h/l take the close
+    auto parsed = YahooChart::parse(response, YahooChart::kArchivedNullPrices);
+    if (parsed.isError()) {
+        std::cerr << "JSON Parse Error (Candles " << symbol << "): " << parsed.error().details << std::endl;
+        return std::nullopt;
+    }
+    return std::move(parsed.value());
+}
+
+// Bring the archived history up to date from the chart response for `plan`.
+// A delta that no longer matches the archive is replaced by a full fetch.
+static BarColumns storeChart(const std::string& symbol, const std::string& ySymbol,
+                             HistoryStore::Plan plan, const std::string& response) {
+    auto bars = parseChart(symbol, response);
+    if (!bars) return plan.isDelta() ? std::move(plan.stored) : BarColumns{};
+    if (!plan.isDelta()) {
+        return HistoryStore::replace(ySymbol, BarArchive::kDailySeconds, std::move(*bars), historyStart());
+    }
+    if (auto merged = HistoryStore::merge(ySymbol, BarArchive::kDailySeconds, std::move(plan), *bars, historyStart())) {
+        return std::move(*merged);
+    }
+
+    std::string full = NetworkUtils::fetchData(chartUrl(ySymbol), kChartCacheSeconds);
+    auto fullBars = full.empty() ? std::nullopt : parseChart(symbol, full);
+    if (!fullBars) return {};
+    return HistoryStore::replace(ySymbol, BarArchive::kDailySeconds, std::move(*fullBars), historyStart());
+}
+
+BarColumns fetchBarColumns(const std::string& symbol, const std::string& type) {
+    std::string ySymbol = formatSymbol(symbol, type);
+
+    // Fast path: recent binary archive, no network or JSON
+    // (the mapping is released before the archive is rewritten)
+    if (auto archived = freshArchive(BarArchive::pathFor(ySymbol))) {
+        return std::move(*archived);
+    }
+
+    // Otherwise only the bars since the archive's last complete one
+    auto plan = HistoryStore::plan(ySymbol, BarArchive::kDailySeconds, historyStart());
+    std::string response = NetworkUtils::fetchData(chartUrl(ySymbol, plan.fetchFrom), kChartCacheSeconds);
+    if (response.empty()) return std::move(plan.stored);  // Stale history beats none
+    return storeChart(symbol, ySymbol, std::move(plan), response);
+}
+
+void prefetchBarColumns(const std::vector<std::pair<std::string, std::string>>& symbols) {
+    struct Pending {
+        std::string symbol;
+        std::string ySymbol;
+        HistoryStore::Plan plan;
+    };
+    std::vector<Pending> stale;
+    std::vector<std::string> urls;
+    for (const auto& [symbol, type] : symbols) {
+        std::string ySymbol = formatSymbol(symbol, type);
+        if (freshArchive(BarArchive::pathFor(ySymbol))) continue;
+        auto plan = HistoryStore::plan(ySymbol, BarArchive::kDailySeconds, historyStart());
+        urls.push_back(chartUrl(ySymbol, plan.fetchFrom));
+        stale.push_back({symbol, ySymbol, std::move(plan)});
+    }
+    if (urls.empty()) return;
+
+    auto responses = NetworkUtils::fetchAllWithResult(urls, kChartCacheSeconds);
+    for (size_t i = 0; i < responses.size(); ++i) {
+        if (responses[i].isOk() && !responses[i].value().empty()) {
+            storeChart(stale[i].symbol, stale[i].ySymbol, std::move(stale[i].plan), responses[i].value());
         }
-    } catch (const json::parse_error& e) {
-        std::cerr << "JSON Parse Error (Candles " << symbol << "): " << e.what() << std::endl;
-    } catch (...) {
-        // std::cerr << "Unknown Error parsing candles for " << symbol << std::endl;
     }
-    return candles;
+}
+
+std::vector<Candle> fetchCandles(const std::string& symbol, const std::string& type) {
+    return fetchBarColumns(symbol, type).toCandles();
 }
 
 Fundamentals fetchFundamentals(const std::string& symbol, const std::string& type) {
@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <span>
+#include <utility>
 #include "TimeUtils.h"
 
 struct Candle {
@@ -14,6 +16,10 @@ struct Candle {
     int64_t volume;
 };
 
+// Read-only window over a contiguous candle series (e.g. the prefix of a
+// std::vector<Candle> up to the current bar). Cheap to pass by value.
+using CandleView = std::span<const Candle>;
+
 struct Fundamentals {
     // Existing basic fields
     double pe_ratio;
@@ -86,7 +92,21 @@ struct OnChainData {
     bool valid;
 };
 
+class BarColumns;  // BarColumns.h
+
 // Data Fetching Interface
 std::vector<Candle> fetchCandles(const std::string& symbol, const std::string& type);
+
+// Fetch daily history straight into column form (the chart response is
+// parsed into the columns directly; see YahooChartParser.h). An archived
+// history is extended with only the bars since it was written (HistoryStore.h).
+BarColumns fetchBarColumns(const std::string& symbol, const std::string& type);
+
+// Bring the daily history of many (symbol, type) pairs into the archive with
+// all the chart requests in flight at once; fetchBarColumns then reads each
+// from the archive. Symbols whose archive is recent are not requested, and
+// the rest only request their missing bars.
+void prefetchBarColumns(const std::vector<std::pair<std::string, std::string>>& symbols);
+
 Fundamentals fetchFundamentals(const std::string& symbol, const std::string& type);
 OnChainData fetchOnChainData(const std::string& symbol);
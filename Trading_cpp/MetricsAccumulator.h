@@ -0,0 +1,220 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+// Streaming performance statistics for the backtest kernel.
+//
+// Everything is updated in O(1) per bar with fixed storage, so a run can
+// produce its summary metrics without keeping the equity/return curves
+// (BacktestConfig::resultDetail = ResultDetail::SummaryOnly).
+
+// P-square quantile estimator (Jain & Chlamtac, 1985): tracks one quantile
+// of a stream with five markers. Exact for the first five observations
+// (same index rule as Backtester's sorted VaR), approximate afterwards.
+class P2Quantile {
+public:
+    explicit P2Quantile(double p = 0.5) : p_(p) {}
+
+    void reset(double p) {
+        p_ = p;
+        n_ = 0;
+    }
+
+    size_t count() const { return n_; }
+
+    void add(double x) {
+        if (n_ < 5) {
+            // Insertion into the sorted initial sample
+            size_t i = n_++;
+            while (i > 0 && q_[i - 1] > x) {
+                q_[i] = q_[i - 1];
+                --i;
+            }
+            q_[i] = x;
+            if (n_ == 5) {
+                for (int k = 0; k < 5; ++k) pos_[k] = k + 1;
+                desired_ = {1.0, 1.0 + 2.0 * p_, 1.0 + 4.0 * p_, 3.0 + 2.0 * p_, 5.0};
+                step_ = {0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+            }
+            return;
+        }
+        ++n_;
+
+        // Cell containing x (extending the extremes if needed)
+        int k;
+        if (x < q_[0]) {
+            q_[0] = x;
+            k = 0;
+        } else if (x >= q_[4]) {
+            q_[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (k < 3 && x >= q_[k + 1]) ++k;
+        }
+
+        for (int i = k + 1; i < 5; ++i) pos_[i] += 1.0;
+        for (int i = 0; i < 5; ++i) desired_[i] += step_[i];
+
+        // Move the middle markers towards their desired positions
+        for (int i = 1; i <= 3; ++i) {
+            double d = desired_[i] - pos_[i];
+            if ((d >= 1.0 && pos_[i + 1] - pos_[i] > 1.0) ||
+                (d <= -1.0 && pos_[i - 1] - pos_[i] < -1.0)) {
+                int s = d > 0 ? 1 : -1;
+                double candidate = parabolic(i, s);
+                if (q_[i - 1] < candidate && candidate < q_[i + 1]) {
+                    q_[i] = candidate;
+                } else {
+                    q_[i] += s * (q_[i + s] - q_[i]) / (pos_[i + s] - pos_[i]);
+                }
+                pos_[i] += s;
+            }
+        }
+    }
+
+    double value() const {
+        if (n_ == 0) return 0.0;
+        if (n_ < 5) {
+            size_t idx = std::min(static_cast<size_t>(p_ * n_), n_ - 1);
+            return q_[idx];
+        }
+        return q_[2];
+    }
+
+private:
+    double parabolic(int i, int s) const {
+        double span = pos_[i + 1] - pos_[i - 1];
+        double right = (pos_[i] - pos_[i - 1] + s) * (q_[i + 1] - q_[i]) / (pos_[i + 1] - pos_[i]);
+        double left = (pos_[i + 1] - pos_[i] - s) * (q_[i] - q_[i - 1]) / (pos_[i] - pos_[i - 1]);
+        return q_[i] + s * (right + left) / span;
+    }
+
+    double p_;
+    size_t n_ = 0;
+    std::array<double, 5> q_{};         // Marker heights
+    std::array<double, 5> pos_{};       // Actual marker positions (1-based)
+    std::array<double, 5> desired_{};   // Desired marker positions
+    std::array<double, 5> step_{};      // Desired position increments
+};
+
+// Return-series statistics in the form the Sharpe/Sortino/volatility and
+// VaR/CVaR formulas need. Built exactly from a stored curve or read from a
+// MetricsAccumulator.
+struct ReturnStats {
+    size_t count = 0;
+    double mean = 0.0;
+    double sumSquaredDeviation = 0.0;   // sum((r - mean)^2)
+    double downsideSumSquared = 0.0;    // sum((r - rf)^2) over r < rf
+    int downsideCount = 0;
+    double valueAtRisk = 0.0;           // Loss at the tail quantile (positive)
+    double conditionalVaR = 0.0;        // Mean loss beyond it (positive)
+
+    double sampleVariance() const {
+        return count > 1 ? sumSquaredDeviation / (count - 1) : 0.0;
+    }
+};
+
+// Online accumulator for one simulation
+class MetricsAccumulator {
+public:
+    static constexpr double kTailProbability = 0.05;   // 95% VaR/CVaR
+    static constexpr int kTailSlices = 4;               // Quantiles averaged for CVaR
+
+    MetricsAccumulator() { reset(0.0); }
+
+    void reset(double dailyRiskFree) {
+        dailyRiskFree_ = dailyRiskFree;
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        downsideSumSquared_ = 0.0;
+        downsideCount_ = 0;
+        varQuantile_.reset(kTailProbability);
+        for (int k = 0; k < kTailSlices; ++k) {
+            tailQuantiles_[k].reset(kTailProbability * (k + 0.5) / kTailSlices);
+        }
+
+        peakEquity_ = 0.0f;
+        drawdownStartBar_ = -1;
+        longestDrawdown_ = 0.0f;
+        maxDrawdown_ = 0.0;
+    }
+
+    // --- Returns: Welford mean/variance, downside deviation, tail quantiles ---
+    void addReturn(double r) {
+        ++count_;
+        double delta = r - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (r - mean_);
+
+        if (r < dailyRiskFree_) {
+            downsideSumSquared_ += (r - dailyRiskFree_) * (r - dailyRiskFree_);
+            downsideCount_++;
+        }
+
+        varQuantile_.add(r);
+        for (auto& q : tailQuantiles_) q.add(r);
+    }
+
+    ReturnStats returnStats() const {
+        ReturnStats stats;
+        stats.count = count_;
+        stats.mean = mean_;
+        stats.sumSquaredDeviation = m2_;
+        stats.downsideSumSquared = downsideSumSquared_;
+        stats.downsideCount = downsideCount_;
+        if (count_ > 0) {
+            stats.valueAtRisk = -varQuantile_.value();
+            // CVaR = average of the quantile function over the tail
+            double tail = 0.0;
+            for (const auto& q : tailQuantiles_) tail += q.value();
+            stats.conditionalVaR = -tail / kTailSlices;
+        }
+        return stats;
+    }
+
+    // --- Drawdown: peak tracking and longest drawdown, in the kernel's float
+    // precision. Returns the drawdown at this bar.
+    void startEquity(float equity) { peakEquity_ = equity; }
+
+    float addEquity(float equity, int bar) {
+        if (equity > peakEquity_) {
+            peakEquity_ = equity;
+            drawdownStartBar_ = -1;
+        }
+        float drawdown = (peakEquity_ - equity) / peakEquity_;
+
+        if (drawdown > maxDrawdown_) {
+            maxDrawdown_ = drawdown;
+        }
+
+        if (drawdown > 0 && drawdownStartBar_ < 0) {
+            drawdownStartBar_ = bar;
+        } else if (drawdown == 0 && drawdownStartBar_ >= 0) {
+            longestDrawdown_ = std::max(longestDrawdown_, (float)(bar - drawdownStartBar_));
+            drawdownStartBar_ = -1;
+        }
+        return drawdown;
+    }
+
+    double maxDrawdown() const { return maxDrawdown_; }
+    float longestDrawdown() const { return longestDrawdown_; }
+
+private:
+    double dailyRiskFree_ = 0.0;
+    size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double downsideSumSquared_ = 0.0;
+    int downsideCount_ = 0;
+    P2Quantile varQuantile_;
+    std::array<P2Quantile, kTailSlices> tailQuantiles_;
+
+    float peakEquity_ = 0.0f;
+    int drawdownStartBar_ = -1;
+    float longestDrawdown_ = 0.0f;
+    double maxDrawdown_ = 0.0;
+};
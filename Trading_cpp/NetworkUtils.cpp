@@ -2,28 +2,25 @@
 #include "Cache.h"
 #include "Result.h"
 #include "json.hpp"
+#include "HttpEngine.h"
+#include "ResponseStore.h"
 #include <iostream>
-#include <fstream>
 #include <sstream>
-#include <thread>
 #include <chrono>
 #include <map>
-#include <filesystem>
 #include <functional>
 #include <regex>
 #include <ctime>
 #include <iomanip>
-
-#ifdef ENABLE_CURL
-#include <curl/curl.h>
-#endif
+#include <memory>
+#include <mutex>
 
 namespace NetworkUtils {
 
 // Global state
 static std::map<std::string, std::string> apiKeys;
 static LRUCache<std::string, std::string> responseCache(200, std::chrono::seconds(300));
-static RateLimiter rateLimiter(60, std::chrono::seconds(60), std::chrono::milliseconds(100));
+static SingleFlight<std::string, Result<std::string>> inFlight;
 
 // Extract domain from URL
 static std::string extractDomain(const std::string& url) {
@@ -57,177 +54,150 @@ std::string getApiKey(const std::string& service) {
     return "";  // No default fallback for security
 }
 
-#ifdef ENABLE_CURL
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    size_t totalSize = size * nmemb;
-    userp->append((char*)contents, totalSize);
-    return totalSize;
-}
-
+// Every request goes through the shared HttpEngine, so concurrent callers
+// reuse its open connections instead of handshaking per request. Its
+// scheduler applies the per-domain rate limit and the retry backoff without
+// a thread sleeping on either.
 static Result<std::string> performCurlRequest(const std::string& url,
                                               const std::vector<std::string>& headers,
                                               bool isPost = false,
-                                              const std::string& payload = "") {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return Result<std::string>::err(Error::internal("Failed to initialize CURL"));
-    }
+                                              const std::string& payload = "",
+                                              int maxAttempts = 1) {
+    HttpRequest request;
+    request.url = url;
+    request.headers = headers;
+    request.post = isPost;
+    request.payload = payload;
+    request.rateDomain = extractDomain(url);
+    request.maxAttempts = maxAttempts;
+    return HttpEngine::shared().fetch(std::move(request)).get();
+}
 
-    std::string readBuffer;
-    CURLcode res;
+// Responses outlive the process in one indexed file shared by every
+// process of the bot (instead of a file per URL)
+static ResponseStore& responseStore() {
+    static ResponseStore store(".cache/responses.store");
+    return store;
+}
 
-    struct curl_slist* chunk = NULL;
-    for (const auto& h : headers) {
-        chunk = curl_slist_append(chunk, h.c_str());
-    }
-    if (chunk) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
-    }
+// Cached response for a URL (in memory, then on disk) younger than
+// cacheDurationSeconds
+static std::shared_ptr<const std::string> cachedResponse(const std::string& url, int cacheDurationSeconds) {
+    if (cacheDurationSeconds <= 0) return nullptr;
 
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    // Use a modern Chrome User-Agent
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36");
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 15L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-
-    if (isPost) {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.c_str());
+    std::string cacheKey = hashUrl(url);
+    if (auto cached = responseCache.get(cacheKey)) {
+        return cached;
     }
 
-    res = curl_easy_perform(curl);
-
-    long httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+    // Persistent cache for longer-term caching
+    if (auto stored = responseStore().get(url, std::chrono::seconds(cacheDurationSeconds))) {
+        auto data = std::make_shared<const std::string>(std::move(*stored));
 
-    curl_easy_cleanup(curl);
-    if (chunk) {
-        curl_slist_free_all(chunk);
+        // Also update in-memory cache
+        responseCache.put(cacheKey, data, std::chrono::seconds(cacheDurationSeconds));
+        return data;
     }
+    return nullptr;
+}
 
-    if (res != CURLE_OK) {
-        std::string errorMsg = curl_easy_strerror(res);
-        if (res == CURLE_OPERATION_TIMEDOUT) {
-            return Result<std::string>::err(Error::timeout(url));
-        }
-        return Result<std::string>::err(Error::network(errorMsg));
-    }
+static void storeResponse(const std::string& url, const std::string& data, int cacheDurationSeconds) {
+    // In-memory cache
+    responseCache.put(hashUrl(url), data, std::chrono::seconds(cacheDurationSeconds));
 
-    if (httpCode == 429) {
-        return Result<std::string>::err(Error::rateLimit("HTTP 429 received"));
-    }
+    // Persistent cache (a failed write only costs a refetch later)
+    responseStore().put(url, data, std::chrono::seconds(cacheDurationSeconds));
+}
 
-    if (httpCode == 401 || httpCode == 403) {
-        return Result<std::string>::err(Error::auth("HTTP " + std::to_string(httpCode)));
-    }
+// Enhanced fetch with caching, rate limiting, and Result type
+// Steps 3-5 of fetchDataWithResult: the upstream request itself
+static Result<std::string> fetchUncached(const std::string& url,
+                                         int cacheDurationSeconds,
+                                         const std::vector<std::string>& headers) {
+    // 3-4. Rate limited fetch with retry (exponential backoff from 1 s; auth
+    // errors are not retried)
+    Result<std::string> result = performCurlRequest(url, headers, false, "", 3);
 
-    if (httpCode >= 400) {
-        return Result<std::string>::err(Error::network("HTTP " + std::to_string(httpCode)));
+    // 5. Cache successful response
+    if (result.isOk() && cacheDurationSeconds > 0) {
+        storeResponse(url, result.value(), cacheDurationSeconds);
+    } else if (result.isError()) {
+        std::cerr << "[Network Error] " << url << " : " << result.error().message << std::endl;
     }
 
-    return Result<std::string>::ok(readBuffer);
+    return result;
 }
 
-#else
-static Result<std::string> performCurlRequest(const std::string& url,
-                                              const std::vector<std::string>& headers,
-                                              bool isPost = false,
-                                              const std::string& payload = "") {
-    (void)url; (void)headers; (void)isPost; (void)payload;
-    return Result<std::string>::err(Error::internal("CURL not enabled"));
+// Requests are coalesced per URL and header set
+static std::string flightKey(const std::string& url, const std::vector<std::string>& headers) {
+    std::string key = url;
+    for (const auto& h : headers) key += "\n" + h;
+    return key;
 }
-#endif
 
-// Enhanced fetch with caching, rate limiting, and Result type
 Result<std::string> fetchDataWithResult(const std::string& url,
                                         int cacheDurationSeconds,
                                         const std::vector<std::string>& headers) {
-    // 1. Check in-memory cache first
-    std::string cacheKey = hashUrl(url);
-    if (cacheDurationSeconds > 0) {
-        auto cached = responseCache.get(cacheKey);
-        if (cached) {
-            return Result<std::string>::ok(*cached);
-        }
+    // 1-2. In-memory cache, then file cache
+    if (auto cached = cachedResponse(url, cacheDurationSeconds)) {
+        return Result<std::string>::ok(*cached);
     }
 
-    // 2. Check file cache for longer-term caching
-    std::string cacheDir = ".cache";
-    std::string cacheFile = cacheDir + "/" + cacheKey + ".json";
-
-    if (cacheDurationSeconds > 0 && std::filesystem::exists(cacheFile)) {
-        auto lastWrite = std::filesystem::last_write_time(cacheFile);
-        auto now = std::filesystem::file_time_type::clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - lastWrite).count();
-
-        if (duration < cacheDurationSeconds) {
-            std::ifstream ifs(cacheFile);
-            std::stringstream buffer;
-            buffer << ifs.rdbuf();
-            std::string data = buffer.str();
-
-            // Also update in-memory cache
-            responseCache.put(cacheKey, data, std::chrono::seconds(cacheDurationSeconds));
-
-            return Result<std::string>::ok(data);
+    // Concurrent misses for the same request share one upstream fetch
+    return inFlight.run(flightKey(url, headers), [&] {
+        // A fetch that finished since the lookup above may have filled the cache
+        if (cacheDurationSeconds > 0) {
+            if (auto cached = responseCache.get(hashUrl(url))) {
+                return Result<std::string>::ok(*cached);
+            }
         }
-    }
-
-    // 3. Apply rate limiting
-    std::string domain = extractDomain(url);
-    rateLimiter.waitForAllowance(domain);
-
-    // 4. Fetch with retry (exponential backoff)
-    int retries = 3;
-    int waitTimeSeconds = 1;
-    Result<std::string> result = Result<std::string>::err(Error::network("Request failed"));
-
-    for (int i = 0; i < retries; ++i) {
-        result = performCurlRequest(url, headers);
+        return fetchUncached(url, cacheDurationSeconds, headers);
+    });
+}
 
-        if (result.isOk()) {
-            break;
-        }
+CoalescingStats coalescingStats() {
+    auto stats = inFlight.stats();
+    return {stats.calls, stats.coalesced};
+}
 
-        // Don't retry on auth errors
-        if (result.error().code == Error::AuthError) {
-            break;
-        }
+void resetCoalescingStats() {
+    inFlight.resetStats();
+}
 
-        // Don't retry on rate limit (wait instead) - though performCurlRequest returns 429 as RateLimitError
-        if (result.error().code == Error::RateLimitError) {
-            std::this_thread::sleep_for(std::chrono::seconds(waitTimeSeconds));
-            waitTimeSeconds *= 2;
+// Many URLs at once: cache hits are served directly and the misses go out
+// together through the shared HttpEngine
+std::vector<Result<std::string>> fetchAllWithResult(const std::vector<std::string>& urls,
+                                                    int cacheDurationSeconds,
+                                                    const std::vector<std::string>& headers) {
+    std::vector<Result<std::string>> results(urls.size(), Result<std::string>::err(Error::network("Request failed")));
+    std::vector<size_t> misses;
+    std::vector<HttpRequest> requests;
+
+    for (size_t i = 0; i < urls.size(); ++i) {
+        if (auto cached = cachedResponse(urls[i], cacheDurationSeconds)) {
+            results[i] = Result<std::string>::ok(*cached);
             continue;
         }
-
-        if (i < retries - 1) {
-            std::this_thread::sleep_for(std::chrono::seconds(waitTimeSeconds));
-            waitTimeSeconds *= 2;
-        }
+        // Queued behind the domain's rate limit in the engine, not here
+        HttpRequest request;
+        request.url = urls[i];
+        request.headers = headers;
+        request.rateDomain = extractDomain(urls[i]);
+        requests.push_back(std::move(request));
+        misses.push_back(i);
     }
 
-    // 5. Cache successful response
-    if (result.isOk() && cacheDurationSeconds > 0) {
-        std::string data = result.value();
-
-        // In-memory cache
-        responseCache.put(cacheKey, data, std::chrono::seconds(cacheDurationSeconds));
-
-        // File cache
-        if (!std::filesystem::exists(cacheDir)) {
-            std::filesystem::create_directory(cacheDir);
+    auto fetched = HttpEngine::shared().fetchAll(std::move(requests));
+    for (size_t k = 0; k < misses.size(); ++k) {
+        const std::string& url = urls[misses[k]];
+        if (fetched[k].isOk() && cacheDurationSeconds > 0) {
+            storeResponse(url, fetched[k].value(), cacheDurationSeconds);
+        } else if (fetched[k].isError()) {
+            std::cerr << "[Network Error] " << url << " : " << fetched[k].error().message << std::endl;
         }
-        std::ofstream ofs(cacheFile);
-        ofs << data;
-    } else if (result.isError()) {
-        std::cerr << "[Network Error] " << url << " : " << result.error().message << std::endl;
+        results[misses[k]] = std::move(fetched[k]);
     }
-
-    return result;
+    return results;
 }
 
 // Original interface maintained for backward compatibility
@@ -241,18 +211,7 @@ std::string fetchData(const std::string& url, int cacheDurationSeconds,
 Result<std::string> postDataWithResult(const std::string& url,
                                        const std::string& payload,
                                        const std::vector<std::string>& headers) {
-    std::string domain = extractDomain(url);
-
-    // Rate limiting
-    auto waitTime = rateLimiter.getWaitTime(domain);
-    if (waitTime.count() > 0) {
-        std::this_thread::sleep_for(waitTime);
-    }
-
-    if (!rateLimiter.allowRequest(domain)) {
-        return Result<std::string>::err(Error::rateLimit("Rate limit for " + domain));
-    }
-
+    // Rate limited like fetches (queued, not refused)
     return performCurlRequest(url, headers, true, payload);
 }
 
@@ -278,90 +237,53 @@ void setCacheTTL(int seconds) {
 
 // Rate limiter configuration
 void setRateLimit(const std::string& domain, int requestsPerMinute) {
-    // Note: Current implementation uses global settings
-    // A more sophisticated version would have per-domain settings
-    (void)domain;
-    (void)requestsPerMinute;
+    // Bursts of up to 10 requests (or 10 s worth, if fewer)
+    double perSecond = requestsPerMinute / 60.0;
+    HttpEngine::shared().setRateLimit(domain, {perSecond, std::clamp(perSecond * 10.0, 1.0, 10.0)});
 }
 
-#ifdef ENABLE_CURL
-
 // Yahoo-specific: Get crumb token for Yahoo Finance API
 // Yahoo requires a crumb token to be included in chart API requests
 // This function fetches and caches the crumb
 std::string getYahooCrumb() {
+    static std::mutex crumbMutex;
     static std::string cachedCrumb;
     static std::chrono::steady_clock::time_point lastFetchTime;
     auto now = std::chrono::steady_clock::now();
 
     // Cache crumb for 1 hour
-    if (!cachedCrumb.empty()) {
-        auto duration = std::chrono::duration_cast<std::chrono::minutes>(now - lastFetchTime).count();
-        if (duration < 60) {
-            return cachedCrumb;
+    {
+        std::lock_guard<std::mutex> lock(crumbMutex);
+        if (!cachedCrumb.empty()) {
+            auto duration = std::chrono::duration_cast<std::chrono::minutes>(now - lastFetchTime).count();
+            if (duration < 60) {
+                return cachedCrumb;
+            }
         }
     }
 
-    // Fetch new crumb from Yahoo
+    // Fetch new crumb from Yahoo (callers that miss together share the request)
     std::string url = "https://query1.finance.yahoo.com/v1/test/getcrumb";
     std::vector<std::string> headers = {
         "Accept: */*"
     };
 
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return "";
-    }
-
-    std::string readBuffer;
-    struct curl_slist* chunk = NULL;
-    for (const auto& h : headers) {
-        chunk = curl_slist_append(chunk, h.c_str());
-    }
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36");
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 15L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    if (chunk) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk);
-    }
-
-    CURLcode res = curl_easy_perform(curl);
-
-    long httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-
-    curl_easy_cleanup(curl);
-    if (chunk) {
-        curl_slist_free_all(chunk);
-    }
-
-    if (res == CURLE_OK && httpCode == 200 && !readBuffer.empty()) {
-        // The crumb is returned as a plain string (not JSON)
-        cachedCrumb = readBuffer;
-        // Trim whitespace/newlines
-        cachedCrumb.erase(std::remove_if(cachedCrumb.begin(), cachedCrumb.end(),
-            [](char c) { return c == '\n' || c == '\r' || c == ' '; }), cachedCrumb.end());
+    std::string crumb = inFlight.run(flightKey(url, headers), [&] {
+        return performCurlRequest(url, headers);
+    }).valueOr("");
+
+    // The crumb is returned as a plain string (not JSON)
+    // Trim whitespace/newlines
+    crumb.erase(std::remove_if(crumb.begin(), crumb.end(),
+        [](char c) { return c == '\n' || c == '\r' || c == ' '; }), crumb.end());
+    if (!crumb.empty()) {
+        std::lock_guard<std::mutex> lock(crumbMutex);
+        cachedCrumb = crumb;
         lastFetchTime = now;
-        return cachedCrumb;
     }
-
-    return "";
+    return crumb;
 }
 
-#else
-
-// Stub for when CURL is not enabled
-std::string getYahooCrumb() {
-    return "";
-}
-
-#endif
-
 // Fetch next earnings date for a symbol (returns ISO date string or empty)
 std::string fetchEarningsDate(const std::string& symbol) {
     using json = nlohmann::json;
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "Result.h"
@@ -14,6 +15,22 @@ namespace NetworkUtils {
                                             int cacheDurationSeconds = 300,
                                             const std::vector<std::string>& headers = {});
 
+    // Fetch many URLs concurrently (cache and rate limiting as above, no
+    // retries); results in URL order
+    std::vector<Result<std::string>> fetchAllWithResult(const std::vector<std::string>& urls,
+                                                        int cacheDurationSeconds = 300,
+                                                        const std::vector<std::string>& headers = {});
+
+    // Concurrent fetchDataWithResult calls for the same request share one
+    // upstream fetch: upstreamFetches counts the fetches that ran (cache
+    // misses), coalescedHits the callers that waited on another's instead
+    struct CoalescingStats {
+        uint64_t upstreamFetches = 0;
+        uint64_t coalescedHits = 0;
+    };
+    CoalescingStats coalescingStats();
+    void resetCoalescingStats();
+
     // Send HTTP POST request
     std::string postData(const std::string& url, const std::string& payload,
                          const std::vector<std::string>& headers);
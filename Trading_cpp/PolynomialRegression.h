@@ -0,0 +1,246 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Least-squares polynomial fits of fixed degree.
+//
+// Everything is sized by the Degree template parameter: the normal equations
+// are (Degree + 1)^2 values on the stack, solved by Cholesky, and every loop
+// has a compile-time trip count, so the common degrees 1-3 compile to
+// straight-line code. Positions are mapped to t = (x - center) / scale in
+// [-1, 1] before taking powers, which keeps the normal equations well
+// conditioned (raw x^6 sums reach 1e13 for a 120-bar window).
+
+namespace PolyRegression {
+
+template <int M>
+using Matrix = std::array<std::array<double, M>, M>;
+
+// In-place Cholesky factorization A = L L^T of a symmetric positive definite
+// matrix (only the lower triangle is read; L replaces it). Returns false if A
+// is not numerically positive definite.
+template <int M>
+bool choleskyFactor(Matrix<M>& A) {
+    for (int j = 0; j < M; ++j) {
+        double diag = A[j][j];
+        for (int k = 0; k < j; ++k) diag -= A[j][k] * A[j][k];
+        if (!(diag > 1e-12 * std::abs(A[j][j]))) return false;
+        A[j][j] = std::sqrt(diag);
+        for (int i = j + 1; i < M; ++i) {
+            double v = A[i][j];
+            for (int k = 0; k < j; ++k) v -= A[i][k] * A[j][k];
+            A[i][j] = v / A[j][j];
+        }
+    }
+    return true;
+}
+
+// Solve L L^T z = b in place, given the factor from choleskyFactor
+template <int M>
+void choleskySubstitute(const Matrix<M>& L, std::array<double, M>& b) {
+    for (int i = 0; i < M; ++i) {
+        for (int k = 0; k < i; ++k) b[i] -= L[i][k] * b[k];
+        b[i] /= L[i][i];
+    }
+    for (int i = M - 1; i >= 0; --i) {
+        for (int k = i + 1; k < M; ++k) b[i] -= L[k][i] * b[k];
+        b[i] /= L[i][i];
+    }
+}
+
+// Polynomial in t = (x - center) / scale
+template <int Degree>
+struct Fit {
+    std::array<double, Degree + 1> beta{};
+    double center = 0.0;
+    double scale = 1.0;
+    bool valid = false;
+
+    double at(double x) const {
+        double t = (x - center) / scale;
+        double y = 0.0;
+        for (int k = Degree; k >= 0; --k) y = y * t + beta[k];
+        return y;
+    }
+};
+
+// Normal-equation matrix from the position power sums: A[i][j] = P[i + j]
+template <int Degree>
+Matrix<Degree + 1> normalMatrix(const std::array<double, 2 * Degree + 1>& P) {
+    Matrix<Degree + 1> A;
+    for (int i = 0; i <= Degree; ++i)
+        for (int j = 0; j <= Degree; ++j) A[i][j] = P[i + j];
+    return A;
+}
+
+// Fit y[i] against x = i for the whole series
+template <int Degree>
+Fit<Degree> fit(std::span<const double> y) {
+    Fit<Degree> result;
+    if (y.size() < Degree + 1) return result;
+
+    double center = (y.size() - 1) / 2.0;
+    double scale = center > 0 ? center : 1.0;
+    std::array<double, 2 * Degree + 1> P{};
+    std::array<double, Degree + 1> S{};
+    for (size_t i = 0; i < y.size(); ++i) {
+        double t = (i - center) / scale;
+        double power = 1.0;
+        for (int k = 0; k <= 2 * Degree; ++k) {
+            P[k] += power;
+            if (k <= Degree) S[k] += power * y[i];
+            power *= t;
+        }
+    }
+    Matrix<Degree + 1> L = normalMatrix<Degree>(P);
+    result.center = center;
+    result.scale = scale;
+    result.beta = S;
+    result.valid = choleskyFactor<Degree + 1>(L);
+    if (result.valid) choleskySubstitute<Degree + 1>(L, result.beta);
+    return result;
+}
+
+}  // namespace PolyRegression
+
+// Polynomial fit over the last `window` values, updated per bar.
+//
+// Keeps the power sums S[k] = sum(t^k * y) of the full window. When the
+// window slides, the oldest point leaves and every position moves one step
+// left, which re-expands the sums binomially: O(Degree^2) per bar,
+// independent of the window length. The position sums, and so the Cholesky
+// factor of the normal equations, never change once the window is full; each
+// bar is then two triangular substitutions. The y sums are re-added from the
+// buffer once per window length so rounding cannot accumulate. While the
+// window is still filling, the partial history is simply refitted.
+//
+// value(horizon) matches forecastPricePoly(last window values, horizon, Degree)
+// up to rounding; nothing is allocated after reset().
+template <int Degree>
+class RollingPolyFit {
+public:
+    explicit RollingPolyFit(int window = 60) { reset(window); }
+
+    void reset(int window) {
+        window_ = std::max(Degree + 1, window);
+        values_.assign(window_, 0.0);
+        head_ = 0;
+        count_ = 0;
+        slidesSinceResum_ = 0;
+        center_ = (window_ - 1) / 2.0;
+        scale_ = center_;
+        fit_ = {};
+        factored_ = false;
+    }
+
+    void update(double y) {
+        if (count_ < (size_t)window_) {
+            values_[count_++] = y;
+            if (count_ < (size_t)window_) {
+                fit_ = PolyRegression::fit<Degree>(std::span<const double>(values_.data(), count_));
+                return;
+            }
+
+            // Window just filled: factor its normal equations once
+            std::array<double, 2 * Degree + 1> P{};
+            for (int x = 0; x < window_; ++x) {
+                double power = 1.0;
+                for (int k = 0; k <= 2 * Degree; ++k) {
+                    P[k] += power;
+                    power *= position(x);
+                }
+            }
+            factor_ = PolyRegression::normalMatrix<Degree>(P);
+            factored_ = PolyRegression::choleskyFactor<M>(factor_);
+            resum();
+        } else {
+            // Sliding: drop x = 0, shift everything left, add at x = window - 1
+            double oldest = values_[head_];
+            values_[head_] = y;
+            head_ = (head_ + 1) % window_;
+
+            if (++slidesSinceResum_ >= window_) {
+                resum();
+            } else {
+                accumulate(position(0), -oldest);
+                shift();
+                accumulate(position(window_ - 1), y);
+            }
+        }
+
+        fit_.center = center_;
+        fit_.scale = scale_;
+        fit_.valid = factored_;
+        fit_.beta = S_;
+        if (factored_) PolyRegression::choleskySubstitute<M>(factor_, fit_.beta);
+    }
+
+    bool ready() const { return fit_.valid; }
+    size_t size() const { return count_; }
+
+    // Fitted value `horizon` bars after the newest (0 = the fit at the newest
+    // bar); the newest value until the fit is determined
+    double value(int horizon) const {
+        if (!fit_.valid) return count_ > 0 ? newest() : 0.0;
+        return fit_.at(static_cast<double>(count_ - 1 + horizon));
+    }
+
+    // Current fit in window-relative positions (x = 0 is the oldest value)
+    const PolyRegression::Fit<Degree>& fit() const { return fit_; }
+
+private:
+    static constexpr int M = Degree + 1;
+
+    double position(size_t x) const { return (x - center_) / scale_; }
+
+    double newest() const {
+        return count_ < (size_t)window_ ? values_[count_ - 1] : values_[(head_ + window_ - 1) % window_];
+    }
+
+    // S[k] += t^k * y
+    void accumulate(double t, double y) {
+        double power = 1.0;
+        for (int k = 0; k < M; ++k) {
+            S_[k] += power * y;
+            power *= t;
+        }
+    }
+
+    // Positions move from t to t - step: S[k] <- sum_j C(k, j) (-step)^(k-j) S[j]
+    void shift() {
+        double step = 1.0 / scale_;
+        std::array<double, M> shifted{};
+        for (int k = 0; k < M; ++k) {
+            double binom = 1.0;
+            double stepPower = 1.0;
+            for (int j = k; j >= 0; --j) {
+                shifted[k] += binom * stepPower * S_[j];
+                binom = binom * j / (k - j + 1);
+                stepPower *= -step;
+            }
+        }
+        S_ = shifted;
+    }
+
+    void resum() {
+        slidesSinceResum_ = 0;
+        S_.fill(0.0);
+        for (int x = 0; x < window_; ++x) accumulate(position(x), values_[(head_ + x) % window_]);
+    }
+
+    int window_ = 60;
+    std::vector<double> values_;
+    size_t head_ = 0;      // Oldest value once full
+    size_t count_ = 0;
+    int slidesSinceResum_ = 0;
+    double center_ = 0.0;  // Full-window position mapping
+    double scale_ = 1.0;
+    std::array<double, M> S_{};
+    PolyRegression::Matrix<M> factor_{};
+    bool factored_ = false;
+    PolyRegression::Fit<Degree> fit_;
+};
@@ -50,10 +50,14 @@ public:
         float initialValue = config_.baseConfig.initialCapital;
         float peakValue = initialValue;
 
-        // Generate signals per asset
+        // Generate signals per asset. Each asset's history grows by one bar
+        // per step in a buffer kept here (as Backtester::run does), so the
+        // strategies are fed without copying the whole prefix every bar.
         std::map<std::string, std::unique_ptr<IStrategy>> assetStrategies;
+        std::map<std::string, CandleHistoryAdapter> histories;
         for (const auto& [symbol, candles] : multiAssetData) {
             assetStrategies[symbol] = strategy.clone();
+            histories.try_emplace(symbol, candles.size());
         }
 
         // Main backtest loop
@@ -73,8 +77,8 @@ public:
             // Generate signals for each asset
             std::map<std::string, StrategySignal> signals;
             for (const auto& [symbol, candles] : multiAssetData) {
-                std::vector<Candle> history(candles.begin(), candles.begin() + i + 1);
-                signals[symbol] = assetStrategies[symbol]->generateSignal(history, i);
+                signals[symbol] = assetStrategies[symbol]->generateSignal(
+                    histories.at(symbol).sync(CandleView(candles.data(), i + 1)), i);
             }
 
             // Calculate target allocation based on signals
@@ -141,6 +145,11 @@ public:
         std::vector<float> equityCurve;
         float peakValue = config_.baseConfig.initialCapital;
 
+        std::map<std::string, CandleHistoryAdapter> histories;
+        for (const auto& [symbol, candles] : multiAssetData) {
+            histories.try_emplace(symbol, candles.size());
+        }
+
         for (size_t i = maxWarmup; i < minLength; ++i) {
             std::map<std::string, float> currentPrices;
             std::string currentDate;
@@ -155,8 +164,8 @@ public:
             for (const auto& [symbol, strategy] : assetStrategies) {
                 if (multiAssetData.count(symbol)) {
                     const auto& candles = multiAssetData.at(symbol);
-                    std::vector<Candle> history(candles.begin(), candles.begin() + i + 1);
-                    signals[symbol] = strategy->generateSignal(history, i);
+                    signals[symbol] = strategy->generateSignal(
+                        histories.at(symbol).sync(CandleView(candles.data(), i + 1)), i);
                 }
             }
 
@@ -1,5 +1,7 @@
 #include "Providers.h"
 #include "NetworkUtils.h"
+#include "HistoryStore.h"
+#include "YahooChartParser.h"
 #include "json.hpp"
 #include <algorithm>
 #include <iostream>
@@ -36,6 +38,17 @@ static std::string getYahooRange(std::chrono::minutes barSize, int numDays = 60)
     return "2y";
 }
 
+// Length of a Yahoo interval string ("15m", "1d") in seconds
+static int64_t getYahooIntervalSeconds(const std::string& interval) {
+    int64_t count = std::stoll(interval);
+    return interval.back() == 'd' ? count * 86400 : count * 60;
+}
+
+// History kept locally per bar size: as far back as getYahooRange reaches
+static std::chrono::seconds getHistoryWindow(std::chrono::minutes barSize) {
+    return std::chrono::hours(24) * (barSize.count() <= 60 ? 60 : 730);
+}
+
 std::string YahooPriceProvider::buildYahooUrl(
     const std::string& symbol,
     const std::string& interval,
@@ -51,61 +64,35 @@ std::string YahooPriceProvider::buildYahooUrl(
     return url;
 }
 
+std::string YahooPriceProvider::buildYahooUrl(
+    const std::string& symbol,
+    const std::string& interval,
+    TimePoint from,
+    TimePoint to
+) {
+    std::string ySymbol = formatYahooSymbol(symbol);
+    std::string crumb = NetworkUtils::getYahooCrumb();
+    std::string url = "https://query1.finance.yahoo.com/v8/finance/chart/" + ySymbol +
+           "?interval=" + interval + "&period1=" + std::to_string(TimeUtils::toUnixSeconds(from)) +
+           "&period2=" + std::to_string(TimeUtils::toUnixSeconds(to)) + "&includePrePost=false";
+    if (!crumb.empty()) {
+        url += "&crumb=" + crumb;
+    }
+    return url;
+}
+
 std::vector<Candle> YahooPriceProvider::parseYahooResponse(const std::string& response) {
     std::vector<Candle> candles;
     if (response.empty()) return candles;
 
-    try {
-        json data = json::parse(response);
-        if (data.contains("chart") && data["chart"].contains("result")) {
-            auto result = data["chart"]["result"];
-            if (!result.is_null() && !result.empty()) {
-                auto quoteData = result[0];
-                if (quoteData.contains("timestamp") && quoteData.contains("indicators")) {
-                    auto timestamps = quoteData["timestamp"];
-                    auto indicators = quoteData["indicators"]["quote"][0];
-
-                    if (timestamps.is_array() && indicators.contains("close")) {
-                        size_t len = timestamps.size();
-                        auto closes = indicators["close"];
-                        auto opens = indicators.contains("open") ? indicators["open"] : closes;
-                        auto highs = indicators.contains("high") ? indicators["high"] : closes;
-                        auto lows = indicators.contains("low") ? indicators["low"] : closes;
-                        auto volumes = indicators.contains("volume") ? indicators["volume"] : json::array();
-
-                        for (size_t i = 0; i < len; ++i) {
-                            // Skip null candles
-                            if (closes[i].is_null() || opens[i].is_null() ||
-                                highs[i].is_null() || lows[i].is_null()) {
-                                continue;
-                            }
-
-                            Candle c;
-                            int64_t tsValue = timestamps[i].get<int64_t>();
-                            c.ts = TimeUtils::fromUnixSeconds(tsValue);
-                            c.date = std::to_string(tsValue);
-                            c.close = closes[i].get<double>();
-                            c.open = opens[i].get<double>();
-                            c.high = highs[i].get<double>();
-                            c.low = lows[i].get<double>();
-
-                            if (!volumes.empty() && i < volumes.size() && !volumes[i].is_null()) {
-                                c.volume = volumes[i].get<int64_t>();
-                            } else {
-                                c.volume = 0;
-                            }
-
-                            candles.push_back(c);
-                        }
-                    }
-                }
-            }
-        }
-    } catch (const json::parse_error& e) {
-        std::cerr << "JSON Parse Error: " << e.what() << std::endl;
-    } catch (...) {
-        // Silent fail
+    // Streamed straight into columns (no DOM). Null o/h/l take the close, as
+    // for fetchBarColumns: both keep their history in the same archive.
+    auto parsed = YahooChart::parse(response, YahooChart::kArchivedNullPrices);
+    if (parsed.isError()) {
+        std::cerr << "JSON Parse Error: " << parsed.error().details << std::endl;
+        return candles;
     }
+    candles = parsed.value().toCandles();
 
     // Sort by timestamp
     std::sort(candles.begin(), candles.end(),
@@ -122,21 +109,42 @@ Result<std::vector<Candle>> YahooPriceProvider::getHistory(
 ) {
     std::string interval = getYahooInterval(barSize);
     std::string range = getYahooRange(barSize);
-    std::string url = buildYahooUrl(symbol, interval, range);
-
-    std::string response = NetworkUtils::fetchData(url);
-    if (response.empty()) {
+    std::string ySymbol = formatYahooSymbol(symbol);
+    int64_t intervalSeconds = getYahooIntervalSeconds(interval);
+    TimePoint now = TimeUtils::now();
+    TimePoint keepFrom = now - getHistoryWindow(barSize);
+
+    // The local history only needs the bars since its last complete one.
+    // Responses are not cached: the history archive holds them already.
+    auto plan = HistoryStore::plan(ySymbol, intervalSeconds, std::max(start, keepFrom));
+    auto fetchFull = [&]() -> std::optional<BarColumns> {
+        std::string response = NetworkUtils::fetchData(buildYahooUrl(symbol, interval, range), 0);
+        if (response.empty()) return std::nullopt;
+        return HistoryStore::replace(ySymbol, intervalSeconds, BarColumns(parseYahooResponse(response)), keepFrom);
+    };
+
+    std::optional<BarColumns> history;
+    if (plan.isDelta()) {
+        std::string response = NetworkUtils::fetchData(buildYahooUrl(symbol, interval, *plan.fetchFrom, now), 0);
+        if (response.empty()) {
+            history = std::move(plan.stored);  // Stale history beats none
+        } else {
+            BarColumns delta(parseYahooResponse(response));
+            history = HistoryStore::merge(ySymbol, intervalSeconds, std::move(plan), delta, keepFrom);
+            if (!history) history = fetchFull();  // Revised upstream
+        }
+    } else {
+        history = fetchFull();
+    }
+    if (!history) {
         return Result<std::vector<Candle>>::err(Error::network("Failed to fetch from Yahoo"));
     }
 
-    auto candles = parseYahooResponse(response);
-
     // Filter to requested range
     std::vector<Candle> filtered;
-    for (const auto& c : candles) {
-        if (c.ts >= start && c.ts <= end) {
-            filtered.push_back(c);
-        }
+    auto ts = history->timestamps();
+    for (size_t i = std::lower_bound(ts.begin(), ts.end(), start) - ts.begin(); i < ts.size() && ts[i] <= end; ++i) {
+        filtered.push_back(history->candle(i));
     }
 
     return Result<std::vector<Candle>>::ok(filtered);
@@ -80,6 +80,7 @@ public:
 
 private:
     std::string buildYahooUrl(const std::string& symbol, const std::string& interval, const std::string& range);
+    std::string buildYahooUrl(const std::string& symbol, const std::string& interval, TimePoint from, TimePoint to);
     std::vector<Candle> parseYahooResponse(const std::string& response);
 };
 
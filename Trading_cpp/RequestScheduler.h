@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "Cache.h"
+
+// Per-domain request queue in front of a RateLimiter.
+//
+// Items wait in a FIFO per domain and are released only as the domain's
+// token bucket allows, so an I/O loop can hold any number of requests
+// without a thread sleeping on the limiter: release() hands back what may
+// start now plus the exact time until the next item could, which the loop
+// uses as its wait timeout. Items may also be deferred to a later time
+// (retry backoff). Items with an empty domain are not rate limited.
+//
+// Not thread-safe: it belongs to the one thread that drives the requests.
+template<typename T>
+class RequestScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RequestScheduler(RateLimiter& limiter) : limiter_(limiter) {}
+
+    // Queue an item; it is not released before notBefore
+    void push(const std::string& domain, T item, Clock::time_point notBefore = {}) {
+        if (notBefore > Clock::time_point{}) {
+            delayed_.push_back(Delayed{notBefore, sequence_++, domain, std::move(item)});
+            std::push_heap(delayed_.begin(), delayed_.end(), later);
+        } else {
+            queues_[domain].push_back(std::move(item));
+        }
+        ++pending_;
+    }
+
+    // Append every item that may start at `now` to `ready` (FIFO within a
+    // domain). Returns the time until the next release could happen, or
+    // Clock::duration::max() when nothing is waiting.
+    Clock::duration release(Clock::time_point now, std::vector<T>& ready) {
+        while (!delayed_.empty() && delayed_.front().notBefore <= now) {
+            std::pop_heap(delayed_.begin(), delayed_.end(), later);
+            Delayed& d = delayed_.back();
+            queues_[d.domain].push_back(std::move(d.item));
+            delayed_.pop_back();
+        }
+
+        Clock::duration next = Clock::duration::max();
+        for (auto it = queues_.begin(); it != queues_.end();) {
+            auto& [domain, queue] = *it;
+            while (!queue.empty()) {
+                Clock::duration wait = domain.empty() ? Clock::duration::zero() : limiter_.tryAcquire(domain, now);
+                if (wait > Clock::duration::zero()) {
+                    next = std::min(next, wait);
+                    break;
+                }
+                ready.push_back(std::move(queue.front()));
+                queue.pop_front();
+                --pending_;
+            }
+            it = queue.empty() ? queues_.erase(it) : std::next(it);
+        }
+
+        if (!delayed_.empty()) next = std::min(next, delayed_.front().notBefore - now);
+        return next;
+    }
+
+    // Move every waiting item to `out`, ignoring limits and times (shutdown)
+    void drain(std::vector<T>& out) {
+        for (auto& [domain, queue] : queues_) {
+            for (auto& item : queue) out.push_back(std::move(item));
+        }
+        std::sort(delayed_.begin(), delayed_.end(), [](const Delayed& a, const Delayed& b) { return later(b, a); });
+        for (auto& d : delayed_) out.push_back(std::move(d.item));
+        queues_.clear();
+        delayed_.clear();
+        pending_ = 0;
+    }
+
+    // Items queued or deferred
+    size_t pending() const { return pending_; }
+
+private:
+    struct Delayed {
+        Clock::time_point notBefore;
+        uint64_t sequence;  // Keeps equal times in push order
+        std::string domain;
+        T item;
+    };
+
+    // Min-heap order on (notBefore, sequence)
+    static bool later(const Delayed& a, const Delayed& b) {
+        return a.notBefore != b.notBefore ? a.notBefore > b.notBefore : a.sequence > b.sequence;
+    }
+
+    RateLimiter& limiter_;
+    std::map<std::string, std::deque<T>> queues_;
+    std::vector<Delayed> delayed_;
+    uint64_t sequence_ = 0;
+    size_t pending_ = 0;
+};
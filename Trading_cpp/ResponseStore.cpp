@@ -0,0 +1,777 @@
+#include "ResponseStore.h"
+#include "TimeUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[4] = {'T', 'R', 'S', 'P'};
+constexpr size_t kScanWindow = 64 << 10;
+
+// FNV-1a over 8-byte words (then the remaining bytes): enough to catch a
+// torn or overwritten record, and cheap next to the read itself
+uint64_t checksum(const char* key, size_t keySize, const char* value, size_t valueSize) {
+    constexpr uint64_t kPrime = 1099511628211ull;
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const char* p, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, p + i, sizeof(word));
+            h = (h ^ word) * kPrime;
+        }
+        for (; i < n; ++i) {
+            h = (h ^ static_cast<unsigned char>(p[i])) * kPrime;
+        }
+    };
+    mix(key, keySize);
+    mix(value, valueSize);
+    return h;
+}
+
+// Compressed bytes, or nothing when compression is unavailable or does not pay
+std::optional<std::string> deflateValue(const std::string& value) {
+#ifdef ENABLE_ZLIB
+    uLongf size = compressBound(static_cast<uLong>(value.size()));
+    std::string out(size, '\0');
+    // Fastest level: responses are JSON and shrink well at any level
+    if (compress2(reinterpret_cast<Bytef*>(out.data()), &size,
+                  reinterpret_cast<const Bytef*>(value.data()), static_cast<uLong>(value.size()),
+                  Z_BEST_SPEED) != Z_OK || size >= value.size()) {
+        return std::nullopt;
+    }
+    out.resize(size);
+    return out;
+#else
+    (void)value;
+    return std::nullopt;
+#endif
+}
+
+std::optional<std::string> inflateValue(const char* data, size_t size, size_t rawSize) {
+#ifdef ENABLE_ZLIB
+    std::string out(rawSize, '\0');
+    uLongf outSize = static_cast<uLongf>(rawSize);
+    if (uncompress(reinterpret_cast<Bytef*>(out.data()), &outSize,
+                   reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size)) != Z_OK ||
+        outSize != rawSize) {
+        return std::nullopt;
+    }
+    return out;
+#else
+    (void)data; (void)size; (void)rawSize;
+    return std::nullopt;
+#endif
+}
+
+// The few file operations the store needs: positioned reads, appends, header
+// rewrites, truncation and an exclusive lock that other processes respect
+class StoreFile {
+public:
+    StoreFile() = default;
+    StoreFile(const StoreFile&) = delete;
+    StoreFile& operator=(const StoreFile&) = delete;
+    ~StoreFile() { close(); }
+
+    void swap(StoreFile& other) noexcept {
+#ifdef _WIN32
+        std::swap(handle_, other.handle_);
+#else
+        std::swap(fd_, other.fd_);
+#endif
+    }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE h = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE) return false;
+        handle_ = h;
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ < 0) return false;
+#endif
+        return true;
+    }
+
+    bool isOpen() const {
+#ifdef _WIN32
+        return handle_ != nullptr;
+#else
+        return fd_ >= 0;
+#endif
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (handle_) CloseHandle(handle_);
+        handle_ = nullptr;
+#else
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+    }
+
+    uint64_t size() const {
+#ifdef _WIN32
+        LARGE_INTEGER size;
+        return GetFileSizeEx(handle_, &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+#else
+        struct stat st;
+        return fstat(fd_, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+#endif
+    }
+
+    bool readAt(uint64_t offset, char* out, size_t length) const {
+        while (length > 0) {
+#ifdef _WIN32
+            OVERLAPPED ov{};
+            ov.Offset = static_cast<DWORD>(offset);
+            ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(length, 1u << 30));
+            DWORD n = 0;
+            if (!ReadFile(handle_, out, chunk, &n, &ov) || n == 0) return false;
+#else
+            ssize_t n = pread(fd_, out, length, static_cast<off_t>(offset));
+            if (n <= 0) return false;
+#endif
+            out += n;
+            offset += static_cast<uint64_t>(n);
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Writes at the end of the file; callers hold the lock
+    bool append(const std::string& data) {
+        const char* p = data.data();
+        size_t length = data.size();
+        while (length > 0) {
+#ifdef _WIN32
+            OVERLAPPED ov{};
+            ov.Offset = 0xFFFFFFFF;  // Append
+            ov.OffsetHigh = 0xFFFFFFFF;
+            DWORD n = 0;
+            if (!WriteFile(handle_, p, static_cast<DWORD>(std::min<size_t>(length, 1u << 30)), &n, &ov)) return false;
+#else
+            ssize_t n = ::write(fd_, p, length);
+            if (n <= 0) return false;
+#endif
+            p += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Overwrites bytes already in the file (the header); callers hold the lock
+    bool writeAt(uint64_t offset, const char* data, size_t length) {
+#ifdef _WIN32
+        OVERLAPPED ov{};
+        ov.Offset = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD n = 0;
+        return WriteFile(handle_, data, static_cast<DWORD>(length), &n, &ov) && n == length;
+#else
+        // pwrite ignores the offset on an O_APPEND descriptor (Linux), so
+        // drop the flag for this one write
+        int flags = fcntl(fd_, F_GETFL);
+        if (flags < 0 || fcntl(fd_, F_SETFL, flags & ~O_APPEND) != 0) return false;
+        bool written = pwrite(fd_, data, length, static_cast<off_t>(offset)) == static_cast<ssize_t>(length);
+        fcntl(fd_, F_SETFL, flags);
+        return written;
+#endif
+    }
+
+    bool truncate(uint64_t length) {
+#ifdef _WIN32
+        LARGE_INTEGER pos;
+        pos.QuadPart = static_cast<LONGLONG>(length);
+        return SetFilePointerEx(handle_, pos, nullptr, FILE_BEGIN) && SetEndOfFile(handle_);
+#else
+        return ftruncate(fd_, static_cast<off_t>(length)) == 0;
+#endif
+    }
+
+    // Blocks until no other process holds the lock. Threads of one process
+    // are serialized by the store's mutex, not by this.
+    void lock() {
+#ifdef _WIN32
+        // A byte far past the data, so the lock never blocks readers
+        OVERLAPPED ov{};
+        ov.OffsetHigh = 0x40000000;
+        LockFileEx(handle_, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &ov);
+#else
+        while (flock(fd_, LOCK_EX) != 0 && errno == EINTR) {
+        }
+#endif
+    }
+
+    void unlock() {
+#ifdef _WIN32
+        OVERLAPPED ov{};
+        ov.OffsetHigh = 0x40000000;
+        UnlockFileEx(handle_, 0, 1, 0, &ov);
+#else
+        flock(fd_, LOCK_UN);
+#endif
+    }
+
+    // False once another process's compaction has renamed a new file over path
+    bool isCurrent(const std::string& path) const {
+#ifdef _WIN32
+        HANDLE other = CreateFileA(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (other == INVALID_HANDLE_VALUE) return false;
+        BY_HANDLE_FILE_INFORMATION a, b;
+        bool same = GetFileInformationByHandle(handle_, &a) && GetFileInformationByHandle(other, &b) &&
+                    a.dwVolumeSerialNumber == b.dwVolumeSerialNumber &&
+                    a.nFileIndexHigh == b.nFileIndexHigh && a.nFileIndexLow == b.nFileIndexLow;
+        CloseHandle(other);
+        return same;
+#else
+        struct stat mine, named;
+        return fstat(fd_, &mine) == 0 && ::stat(path.c_str(), &named) == 0 &&
+               mine.st_dev == named.st_dev && mine.st_ino == named.st_ino;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE handle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// A temporary name next to path that no other compaction uses, in this
+// process or another
+std::string tempPathFor(const std::string& path) {
+    static std::atomic<uint64_t> compactions{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    long pid = static_cast<long>(getpid());
+#endif
+    return path + "." + std::to_string(pid) + "." + std::to_string(compactions++) + ".tmp";
+}
+
+int64_t unixNow() {
+    return TimeUtils::toUnixSeconds(TimeUtils::now());
+}
+
+} // namespace
+
+struct ResponseStore::Impl {
+    // Latest record for a key
+    struct Entry {
+        uint64_t offset;
+        uint32_t size;          // Whole record, header included
+        int64_t writtenAt;
+        int64_t expiresAt;
+    };
+
+    std::string path;
+    ResponseStoreOptions options;
+
+    std::mutex mutex;
+    StoreFile file;
+    std::unordered_map<std::string, Entry> index;
+    uint64_t indexedEnd = 0;    // Records before this offset are in the index
+    uint64_t liveBytes = 0;
+    uint64_t expiredBytes = 0;  // Of liveBytes, as of expiredAsOf
+    int64_t expiredAsOf = -1;
+    ResponseStoreStats counters;
+
+    std::thread compactor;
+    std::condition_variable compactWake;
+    std::condition_variable compactDone;
+    bool compactRequested = false;
+    bool compacting = false;    // A compaction is copying without the mutex
+    bool stopping = false;
+
+    Impl(std::string p, ResponseStoreOptions o) : path(std::move(p)), options(o) {
+        if (options.backgroundCompaction) {
+            compactor = std::thread([this] { compactLoop(); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        compactWake.notify_all();
+        if (compactor.joinable()) compactor.join();
+    }
+
+    // --- Index ---
+
+    void resetIndex() {
+        index.clear();
+        indexedEnd = 0;
+        liveBytes = 0;
+        expiredAsOf = -1;
+    }
+
+    void apply(const std::string& key, const ResponseRecordHeader& rec, uint64_t offset) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            liveBytes -= it->second.size;
+            if (rec.flags & kErased) {
+                index.erase(it);
+                return;
+            }
+        } else if (rec.flags & kErased) {
+            return;
+        }
+        uint32_t size = static_cast<uint32_t>(sizeof(rec) + rec.keySize + rec.storedSize);
+        index[key] = Entry{offset, size, rec.writtenAt, rec.expiresAt};
+        liveBytes += size;
+    }
+
+    // Index whatever was appended since the last look, reading only record
+    // headers and keys (checksums are verified when a record is read). A
+    // record that runs past the end of the file is either still being
+    // written by another process or was torn by a crash; only a writer
+    // holding the file lock (`repair`) can tell, and cuts it off.
+    bool syncTail(bool repair) {
+        uint64_t fileSize = file.size();
+        if (fileSize < indexedEnd) {
+            resetIndex();  // Truncated under us: start over
+        }
+
+        if (indexedEnd == 0) {
+            ResponseStoreHeader header{};
+            bool valid = fileSize >= sizeof(header) && file.readAt(0, reinterpret_cast<char*>(&header), sizeof(header)) &&
+                         std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kVersion &&
+                         header.headerSize == sizeof(ResponseStoreHeader) &&
+                         header.recordHeaderSize == sizeof(ResponseRecordHeader);
+            if (!valid) {
+                if (!repair) return true;
+                // New (or foreign/older) file: start it afresh
+                std::memcpy(header.magic, kMagic, sizeof(kMagic));
+                header.version = kVersion;
+                header.headerSize = sizeof(ResponseStoreHeader);
+                header.recordHeaderSize = sizeof(ResponseRecordHeader);
+                header.createdAt = unixNow();
+                header.replacedAt = 0;
+                if (!file.truncate(0) ||
+                    !file.append(std::string(reinterpret_cast<const char*>(&header), sizeof(header)))) {
+                    return false;
+                }
+                fileSize = sizeof(header);
+            }
+            indexedEnd = sizeof(header);
+        }
+
+        // Records are read through a window that slides over the file
+        std::string window;
+        uint64_t windowStart = 0;
+        auto view = [&](uint64_t at, size_t length) -> const char* {
+            if (at < windowStart || at + length > windowStart + window.size()) {
+                size_t want = static_cast<size_t>(std::min<uint64_t>(std::max(length, kScanWindow), fileSize - at));
+                window.resize(want);
+                windowStart = at;
+                if (want < length || !file.readAt(at, window.data(), want)) {
+                    window.clear();
+                    return nullptr;
+                }
+            }
+            return window.data() + (at - windowStart);
+        };
+
+        uint64_t offset = indexedEnd;
+        while (fileSize - offset >= sizeof(ResponseRecordHeader)) {
+            const char* head = view(offset, sizeof(ResponseRecordHeader));
+            if (!head) break;
+            ResponseRecordHeader rec;
+            std::memcpy(&rec, head, sizeof(rec));
+            uint64_t end = offset + sizeof(rec) + rec.keySize + rec.storedSize;
+            if (rec.magic != kRecordMagic || end > fileSize) break;
+            const char* key = view(offset + sizeof(rec), rec.keySize);
+            if (!key) break;
+
+            apply(std::string(key, rec.keySize), rec, offset);
+            offset = end;
+        }
+        indexedEnd = offset;
+
+        if (repair && indexedEnd < fileSize) {
+            return file.truncate(indexedEnd);
+        }
+        return true;
+    }
+
+    bool ensureOpen() {
+        if (file.isOpen()) return true;
+        std::error_code ec;
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) {
+            std::filesystem::create_directories(target.parent_path(), ec);
+        }
+        if (!file.open(path)) return false;
+        resetIndex();
+        return syncTail(false);
+    }
+
+    bool reopen() {
+        file.close();
+        return ensureOpen();
+    }
+
+    // --- Replacement mark ---
+
+    // Whether another process's compaction has replaced the open file (or is
+    // about to: the mark goes on before the rename)
+    bool replaced() const {
+        int64_t at = 0;
+        return file.readAt(offsetof(ResponseStoreHeader, replacedAt), reinterpret_cast<char*>(&at), sizeof(at)) &&
+               at != 0;
+    }
+
+    bool markReplaced(int64_t at) {
+        return file.writeAt(offsetof(ResponseStoreHeader, replacedAt), reinterpret_cast<const char*>(&at), sizeof(at));
+    }
+
+    // Lock the current file (following another process's compaction to the
+    // new one) and bring the index up to its end
+    bool lockFile() {
+        if (!ensureOpen()) return false;
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            file.lock();
+            if (file.isCurrent(path)) {
+                // Still in place but marked: that compaction died before its rename
+                if (syncTail(true) && (!replaced() || markReplaced(0))) return true;
+                file.unlock();
+                return false;
+            }
+            file.unlock();
+            if (!reopen()) return false;
+        }
+        return false;
+    }
+
+    // --- Records ---
+
+    std::optional<std::string> read(const Entry& entry) const {
+        std::string buffer(entry.size, '\0');
+        if (!file.readAt(entry.offset, buffer.data(), buffer.size())) return std::nullopt;
+
+        ResponseRecordHeader rec;
+        std::memcpy(&rec, buffer.data(), sizeof(rec));
+        const char* key = buffer.data() + sizeof(rec);
+        const char* value = key + rec.keySize;
+        if (rec.magic != kRecordMagic || sizeof(rec) + rec.keySize + rec.storedSize != entry.size ||
+            checksum(key, rec.keySize, value, rec.storedSize) != rec.checksum) {
+            return std::nullopt;
+        }
+        if (rec.flags & kCompressed) {
+            return inflateValue(value, rec.storedSize, rec.rawSize);
+        }
+        return std::string(value, rec.storedSize);
+    }
+
+    static std::string encode(const std::string& key, const std::string& value, uint32_t flags,
+                              int64_t writtenAt, int64_t expiresAt, const ResponseStoreOptions& options) {
+        std::optional<std::string> compressed;
+        if (options.compress && !(flags & kErased) && value.size() >= options.minCompressBytes) {
+            compressed = deflateValue(value);
+        }
+        const std::string& stored = compressed ? *compressed : value;
+
+        ResponseRecordHeader rec{};
+        rec.magic = kRecordMagic;
+        rec.flags = flags | (compressed ? kCompressed : 0);
+        rec.keySize = static_cast<uint32_t>(key.size());
+        rec.storedSize = static_cast<uint32_t>(stored.size());
+        rec.rawSize = static_cast<uint32_t>(value.size());
+        rec.writtenAt = writtenAt;
+        rec.expiresAt = expiresAt;
+        rec.checksum = checksum(key.data(), key.size(), stored.data(), stored.size());
+
+        std::string out;
+        out.reserve(sizeof(rec) + key.size() + stored.size());
+        out.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        out += key;
+        out += stored;
+        return out;
+    }
+
+    Result<void> append(const std::string& key, const std::string& value, uint32_t flags, int64_t expiresAt) {
+        if (key.size() > UINT32_MAX || value.size() > UINT32_MAX) {
+            return Result<void>::err(Error::validation("Response too large to cache: " + key));
+        }
+        if (!lockFile()) {
+            return Result<void>::err(Error::internal("Cannot open response store " + path));
+        }
+        int64_t now = unixNow();
+        std::string record = encode(key, value, flags, now, expiresAt, options);
+        uint64_t offset = file.size();
+        bool written = offset == indexedEnd && file.append(record);
+        if (written) {
+            ResponseRecordHeader rec;
+            std::memcpy(&rec, record.data(), sizeof(rec));
+            apply(key, rec, offset);
+            indexedEnd = offset + record.size();
+            ++counters.writes;
+        }
+        file.unlock();
+        if (!written) {
+            return Result<void>::err(Error::internal("Write failed: " + path));
+        }
+
+        if (compactor.joinable() && shouldCompact()) {
+            compactRequested = true;
+            compactWake.notify_one();
+        }
+        return Result<void>::ok();
+    }
+
+    // --- Compaction ---
+
+    // Bytes of indexed records that have expired, recounted at most once a
+    // second (expiry has one-second resolution)
+    uint64_t expiredLiveBytes(int64_t now) {
+        if (now != expiredAsOf) {
+            expiredBytes = 0;
+            for (const auto& [key, entry] : index) {
+                if (entry.expiresAt <= now) expiredBytes += entry.size;
+            }
+            expiredAsOf = now;
+        }
+        return std::min(expiredBytes, liveBytes);
+    }
+
+    // Superseded, erased and expired records make up enough of the file
+    bool shouldCompact() {
+        if (indexedEnd < options.compactMinBytes) return false;
+        uint64_t records = indexedEnd > sizeof(ResponseStoreHeader) ? indexedEnd - sizeof(ResponseStoreHeader) : 0;
+        uint64_t dead = records - liveBytes + expiredLiveBytes(unixNow());
+        return static_cast<double>(dead) >= options.compactDeadRatio * static_cast<double>(records);
+    }
+
+    // Rewrites the live records to a temporary file and renames it into
+    // place. Only the snapshot of the index and the final switch hold the
+    // mutex and the file lock; the copy in between reads through a handle of
+    // its own while gets and puts go on, and whatever they append meanwhile
+    // is copied as is at the end. A compaction that finds another process's
+    // already in place drops its copy. Called and returns with `lock` held.
+    Result<void> compactFile(std::unique_lock<std::mutex>& lock) {
+        compactDone.wait(lock, [this] { return !compacting; });
+        if (!lockFile()) {
+            return Result<void>::err(Error::internal("Cannot open response store " + path));
+        }
+
+        // Live records in file order
+        struct Live {
+            std::string key;
+            Entry entry;
+        };
+        std::vector<Live> live;
+        live.reserve(index.size());
+        int64_t now = unixNow();
+        for (const auto& [key, entry] : index) {
+            if (entry.expiresAt > now) live.push_back({key, entry});
+        }
+        std::sort(live.begin(), live.end(), [](const Live& a, const Live& b) { return a.entry.offset < b.entry.offset; });
+        uint64_t snapshotEnd = indexedEnd;
+
+        // Records before snapshotEnd never change, and no one can rename
+        // over the file while it is locked, so this is the same file
+        StoreFile source;
+        bool opened = source.open(path);
+        file.unlock();
+        if (!opened) {
+            return Result<void>::err(Error::internal("Cannot open response store " + path));
+        }
+
+        // Unique per compaction, as other processes may be compacting too
+        std::string tmpPath = tempPathFor(path);
+        std::unordered_map<std::string, Entry> rewritten;
+        uint64_t offset = sizeof(ResponseStoreHeader);
+        bool copied = false;
+
+        compacting = true;
+        lock.unlock();
+        {
+            std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+            ResponseStoreHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.headerSize = sizeof(ResponseStoreHeader);
+            header.recordHeaderSize = sizeof(ResponseRecordHeader);
+            header.createdAt = now;
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            std::string buffer;
+            for (const auto& [key, entry] : live) {
+                buffer.resize(entry.size);
+                if (!source.readAt(entry.offset, buffer.data(), buffer.size())) continue;
+                ofs.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                rewritten[key] = Entry{offset, entry.size, entry.writtenAt, entry.expiresAt};
+                offset += entry.size;
+            }
+            ofs.close();
+            copied = static_cast<bool>(ofs);
+        }
+        lock.lock();
+        compacting = false;
+        compactDone.notify_all();
+
+        std::error_code ec;
+        auto abandon = [&](Result<void> result) {
+            std::filesystem::remove(tmpPath, ec);
+            return result;
+        };
+        if (!copied) {
+            return abandon(Result<void>::err(Error::internal("Cannot compact " + path)));
+        }
+        if (!lockFile()) {
+            return abandon(Result<void>::err(Error::internal("Cannot open response store " + path)));
+        }
+        if (!source.isCurrent(path)) {
+            // Another process compacted the file in the meantime
+            file.unlock();
+            return abandon(Result<void>::ok());
+        }
+
+        // Appended while copying: superseding records and tombstones are
+        // indexed again from the new file below
+        bool ok = true;
+        if (indexedEnd > snapshotEnd) {
+            std::string tail(static_cast<size_t>(indexedEnd - snapshotEnd), '\0');
+            ok = file.readAt(snapshotEnd, tail.data(), tail.size());
+            if (ok) {
+                std::ofstream ofs(tmpPath, std::ios::binary | std::ios::app);
+                ofs.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+                ofs.close();
+                ok = static_cast<bool>(ofs);
+            }
+        }
+
+        // Mark the old file first, so a lookup never misses the switch
+        ok = ok && markReplaced(unixNow());
+        if (ok) std::filesystem::rename(tmpPath, path, ec);
+        if (!ok || ec) {
+            markReplaced(0);
+            file.unlock();
+            return abandon(Result<void>::err(Error::internal("Cannot compact " + path)));
+        }
+
+        // Other processes still holding the old file wait on its lock, then
+        // notice it was replaced and reopen
+        StoreFile replacement;
+        if (!replacement.open(path)) {
+            file.unlock();
+            file.close();
+            resetIndex();
+            return Result<void>::err(Error::internal("Cannot reopen " + path));
+        }
+        file.unlock();
+        file.swap(replacement);
+        index = std::move(rewritten);
+        indexedEnd = offset;
+        liveBytes = offset - sizeof(ResponseStoreHeader);
+        expiredAsOf = -1;
+        syncTail(false);
+        ++counters.compactions;
+        return Result<void>::ok();
+    }
+
+    void compactLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            compactWake.wait(lock, [this] { return stopping || compactRequested; });
+            if (stopping) return;
+            compactRequested = false;
+            if (shouldCompact()) compactFile(lock);
+        }
+    }
+};
+
+ResponseStore::ResponseStore(std::string path, ResponseStoreOptions options)
+    : impl_(std::make_unique<Impl>(std::move(path), options)) {}
+
+ResponseStore::~ResponseStore() = default;
+
+std::optional<std::string> ResponseStore::get(const std::string& key, std::optional<std::chrono::seconds> maxAge) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    int64_t now = unixNow();
+    auto fresh = [&](const Impl::Entry& e) {
+        return now < e.expiresAt && (!maxAge || now - e.writtenAt < maxAge->count());
+    };
+
+    // Pick up other processes' appends (or their compacted file) first, so a
+    // replaced value is never served. A file still marked after reopening is
+    // between another process's mark and rename: a miss for now.
+    if (!impl_->ensureOpen() || (impl_->replaced() && (!impl_->reopen() || impl_->replaced())) ||
+        !impl_->syncTail(false)) {
+        ++impl_->counters.misses;
+        return std::nullopt;
+    }
+    auto it = impl_->index.find(key);
+    if (it != impl_->index.end() && fresh(it->second)) {
+        if (auto value = impl_->read(it->second)) {
+            ++impl_->counters.hits;
+            return value;
+        }
+    }
+    ++impl_->counters.misses;
+    return std::nullopt;
+}
+
+Result<void> ResponseStore::put(const std::string& key, const std::string& value, std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->append(key, value, 0, unixNow() + ttl.count());
+}
+
+Result<void> ResponseStore::erase(const std::string& key) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->append(key, "", kErased, 0);
+}
+
+Result<void> ResponseStore::compact() {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    return impl_->compactFile(lock);
+}
+
+ResponseStoreStats ResponseStore::stats() {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    ResponseStoreStats stats = impl_->counters;
+    stats.entries = impl_->index.size();
+    stats.fileBytes = impl_->indexedEnd;
+    stats.liveBytes = impl_->liveBytes;
+    return stats;
+}
+
+const std::string& ResponseStore::path() const {
+    return impl_->path;
+}
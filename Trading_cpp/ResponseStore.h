@@ -0,0 +1,104 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include "Result.h"
+
+// Persistent response cache: one append-only file instead of a file per URL.
+//
+// Every put() appends a record (key, value, write time, expiry) and an
+// in-memory index maps each key to its latest record, so a lookup is one
+// hash probe and one positioned read. Values are zlib-compressed when that
+// helps (ENABLE_ZLIB builds). Superseded and expired records are dropped by
+// compaction, which rewrites the live records to a new file and renames it
+// into place; it runs on a background thread once enough of the file is dead.
+// Lookups and writes only wait for its start and end, not for the copy.
+//
+// Several processes may share one file: appends and compaction hold an
+// exclusive file lock, and each process picks up the others' appends from
+// the end of the file. Compaction marks the old file's header (replacedAt)
+// before renaming the new one over it, so a lookup notices with one small
+// read and reopens the path. A record left half-written by a crash is cut off
+// by the next writer, and one that fails its checksum reads as a miss.
+//
+// Layout (native byte order):
+//   ResponseStoreHeader (32 bytes)
+//   repeated: ResponseRecordHeader (48 bytes), key bytes, stored value bytes
+struct ResponseStoreHeader {
+    char magic[4];              // "TRSP"
+    uint32_t version;           // ResponseStore::kVersion
+    uint32_t headerSize;        // sizeof(ResponseStoreHeader)
+    uint32_t recordHeaderSize;  // sizeof(ResponseRecordHeader)
+    int64_t createdAt;          // Unix seconds when the file was (re)written
+    int64_t replacedAt;         // Unix seconds when compaction replaced the file; 0 while current
+};
+static_assert(sizeof(ResponseStoreHeader) == 32, "ResponseStoreHeader must stay 32 bytes");
+
+struct ResponseRecordHeader {
+    uint32_t magic;             // ResponseStore::kRecordMagic
+    uint32_t flags;             // ResponseStore::kCompressed | kErased
+    uint32_t keySize;
+    uint32_t storedSize;        // Value bytes in the file
+    uint32_t rawSize;           // Value bytes once decompressed
+    uint32_t reserved;
+    int64_t writtenAt;          // Unix seconds
+    int64_t expiresAt;          // Unix seconds; expired once now >= expiresAt
+    uint64_t checksum;          // FNV-1a (8-byte words) of key and stored value
+};
+static_assert(sizeof(ResponseRecordHeader) == 48, "ResponseRecordHeader must stay 48 bytes");
+
+struct ResponseStoreStats {
+    size_t entries = 0;         // Live keys in the index
+    uint64_t fileBytes = 0;
+    uint64_t liveBytes = 0;     // Bytes of the records the index points at
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t writes = 0;
+    uint64_t compactions = 0;
+};
+
+struct ResponseStoreOptions {
+    bool compress = true;                      // Only with ENABLE_ZLIB
+    size_t minCompressBytes = 512;             // Smaller values are stored as is
+    uint64_t compactMinBytes = 4ull << 20;     // Never compact a smaller file
+    double compactDeadRatio = 0.5;             // Compact once this share is dead
+    bool backgroundCompaction = true;          // Otherwise only compact() does
+};
+
+class ResponseStore {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kRecordMagic = 0x43455254;  // "TREC"
+    static constexpr uint32_t kCompressed = 1;
+    static constexpr uint32_t kErased = 2;
+
+    // The file (and its directory) is created on first use
+    explicit ResponseStore(std::string path, ResponseStoreOptions options = {});
+    ~ResponseStore();
+
+    ResponseStore(const ResponseStore&) = delete;
+    ResponseStore& operator=(const ResponseStore&) = delete;
+
+    // Value for key unless it has expired or, when maxAge is given, was
+    // written longer ago than that
+    std::optional<std::string> get(const std::string& key,
+                                   std::optional<std::chrono::seconds> maxAge = std::nullopt);
+
+    // Write (or replace) a value that expires after ttl
+    Result<void> put(const std::string& key, const std::string& value, std::chrono::seconds ttl);
+
+    // Drop a key (appends a tombstone so other processes see it too)
+    Result<void> erase(const std::string& key);
+
+    // Rewrite the file with only the live, unexpired records
+    Result<void> compact();
+
+    ResponseStoreStats stats();
+    const std::string& path() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
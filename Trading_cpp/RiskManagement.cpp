@@ -147,7 +147,7 @@ std::optional<OrderRequest> DecisionEngine::evaluate(
     // Buy signal
     if (signal.type == SignalType::Buy && !hasPos) {
         // Calculate ATR for position sizing
-        double atr = computeATR(std::vector<Candle>(series.bars().begin(), series.bars().end()), 14);
+        double atr = computeATR(series.bars(), 14);
         double entryPrice = series.bars().back().close;
 
         // Calculate stop loss
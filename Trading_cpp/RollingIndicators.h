@@ -0,0 +1,991 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <numbers>
+#include <utility>
+#include "MarketData.h"
+#include "TechnicalAnalysis.h"
+
+// Rolling (streaming) indicator state for incremental strategies.
+//
+// Each class consumes one observation per update() and mirrors the batch
+// function of the same name in TechnicalAnalysis.h: after n updates, value()
+// equals the batch result over those n observations (same recursions, same
+// summation order). The window averages (RollingSMA, RollingBollinger,
+// RollingSqueeze) keep running sums instead (see WindowMoments) and match up
+// to rounding. Buffers are sized in reset(); update() never allocates.
+
+// Fixed-capacity ring buffer of the most recent values
+template <typename T>
+class RingWindow {
+public:
+    explicit RingWindow(size_t capacity = 0) : data_(capacity) {}
+
+    void reset(size_t capacity) {
+        data_.assign(capacity, T{});
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void push(const T& value) {
+        if (data_.empty()) return;
+        data_[head_] = value;
+        head_ = (head_ + 1) % data_.size();
+        if (size_ < data_.size()) ++size_;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return data_.size(); }
+    bool full() const { return size_ == data_.size() && size_ > 0; }
+
+    // Index 0 is the oldest retained value, size() - 1 the newest
+    const T& operator[](size_t i) const {
+        return data_[(head_ + data_.size() - size_ + i) % data_.size()];
+    }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+private:
+    std::vector<T> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+// Running sum and sum of squares of a sliding window: O(1) per value.
+// Both are taken relative to an anchor (a recent value) so the variance does
+// not cancel at price levels, and the owner re-adds them from its window once
+// per window length (resumDue/resum, as RollingPolyFit) so rounding cannot
+// accumulate. A window of identical values reads back exactly: that value as
+// the mean and zero variance. Holds no buffer, so fixed-size owners such as
+// the Fused stages can use it too.
+class WindowMoments {
+public:
+    void clear() { *this = WindowMoments(); }
+
+    // The window grows by x
+    void add(double x) {
+        if (count_ == 0) anchor_ = x;
+        ++count_;
+        accumulate(x, 1.0);
+        track(x);
+    }
+
+    // The window slides: leaving drops out, entering joins
+    void replace(double leaving, double entering) {
+        accumulate(leaving, -1.0);
+        accumulate(entering, 1.0);
+        track(entering);
+        ++slides_;
+    }
+
+    bool resumDue(size_t period) const { return slides_ >= period; }
+
+    // Re-add the n values at(0) (oldest) .. at(n - 1) around the newest
+    template <typename At>
+    void resum(size_t n, At at) {
+        slides_ = 0;
+        count_ = n;
+        anchor_ = n > 0 ? at(n - 1) : 0.0;
+        sum_ = sumSq_ = 0.0;
+        for (size_t i = 0; i < n; ++i) accumulate(at(i), 1.0);
+    }
+
+    size_t size() const { return count_; }
+
+    double mean() const {
+        if (count_ == 0) return 0.0;
+        if (flat()) return last_;
+        return anchor_ + sum_ / count_;
+    }
+
+    // Population variance (divided by the window length)
+    double variance() const {
+        if (count_ == 0 || flat()) return 0.0;
+        double m = sum_ / count_;
+        return std::max(0.0, sumSq_ / count_ - m * m);
+    }
+
+private:
+    void accumulate(double x, double sign) {
+        double d = x - anchor_;
+        sum_ += sign * d;
+        sumSq_ += sign * d * d;
+    }
+
+    void track(double x) {
+        run_ = (run_ > 0 && x == last_) ? run_ + 1 : 1;
+        last_ = x;
+    }
+
+    bool flat() const { return run_ >= count_; }
+
+    size_t count_ = 0;
+    size_t slides_ = 0;
+    size_t run_ = 0;       // Trailing values equal to last_
+    double last_ = 0.0;
+    double anchor_ = 0.0;
+    double sum_ = 0.0;     // Of x - anchor_
+    double sumSq_ = 0.0;
+};
+
+// Fixed window of the most recent values with its running moments
+class MomentWindow {
+public:
+    explicit MomentWindow(int period = 1) { reset(period); }
+
+    void reset(int period) {
+        window_.reset(static_cast<size_t>(std::max(1, period)));
+        moments_.clear();
+    }
+
+    void push(double x) {
+        if (!window_.full()) {
+            window_.push(x);
+            moments_.add(x);
+            return;
+        }
+        double leaving = window_[0];
+        window_.push(x);
+        moments_.replace(leaving, x);
+        if (moments_.resumDue(window_.capacity())) {
+            moments_.resum(window_.size(), [this](size_t i) { return window_[i]; });
+        }
+    }
+
+    bool full() const { return window_.full(); }
+    double mean() const { return moments_.mean(); }
+    double stdDev() const { return std::sqrt(moments_.variance()); }
+
+private:
+    RingWindow<double> window_;
+    WindowMoments moments_;
+};
+
+// Order-statistic multiset over a fixed set of slots (e.g. the positions of a
+// rolling window): set or clear a slot's value and read the k-th smallest
+// live value, each in O(log n) expected time. A treap stored in arrays, so
+// nothing is allocated after reset().
+class OrderStatisticSlots {
+public:
+    explicit OrderStatisticSlots(size_t capacity = 0) { reset(capacity); }
+
+    void reset(size_t capacity) {
+        nodes_.assign(capacity, Node{});
+        for (size_t i = 0; i < capacity; ++i) nodes_[i].priority = mix(i);
+        root_ = kNone;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool contains(size_t slot) const { return nodes_[slot].live; }
+
+    void insert(size_t slot, double value) {
+        erase(slot);
+        Node& node = nodes_[slot];
+        node.value = value;
+        node.left = node.right = kNone;
+        node.count = 1;
+        node.live = true;
+
+        int left, right;
+        split(root_, static_cast<int>(slot), left, right);
+        root_ = merge(merge(left, static_cast<int>(slot)), right);
+        ++size_;
+    }
+
+    void erase(size_t slot) {
+        if (!contains(slot)) return;
+        root_ = remove(root_, static_cast<int>(slot));
+        nodes_[slot].live = false;
+        --size_;
+    }
+
+    // k-th smallest live value (0-based); k < size()
+    double kth(size_t k) const {
+        int t = root_;
+        while (true) {
+            const Node& node = nodes_[t];
+            size_t leftCount = count(node.left);
+            if (k < leftCount) {
+                t = node.left;
+            } else if (k == leftCount) {
+                return node.value;
+            } else {
+                k -= leftCount + 1;
+                t = node.right;
+            }
+        }
+    }
+
+private:
+    static constexpr int kNone = -1;
+
+    struct Node {
+        double value = 0.0;
+        uint64_t priority = 0;
+        int left = kNone;
+        int right = kNone;
+        size_t count = 0;   // Nodes in this subtree
+        bool live = false;
+    };
+
+    // Fixed pseudo-random priority per slot (splitmix64)
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    size_t count(int t) const { return t == kNone ? 0 : nodes_[t].count; }
+
+    void pull(int t) { nodes_[t].count = 1 + count(nodes_[t].left) + count(nodes_[t].right); }
+
+    // Ordered by value, ties by slot, so every node has a distinct key
+    bool less(int a, int b) const {
+        return nodes_[a].value < nodes_[b].value || (nodes_[a].value == nodes_[b].value && a < b);
+    }
+
+    int merge(int a, int b) {
+        if (a == kNone) return b;
+        if (b == kNone) return a;
+        if (nodes_[a].priority > nodes_[b].priority) {
+            nodes_[a].right = merge(nodes_[a].right, b);
+            pull(a);
+            return a;
+        }
+        nodes_[b].left = merge(a, nodes_[b].left);
+        pull(b);
+        return b;
+    }
+
+    // Split t into keys below `key` and the rest
+    void split(int t, int key, int& left, int& right) {
+        if (t == kNone) {
+            left = right = kNone;
+            return;
+        }
+        if (less(t, key)) {
+            split(nodes_[t].right, key, nodes_[t].right, right);
+            left = t;
+        } else {
+            split(nodes_[t].left, key, left, nodes_[t].left);
+            right = t;
+        }
+        pull(t);
+    }
+
+    int remove(int t, int key) {
+        if (t == key) return merge(nodes_[t].left, nodes_[t].right);
+        if (less(key, t)) nodes_[t].left = remove(nodes_[t].left, key);
+        else nodes_[t].right = remove(nodes_[t].right, key);
+        pull(t);
+        return t;
+    }
+
+    std::vector<Node> nodes_;
+    int root_ = kNone;
+    size_t size_ = 0;
+};
+
+// Simple moving average; value() is 0 until the window is full
+class RollingSMA {
+public:
+    explicit RollingSMA(int period = 1) { reset(period); }
+
+    void reset(int period) {
+        window_.reset(period);
+        value_ = 0.0;
+        previous_ = 0.0;
+    }
+
+    void update(double x) {
+        previous_ = value_;
+        window_.push(x);
+        if (window_.full()) value_ = window_.mean();
+    }
+
+    bool ready() const { return window_.full(); }
+    double value() const { return value_; }
+    double previous() const { return previous_; }  // Value before the last update
+
+private:
+    MomentWindow window_;
+    double value_ = 0.0;
+    double previous_ = 0.0;
+};
+
+// EMA seeded with the SMA of the first `period` values (as computeEMA)
+class RollingEMA {
+public:
+    explicit RollingEMA(int period = 1) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        multiplier_ = 2.0 / (period_ + 1.0);
+        count_ = 0;
+        sum_ = 0.0;
+        value_ = 0.0;
+    }
+
+    void update(double x) {
+        if (count_ < period_) {
+            sum_ += x;
+            if (count_ == period_ - 1) value_ = sum_ / period_;
+        } else {
+            value_ = (x - value_) * multiplier_ + value_;
+        }
+        ++count_;
+    }
+
+    bool ready() const { return count_ >= period_; }
+    double value() const { return value_; }
+
+private:
+    int period_ = 1;
+    double multiplier_ = 1.0;
+    long long count_ = 0;
+    double sum_ = 0.0;
+    double value_ = 0.0;
+};
+
+// Wilder RSI (as computeRSI): 50 until period + 1 prices have been seen
+class RollingRSI {
+public:
+    explicit RollingRSI(int period = 14) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        count_ = 0;
+        prev_ = 0.0;
+        avgUp_ = 0.0;
+        avgDown_ = 0.0;
+    }
+
+    void update(double price) {
+        if (count_ > 0) {
+            double diff = price - prev_;
+            if (count_ <= period_) {
+                if (diff > 0) avgUp_ += diff; else avgDown_ -= diff;
+                if (count_ == period_) {
+                    avgUp_ /= period_;
+                    avgDown_ /= period_;
+                }
+            } else {
+                double up = (diff > 0) ? diff : 0.0;
+                double down = (diff < 0) ? -diff : 0.0;
+                avgUp_ = (avgUp_ * (period_ - 1) + up) / period_;
+                avgDown_ = (avgDown_ * (period_ - 1) + down) / period_;
+            }
+        }
+        prev_ = price;
+        ++count_;
+    }
+
+    double value() const {
+        if (count_ <= period_) return 50.0;
+        if (avgDown_ == 0.0) return 100.0;
+        double rs = avgUp_ / avgDown_;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+
+private:
+    int period_ = 14;
+    long long count_ = 0;
+    double prev_ = 0.0;
+    double avgUp_ = 0.0;
+    double avgDown_ = 0.0;
+};
+
+// Wilder ATR (as computeATR): 0 until period + 1 candles have been seen
+class RollingATR {
+public:
+    explicit RollingATR(int period = 14) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        count_ = 0;
+        prevClose_ = 0.0;
+        atr_ = 0.0;
+    }
+
+    void update(double high, double low, double close) {
+        double tr = high - low;
+        if (count_ > 0) {
+            double hpc = std::abs(high - prevClose_);
+            double lpc = std::abs(low - prevClose_);
+            tr = std::max({tr, hpc, lpc});
+        }
+        if (count_ < period_) {
+            atr_ += tr;
+            if (count_ == period_ - 1) atr_ /= period_;
+        } else {
+            atr_ = (atr_ * (period_ - 1) + tr) / period_;
+        }
+        prevClose_ = close;
+        ++count_;
+    }
+    void update(const Candle& c) { update(c.high, c.low, c.close); }
+
+    double value() const { return count_ > period_ ? atr_ : 0.0; }
+
+private:
+    int period_ = 14;
+    long long count_ = 0;
+    double prevClose_ = 0.0;
+    double atr_ = 0.0;
+};
+
+// Wilder ADX with +DI/-DI (as computeADX): zeros until 2 * period candles
+class RollingADX {
+public:
+    explicit RollingADX(int period = 14) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        count_ = 0;
+        prevHigh_ = prevLow_ = prevClose_ = 0.0;
+        smoothTR_ = smoothPlusDM_ = smoothMinusDM_ = 0.0;
+        plusDI_ = minusDI_ = 0.0;
+        dxCount_ = 0;
+        adx_ = 0.0;
+    }
+
+    void update(double high, double low, double close) {
+        if (count_ > 0) {
+            double highDiff = high - prevHigh_;
+            double lowDiff = prevLow_ - low;
+            double plusDM = (highDiff > lowDiff && highDiff > 0) ? highDiff : 0.0;
+            double minusDM = (lowDiff > highDiff && lowDiff > 0) ? lowDiff : 0.0;
+
+            double hl = high - low;
+            double hpc = std::abs(high - prevClose_);
+            double lpc = std::abs(low - prevClose_);
+            double tr = std::max({hl, hpc, lpc});
+
+            if (count_ <= period_) {
+                smoothTR_ += tr;
+                smoothPlusDM_ += plusDM;
+                smoothMinusDM_ += minusDM;
+            } else {
+                smoothTR_ = smoothTR_ - (smoothTR_ / period_) + tr;
+                smoothPlusDM_ = smoothPlusDM_ - (smoothPlusDM_ / period_) + plusDM;
+                smoothMinusDM_ = smoothMinusDM_ - (smoothMinusDM_ / period_) + minusDM;
+
+                plusDI_ = (smoothTR_ == 0) ? 0 : (100.0 * smoothPlusDM_ / smoothTR_);
+                minusDI_ = (smoothTR_ == 0) ? 0 : (100.0 * smoothMinusDM_ / smoothTR_);
+
+                double diSum = plusDI_ + minusDI_;
+                double dx = (diSum == 0) ? 0 : (100.0 * std::abs(plusDI_ - minusDI_) / diSum);
+
+                if (dxCount_ < period_) {
+                    adx_ += dx;
+                    if (dxCount_ == period_ - 1) adx_ /= period_;
+                } else {
+                    adx_ = ((adx_ * (period_ - 1)) + dx) / period_;
+                }
+                ++dxCount_;
+            }
+        }
+        prevHigh_ = high;
+        prevLow_ = low;
+        prevClose_ = close;
+        ++count_;
+    }
+    void update(const Candle& c) { update(c.high, c.low, c.close); }
+
+    ADXResult value() const {
+        ADXResult res = {0.0, 0.0, 0.0};
+        if (count_ < 2LL * period_) return res;
+        res.plusDI = plusDI_;
+        res.minusDI = minusDI_;
+        if (dxCount_ >= period_) res.adx = adx_;
+        return res;
+    }
+
+private:
+    int period_ = 14;
+    long long count_ = 0;
+    double prevHigh_ = 0.0, prevLow_ = 0.0, prevClose_ = 0.0;
+    double smoothTR_ = 0.0, smoothPlusDM_ = 0.0, smoothMinusDM_ = 0.0;
+    double plusDI_ = 0.0, minusDI_ = 0.0;
+    long long dxCount_ = 0;
+    double adx_ = 0.0;
+};
+
+// MACD(12, 26, 9) line and signal (as computeMACD)
+class RollingMACD {
+public:
+    RollingMACD() { reset(); }
+
+    void reset() {
+        ema12_.reset(12);
+        ema26_.reset(26);
+        signal_.reset(9);
+        macd_ = 0.0;
+    }
+
+    void update(double price) {
+        ema12_.update(price);
+        ema26_.update(price);
+        if (ema26_.ready()) {
+            macd_ = ema12_.value() - ema26_.value();
+            signal_.update(macd_);
+        }
+    }
+
+    // {macd, signal}; zeros until the signal line has 9 MACD values
+    std::pair<double, double> value() const {
+        if (!signal_.ready()) return {0.0, 0.0};
+        return {macd_, signal_.value()};
+    }
+
+private:
+    RollingEMA ema12_;
+    RollingEMA ema26_;
+    RollingEMA signal_;
+    double macd_ = 0.0;
+};
+
+// Bollinger Bands over a fixed window (as computeBollingerBands)
+class RollingBollinger {
+public:
+    explicit RollingBollinger(int period = 20, double multiplier = 2.0) { reset(period, multiplier); }
+
+    void reset(int period, double multiplier) {
+        multiplier_ = multiplier;
+        window_.reset(period);
+    }
+
+    void update(double price) { window_.push(price); }
+
+    BollingerBands value() const {
+        BollingerBands bb = {0.0, 0.0, 0.0, 0.0};
+        if (!window_.full()) return bb;
+
+        bb.middle = window_.mean();
+        double stdDev = window_.stdDev();
+
+        bb.upper = bb.middle + (multiplier_ * stdDev);
+        bb.lower = bb.middle - (multiplier_ * stdDev);
+        if (bb.middle > 0) bb.bandwidth = (bb.upper - bb.lower) / bb.middle;
+        return bb;
+    }
+
+private:
+    double multiplier_ = 2.0;
+    MomentWindow window_;
+};
+
+// GARCH(1,1) volatility over all returns seen (as computeGARCHVolatility).
+// The batch version re-runs the recursion from the full-sample mean and
+// variance on every call; unrolled, the final sigma^2 is
+//   beta^n * var + omega * S0 + alpha * (S2 - 2*mean*S1 + mean^2*S0)
+// where Sk = sum(beta^(n-1-i) * r_i^k), all of which update in O(1).
+class RollingGARCH {
+public:
+    explicit RollingGARCH(double alpha = 0.05, double beta = 0.90) : alpha_(alpha), beta_(beta) {}
+
+    void reset() {
+        n_ = 0;
+        mean_ = m2_ = 0.0;
+        s0_ = s1_ = s2_ = 0.0;
+        betaPow_ = 1.0;
+    }
+
+    void update(double r) {
+        ++n_;
+        double delta = r - mean_;
+        mean_ += delta / n_;
+        m2_ += delta * (r - mean_);
+
+        s0_ = beta_ * s0_ + 1.0;
+        s1_ = beta_ * s1_ + r;
+        s2_ = beta_ * s2_ + r * r;
+        betaPow_ *= beta_;
+    }
+
+    double value() const {
+        if (n_ == 0) return 0.0;
+        double variance = m2_ / n_;
+        double omega = variance * (1.0 - alpha_ - beta_);
+        double shocks = s2_ - 2.0 * mean_ * s1_ + mean_ * mean_ * s0_;
+        double sigma2 = betaPow_ * variance + omega * s0_ + alpha_ * std::max(0.0, shocks);
+        return std::sqrt(std::max(0.0, sigma2));
+    }
+
+private:
+    double alpha_;
+    double beta_;
+    long long n_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double s0_ = 0.0, s1_ = 0.0, s2_ = 0.0;
+    double betaPow_ = 1.0;
+};
+
+// Volatility squeeze flag (as checkVolatilitySqueeze): true when the current
+// 20-bar BB bandwidth is in the bottom `percentile` of the last `lookback` bars.
+// The band comes from running sums and bandwidths sit in an order-statistic
+// set keyed by ring position, so each bar is O(1) band plus O(log lookback)
+// rank work instead of a selection over the whole window.
+class RollingSqueeze {
+public:
+    explicit RollingSqueeze(int lookback = 120, double percentile = 0.10) { reset(lookback, percentile); }
+
+    void reset(int lookback, double percentile) {
+        lookback_ = std::max(1, lookback);
+        percentile_ = percentile;
+        prices_.reset(kBBPeriod);
+        bandwidths_.reset(lookback_);
+        count_ = 0;
+        currentBW_ = 0.0;
+        squeeze_ = false;
+    }
+
+    void update(double price) {
+        prices_.push(price);
+
+        // Bandwidth of the 20-bar window ending here (flat windows give exactly 0)
+        bool valid = false;
+        double bandwidth = 0.0;
+        if (count_ >= kBBPeriod) {
+            double sma = prices_.mean();
+            double stdDev = prices_.stdDev();
+            double upper = sma + 2 * stdDev;
+            double lower = sma - 2 * stdDev;
+
+            if (sma > 0) {
+                valid = true;
+                bandwidth = (upper - lower) / sma;
+            }
+        }
+        updateBandwidth(valid, bandwidth);
+    }
+
+    // Advance one bar with its bandwidth already computed (valid = the window
+    // existed and its SMA was positive). Used by the bulk series, which
+    // computes the bandwidths vectorised; don't mix with update().
+    void updateBandwidth(bool valid, double bandwidth) {
+        size_t slot = static_cast<size_t>(count_ % lookback_);
+        bandwidths_.erase(slot);  // Bar leaving the window
+        if (valid) {
+            bandwidths_.insert(slot, bandwidth);
+            currentBW_ = bandwidth;
+        }
+        ++count_;
+
+        squeeze_ = (count_ >= lookback_) ? evaluate() : false;
+    }
+
+    bool value() const { return squeeze_; }
+
+private:
+    static constexpr int kBBPeriod = 20;
+
+    // currentBW_ is the newest valid bandwidth, which is in the window
+    // whenever the window has any
+    bool evaluate() const {
+        if (bandwidths_.empty()) return false;
+
+        size_t thresholdIdx = static_cast<size_t>(bandwidths_.size() * percentile_);
+        if (thresholdIdx >= bandwidths_.size()) thresholdIdx = bandwidths_.size() - 1;
+        return currentBW_ <= bandwidths_.kth(thresholdIdx);
+    }
+
+    int lookback_ = 120;
+    double percentile_ = 0.10;
+    MomentWindow prices_;
+    OrderStatisticSlots bandwidths_;
+    long long count_ = 0;
+    double currentBW_ = 0.0;
+    bool squeeze_ = false;
+};
+
+// Dominant cycle period (as detectCycle): the period P in [5, 60] (and below
+// half the bar count) whose frequency 1/P has the most power in the linearly
+// detrended series. The detrended transform is linear in the data,
+//   sum(d[n] e^-iwn) = sum(p[n] e^-iwn) - slope * sum(n e^-iwn) - intercept * sum(e^-iwn)
+// so each update adds one term to the three sums of every period (O(periods),
+// table twiddles, no trig calls) and the regression line is applied when the
+// value is read. detectCycle runs this same accumulator over its input.
+class RollingCycle {
+public:
+    static constexpr int kMinPeriod = 5;
+    static constexpr int kMaxPeriod = 60;
+    static constexpr size_t kMinBars = 40;
+
+    RollingCycle() { reset(); }
+
+    void reset() {
+        count_ = 0;
+        sumPrice_ = 0.0;
+        sumIndexPrice_ = 0.0;
+        sums_.fill(Sums{});
+        phase_.fill(0);
+    }
+
+    void update(double price) {
+        const Twiddles& twiddles = twiddleTables();
+        double index = static_cast<double>(count_);
+        sumPrice_ += price;
+        sumIndexPrice_ += index * price;
+
+        for (int k = 0; k < kPeriods; ++k) {
+            double c = twiddles.cos[k][phase_[k]];
+            double s = twiddles.sin[k][phase_[k]];
+            Sums& sums = sums_[k];
+            sums.priceCos += price * c;
+            sums.priceSin += price * s;
+            sums.indexCos += index * c;
+            sums.indexSin += index * s;
+            sums.cos += c;
+            sums.sin += s;
+            if (++phase_[k] == kMinPeriod + k) phase_[k] = 0;
+        }
+        ++count_;
+    }
+
+    // Dominant period, 0 until kMinBars bars
+    int value() const {
+        if (count_ < kMinBars) return 0;
+
+        // Least-squares line through (n, price)
+        double n = static_cast<double>(count_);
+        double xMean = (n - 1) / 2.0;
+        double yMean = sumPrice_ / n;
+        double slope = (sumIndexPrice_ - xMean * sumPrice_) / (n * (n * n - 1) / 12.0);
+        double intercept = yMean - slope * xMean;
+
+        double maxPower = 0.0;
+        int dominantPeriod = 0;
+        for (int P = kMinPeriod; P <= kMaxPeriod && P < static_cast<int>(count_) / 2; ++P) {
+            const Sums& sums = sums_[P - kMinPeriod];
+            double real = sums.priceCos - slope * sums.indexCos - intercept * sums.cos;
+            double imag = -(sums.priceSin - slope * sums.indexSin - intercept * sums.sin);
+            double power = std::sqrt(real * real + imag * imag);
+            if (power > maxPower) {
+                maxPower = power;
+                dominantPeriod = P;
+            }
+        }
+        return dominantPeriod;
+    }
+
+private:
+    static constexpr int kPeriods = kMaxPeriod - kMinPeriod + 1;
+
+    // Running sums of x * cos(2 pi n / P) and x * sin(2 pi n / P) for x = price, n, 1
+    struct Sums {
+        double priceCos = 0.0, priceSin = 0.0;
+        double indexCos = 0.0, indexSin = 0.0;
+        double cos = 0.0, sin = 0.0;
+    };
+
+    // cos/sin(2 pi j / P) for j in [0, P), one table per period
+    struct Twiddles {
+        std::array<std::vector<double>, kPeriods> cos;
+        std::array<std::vector<double>, kPeriods> sin;
+    };
+
+    static const Twiddles& twiddleTables() {
+        static const Twiddles tables = [] {
+            Twiddles t;
+            for (int k = 0; k < kPeriods; ++k) {
+                int P = kMinPeriod + k;
+                for (int j = 0; j < P; ++j) {
+                    double angle = 2.0 * std::numbers::pi * j / P;
+                    t.cos[k].push_back(std::cos(angle));
+                    t.sin[k].push_back(std::sin(angle));
+                }
+            }
+            return t;
+        }();
+        return tables;
+    }
+
+    size_t count_ = 0;
+    double sumPrice_ = 0.0;
+    double sumIndexPrice_ = 0.0;
+    std::array<Sums, kPeriods> sums_;
+    std::array<int, kPeriods> phase_;
+};
+
+// Extreme of the last `period` values via a monotonic deque of (bar, value):
+// values that can never be the extreme again are dropped from the back, so
+// the front is always the answer and each value is pushed and popped at most
+// once (amortised O(1) per update). Compare = std::greater for the max,
+// std::less for the min.
+template <typename Compare>
+class MonotonicWindow {
+public:
+    explicit MonotonicWindow(int period = 1) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        entries_.assign(period_, Entry{});
+        head_ = 0;
+        size_ = 0;
+        count_ = 0;
+    }
+
+    void push(double value) {
+        // Drop the value leaving the window, then everything the new value beats
+        if (size_ > 0 && entries_[head_].bar + period_ <= count_) popFront();
+        while (size_ > 0 && !Compare{}(entries_[(head_ + size_ - 1) % period_].value, value)) --size_;
+        entries_[(head_ + size_) % period_] = {count_, value};
+        ++size_;
+        ++count_;
+    }
+
+    bool empty() const { return count_ == 0; }
+    double value() const { return entries_[head_].value; }
+
+private:
+    struct Entry {
+        size_t bar = 0;
+        double value = 0.0;
+    };
+
+    void popFront() {
+        head_ = (head_ + 1) % period_;
+        --size_;
+    }
+
+    size_t period_ = 1;
+    std::vector<Entry> entries_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    size_t count_ = 0;
+};
+
+// Support/resistance as the min/max of the last `period` prices (as
+// identifyLevels)
+class RollingLevels {
+public:
+    explicit RollingLevels(int period = 60) { reset(period); }
+
+    void reset(int period) {
+        min_.reset(period);
+        max_.reset(period);
+    }
+
+    void update(double price) {
+        min_.push(price);
+        max_.push(price);
+    }
+
+    SupportResistance value() const {
+        if (min_.empty()) return {0.0, 0.0};
+        return {min_.value(), max_.value()};
+    }
+
+private:
+    MonotonicWindow<std::less<double>> min_;
+    MonotonicWindow<std::greater<double>> max_;
+};
+
+// Local extrema over the last `period` prices (as findLocalExtrema): a bar is
+// a pivot high (low) when no price within kConfirmBars on either side is
+// higher (lower), i.e. it equals the max (min) of the 2 * kConfirmBars + 1
+// bars centred on it. Pivots are confirmed kConfirmBars after they occur,
+// with two monotonic windows, so update() is amortised O(1). targets() sorts
+// and thins the pivots still inside the trailing period.
+class RollingExtrema {
+public:
+    static constexpr int kConfirmBars = 5;
+
+    explicit RollingExtrema(int period = 60) { reset(period); }
+
+    void reset(int period) {
+        period_ = std::max(1, period);
+        highs_.reset(kSpan);
+        lows_.reset(kSpan);
+        recent_.reset(kSpan);
+        highPivots_.reset(period_);
+        lowPivots_.reset(period_);
+        count_ = 0;
+    }
+
+    void update(double price) {
+        highs_.push(price);
+        lows_.push(price);
+        recent_.push(price);
+        ++count_;
+        if (count_ < (size_t)kSpan) return;
+
+        // The centre bar now has kConfirmBars bars on each side
+        size_t bar = count_ - 1 - kConfirmBars;
+        double centre = recent_[kConfirmBars];
+        if (centre >= highs_.value()) highPivots_.push({bar, centre});
+        if (centre <= lows_.value()) lowPivots_.push({bar, centre});
+    }
+
+    // Pivot highs (maxima) or lows of the trailing period, ascending, with
+    // values within 1% of the previous kept one dropped
+    std::vector<double> targets(bool findMaxima) const {
+        std::vector<double> values;
+        if (count_ < 10) return values;
+
+        size_t start = count_ > (size_t)period_ ? count_ - period_ : 0;
+        const RingWindow<Pivot>& pivots = findMaxima ? highPivots_ : lowPivots_;
+        for (size_t i = 0; i < pivots.size(); ++i) {
+            if (pivots[i].bar >= start + kConfirmBars) values.push_back(pivots[i].value);
+        }
+        std::sort(values.begin(), values.end());
+
+        std::vector<double> unique;
+        for (double v : values) {
+            if (unique.empty() || v > unique.back() * 1.01) unique.push_back(v);
+        }
+        return unique;
+    }
+
+private:
+    static constexpr int kSpan = 2 * kConfirmBars + 1;
+
+    struct Pivot {
+        size_t bar = 0;
+        double value = 0.0;
+    };
+
+    int period_ = 60;
+    MonotonicWindow<std::greater<double>> highs_;
+    MonotonicWindow<std::less<double>> lows_;
+    RingWindow<double> recent_;
+    RingWindow<Pivot> highPivots_;   // At most period_ pivots can be in range
+    RingWindow<Pivot> lowPivots_;
+    size_t count_ = 0;
+};
+
+// Last N candles in chronological order, exposed as a CandleView
+template <size_t N>
+class CandleTail {
+public:
+    void clear() { size_ = 0; }
+
+    void push(const Candle& c) {
+        if (size_ < N) {
+            bars_[size_++] = c;
+        } else {
+            std::rotate(bars_.begin(), bars_.begin() + 1, bars_.end());
+            bars_[N - 1] = c;
+        }
+    }
+
+    CandleView view() const { return CandleView(bars_.data(), size_); }
+    size_t size() const { return size_; }
+
+private:
+    std::array<Candle, N> bars_{};
+    size_t size_ = 0;
+};
@@ -0,0 +1,704 @@
+#include "RollingKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "TechnicalAnalysis.h"
+
+// SSE2 is part of the x86-64 baseline; AVX2 functions are compiled for that
+// target individually and only called after the runtime check, so the rest of
+// the build needs no special flags. Other architectures use the scalar path.
+#if defined(__x86_64__) || defined(_M_X64)
+#define ROLLING_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ROLLING_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ROLLING_TARGET_AVX2
+#endif
+
+// Scalar helpers shared with the AVX2 kernels are inlined into them, so they
+// are compiled with VEX encoding there (a call out to SSE code from AVX code
+// costs a state transition)
+#if defined(_MSC_VER)
+#define ROLLING_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define ROLLING_INLINE inline __attribute__((always_inline))
+#else
+#define ROLLING_INLINE inline
+#endif
+
+namespace RollingKernels {
+
+namespace {
+
+// The windows of one call: window j is walked from first + j in steps of
+// `step` (+1 from its oldest value, or -1 from its newest). Consecutive
+// windows start at consecutive addresses, so one unaligned load fills a lane
+// per window.
+struct Windows {
+    const double* first;
+    ptrdiff_t step;
+    int period;
+};
+
+Windows makeWindows(std::span<const double> x, size_t firstEnd, int period, WindowSums sums) {
+    if (sums == WindowSums::ExactNewestFirst) return {x.data() + firstEnd, -1, period};
+    return {x.data() + firstEnd + 1 - period, 1, period};
+}
+
+bool validWindows(std::span<const double> x, size_t firstEnd, int period, size_t count) {
+    return period > 0 && firstEnd + 1 >= (size_t)period && firstEnd + count <= x.size();
+}
+
+// --- Scalar (reference) kernels: the loops the SIMD lanes reproduce ---
+
+// Exact window statistics: every window re-added
+void statsScalar(const Windows& w, size_t begin, size_t count, double* mean, double* stdDev) {
+    for (size_t j = begin; j < count; ++j) {
+        const double* p = w.first + j;
+        double sum = 0.0;
+        for (int k = 0; k < w.period; ++k) sum += p[k * w.step];
+        double m = sum / w.period;
+        mean[j] = m;
+        if (!stdDev) continue;
+
+        double varSum = 0.0;
+        for (int k = 0; k < w.period; ++k) {
+            double d = p[k * w.step] - m;
+            varSum += d * d;
+        }
+        stdDev[j] = std::sqrt(varSum / w.period);
+    }
+}
+
+// --- Sliding sums ---
+//
+// The windows of a call are cut into kSlidingChunks equal chunks plus a tail
+// (count % kSlidingChunks windows). Each is an independent chain: re-summed at
+// its first window and then every `period` windows, slid in between. SIMD
+// levels carry the chunks in lanes and the tail stays scalar, so the chains,
+// and therefore the results, are the same at every level.
+constexpr size_t kSlidingChunks = 4;
+
+struct SlidingChain {
+    double anchor;  // Sums are of x - anchor (the newest value at the last re-sum)
+    double sum;
+    double sumSq;
+    double run;     // Trailing values equal to last
+    double last;
+};
+
+ROLLING_INLINE SlidingChain resumChain(const double* oldest, int period) {
+    SlidingChain c;
+    c.last = oldest[period - 1];
+    c.anchor = c.last;
+    c.sum = 0.0;
+    c.sumSq = 0.0;
+    for (int k = 0; k < period; ++k) {
+        double d = oldest[k] - c.anchor;
+        c.sum = c.sum + d;
+        c.sumSq = c.sumSq + d * d;
+    }
+    int run = 1;
+    while (run < period && oldest[period - 1 - run] == c.last) ++run;
+    c.run = run;
+    return c;
+}
+
+ROLLING_INLINE void slideChain(SlidingChain& c, double leaving, double entering) {
+    double out = leaving - c.anchor;
+    double in = entering - c.anchor;
+    c.sum = (c.sum - out) + in;
+    c.sumSq = (c.sumSq - out * out) + in * in;
+    c.run = entering == c.last ? c.run + 1.0 : 1.0;
+    c.last = entering;
+}
+
+ROLLING_INLINE void emitChain(const SlidingChain& c, double n, double* mean, double* stdDev) {
+    double m = c.sum / n;
+    bool flat = c.run >= n;
+    *mean = flat ? c.last : c.anchor + m;
+    if (stdDev) *stdDev = flat ? 0.0 : std::sqrt(std::max(0.0, c.sumSq / n - m * m));
+}
+
+// One chain over windows [begin, end); `oldest` points at window 0's oldest value
+void slidingChainScalar(const double* oldest, int period, size_t begin, size_t end,
+                        double* mean, double* stdDev) {
+    SlidingChain c{};
+    for (size_t j = begin; j < end; ++j) {
+        if ((j - begin) % period == 0) {
+            c = resumChain(oldest + j, period);
+        } else {
+            slideChain(c, oldest[j - 1], oldest[j + period - 1]);
+        }
+        emitChain(c, period, mean + j, stdDev ? stdDev + j : nullptr);
+    }
+}
+
+void slidingScalar(const double* oldest, int period, size_t begin, size_t count,
+                   double* mean, double* stdDev) {
+    size_t chunk = count / kSlidingChunks;
+    for (size_t b = begin; b < kSlidingChunks * chunk; b += chunk) {
+        slidingChainScalar(oldest, period, b, b + chunk, mean, stdDev);
+    }
+    size_t tail = std::max(begin, kSlidingChunks * chunk);
+    slidingChainScalar(oldest, period, tail, count, mean, stdDev);
+}
+
+void bandsScalar(size_t begin, size_t count, double multiplier, const double* middle,
+                 const double* stdDev, double* upper, double* lower, double* bandwidth) {
+    for (size_t j = begin; j < count; ++j) {
+        upper[j] = middle[j] + (multiplier * stdDev[j]);
+        lower[j] = middle[j] - (multiplier * stdDev[j]);
+        bandwidth[j] = middle[j] > 0 ? (upper[j] - lower[j]) / middle[j] : 0.0;
+    }
+}
+
+void trueRangeScalar(size_t begin, size_t count, const double* high, const double* low,
+                     const double* close, double* out) {
+    for (size_t i = begin; i < count; ++i) {
+        double hl = high[i] - low[i];
+        double hpc = std::abs(high[i] - close[i - 1]);
+        double lpc = std::abs(low[i] - close[i - 1]);
+        out[i] = std::max({hl, hpc, lpc});
+    }
+}
+
+// Raw column pointers as a patternMaskAt accessor
+struct PatternColumns {
+    const double *open_, *high_, *low_, *close_;
+
+    double open(size_t i) const { return open_[i]; }
+    double high(size_t i) const { return high_[i]; }
+    double low(size_t i) const { return low_[i]; }
+    double close(size_t i) const { return close_[i]; }
+};
+
+// Tail (and scalar level) of candlePatterns; the first two bars stay 0
+void candlePatternsScalar(size_t begin, size_t count, const double* open, const double* high,
+                          const double* low, const double* close, uint8_t* mask) {
+    PatternColumns bars{open, high, low, close};
+    for (size_t i = std::max<size_t>(begin, 2); i < count; ++i) mask[i] = patternMaskAt(bars, i);
+}
+
+#if defined(ROLLING_KERNELS_X86)
+
+// Spread per-lane comparison bits (from movemask) into one mask byte per bar
+inline void scatterPatternBits(size_t lanes, int hammer, int shootingStar, int bullishEngulfing,
+                               int bearishEngulfing, int doji, uint8_t* mask) {
+    for (size_t j = 0; j < lanes; ++j) {
+        mask[j] = (uint8_t)((((hammer >> j) & 1) << (int)CandlePattern::Hammer) |
+                            (((shootingStar >> j) & 1) << (int)CandlePattern::ShootingStar) |
+                            (((bullishEngulfing >> j) & 1) << (int)CandlePattern::BullishEngulfing) |
+                            (((bearishEngulfing >> j) & 1) << (int)CandlePattern::BearishEngulfing) |
+                            (((doji >> j) & 1) << (int)CandlePattern::Doji));
+    }
+}
+
+// --- SSE2: two windows per iteration ---
+
+size_t statsSSE2(const Windows& w, size_t count, double* mean, double* stdDev) {
+    const __m128d n = _mm_set1_pd(w.period);
+    size_t j = 0;
+    for (; j + 2 <= count; j += 2) {
+        const double* p = w.first + j;
+        __m128d sum = _mm_setzero_pd();
+        for (int k = 0; k < w.period; ++k) sum = _mm_add_pd(sum, _mm_loadu_pd(p + k * w.step));
+        __m128d m = _mm_div_pd(sum, n);
+        _mm_storeu_pd(mean + j, m);
+        if (!stdDev) continue;
+
+        __m128d varSum = _mm_setzero_pd();
+        for (int k = 0; k < w.period; ++k) {
+            __m128d d = _mm_sub_pd(_mm_loadu_pd(p + k * w.step), m);
+            varSum = _mm_add_pd(varSum, _mm_mul_pd(d, d));
+        }
+        _mm_storeu_pd(stdDev + j, _mm_sqrt_pd(_mm_div_pd(varSum, n)));
+    }
+    return j;
+}
+
+// Two chunks per pass, one per lane; each block of `period` windows starts
+// from scalar re-sums
+size_t slidingSSE2(const double* oldest, int period, size_t count, double* mean, double* stdDev) {
+    const size_t chunk = count / kSlidingChunks;
+    const __m128d n = _mm_set1_pd(period);
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+    alignas(16) double lane[2];
+    for (size_t b0 = 0; b0 < kSlidingChunks * chunk; b0 += 2 * chunk) {
+        const size_t b1 = b0 + chunk;
+        for (size_t t0 = 0; t0 < chunk; t0 += period) {
+            SlidingChain c0 = resumChain(oldest + b0 + t0, period);
+            SlidingChain c1 = resumChain(oldest + b1 + t0, period);
+            emitChain(c0, period, mean + b0 + t0, stdDev ? stdDev + b0 + t0 : nullptr);
+            emitChain(c1, period, mean + b1 + t0, stdDev ? stdDev + b1 + t0 : nullptr);
+
+            __m128d anchor = _mm_set_pd(c1.anchor, c0.anchor);
+            __m128d sum = _mm_set_pd(c1.sum, c0.sum);
+            __m128d sumSq = _mm_set_pd(c1.sumSq, c0.sumSq);
+            __m128d run = _mm_set_pd(c1.run, c0.run);
+            __m128d last = _mm_set_pd(c1.last, c0.last);
+
+            const size_t tEnd = std::min(t0 + period, chunk);
+            for (size_t t = t0 + 1; t < tEnd; ++t) {
+                const double* p0 = oldest + b0 + t;
+                const double* p1 = oldest + b1 + t;
+                __m128d entering = _mm_set_pd(p1[period - 1], p0[period - 1]);
+                __m128d out = _mm_sub_pd(_mm_set_pd(p1[-1], p0[-1]), anchor);
+                __m128d in = _mm_sub_pd(entering, anchor);
+                sum = _mm_add_pd(_mm_sub_pd(sum, out), in);
+                sumSq = _mm_add_pd(_mm_sub_pd(sumSq, _mm_mul_pd(out, out)), _mm_mul_pd(in, in));
+                __m128d same = _mm_cmpeq_pd(entering, last);
+                run = _mm_or_pd(_mm_and_pd(same, _mm_add_pd(run, one)), _mm_andnot_pd(same, one));
+                last = entering;
+
+                __m128d m = _mm_div_pd(sum, n);
+                __m128d flat = _mm_cmpge_pd(run, n);
+                _mm_store_pd(lane, _mm_or_pd(_mm_and_pd(flat, last), _mm_andnot_pd(flat, _mm_add_pd(anchor, m))));
+                mean[b0 + t] = lane[0];
+                mean[b1 + t] = lane[1];
+                if (!stdDev) continue;
+
+                __m128d var = _mm_max_pd(_mm_sub_pd(_mm_div_pd(sumSq, n), _mm_mul_pd(m, m)), zero);
+                _mm_store_pd(lane, _mm_andnot_pd(flat, _mm_sqrt_pd(var)));
+                stdDev[b0 + t] = lane[0];
+                stdDev[b1 + t] = lane[1];
+            }
+        }
+    }
+    return kSlidingChunks * chunk;
+}
+
+size_t bandsSSE2(size_t count, double multiplier, const double* middle, const double* stdDev,
+                 double* upper, double* lower, double* bandwidth) {
+    const __m128d mult = _mm_set1_pd(multiplier);
+    const __m128d zero = _mm_setzero_pd();
+    size_t j = 0;
+    for (; j + 2 <= count; j += 2) {
+        __m128d m = _mm_loadu_pd(middle + j);
+        __m128d width = _mm_mul_pd(mult, _mm_loadu_pd(stdDev + j));
+        __m128d up = _mm_add_pd(m, width);
+        __m128d lo = _mm_sub_pd(m, width);
+        __m128d bw = _mm_div_pd(_mm_sub_pd(up, lo), m);
+        _mm_storeu_pd(upper + j, up);
+        _mm_storeu_pd(lower + j, lo);
+        _mm_storeu_pd(bandwidth + j, _mm_and_pd(_mm_cmpgt_pd(m, zero), bw));
+    }
+    return j;
+}
+
+size_t trueRangeSSE2(size_t count, const double* high, const double* low, const double* close,
+                     double* out) {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        __m128d h = _mm_loadu_pd(high + i);
+        __m128d l = _mm_loadu_pd(low + i);
+        __m128d pc = _mm_loadu_pd(close + i - 1);
+        __m128d hl = _mm_sub_pd(h, l);
+        __m128d hpc = _mm_andnot_pd(signMask, _mm_sub_pd(h, pc));
+        __m128d lpc = _mm_andnot_pd(signMask, _mm_sub_pd(l, pc));
+        // max_pd(a, b) is a > b ? a : b, so this keeps std::max's first-wins order
+        __m128d tr = _mm_max_pd(lpc, _mm_max_pd(hpc, hl));
+        _mm_storeu_pd(out + i, tr);
+    }
+    return i;
+}
+
+// Two bars per iteration; patternMaskAt's comparisons become lane masks
+size_t candlePatternsSSE2(size_t count, const double* open, const double* high, const double* low,
+                          const double* close, uint8_t* mask) {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d two = _mm_set1_pd(2.0), half = _mm_set1_pd(0.5), tenth = _mm_set1_pd(0.1);
+    const __m128d three = _mm_set1_pd(3.0);
+    size_t i = 2;
+    for (; i + 2 <= count; i += 2) {
+        __m128d o = _mm_loadu_pd(open + i), h = _mm_loadu_pd(high + i);
+        __m128d l = _mm_loadu_pd(low + i), c = _mm_loadu_pd(close + i);
+        __m128d po = _mm_loadu_pd(open + i - 1), pc = _mm_loadu_pd(close + i - 1);
+        __m128d ppo = _mm_loadu_pd(open + i - 2), ppc = _mm_loadu_pd(close + i - 2);
+
+        __m128d body = _mm_andnot_pd(signMask, _mm_sub_pd(c, o));
+        __m128d range = _mm_sub_pd(h, l);
+        // max_pd(c, o) is c > o ? c : o, as std::max(o, c); likewise min
+        __m128d upperShadow = _mm_sub_pd(h, _mm_max_pd(c, o));
+        __m128d lowerShadow = _mm_sub_pd(_mm_min_pd(c, o), l);
+        __m128d avgBody = _mm_add_pd(_mm_add_pd(body, _mm_andnot_pd(signMask, _mm_sub_pd(pc, po))),
+                                     _mm_andnot_pd(signMask, _mm_sub_pd(ppc, ppo)));
+        avgBody = _mm_div_pd(avgBody, three);
+
+        __m128d isBullish = _mm_cmpgt_pd(c, o), isBearish = _mm_cmplt_pd(c, o);
+        __m128d pBullish = _mm_cmpgt_pd(pc, po), pBearish = _mm_cmplt_pd(pc, po);
+        __m128d longBody = _mm_mul_pd(two, body), halfBody = _mm_mul_pd(body, half);
+
+        __m128d hammer = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(lowerShadow, longBody),
+                                               _mm_cmplt_pd(upperShadow, halfBody)), isBullish);
+        __m128d shootingStar = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(upperShadow, longBody),
+                                                     _mm_cmplt_pd(lowerShadow, halfBody)), isBearish);
+        __m128d bullishEngulfing = _mm_and_pd(_mm_and_pd(pBearish, isBullish),
+                                              _mm_and_pd(_mm_cmpgt_pd(c, po), _mm_cmplt_pd(o, pc)));
+        __m128d bearishEngulfing = _mm_and_pd(_mm_and_pd(pBullish, isBearish),
+                                              _mm_and_pd(_mm_cmplt_pd(c, po), _mm_cmpgt_pd(o, pc)));
+        __m128d doji = _mm_and_pd(_mm_cmplt_pd(body, _mm_mul_pd(tenth, range)), _mm_cmpgt_pd(range, avgBody));
+
+        scatterPatternBits(2, _mm_movemask_pd(hammer), _mm_movemask_pd(shootingStar),
+                           _mm_movemask_pd(bullishEngulfing), _mm_movemask_pd(bearishEngulfing),
+                           _mm_movemask_pd(doji), mask + i);
+    }
+    return i;
+}
+
+// --- AVX2: four windows per iteration ---
+
+ROLLING_TARGET_AVX2
+size_t statsAVX2(const Windows& w, size_t count, double* mean, double* stdDev) {
+    const __m256d n = _mm256_set1_pd(w.period);
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        const double* p = w.first + j;
+        __m256d sum = _mm256_setzero_pd();
+        for (int k = 0; k < w.period; ++k) sum = _mm256_add_pd(sum, _mm256_loadu_pd(p + k * w.step));
+        __m256d m = _mm256_div_pd(sum, n);
+        _mm256_storeu_pd(mean + j, m);
+        if (!stdDev) continue;
+
+        __m256d varSum = _mm256_setzero_pd();
+        for (int k = 0; k < w.period; ++k) {
+            __m256d d = _mm256_sub_pd(_mm256_loadu_pd(p + k * w.step), m);
+            varSum = _mm256_add_pd(varSum, _mm256_mul_pd(d, d));
+        }
+        _mm256_storeu_pd(stdDev + j, _mm256_sqrt_pd(_mm256_div_pd(varSum, n)));
+    }
+    return j;
+}
+
+// All four chunks per pass, one per lane
+ROLLING_TARGET_AVX2
+size_t slidingAVX2(const double* oldest, int period, size_t count, double* mean, double* stdDev) {
+    const size_t chunk = count / kSlidingChunks;
+    const __m256d n = _mm256_set1_pd(period);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    alignas(32) double lane[4];
+    for (size_t t0 = 0; t0 < chunk; t0 += period) {
+        SlidingChain c[4];
+        for (size_t l = 0; l < 4; ++l) {
+            size_t j = l * chunk + t0;
+            c[l] = resumChain(oldest + j, period);
+            emitChain(c[l], period, mean + j, stdDev ? stdDev + j : nullptr);
+        }
+
+        __m256d anchor = _mm256_set_pd(c[3].anchor, c[2].anchor, c[1].anchor, c[0].anchor);
+        __m256d sum = _mm256_set_pd(c[3].sum, c[2].sum, c[1].sum, c[0].sum);
+        __m256d sumSq = _mm256_set_pd(c[3].sumSq, c[2].sumSq, c[1].sumSq, c[0].sumSq);
+        __m256d run = _mm256_set_pd(c[3].run, c[2].run, c[1].run, c[0].run);
+        __m256d last = _mm256_set_pd(c[3].last, c[2].last, c[1].last, c[0].last);
+
+        const size_t tEnd = std::min(t0 + period, chunk);
+        for (size_t t = t0 + 1; t < tEnd; ++t) {
+            const double* p0 = oldest + t;
+            const double* p1 = p0 + chunk;
+            const double* p2 = p1 + chunk;
+            const double* p3 = p2 + chunk;
+            __m256d entering = _mm256_set_pd(p3[period - 1], p2[period - 1], p1[period - 1], p0[period - 1]);
+            __m256d out = _mm256_sub_pd(_mm256_set_pd(p3[-1], p2[-1], p1[-1], p0[-1]), anchor);
+            __m256d in = _mm256_sub_pd(entering, anchor);
+            sum = _mm256_add_pd(_mm256_sub_pd(sum, out), in);
+            sumSq = _mm256_add_pd(_mm256_sub_pd(sumSq, _mm256_mul_pd(out, out)), _mm256_mul_pd(in, in));
+            __m256d same = _mm256_cmp_pd(entering, last, _CMP_EQ_OQ);
+            run = _mm256_blendv_pd(one, _mm256_add_pd(run, one), same);
+            last = entering;
+
+            __m256d m = _mm256_div_pd(sum, n);
+            __m256d flat = _mm256_cmp_pd(run, n, _CMP_GE_OQ);
+            _mm256_store_pd(lane, _mm256_blendv_pd(_mm256_add_pd(anchor, m), last, flat));
+            for (size_t l = 0; l < 4; ++l) mean[l * chunk + t] = lane[l];
+            if (!stdDev) continue;
+
+            __m256d var = _mm256_max_pd(_mm256_sub_pd(_mm256_div_pd(sumSq, n), _mm256_mul_pd(m, m)), zero);
+            _mm256_store_pd(lane, _mm256_andnot_pd(flat, _mm256_sqrt_pd(var)));
+            for (size_t l = 0; l < 4; ++l) stdDev[l * chunk + t] = lane[l];
+        }
+    }
+    return kSlidingChunks * chunk;
+}
+
+ROLLING_TARGET_AVX2
+size_t bandsAVX2(size_t count, double multiplier, const double* middle, const double* stdDev,
+                 double* upper, double* lower, double* bandwidth) {
+    const __m256d mult = _mm256_set1_pd(multiplier);
+    const __m256d zero = _mm256_setzero_pd();
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m256d m = _mm256_loadu_pd(middle + j);
+        __m256d width = _mm256_mul_pd(mult, _mm256_loadu_pd(stdDev + j));
+        __m256d up = _mm256_add_pd(m, width);
+        __m256d lo = _mm256_sub_pd(m, width);
+        __m256d bw = _mm256_div_pd(_mm256_sub_pd(up, lo), m);
+        _mm256_storeu_pd(upper + j, up);
+        _mm256_storeu_pd(lower + j, lo);
+        _mm256_storeu_pd(bandwidth + j, _mm256_and_pd(_mm256_cmp_pd(m, zero, _CMP_GT_OQ), bw));
+    }
+    return j;
+}
+
+ROLLING_TARGET_AVX2
+size_t trueRangeAVX2(size_t count, const double* high, const double* low, const double* close,
+                     double* out) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m256d h = _mm256_loadu_pd(high + i);
+        __m256d l = _mm256_loadu_pd(low + i);
+        __m256d pc = _mm256_loadu_pd(close + i - 1);
+        __m256d hl = _mm256_sub_pd(h, l);
+        __m256d hpc = _mm256_andnot_pd(signMask, _mm256_sub_pd(h, pc));
+        __m256d lpc = _mm256_andnot_pd(signMask, _mm256_sub_pd(l, pc));
+        __m256d tr = _mm256_max_pd(lpc, _mm256_max_pd(hpc, hl));
+        _mm256_storeu_pd(out + i, tr);
+    }
+    return i;
+}
+
+ROLLING_TARGET_AVX2
+size_t candlePatternsAVX2(size_t count, const double* open, const double* high, const double* low,
+                          const double* close, uint8_t* mask) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d two = _mm256_set1_pd(2.0), half = _mm256_set1_pd(0.5), tenth = _mm256_set1_pd(0.1);
+    const __m256d three = _mm256_set1_pd(3.0);
+    size_t i = 2;
+    for (; i + 4 <= count; i += 4) {
+        __m256d o = _mm256_loadu_pd(open + i), h = _mm256_loadu_pd(high + i);
+        __m256d l = _mm256_loadu_pd(low + i), c = _mm256_loadu_pd(close + i);
+        __m256d po = _mm256_loadu_pd(open + i - 1), pc = _mm256_loadu_pd(close + i - 1);
+        __m256d ppo = _mm256_loadu_pd(open + i - 2), ppc = _mm256_loadu_pd(close + i - 2);
+
+        __m256d body = _mm256_andnot_pd(signMask, _mm256_sub_pd(c, o));
+        __m256d range = _mm256_sub_pd(h, l);
+        __m256d upperShadow = _mm256_sub_pd(h, _mm256_max_pd(c, o));
+        __m256d lowerShadow = _mm256_sub_pd(_mm256_min_pd(c, o), l);
+        __m256d avgBody = _mm256_add_pd(_mm256_add_pd(body, _mm256_andnot_pd(signMask, _mm256_sub_pd(pc, po))),
+                                        _mm256_andnot_pd(signMask, _mm256_sub_pd(ppc, ppo)));
+        avgBody = _mm256_div_pd(avgBody, three);
+
+        __m256d isBullish = _mm256_cmp_pd(c, o, _CMP_GT_OQ), isBearish = _mm256_cmp_pd(c, o, _CMP_LT_OQ);
+        __m256d pBullish = _mm256_cmp_pd(pc, po, _CMP_GT_OQ), pBearish = _mm256_cmp_pd(pc, po, _CMP_LT_OQ);
+        __m256d longBody = _mm256_mul_pd(two, body), halfBody = _mm256_mul_pd(body, half);
+
+        __m256d hammer = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(lowerShadow, longBody, _CMP_GT_OQ),
+                                                     _mm256_cmp_pd(upperShadow, halfBody, _CMP_LT_OQ)), isBullish);
+        __m256d shootingStar = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(upperShadow, longBody, _CMP_GT_OQ),
+                                                           _mm256_cmp_pd(lowerShadow, halfBody, _CMP_LT_OQ)), isBearish);
+        __m256d bullishEngulfing = _mm256_and_pd(_mm256_and_pd(pBearish, isBullish),
+                                                 _mm256_and_pd(_mm256_cmp_pd(c, po, _CMP_GT_OQ),
+                                                               _mm256_cmp_pd(o, pc, _CMP_LT_OQ)));
+        __m256d bearishEngulfing = _mm256_and_pd(_mm256_and_pd(pBullish, isBearish),
+                                                 _mm256_and_pd(_mm256_cmp_pd(c, po, _CMP_LT_OQ),
+                                                               _mm256_cmp_pd(o, pc, _CMP_GT_OQ)));
+        __m256d doji = _mm256_and_pd(_mm256_cmp_pd(body, _mm256_mul_pd(tenth, range), _CMP_LT_OQ),
+                                     _mm256_cmp_pd(range, avgBody, _CMP_GT_OQ));
+
+        scatterPatternBits(4, _mm256_movemask_pd(hammer), _mm256_movemask_pd(shootingStar),
+                           _mm256_movemask_pd(bullishEngulfing), _mm256_movemask_pd(bearishEngulfing),
+                           _mm256_movemask_pd(doji), mask + i);
+    }
+    return i;
+}
+
+#endif  // ROLLING_KERNELS_X86
+
+std::atomic<SimdLevel>& activeLevel() {
+    static std::atomic<SimdLevel> level{detectedSimdLevel()};
+    return level;
+}
+
+// Mean (and optionally standard deviation) of every window
+void stats(std::span<const double> x, size_t firstEnd, int period, WindowSums sums, size_t count,
+           double* mean, double* stdDev) {
+    size_t done = 0;
+    if (sums == WindowSums::Sliding) {
+        const double* oldest = x.data() + firstEnd + 1 - period;
+#if defined(ROLLING_KERNELS_X86)
+        switch (activeSimdLevel()) {
+            case SimdLevel::AVX2: done = slidingAVX2(oldest, period, count, mean, stdDev); break;
+            case SimdLevel::SSE2: done = slidingSSE2(oldest, period, count, mean, stdDev); break;
+            case SimdLevel::Scalar: break;
+        }
+#endif
+        slidingScalar(oldest, period, done, count, mean, stdDev);
+        return;
+    }
+
+    Windows w = makeWindows(x, firstEnd, period, sums);
+#if defined(ROLLING_KERNELS_X86)
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX2: done = statsAVX2(w, count, mean, stdDev); break;
+        case SimdLevel::SSE2: done = statsSSE2(w, count, mean, stdDev); break;
+        case SimdLevel::Scalar: break;
+    }
+#endif
+    statsScalar(w, done, count, mean, stdDev);
+}
+
+}  // namespace
+
+const char* toString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+SimdLevel detectedSimdLevel() {
+#if defined(ROLLING_KERNELS_X86)
+    static const SimdLevel level = [] {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        // The OS must also save the YMM registers
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5)) return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#endif
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel activeSimdLevel() {
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) {
+    activeLevel().store(std::min(level, detectedSimdLevel()), std::memory_order_relaxed);
+}
+
+void rollingMean(std::span<const double> x, size_t firstEnd, int period,
+                 std::span<double> mean, WindowSums sums) {
+    if (!validWindows(x, firstEnd, period, mean.size())) {
+        std::fill(mean.begin(), mean.end(), 0.0);
+        return;
+    }
+    stats(x, firstEnd, period, sums, mean.size(), mean.data(), nullptr);
+}
+
+void rollingStdDev(std::span<const double> x, size_t firstEnd, int period,
+                   std::span<double> mean, std::span<double> stdDev, WindowSums sums) {
+    size_t count = std::min(mean.size(), stdDev.size());
+    if (!validWindows(x, firstEnd, period, count)) {
+        std::fill(mean.begin(), mean.end(), 0.0);
+        std::fill(stdDev.begin(), stdDev.end(), 0.0);
+        return;
+    }
+    stats(x, firstEnd, period, sums, count, mean.data(), stdDev.data());
+}
+
+void rollingBollinger(std::span<const double> x, size_t firstEnd, int period, double multiplier,
+                      std::span<double> upper, std::span<double> middle,
+                      std::span<double> lower, std::span<double> bandwidth, WindowSums sums) {
+    size_t count = std::min({upper.size(), middle.size(), lower.size(), bandwidth.size()});
+    if (!validWindows(x, firstEnd, period, count)) {
+        for (auto out : {upper, middle, lower, bandwidth}) std::fill(out.begin(), out.end(), 0.0);
+        return;
+    }
+
+    // Standard deviation goes through `lower` and is overwritten by the band
+    double* stdDev = lower.data();
+    stats(x, firstEnd, period, sums, count, middle.data(), stdDev);
+
+    size_t done = 0;
+#if defined(ROLLING_KERNELS_X86)
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX2:
+            done = bandsAVX2(count, multiplier, middle.data(), stdDev, upper.data(), lower.data(), bandwidth.data());
+            break;
+        case SimdLevel::SSE2:
+            done = bandsSSE2(count, multiplier, middle.data(), stdDev, upper.data(), lower.data(), bandwidth.data());
+            break;
+        case SimdLevel::Scalar:
+            break;
+    }
+#endif
+    bandsScalar(done, count, multiplier, middle.data(), stdDev, upper.data(), lower.data(), bandwidth.data());
+}
+
+void trueRange(std::span<const double> high, std::span<const double> low,
+               std::span<const double> close, std::span<double> out) {
+    size_t n = std::min({high.size(), low.size(), close.size(), out.size()});
+    if (n == 0) return;
+    out[0] = high[0] - low[0];
+
+    size_t done = 1;
+#if defined(ROLLING_KERNELS_X86)
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX2: done = trueRangeAVX2(n, high.data(), low.data(), close.data(), out.data()); break;
+        case SimdLevel::SSE2: done = trueRangeSSE2(n, high.data(), low.data(), close.data(), out.data()); break;
+        case SimdLevel::Scalar: break;
+    }
+#endif
+    trueRangeScalar(done, n, high.data(), low.data(), close.data(), out.data());
+}
+
+void averageTrueRange(std::span<const double> high, std::span<const double> low,
+                      std::span<const double> close, int period, std::span<double> out) {
+    size_t n = std::min({high.size(), low.size(), close.size(), out.size()});
+    if (period <= 0 || n <= (size_t)period) {
+        std::fill(out.begin(), out.end(), 0.0);
+        return;
+    }
+
+    // True ranges in place, then Wilder smoothing over them
+    trueRange(high.first(n), low.first(n), close.first(n), out.first(n));
+    double atr = 0.0;
+    for (int i = 0; i < period; ++i) {
+        atr += out[i];
+        out[i] = 0.0;
+    }
+    atr /= period;
+    for (size_t i = period; i < n; ++i) {
+        atr = (atr * (period - 1) + out[i]) / period;
+        out[i] = atr;
+    }
+}
+
+void candlePatterns(std::span<const double> open, std::span<const double> high,
+                    std::span<const double> low, std::span<const double> close, std::span<uint8_t> mask) {
+    size_t n = std::min({open.size(), high.size(), low.size(), close.size(), mask.size()});
+    std::fill(mask.begin(), mask.begin() + std::min<size_t>(n, 2), 0);
+
+    size_t done = 2;
+#if defined(ROLLING_KERNELS_X86)
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX2:
+            done = candlePatternsAVX2(n, open.data(), high.data(), low.data(), close.data(), mask.data());
+            break;
+        case SimdLevel::SSE2:
+            done = candlePatternsSSE2(n, open.data(), high.data(), low.data(), close.data(), mask.data());
+            break;
+        case SimdLevel::Scalar:
+            break;
+    }
+#endif
+    candlePatternsScalar(done, n, open.data(), high.data(), low.data(), close.data(), mask.data());
+}
+
+}  // namespace RollingKernels
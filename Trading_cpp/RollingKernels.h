@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Vectorised rolling-window kernels (SSE2 / AVX2 with a scalar fallback).
+//
+// Every lane performs the scalar code's exact sequence of adds, multiplies,
+// divides and square roots (no FMA), so results are bit-identical whatever
+// instruction set is selected. The window statistics either carry running
+// sums from one window to the next (WindowSums::Sliding, one independent chain
+// of windows per lane) or re-add every window (the exact modes, one window per
+// lane).
+//
+// Window j of a call covers x[firstEnd + j - period + 1 .. firstEnd + j], for
+// every j in [0, out.size()); firstEnd must be at least period - 1.
+namespace RollingKernels {
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+const char* toString(SimdLevel level);
+
+// Best level this CPU (and build) supports
+SimdLevel detectedSimdLevel();
+
+// Level the kernels currently use; defaults to detectedSimdLevel()
+SimdLevel activeSimdLevel();
+
+// Force a level (clamped to what the CPU supports), e.g. to benchmark or test
+// the scalar path. Not meant to be changed while kernels are running.
+void setSimdLevel(SimdLevel level);
+
+// How the window statistics are summed.
+//
+// Sliding: a running sum and sum of squares, each window's following from the
+// previous one's by adding the value entering and subtracting the one
+// leaving, so a window costs O(1) whatever the period. The sums are taken
+// around a recent value and re-added once per `period` windows, so they
+// match the exact modes up to rounding; a window of identical values comes
+// out exactly (that mean, zero deviation).
+//
+// ExactOldestFirst / ExactNewestFirst: every window re-added in that order
+// with a two-pass deviation, O(period) per window, bit-identical to the
+// scalar definition (computeBollingerBands on one window; NewestFirst is the
+// original squeeze loop).
+enum class WindowSums { Sliding, ExactOldestFirst, ExactNewestFirst };
+
+// Rolling mean (SMA)
+void rollingMean(std::span<const double> x, size_t firstEnd, int period,
+                 std::span<double> mean, WindowSums sums = WindowSums::Sliding);
+
+// Rolling mean and population standard deviation
+void rollingStdDev(std::span<const double> x, size_t firstEnd, int period,
+                   std::span<double> mean, std::span<double> stdDev,
+                   WindowSums sums = WindowSums::Sliding);
+
+// Bollinger Bands; bandwidth is 0 where the middle band is not positive
+void rollingBollinger(std::span<const double> x, size_t firstEnd, int period, double multiplier,
+                      std::span<double> upper, std::span<double> middle,
+                      std::span<double> lower, std::span<double> bandwidth,
+                      WindowSums sums = WindowSums::Sliding);
+
+// True range per bar (high - low for bar 0)
+void trueRange(std::span<const double> high, std::span<const double> low,
+               std::span<const double> close, std::span<double> out);
+
+// Wilder ATR as computeATRSeries: 0 until period + 1 bars. The true ranges are
+// vectorised; the smoothing recurrence is inherently serial and stays scalar.
+void averageTrueRange(std::span<const double> high, std::span<const double> low,
+                      std::span<const double> close, int period, std::span<double> out);
+
+// Candlestick pattern bits per bar: patternMaskAt (TechnicalAnalysis.h) at
+// every i >= 2, the first two bars are 0. The scalar level calls it; the rules
+// are comparisons, so the SIMD levels redo its arithmetic per lane and must
+// give the same bits.
+void candlePatterns(std::span<const double> open, std::span<const double> high,
+                    std::span<const double> low, std::span<const double> close, std::span<uint8_t> mask);
+
+}  // namespace RollingKernels
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "TechnicalAnalysis.h"
+
+// Structured signal reasons. Built-in strategies record why a signal fired
+// as a code plus up to three numbers (StrategySignal::reasonCode,
+// reasonFlags, reasonValues) instead of formatting a string on every bar.
+// The text is only built on demand, by formatSignalReason(), for reports and
+// live output.
+enum class SignalReason : uint8_t {
+    None,                       // No code: StrategySignal::reason is the text
+    InsufficientData,
+    IncrementalUnsupported,
+
+    // Trend following: values = {ADX, +DI (up) or -DI (down)}
+    MACrossUp,
+    MACrossDown,
+    TrendContinuationUp,
+    TrendContinuationDown,
+    TrendWeakening,             // {ADX}
+    NoTrendSignal,
+
+    // Triple MA: values = {ADX}
+    TripleMABullish,
+    TripleMABearish,
+    MAsNotAligned,
+
+    // Mean reversion: values = {RSI}, qualifiers in the flags
+    BelowBBLower,
+    AboveBBUpper,
+    NoMeanReversionSignal,
+    VolumeFilter,
+
+    // ML: values = {predicted return in percent}
+    MLPrediction,
+    MLBelowThreshold,
+
+    // Hybrid ML: values = {ML signal, technical signal} / {combined signal}
+    HybridSignal,
+    HybridBelowThreshold,
+
+    // Ensemble: values = {agreeing, total} / {buy, sell, total}.
+    // For EnsembleConsensus the flags are a bitmask of the agreeing children.
+    EnsembleConsensus,
+    NoEnsembleConsensus,
+    NoChildStrategies
+};
+
+// Qualifier bits for StrategySignal::reasonFlags. Bits 8-15 hold the
+// CandlePattern that confirmed (or opposed) the signal.
+namespace SignalReasonFlag {
+    constexpr uint32_t Squeeze = 1u << 0;
+    constexpr uint32_t SqueezeBreakout = 1u << 1;
+    constexpr uint32_t OpposingPattern = 1u << 2;
+    constexpr uint32_t ReducedUptrend = 1u << 3;
+    constexpr uint32_t ReducedDowntrend = 1u << 4;
+
+    constexpr int kPatternShift = 8;
+    constexpr uint32_t kPatternMask = 0xFFu << kPatternShift;
+
+    constexpr uint32_t pattern(CandlePattern p) {
+        return static_cast<uint32_t>(p) << kPatternShift;
+    }
+
+    constexpr CandlePattern patternOf(uint32_t flags) {
+        return static_cast<CandlePattern>((flags & kPatternMask) >> kPatternShift);
+    }
+}
+
+// Render a reason code as text
+inline std::string formatSignalReason(SignalReason code, uint32_t flags, const double (&v)[3]) {
+    auto i = [&](int k) { return std::to_string((int)v[k]); };
+
+    std::string text;
+    switch (code) {
+        case SignalReason::None: break;
+        case SignalReason::InsufficientData: text = "Insufficient data"; break;
+        case SignalReason::IncrementalUnsupported: text = "Incremental mode not supported"; break;
+
+        case SignalReason::MACrossUp: text = "MA Cross Up, ADX: " + i(0) + ", +DI: " + i(1); break;
+        case SignalReason::MACrossDown: text = "MA Cross Down, ADX: " + i(0) + ", -DI: " + i(1); break;
+        case SignalReason::TrendContinuationUp:
+            text = "Trend Continuation Up, ADX: " + i(0) + ", +DI: " + i(1);
+            break;
+        case SignalReason::TrendContinuationDown:
+            text = "Trend Continuation Down, ADX: " + i(0) + ", -DI: " + i(1);
+            break;
+        case SignalReason::TrendWeakening: text = "Trend weakening, ADX: " + i(0); break;
+        case SignalReason::NoTrendSignal: text = "No trend signal"; break;
+
+        case SignalReason::TripleMABullish: text = "Triple MA aligned bullish, ADX: " + i(0); break;
+        case SignalReason::TripleMABearish: text = "Triple MA aligned bearish, ADX: " + i(0); break;
+        case SignalReason::MAsNotAligned: text = "MAs not aligned"; break;
+
+        case SignalReason::BelowBBLower: text = "RSI: " + i(0) + ", Below BB Lower"; break;
+        case SignalReason::AboveBBUpper: text = "RSI: " + i(0) + ", Above BB Upper"; break;
+        case SignalReason::NoMeanReversionSignal: text = "No mean reversion signal"; break;
+        case SignalReason::VolumeFilter: text = "Volume filter: insufficient volume confirmation"; break;
+
+        case SignalReason::MLPrediction:
+            text = "ML Prediction: " + std::to_string(v[0]) + "% expected return";
+            break;
+        case SignalReason::MLBelowThreshold:
+            text = "ML prediction below threshold: " + std::to_string(v[0]) + "%";
+            break;
+
+        case SignalReason::HybridSignal:
+            text = "Hybrid: ML=" + std::to_string(v[0]) + ", Tech=" + std::to_string(v[1]);
+            break;
+        case SignalReason::HybridBelowThreshold:
+            text = "Combined signal below threshold: " + std::to_string(v[0]);
+            break;
+
+        case SignalReason::EnsembleConsensus:
+            // Child names are added by EnsembleStrategy::describeSignal()
+            return "Ensemble(" + i(0) + "/" + i(1) + ")";
+        case SignalReason::NoEnsembleConsensus:
+            return "No ensemble consensus (" + i(0) + " buy, " + i(1) + " sell of " + i(2) + ")";
+        case SignalReason::NoChildStrategies: return "No child strategies";
+    }
+
+    if (flags & SignalReasonFlag::Squeeze) text += ", Squeeze";
+    else if (flags & SignalReasonFlag::SqueezeBreakout) text += ", SqueezeBreakout";
+
+    CandlePattern pattern = SignalReasonFlag::patternOf(flags);
+    if (pattern != CandlePattern::None) {
+        text += (flags & SignalReasonFlag::OpposingPattern) ? ", opposing " : ", ";
+        text += candlePatternName(pattern);
+    }
+
+    if (flags & SignalReasonFlag::ReducedUptrend) text += " (reduced: uptrend)";
+    if (flags & SignalReasonFlag::ReducedDowntrend) text += " (reduced: downtrend)";
+    return text;
+}
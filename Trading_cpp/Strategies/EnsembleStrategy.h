@@ -18,12 +18,16 @@ private:
         double confidence;
         double stopLoss;
         double takeProfit;
-        std::string name;
+        size_t child;       // Index into children_
     };
 
     std::vector<std::unique_ptr<IStrategy>> children_;
     double requiredAgreement_ = 0.5;  // Fraction of strategies that must agree
 
+    // Per-bar scratch, sized once so combining never allocates
+    std::vector<ChildSignal> buySignals_;
+    std::vector<ChildSignal> sellSignals_;
+
 public:
     EnsembleStrategy(std::vector<std::unique_ptr<IStrategy>> children,
                      double requiredAgreement = 0.5)
@@ -35,87 +39,154 @@ public:
         for (const auto& child : children_) {
             warmupPeriod_ = std::max(warmupPeriod_, child->getWarmupPeriod());
         }
+        buySignals_.reserve(children_.size());
+        sellSignals_.reserve(children_.size());
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
+        return combine([&](size_t k) { return children_[k]->generateSignal(history, idx); });
+    }
+
+    // Children read their indicators from the shared context, so series they
+    // have in common (closes, ATR(14), ...) are computed once per history
+    StrategySignal generateSignal(IndicatorContext& context, size_t idx) override {
+        return combine([&](size_t k) { return children_[k]->generateSignal(context, idx); });
+    }
+
+    // Each child produces its whole signal array in its own fastest mode,
+    // then the arrays are combined bar by bar
+    using StrategyBase::generateSignals;
+    SignalArray generateSignals(IndicatorContext& context, size_t firstBar) override {
+        reset();
+        std::vector<SignalArray> childSignals;
+        childSignals.reserve(children_.size());
+        for (auto& child : children_) {
+            childSignals.push_back(child->generateSignals(context, firstBar));
+        }
+
+        SignalArray out(context.size(), firstBar);
+        for (size_t i = firstBar; i < context.size(); ++i) {
+            out.set(i, combine([&](size_t k) { return childSignals[k].at(i); }));
+        }
+        return out;
+    }
+
+    // Incremental mode is available when every child supports it
+    bool supportsIncremental() const override {
+        if (children_.empty()) return false;
+        for (const auto& child : children_) {
+            if (!child->supportsIncremental()) return false;
+        }
+        return true;
+    }
+
+    void onBar(const Candle& bar) override {
+        ++barsSeen_;
+        for (auto& child : children_) {
+            child->onBar(bar);
+        }
+        currentSignal_ = combine([&](size_t k) { return children_[k]->currentSignal(); });
+    }
+
+    std::unique_ptr<IStrategy> clone() const override {
+        std::vector<std::unique_ptr<IStrategy>> clonedChildren;
+        for (const auto& child : children_) {
+            clonedChildren.push_back(child->clone());
+        }
+        return std::make_unique<EnsembleStrategy>(std::move(clonedChildren), requiredAgreement_);
+    }
+
+    void reset() override {
+        StrategyBase::reset();
+        for (auto& child : children_) {
+            child->reset();
+        }
+    }
+
+    int getWarmupPeriod() const override {
+        int maxWarmup = 0;
+        for (const auto& child : children_) {
+            maxWarmup = std::max(maxWarmup, child->getWarmupPeriod());
+        }
+        return maxWarmup;
+    }
+
+    // "Ensemble(2/2): MeanReversion | TrendFollowing"
+    std::string describeSignal(const StrategySignal& signal) const override {
+        if (signal.reasonCode != SignalReason::EnsembleConsensus || !signal.reason.empty()) {
+            return signal.reasonText();
+        }
+        std::string text = signal.reasonText() + ": ";
+        bool first = true;
+        for (size_t i = 0; i < children_.size() && i < 32; ++i) {
+            if (!(signal.reasonFlags & (1u << i))) continue;
+            if (!first) text += " | ";
+            text += children_[i]->getName();
+            first = false;
+        }
+        return text;
+    }
+
+private:
+    // Build the consensus from each child's signal for the current bar
+    template <typename ChildSignalFn>
+    StrategySignal combine(ChildSignalFn&& childSignal) {
         if (children_.empty()) {
-            return StrategySignal::hold("No child strategies");
+            return StrategySignal::hold(SignalReason::NoChildStrategies);
         }
 
         // Collect signals from all children
-        std::vector<ChildSignal> buySignals;
-        std::vector<ChildSignal> sellSignals;
+        buySignals_.clear();
+        sellSignals_.clear();
 
-        for (auto& child : children_) {
-            StrategySignal sig = child->generateSignal(history, idx);
+        for (size_t k = 0; k < children_.size(); ++k) {
+            StrategySignal sig = childSignal(k);
 
             if (sig.type == SignalType::Buy) {
-                buySignals.push_back({
+                buySignals_.push_back({
                     sig.type,
                     std::abs(sig.strength),
                     sig.confidence,
                     sig.stopLossPrice,
                     sig.takeProfitPrice,
-                    child->getName()
+                    k
                 });
             } else if (sig.type == SignalType::Sell) {
-                sellSignals.push_back({
+                sellSignals_.push_back({
                     sig.type,
                     std::abs(sig.strength),
                     sig.confidence,
                     sig.stopLossPrice,
                     sig.takeProfitPrice,
-                    child->getName()
+                    k
                 });
             }
         }
 
         int total = static_cast<int>(children_.size());
-        int buyCount = static_cast<int>(buySignals.size());
-        int sellCount = static_cast<int>(sellSignals.size());
+        int buyCount = static_cast<int>(buySignals_.size());
+        int sellCount = static_cast<int>(sellSignals_.size());
 
         double buyRatio = static_cast<double>(buyCount) / total;
         double sellRatio = static_cast<double>(sellCount) / total;
 
         // Check if BUY consensus is met
         if (buyRatio >= requiredAgreement_ && buyCount >= sellCount) {
-            return buildConsensusSignal(buySignals, SignalType::Buy, buyCount, total);
+            return buildConsensusSignal(buySignals_, SignalType::Buy, buyCount, total);
         }
 
         // Check if SELL consensus is met
         if (sellRatio >= requiredAgreement_ && sellCount > buyCount) {
-            return buildConsensusSignal(sellSignals, SignalType::Sell, sellCount, total);
-        }
-
-        return StrategySignal::hold("No ensemble consensus (" +
-            std::to_string(buyCount) + " buy, " +
-            std::to_string(sellCount) + " sell of " +
-            std::to_string(total) + ")");
-    }
-
-    std::unique_ptr<IStrategy> clone() const override {
-        std::vector<std::unique_ptr<IStrategy>> clonedChildren;
-        for (const auto& child : children_) {
-            clonedChildren.push_back(child->clone());
+            return buildConsensusSignal(sellSignals_, SignalType::Sell, sellCount, total);
         }
-        return std::make_unique<EnsembleStrategy>(std::move(clonedChildren), requiredAgreement_);
-    }
 
-    void reset() override {
-        for (auto& child : children_) {
-            child->reset();
-        }
+        return StrategySignal::hold(SignalReason::NoEnsembleConsensus, buyCount, sellCount, total);
     }
 
-    int getWarmupPeriod() const override {
-        int maxWarmup = 0;
-        for (const auto& child : children_) {
-            maxWarmup = std::max(maxWarmup, child->getWarmupPeriod());
-        }
-        return maxWarmup;
-    }
-
-private:
     StrategySignal buildConsensusSignal(
         const std::vector<ChildSignal>& agreeing,
         SignalType type,
@@ -160,18 +231,15 @@ private:
         }
         double takeProfit = (tpCount > 0) ? (tpSum / tpCount) : 0.0;
 
-        // Build reason string: "Ensemble(2/2): MeanReversion | TrendFollowing"
-        std::string reason = "Ensemble(" + std::to_string(agreeCount) + "/" +
-                           std::to_string(total) + "): ";
-        for (size_t i = 0; i < agreeing.size(); ++i) {
-            if (i > 0) reason += " | ";
-            reason += agreeing[i].name;
-        }
-
-        // Create signal using factory methods (buy/sell set sign correctly)
+        // Create signal using factory methods (buy/sell set sign correctly).
+        // The agreeing children are recorded as a bitmask; describeSignal()
+        // turns it into names.
         StrategySignal sig = (type == SignalType::Buy) ?
-            StrategySignal::buy(strength, reason) :
-            StrategySignal::sell(strength, reason);
+            StrategySignal::buy(strength, SignalReason::EnsembleConsensus, agreeCount, total) :
+            StrategySignal::sell(strength, SignalReason::EnsembleConsensus, agreeCount, total);
+        for (const auto& cs : agreeing) {
+            if (cs.child < 32) sig.reasonFlags |= 1u << cs.child;
+        }
 
         sig.stopLossPrice = stopLoss;
         sig.takeProfitPrice = takeProfit;
@@ -2,6 +2,7 @@
 #include "../IStrategy.h"
 #include "../MLPredictor.h"
 #include "../TechnicalAnalysis.h"
+#include "../RollingIndicators.h"
 #include <cmath>
 #include <memory>
 #include <algorithm>
@@ -20,6 +21,14 @@ private:
     double lastActualReturn_ = 0.0;
     size_t lastTrainIdx_ = 0;
 
+    // Rolling state for incremental mode
+    RollingRSI rsiState_;
+    RollingMACD macdState_;
+    RollingGARCH garchState_;
+    RollingATR atrState_;
+    RollingCycle cycleState_;
+    double prevClose_ = 0.0;
+
 public:
     MLStrategy(MLPredictor& predictor)
         : StrategyBase("MLStrategy", 60), predictor_(predictor) {
@@ -29,17 +38,21 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if (history.size() < 60) {
-            return StrategySignal::hold("Insufficient data for ML prediction");
+            return StrategySignal::hold(SignalReason::InsufficientData);
         }
 
         // Extract features
         std::vector<double> closes;
+        closes.reserve(history.size());
         for (const auto& c : history) closes.push_back(c.close);
 
         double rsi = computeRSI(closes, 14);
         auto macd = computeMACD(closes);
-        double macdHist = macd.first - macd.second;
 
         // Calculate log returns for GARCH
         std::vector<double> returns;
@@ -51,6 +64,51 @@ public:
 
         // Detect cycle
         int detectedCycle = detectCycle(closes);
+
+        return evaluate(rsi, macd, garchVol, detectedCycle, idx,
+                        closes.back(), closes[closes.size() - 2], computeATR(history, 14));
+    }
+
+    // Incremental mode: RSI/MACD/GARCH/ATR are updated in O(1) per bar, the
+    // cycle spectrum in O(periods)
+    bool supportsIncremental() const override { return true; }
+
+    void onBar(const Candle& bar) override {
+        if (barsSeen_ == 0) {
+            rsiState_.reset(14);
+            macdState_.reset();
+            garchState_.reset();
+            atrState_.reset(14);
+            cycleState_.reset();
+        }
+        ++barsSeen_;
+
+        double previous = prevClose_;
+        prevClose_ = bar.close;
+        if (barsSeen_ > 1 && previous > 0) {
+            garchState_.update(std::log(bar.close / previous));
+        }
+        rsiState_.update(bar.close);
+        macdState_.update(bar.close);
+        atrState_.update(bar);
+        cycleState_.update(bar.close);
+
+        if (barsSeen_ < 60) {
+            currentSignal_ = StrategySignal::hold(SignalReason::InsufficientData);
+            return;
+        }
+
+        currentSignal_ = evaluate(rsiState_.value(), macdState_.value(), garchState_.value(),
+                                  cycleState_.value(), barsSeen_ - 1,
+                                  bar.close, previous, atrState_.value());
+    }
+
+private:
+    // Prediction and signal rules shared by the batch and incremental paths
+    StrategySignal evaluate(double rsi, std::pair<double, double> macd, double garchVol,
+                            int detectedCycle, size_t idx, double current, double previous,
+                            double atr) {
+        double macdHist = macd.first - macd.second;
         if (detectedCycle > 0) cyclePeriod_ = detectedCycle;
 
         // Use external sentiment (default to neutral if not available)
@@ -65,7 +123,7 @@ public:
 
         // Online training: train on previous prediction if available
         if (trainOnline_ && idx > lastTrainIdx_ + 1) {
-            double actualReturn = (closes.back() - closes[closes.size() - 2]) / closes[closes.size() - 2];
+            double actualReturn = (current - previous) / previous;
             predictor_.train(features, actualReturn);
             lastActualReturn_ = actualReturn;
         }
@@ -85,12 +143,10 @@ public:
                 confidence = std::min(1.0, confidence + 0.1);
             }
 
-            StrategySignal sig = StrategySignal::buy(strength,
-                "ML Prediction: " + std::to_string(prediction * 100) + "% expected return");
+            StrategySignal sig = StrategySignal::buy(strength, SignalReason::MLPrediction, prediction * 100);
 
-            double atr = computeATR(history, 14);
-            sig.stopLossPrice = closes.back() - (atr * 2.0);
-            sig.takeProfitPrice = closes.back() * (1.0 + prediction * 2);  // 2x predicted move
+            sig.stopLossPrice = current - (atr * 2.0);
+            sig.takeProfitPrice = current * (1.0 + prediction * 2);  // 2x predicted move
             sig.confidence = confidence;
 
             return sig;
@@ -103,21 +159,19 @@ public:
                 confidence = std::min(1.0, confidence + 0.1);
             }
 
-            StrategySignal sig = StrategySignal::sell(strength,
-                "ML Prediction: " + std::to_string(prediction * 100) + "% expected return");
+            StrategySignal sig = StrategySignal::sell(strength, SignalReason::MLPrediction, prediction * 100);
 
-            double atr = computeATR(history, 14);
-            sig.stopLossPrice = closes.back() + (atr * 2.0);
-            sig.takeProfitPrice = closes.back() * (1.0 + prediction * 2);
+            sig.stopLossPrice = current + (atr * 2.0);
+            sig.takeProfitPrice = current * (1.0 + prediction * 2);
             sig.confidence = confidence;
 
             return sig;
         }
 
-        return StrategySignal::hold("ML prediction below threshold: " +
-            std::to_string(prediction * 100) + "%");
+        return StrategySignal::hold(SignalReason::MLBelowThreshold, prediction * 100);
     }
 
+public:
     std::unique_ptr<IStrategy> clone() const override {
         // Note: Clone shares the same predictor reference
         auto copy = std::make_unique<MLStrategy>(predictor_);
@@ -130,6 +184,7 @@ public:
     }
 
     void reset() override {
+        StrategyBase::reset();
         lastPrediction_ = 0.0;
         lastActualReturn_ = 0.0;
         lastTrainIdx_ = 0;
@@ -168,11 +223,16 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if (history.size() < 60) {
-            return StrategySignal::hold("Insufficient data");
+            return StrategySignal::hold(SignalReason::InsufficientData);
         }
 
         std::vector<double> closes;
+        closes.reserve(history.size());
         for (const auto& c : history) closes.push_back(c.close);
 
         // === ML Signal ===
@@ -217,8 +277,8 @@ public:
 
         // Generate signal
         if (combinedSignal > combinedThreshold_) {
-            StrategySignal sig = StrategySignal::buy(combinedSignal,
-                "Hybrid: ML=" + std::to_string(mlSignal) + ", Tech=" + std::to_string(technicalSignal));
+            StrategySignal sig = StrategySignal::buy(combinedSignal, SignalReason::HybridSignal,
+                                                     mlSignal, technicalSignal);
 
             double atr = computeATR(history, 14);
             sig.stopLossPrice = current - (atr * 2.0);
@@ -228,8 +288,8 @@ public:
         }
 
         if (combinedSignal < -combinedThreshold_) {
-            StrategySignal sig = StrategySignal::sell(std::abs(combinedSignal),
-                "Hybrid: ML=" + std::to_string(mlSignal) + ", Tech=" + std::to_string(technicalSignal));
+            StrategySignal sig = StrategySignal::sell(std::abs(combinedSignal), SignalReason::HybridSignal,
+                                                      mlSignal, technicalSignal);
 
             double atr = computeATR(history, 14);
             sig.stopLossPrice = current + (atr * 2.0);
@@ -238,7 +298,7 @@ public:
             return sig;
         }
 
-        return StrategySignal::hold("Combined signal below threshold: " + std::to_string(combinedSignal));
+        return StrategySignal::hold(SignalReason::HybridBelowThreshold, combinedSignal);
     }
 
     std::unique_ptr<IStrategy> clone() const override {
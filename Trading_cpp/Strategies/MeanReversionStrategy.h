@@ -1,6 +1,7 @@
 #pragma once
 #include "../IStrategy.h"
 #include "../TechnicalAnalysis.h"
+#include "../RollingIndicators.h"
 #include <cmath>
 #include <numeric>
 
@@ -24,6 +25,13 @@ private:
     // Candlestick confirmation
     bool useCandlestickConfirmation_ = true;
 
+    // Rolling state for incremental mode
+    RollingRSI rsiState_;
+    RollingBollinger bbState_;
+    RollingATR atrState_;
+    RollingSqueeze squeezeState_;
+    CandleTail<3> recentBars_;
+
 public:
     MeanReversionStrategy()
         : StrategyBase("MeanReversion", 60) {
@@ -36,12 +44,17 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if (history.size() < 50) {
-            return StrategySignal::hold("Insufficient data");
+            return StrategySignal::hold(SignalReason::InsufficientData);
         }
 
         // Extract close prices
         std::vector<double> closes;
+        closes.reserve(history.size());
         for (const auto& c : history) closes.push_back(c.close);
 
         // Calculate indicators
@@ -57,6 +70,65 @@ public:
         // Check volatility squeeze state
         bool currentSqueeze = (closes.size() >= 120) ?
             checkVolatilitySqueeze(closes) : false;
+
+        return evaluate(bb, rsi, current, atr, currentSqueeze,
+                        [&] { return matchCandlestickPattern(history.last(3)); });
+    }
+
+    // Shared indicators (same rules and values as incremental mode)
+    StrategySignal generateSignal(IndicatorContext& context, size_t idx) override {
+        if (useAdaptiveRSI_) return MeanReversionStrategy::generateSignal(context.candles().first(idx + 1), idx);
+        if (idx + 1 < 50) {
+            return StrategySignal::hold(SignalReason::InsufficientData);
+        }
+
+        CandleView history = context.candles().first(idx + 1);
+        return evaluate(context.bollinger(bbPeriod_, bbMultiplier_).at(idx), context.rsi(rsiPeriod_)[idx],
+                        history.back().close, context.atr(14)[idx], context.squeeze(120, 0.10)[idx] != 0.0,
+                        [&] { return context.candlePatterns().at(idx); });
+    }
+
+    using StrategyBase::generateSignals;
+    SignalArray generateSignals(IndicatorContext& context, size_t firstBar) override {
+        if (useAdaptiveRSI_) return StrategyBase::generateSignals(context, firstBar);
+        return generateSignalsFromContext(context, firstBar);
+    }
+
+    // Incremental mode (not available with adaptive RSI, whose period changes per bar)
+    bool supportsIncremental() const override { return !useAdaptiveRSI_; }
+
+    void onBar(const Candle& bar) override {
+        if (barsSeen_ == 0) {
+            rsiState_.reset(rsiPeriod_);
+            bbState_.reset(bbPeriod_, bbMultiplier_);
+            atrState_.reset(14);
+            squeezeState_.reset(120, 0.10);
+            recentBars_.clear();
+        }
+        ++barsSeen_;
+
+        rsiState_.update(bar.close);
+        bbState_.update(bar.close);
+        atrState_.update(bar);
+        squeezeState_.update(bar.close);
+        recentBars_.push(bar);
+
+        if (barsSeen_ < 50) {
+            currentSignal_ = StrategySignal::hold(SignalReason::InsufficientData);
+            return;
+        }
+
+        currentSignal_ = evaluate(bbState_.value(), rsiState_.value(), bar.close, atrState_.value(),
+                                  squeezeState_.value(), [&] { return matchCandlestickPattern(recentBars_.view()); });
+    }
+
+private:
+    // Signal rules shared by the batch and incremental paths.
+    // patternAt: the candlestick pattern at this bar, only asked for when a
+    // signal needs confirming.
+    template <typename PatternAt>
+    StrategySignal evaluate(const BollingerBands& bb, double rsi, double current, double atr,
+                            bool currentSqueeze, PatternAt&& patternAt) {
         bool squeezeBreakout = (prevSqueeze_ && !currentSqueeze);
         prevSqueeze_ = currentSqueeze;
 
@@ -64,7 +136,7 @@ public:
         // Buy conditions: Oversold
         if (rsi < rsiBuyThreshold_ || current < bb.lower) {
             double strength = 0.5;
-            std::string reason = "RSI: " + std::to_string((int)rsi) + ", Below BB Lower";
+            uint32_t flags = 0;
 
             // Stronger signal if both conditions met
             if (rsi < rsiBuyThreshold_ && current < bb.lower) {
@@ -79,29 +151,30 @@ public:
             // Volatility squeeze boost
             if (currentSqueeze) {
                 strength = std::min(1.0, strength + 0.2);
-                reason += ", Squeeze";
+                flags |= SignalReasonFlag::Squeeze;
             } else if (squeezeBreakout) {
                 strength = std::min(1.0, strength + 0.3);
-                reason += ", SqueezeBreakout";
+                flags |= SignalReasonFlag::SqueezeBreakout;
             }
 
             // Candlestick pattern confirmation
-            if (useCandlestickConfirmation_ && history.size() >= 3) {
-                PatternResult pattern = detectCandlestickPattern(history);
-                if (!pattern.name.empty()) {
+            if (useCandlestickConfirmation_) {
+                PatternMatch pattern = patternAt();
+                if (pattern.pattern != CandlePattern::None) {
                     if (pattern.score > 0) {
                         // Confirming bullish pattern
                         strength = std::min(1.0, strength + 0.15);
-                        reason += ", " + pattern.name;
+                        flags |= SignalReasonFlag::pattern(pattern.pattern);
                     } else if (pattern.score < 0) {
                         // Opposing bearish pattern
                         strength = std::max(0.0, strength - 0.1);
-                        reason += ", opposing " + pattern.name;
+                        flags |= SignalReasonFlag::pattern(pattern.pattern) | SignalReasonFlag::OpposingPattern;
                     }
                 }
             }
 
-            StrategySignal sig = StrategySignal::buy(strength, reason);
+            StrategySignal sig = StrategySignal::buy(strength, SignalReason::BelowBBLower, rsi);
+            sig.reasonFlags = flags;
 
             // Set stop-loss and take-profit
             sig.stopLossPrice = current - (atr * atrMultiplierForStop_);
@@ -114,7 +187,7 @@ public:
         // Sell conditions: Overbought
         if (rsi > rsiSellThreshold_ || current > bb.upper) {
             double strength = 0.5;
-            std::string reason = "RSI: " + std::to_string((int)rsi) + ", Above BB Upper";
+            uint32_t flags = 0;
 
             if (rsi > rsiSellThreshold_ && current > bb.upper) {
                 strength = 0.8;
@@ -127,29 +200,30 @@ public:
             // Volatility squeeze boost
             if (currentSqueeze) {
                 strength = std::min(1.0, strength + 0.2);
-                reason += ", Squeeze";
+                flags |= SignalReasonFlag::Squeeze;
             } else if (squeezeBreakout) {
                 strength = std::min(1.0, strength + 0.3);
-                reason += ", SqueezeBreakout";
+                flags |= SignalReasonFlag::SqueezeBreakout;
             }
 
             // Candlestick pattern confirmation
-            if (useCandlestickConfirmation_ && history.size() >= 3) {
-                PatternResult pattern = detectCandlestickPattern(history);
-                if (!pattern.name.empty()) {
+            if (useCandlestickConfirmation_) {
+                PatternMatch pattern = patternAt();
+                if (pattern.pattern != CandlePattern::None) {
                     if (pattern.score < 0) {
                         // Confirming bearish pattern
                         strength = std::min(1.0, strength + 0.15);
-                        reason += ", " + pattern.name;
+                        flags |= SignalReasonFlag::pattern(pattern.pattern);
                     } else if (pattern.score > 0) {
                         // Opposing bullish pattern
                         strength = std::max(0.0, strength - 0.1);
-                        reason += ", opposing " + pattern.name;
+                        flags |= SignalReasonFlag::pattern(pattern.pattern) | SignalReasonFlag::OpposingPattern;
                     }
                 }
             }
 
-            StrategySignal sig = StrategySignal::sell(strength, reason);
+            StrategySignal sig = StrategySignal::sell(strength, SignalReason::AboveBBUpper, rsi);
+            sig.reasonFlags = flags;
 
             sig.stopLossPrice = current + (atr * atrMultiplierForStop_);
             sig.takeProfitPrice = bb.middle;
@@ -158,9 +232,10 @@ public:
             return sig;
         }
 
-        return StrategySignal::hold("No mean reversion signal");
+        return StrategySignal::hold(SignalReason::NoMeanReversionSignal);
     }
 
+public:
     std::unique_ptr<IStrategy> clone() const override {
         auto copy = std::make_unique<MeanReversionStrategy>();
         copy->rsiPeriod_ = rsiPeriod_;
@@ -176,6 +251,7 @@ public:
     }
 
     void reset() override {
+        StrategyBase::reset();
         prevSqueeze_ = false;
     }
 
@@ -211,6 +287,10 @@ private:
     bool useTrendFilter_ = true;
     int trendMAPeriod_ = 50;
 
+    // Rolling state for incremental mode
+    RingWindow<int64_t> recentVolumes_;
+    RollingSMA trendSMA_;
+
 public:
     EnhancedMeanReversionStrategy() {
         name_ = "EnhancedMeanReversion";
@@ -220,6 +300,10 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         // First get base signal
         StrategySignal baseSig = MeanReversionStrategy::generateSignal(history, idx);
 
@@ -227,45 +311,99 @@ public:
             return baseSig;
         }
 
-        // Apply volume filter
+        int64_t avgVolume = 0;
         if (useVolumeFilter_ && history.size() >= 20) {
-            int64_t avgVolume = 0;
             for (size_t i = history.size() - 20; i < history.size(); ++i) {
                 avgVolume += history[i].volume;
             }
             avgVolume /= 20;
-
-            int64_t currentVolume = history.back().volume;
-            if (currentVolume < static_cast<int64_t>(avgVolume * volumeThreshold_)) {
-                return StrategySignal::hold("Volume filter: insufficient volume confirmation");
-            }
         }
 
-        // Apply trend filter (don't buy in downtrend, don't sell in uptrend)
+        double ma = 0.0;
         if (useTrendFilter_ && history.size() >= (size_t)trendMAPeriod_) {
             double maSum = 0.0;
             for (size_t i = history.size() - trendMAPeriod_; i < history.size(); ++i) {
                 maSum += history[i].close;
             }
-            double ma = maSum / trendMAPeriod_;
-            double current = history.back().close;
+            ma = maSum / trendMAPeriod_;
+        }
+
+        return applyFilters(baseSig, history.size() >= 20, avgVolume, history.back().volume,
+                            history.size() >= (size_t)trendMAPeriod_, ma, history.back().close);
+    }
+
+    StrategySignal generateSignal(IndicatorContext& context, size_t idx) override {
+        StrategySignal baseSig = MeanReversionStrategy::generateSignal(context, idx);
+
+        if (baseSig.type == SignalType::Hold) {
+            return baseSig;
+        }
+
+        CandleView history = context.candles().first(idx + 1);
+        int64_t avgVolume = 0;
+        if (useVolumeFilter_ && history.size() >= 20) {
+            for (size_t i = history.size() - 20; i < history.size(); ++i) {
+                avgVolume += history[i].volume;
+            }
+            avgVolume /= 20;
+        }
 
+        bool haveTrend = history.size() >= (size_t)trendMAPeriod_;
+        double ma = (useTrendFilter_ && haveTrend) ? context.sma(trendMAPeriod_)[idx] : 0.0;
+
+        return applyFilters(baseSig, history.size() >= 20, avgVolume, history.back().volume,
+                            haveTrend, ma, history.back().close);
+    }
+
+    void onBar(const Candle& bar) override {
+        if (barsSeen_ == 0) {
+            recentVolumes_.reset(20);
+            trendSMA_.reset(trendMAPeriod_);
+        }
+        recentVolumes_.push(bar.volume);
+        trendSMA_.update(bar.close);
+
+        MeanReversionStrategy::onBar(bar);
+        if (currentSignal_.type == SignalType::Hold) return;
+
+        int64_t avgVolume = 0;
+        for (size_t i = 0; i < recentVolumes_.size(); ++i) avgVolume += recentVolumes_[i];
+        avgVolume /= 20;
+
+        currentSignal_ = applyFilters(currentSignal_, recentVolumes_.full(), avgVolume, bar.volume,
+                                      trendSMA_.ready(), trendSMA_.value(), bar.close);
+    }
+
+private:
+    // Volume and trend filters shared by the batch and incremental paths
+    StrategySignal applyFilters(StrategySignal baseSig, bool haveVolume, int64_t avgVolume,
+                                int64_t currentVolume, bool haveTrend, double ma, double current) const {
+        // Apply volume filter
+        if (useVolumeFilter_ && haveVolume) {
+            if (currentVolume < static_cast<int64_t>(avgVolume * volumeThreshold_)) {
+                return StrategySignal::hold(SignalReason::VolumeFilter);
+            }
+        }
+
+        // Apply trend filter (don't buy in downtrend, don't sell in uptrend)
+        if (useTrendFilter_ && haveTrend) {
             // In uptrend: only take buy signals
             if (current > ma && baseSig.type == SignalType::Sell) {
                 baseSig.strength *= 0.5;  // Reduce sell signal strength in uptrend
-                baseSig.reason += " (reduced: uptrend)";
+                baseSig.reasonFlags |= SignalReasonFlag::ReducedUptrend;
             }
 
             // In downtrend: only take sell signals
             if (current < ma && baseSig.type == SignalType::Buy) {
                 baseSig.strength *= 0.5;  // Reduce buy signal strength in downtrend
-                baseSig.reason += " (reduced: downtrend)";
+                baseSig.reasonFlags |= SignalReasonFlag::ReducedDowntrend;
             }
         }
 
         return baseSig;
     }
 
+public:
     std::unique_ptr<IStrategy> clone() const override {
         auto copy = std::make_unique<EnhancedMeanReversionStrategy>();
         copy->useVolumeFilter_ = useVolumeFilter_;
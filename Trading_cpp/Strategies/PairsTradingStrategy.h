@@ -67,6 +67,10 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if (history.size() < 50) {
             return StrategySignal::hold("Insufficient data for pairs trading");
         }
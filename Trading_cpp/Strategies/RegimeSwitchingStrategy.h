@@ -60,6 +60,10 @@ public:
     bool isTrained() const { return isTrained_; }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if (history.size() < (size_t)regimeLookback_) {
             return StrategySignal::hold("Insufficient data for regime detection");
         }
@@ -72,65 +76,55 @@ public:
             volumes.push_back(c.volume);
         }
 
-        // Auto-train if enabled and not trained yet
-        if (autoTrain_ && !isTrained_ && closes.size() >= 200) {
-            trainRegimeDetector(closes, volumes);
-        }
-
-        // Detect current regime
-        if (isTrained_) {
-            regimeInfo_ = regimeDetector_.detectCurrentRegime(closes, volumes);
-            currentRegime_ = regimeInfo_.regime;
-
-            // Get regime-based recommendations
-            auto rec = regimeDetector_.getRecommendations(currentRegime_);
-            positionSizeModifier_ = rec.positionSize;
-        } else {
-            // Fallback: use feature-based regime detection
-            currentRegime_ = detectRegimeFallback(closes, volumes);
-            positionSizeModifier_ = 1.0;
-            regimeInfo_.name = "Fallback";
-        }
-
-        // Select appropriate strategy based on regime
-        IStrategy* activeStrategy = selectStrategy();
-
+        IStrategy* activeStrategy = updateRegime(closes, volumes);
         if (!activeStrategy) {
             return StrategySignal::hold("No underlying strategy configured");
         }
 
         // Generate signal from selected strategy
         StrategySignal signal = activeStrategy->generateSignal(history, idx);
+        applyRegime(signal, *activeStrategy, history.back().close,
+                    [&] { return computeATR(history, 14); });
+        return signal;
+    }
 
-        // Apply regime-based position sizing
-        if (signal.isActionable()) {
-            signal.strength *= positionSizeModifier_;
-            signal.strength = std::min(1.0, signal.strength);  // Cap at 1.0
-
-            // Add regime information to signal reason
-            signal.reason += " | Regime: " + regimeInfo_.name;
-            signal.reason += " | Size Mod: " + std::to_string(positionSizeModifier_);
-
-            // Adjust stop-loss based on regime
-            if (signal.stopLossPrice > 0) {
-                auto rec = regimeDetector_.getRecommendations(currentRegime_);
-                double currentPrice = history.back().close;
-                double atr = computeATR(history, 14);
-                double currentStop = signal.stopLossPrice;
-
-                if (signal.type == SignalType::Buy) {
-                    double newStop = currentPrice - atr * rec.stopLossMultiplier;
-                    signal.stopLossPrice = newStop;  // Use regime-adjusted stop
-                } else if (signal.type == SignalType::Sell) {
-                    double newStop = currentPrice + atr * rec.stopLossMultiplier;
-                    signal.stopLossPrice = newStop;
-                }
-            }
-
-            signal.confidence *= positionSizeModifier_;
+    // Shared indicators: the selected sub-strategy and the stop adjustment
+    // read from the context
+    StrategySignal generateSignal(IndicatorContext& context, size_t idx) override {
+        if (idx + 1 < (size_t)regimeLookback_) {
+            return StrategySignal::hold("Insufficient data for regime detection");
         }
 
-        return signal;
+        CandleView history = context.candles().first(idx + 1);
+        std::vector<double> closes(context.closes().begin(), context.closes().begin() + idx + 1);
+        std::vector<int64_t> volumes;
+        volumes.reserve(history.size());
+        for (const auto& c : history) volumes.push_back(c.volume);
+
+        return signalAt(context, idx, closes, volumes);
+    }
+
+    // Whole series: the close/volume history grows by one bar per step
+    // instead of being rebuilt for every bar
+    using StrategyBase::generateSignals;
+    SignalArray generateSignals(IndicatorContext& context, size_t firstBar) override {
+        SignalArray out(context.size(), firstBar);
+        reset();
+
+        CandleView candles = context.candles();
+        size_t start = std::min(firstBar, candles.size());
+        std::vector<double> closes(context.closes().begin(), context.closes().begin() + start);
+        std::vector<int64_t> volumes;
+        volumes.reserve(candles.size());
+        for (size_t i = 0; i < start; ++i) volumes.push_back(candles[i].volume);
+
+        for (size_t i = start; i < candles.size(); ++i) {
+            closes.push_back(candles[i].close);
+            volumes.push_back(candles[i].volume);
+            if (closes.size() < (size_t)regimeLookback_) continue;
+            out.set(i, signalAt(context, i, closes, volumes));
+        }
+        return out;
     }
 
     std::unique_ptr<IStrategy> clone() const override {
@@ -177,6 +171,77 @@ protected:
     }
 
 private:
+    // Detect the regime for the history ending at the current bar and pick
+    // the sub-strategy for it
+    IStrategy* updateRegime(const std::vector<double>& closes, const std::vector<int64_t>& volumes) {
+        // Auto-train if enabled and not trained yet
+        if (autoTrain_ && !isTrained_ && closes.size() >= 200) {
+            trainRegimeDetector(closes, volumes);
+        }
+
+        // Detect current regime
+        if (isTrained_) {
+            regimeInfo_ = regimeDetector_.detectCurrentRegime(closes, volumes);
+            currentRegime_ = regimeInfo_.regime;
+
+            // Get regime-based recommendations
+            auto rec = regimeDetector_.getRecommendations(currentRegime_);
+            positionSizeModifier_ = rec.positionSize;
+        } else {
+            // Fallback: use feature-based regime detection
+            currentRegime_ = detectRegimeFallback(closes, volumes);
+            positionSizeModifier_ = 1.0;
+            regimeInfo_.name = "Fallback";
+        }
+
+        // Select appropriate strategy based on regime
+        return selectStrategy();
+    }
+
+    StrategySignal signalAt(IndicatorContext& context, size_t idx,
+                            const std::vector<double>& closes, const std::vector<int64_t>& volumes) {
+        IStrategy* activeStrategy = updateRegime(closes, volumes);
+        if (!activeStrategy) {
+            return StrategySignal::hold("No underlying strategy configured");
+        }
+
+        StrategySignal signal = activeStrategy->generateSignal(context, idx);
+        applyRegime(signal, *activeStrategy, closes.back(),
+                    [&] { return context.atr(14)[idx]; });
+        return signal;
+    }
+
+    // Regime-based sizing, reason and stop adjustment for an actionable signal.
+    // atr() is only evaluated when the stop needs moving.
+    template <typename AtrFn>
+    void applyRegime(StrategySignal& signal, const IStrategy& activeStrategy,
+                     double currentPrice, AtrFn&& atr) {
+        if (!signal.isActionable()) return;
+
+        // Apply regime-based position sizing
+        signal.strength *= positionSizeModifier_;
+        signal.strength = std::min(1.0, signal.strength);  // Cap at 1.0
+
+        // Add regime information to signal reason
+        signal.reason = activeStrategy.describeSignal(signal);
+        signal.reason += " | Regime: " + regimeInfo_.name;
+        signal.reason += " | Size Mod: " + std::to_string(positionSizeModifier_);
+
+        // Adjust stop-loss based on regime
+        if (signal.stopLossPrice > 0) {
+            auto rec = regimeDetector_.getRecommendations(currentRegime_);
+            double stopDistance = atr() * rec.stopLossMultiplier;
+
+            if (signal.type == SignalType::Buy) {
+                signal.stopLossPrice = currentPrice - stopDistance;  // Use regime-adjusted stop
+            } else if (signal.type == SignalType::Sell) {
+                signal.stopLossPrice = currentPrice + stopDistance;
+            }
+        }
+
+        signal.confidence *= positionSizeModifier_;
+    }
+
     // Select strategy based on current regime
     IStrategy* selectStrategy() {
         switch (currentRegime_) {
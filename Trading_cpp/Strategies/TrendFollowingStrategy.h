@@ -1,6 +1,8 @@
 #pragma once
 #include "../IStrategy.h"
 #include "../TechnicalAnalysis.h"
+#include "../RollingIndicators.h"
+#include "../IndicatorPipeline.h"
 #include <cmath>
 #include <numeric>
 
@@ -16,6 +18,13 @@ private:
     double atrMultiplierForStop_ = 2.5;
     bool signalOnContinuation_ = true;  // Emit signals during established trends
 
+    // Rolling state for incremental mode
+    RollingSMA fastSMA_;
+    RollingSMA slowSMA_;
+    RollingADX adxState_;
+    RollingATR atrState_;
+    RollingMACD macdState_;
+
     // Helper to compute SMA
     double computeSMA(const std::vector<double>& prices, int period, int endIdx) const {
         if (endIdx < period - 1) return 0.0;
@@ -52,12 +61,17 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if ((int)history.size() < slowMAPeriod_ + adxPeriod_ + 5) {
-            return StrategySignal::hold("Insufficient data for trend following");
+            return StrategySignal::hold(SignalReason::InsufficientData);
         }
 
         // Extract close prices
         std::vector<double> closes;
+        closes.reserve(history.size());
         for (const auto& c : history) closes.push_back(c.close);
 
         int lastIdx = (int)closes.size() - 1;
@@ -75,6 +89,98 @@ public:
         double atr = computeATR(history, 14);
         double current = closes.back();
 
+        // Additional MACD confirmation if enabled
+        std::pair<double, double> macd = useMACD_ ? computeMACD(closes) : std::pair<double, double>{0.0, 0.0};
+
+        return evaluate(fastMA, slowMA, prevFastMA, prevSlowMA, adx, atr, current, macd);
+    }
+
+    // Shared indicators (same rules and values as incremental mode)
+    StrategySignal generateSignal(IndicatorContext& context, size_t idx) override {
+        if ((int)idx + 1 < slowMAPeriod_ + adxPeriod_ + 5) {
+            return StrategySignal::hold(SignalReason::InsufficientData);
+        }
+
+        auto fastMA = context.sma(fastMAPeriod_);
+        auto slowMA = context.sma(slowMAPeriod_);
+        return evaluate(fastMA[idx], slowMA[idx], fastMA[idx - 1], slowMA[idx - 1],
+                        context.adx(adxPeriod_).at(idx), context.atr(14)[idx], context.closes()[idx],
+                        useMACD_ ? context.macd().at(idx) : std::pair<double, double>{0.0, 0.0});
+    }
+
+    using StrategyBase::generateSignals;
+    SignalArray generateSignals(IndicatorContext& context, size_t firstBar) override {
+        // Default periods run one fused pass with compile-time windows; other
+        // periods (e.g. optimizer sweeps) read the shared context
+        if (fastMAPeriod_ == 10 && slowMAPeriod_ == 30 && adxPeriod_ == 14) {
+            if (useMACD_) {
+                return generateFused<Fused::Pipeline<Fused::SMA<10>, Fused::SMA<30>, Fused::ADX<14>,
+                                                     Fused::ATR<14>, Fused::MACD<>>>(context.candles(), firstBar);
+            }
+            return generateFused<Fused::Pipeline<Fused::SMA<10>, Fused::SMA<30>, Fused::ADX<14>,
+                                                 Fused::ATR<14>>>(context.candles(), firstBar);
+        }
+        return generateSignalsFromContext(context, firstBar);
+    }
+
+    // Incremental mode: O(1) indicator updates per bar (MAs slide a running sum)
+    bool supportsIncremental() const override { return true; }
+
+    void onBar(const Candle& bar) override {
+        if (barsSeen_ == 0) {
+            fastSMA_.reset(fastMAPeriod_);
+            slowSMA_.reset(slowMAPeriod_);
+            adxState_.reset(adxPeriod_);
+            atrState_.reset(14);
+            macdState_.reset();
+        }
+        ++barsSeen_;
+
+        fastSMA_.update(bar.close);
+        slowSMA_.update(bar.close);
+        adxState_.update(bar);
+        atrState_.update(bar);
+        if (useMACD_) macdState_.update(bar.close);
+
+        if ((int)barsSeen_ < slowMAPeriod_ + adxPeriod_ + 5) {
+            currentSignal_ = StrategySignal::hold(SignalReason::InsufficientData);
+            return;
+        }
+
+        currentSignal_ = evaluate(fastSMA_.value(), slowSMA_.value(),
+                                  fastSMA_.previous(), slowSMA_.previous(),
+                                  adxState_.value(), atrState_.value(), bar.close,
+                                  useMACD_ ? macdState_.value() : std::pair<double, double>{0.0, 0.0});
+    }
+
+private:
+    // Stages 0-3 are the fast SMA, slow SMA, ADX and ATR(14); stage 4, if
+    // present, is MACD. Same values and signals as generateSignal(context, i).
+    template <typename Pipeline>
+    SignalArray generateFused(CandleView candles, size_t firstBar) {
+        SignalArray out(candles.size(), firstBar);
+        reset();
+        Pipeline pipeline;
+        pipeline.run(candles, [&](size_t i, const Pipeline& p) {
+            if (i < firstBar) return;
+            if ((int)i + 1 < slowMAPeriod_ + adxPeriod_ + 5) {
+                out.set(i, StrategySignal::hold(SignalReason::InsufficientData));
+                return;
+            }
+            std::pair<double, double> macd = {0.0, 0.0};
+            if constexpr (Pipeline::kStages > 4) macd = p.template get<4>().value();
+            out.set(i, evaluate(p.template get<0>().value(), p.template get<1>().value(),
+                                p.template get<0>().previous(), p.template get<1>().previous(),
+                                p.template get<2>().value(), p.template get<3>().value(),
+                                candles[i].close, macd));
+        });
+        return out;
+    }
+
+    // Signal rules shared by the batch and incremental paths
+    StrategySignal evaluate(double fastMA, double slowMA, double prevFastMA, double prevSlowMA,
+                            const ADXResult& adx, double atr, double current,
+                            std::pair<double, double> macd) const {
         // Check for MA crossover
         bool bullishCross = (prevFastMA <= prevSlowMA) && (fastMA > slowMA);
         bool bearishCross = (prevFastMA >= prevSlowMA) && (fastMA < slowMA);
@@ -86,7 +192,6 @@ public:
         // Additional MACD confirmation if enabled
         double macdStrength = 0.0;
         if (useMACD_) {
-            auto macd = computeMACD(closes);
             double macdLine = macd.first;
             double signalLine = macd.second;
             double histogram = macdLine - signalLine;
@@ -106,9 +211,8 @@ public:
                 strength = std::min(1.0, strength + macdStrength * 0.2);
             }
 
-            StrategySignal sig = StrategySignal::buy(strength,
-                "MA Cross Up, ADX: " + std::to_string((int)adx.adx) +
-                ", +DI: " + std::to_string((int)adx.plusDI));
+            StrategySignal sig = StrategySignal::buy(strength, SignalReason::MACrossUp,
+                                                     adx.adx, adx.plusDI);
 
             sig.stopLossPrice = current - (atr * atrMultiplierForStop_);
             sig.takeProfitPrice = 0;  // Let trend run, use trailing stop instead
@@ -129,9 +233,8 @@ public:
                 strength = std::min(1.0, strength + std::abs(macdStrength) * 0.2);
             }
 
-            StrategySignal sig = StrategySignal::sell(strength,
-                "MA Cross Down, ADX: " + std::to_string((int)adx.adx) +
-                ", -DI: " + std::to_string((int)adx.minusDI));
+            StrategySignal sig = StrategySignal::sell(strength, SignalReason::MACrossDown,
+                                                      adx.adx, adx.minusDI);
 
             sig.stopLossPrice = current + (atr * atrMultiplierForStop_);
             sig.takeProfitPrice = 0;
@@ -146,9 +249,8 @@ public:
             double contStrength = std::min(0.5, 0.3 + (adx.adx - adxThreshold_) / 100.0);
 
             if (inUptrend && adx.plusDI > adx.minusDI) {
-                StrategySignal sig = StrategySignal::buy(contStrength,
-                    "Trend Continuation Up, ADX: " + std::to_string((int)adx.adx) +
-                    ", +DI: " + std::to_string((int)adx.plusDI));
+                StrategySignal sig = StrategySignal::buy(contStrength, SignalReason::TrendContinuationUp,
+                                                         adx.adx, adx.plusDI);
                 sig.stopLossPrice = current - (atr * atrMultiplierForStop_);
                 sig.takeProfitPrice = 0;  // Let trend run
                 sig.confidence = contStrength;
@@ -156,9 +258,8 @@ public:
             }
 
             if (inDowntrend && adx.minusDI > adx.plusDI) {
-                StrategySignal sig = StrategySignal::sell(contStrength,
-                    "Trend Continuation Down, ADX: " + std::to_string((int)adx.adx) +
-                    ", -DI: " + std::to_string((int)adx.minusDI));
+                StrategySignal sig = StrategySignal::sell(contStrength, SignalReason::TrendContinuationDown,
+                                                          adx.adx, adx.minusDI);
                 sig.stopLossPrice = current + (atr * atrMultiplierForStop_);
                 sig.takeProfitPrice = 0;
                 sig.confidence = contStrength;
@@ -170,15 +271,16 @@ public:
         if (adx.adx < adxThreshold_ * 0.7) {
             if (inUptrend) {
                 // Weak uptrend, consider taking profits
-                return StrategySignal::sell(0.3, "Trend weakening, ADX: " + std::to_string((int)adx.adx));
+                return StrategySignal::sell(0.3, SignalReason::TrendWeakening, adx.adx);
             } else if (inDowntrend) {
-                return StrategySignal::buy(0.3, "Trend weakening, ADX: " + std::to_string((int)adx.adx));
+                return StrategySignal::buy(0.3, SignalReason::TrendWeakening, adx.adx);
             }
         }
 
-        return StrategySignal::hold("No trend signal");
+        return StrategySignal::hold(SignalReason::NoTrendSignal);
     }
 
+public:
     std::unique_ptr<IStrategy> clone() const override {
         auto copy = std::make_unique<TrendFollowingStrategy>();
         copy->fastMAPeriod_ = fastMAPeriod_;
@@ -240,11 +342,16 @@ public:
     }
 
     StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        return generateSignal(CandleView(history), idx);
+    }
+
+    StrategySignal generateSignal(CandleView history, size_t idx) override {
         if ((int)history.size() < slowPeriod_ + 10) {
-            return StrategySignal::hold("Insufficient data");
+            return StrategySignal::hold(SignalReason::InsufficientData);
         }
 
         std::vector<double> closes;
+        closes.reserve(history.size());
         for (const auto& c : history) closes.push_back(c.close);
 
         int lastIdx = (int)closes.size() - 1;
@@ -265,21 +372,19 @@ public:
         // Check for alignment
         if (strongUptrend && adx.adx >= adxThreshold_) {
             double strength = std::min(1.0, adx.adx / 50.0);
-            StrategySignal sig = StrategySignal::buy(strength,
-                "Triple MA aligned bullish, ADX: " + std::to_string((int)adx.adx));
+            StrategySignal sig = StrategySignal::buy(strength, SignalReason::TripleMABullish, adx.adx);
             sig.stopLossPrice = current - (atr * 2.5);
             return sig;
         }
 
         if (strongDowntrend && adx.adx >= adxThreshold_) {
             double strength = std::min(1.0, adx.adx / 50.0);
-            StrategySignal sig = StrategySignal::sell(strength,
-                "Triple MA aligned bearish, ADX: " + std::to_string((int)adx.adx));
+            StrategySignal sig = StrategySignal::sell(strength, SignalReason::TripleMABearish, adx.adx);
             sig.stopLossPrice = current + (atr * 2.5);
             return sig;
         }
 
-        return StrategySignal::hold("MAs not aligned");
+        return StrategySignal::hold(SignalReason::MAsNotAligned);
     }
 
     std::unique_ptr<IStrategy> clone() const override {
@@ -1,4 +1,7 @@
 #include "TechnicalAnalysis.h"
+#include "RollingKernels.h"
+#include "RollingIndicators.h"
+#include "PolynomialRegression.h"
 #include <numeric>
 #include <cmath>
 #include <algorithm>
@@ -46,6 +49,7 @@ bool solveSystem(std::vector<std::vector<double>>& A, std::vector<double>& B, st
 }
 
 // Polynomial Regression using Normal Equation: (X^T * X) * Beta = X^T * Y
+// General-degree fallback; degrees 1-3 go through PolyRegression::fit
 std::vector<double> polyFit(const std::vector<double>& y, int degree) {
     int n = static_cast<int>(y.size());
     int m = degree + 1;
@@ -118,7 +122,7 @@ double computeGARCHVolatility(const std::vector<double>& returns) {
 // Scales period based on Volatility (Standard Deviation)
 // High Volatility -> Shorter Period (Catch fast moves)
 // Low Volatility -> Longer Period (Avoid noise)
-double computeAdaptiveRSI(const std::vector<double>& prices, int basePeriod) {
+double computeAdaptiveRSI(std::span<const double> prices, int basePeriod) {
     if (prices.size() < 30) return computeRSI(prices, basePeriod);
 
     // Calculate recent volatility (last 20 days)
@@ -145,56 +149,60 @@ double computeAdaptiveRSI(const std::vector<double>& prices, int basePeriod) {
 
 // --- 3. Fourier Cycle Detection (Enhanced) ---
 // Uses Discrete Fourier Transform (DFT) to find dominant frequency
-int detectCycle(const std::vector<double>& prices) {
-    size_t N = prices.size();
-    if (N < 40) return 0; // Need enough data
-
-    // Detrend data (Linear Regression removal)
-    std::vector<double> detrended(N);
-    double x_mean = (N - 1) / 2.0;
-    double y_mean = std::accumulate(prices.begin(), prices.end(), 0.0) / N;
-
-    double num = 0.0, den = 0.0;
-    for(size_t i=0; i<N; ++i) {
-        num += (i - x_mean) * (prices[i] - y_mean);
-        den += (i - x_mean) * (i - x_mean);
-    }
-    double slope = num / den;
-    double intercept = y_mean - slope * x_mean;
-
-    for(size_t i=0; i<N; ++i) {
-        detrended[i] = prices[i] - (slope * i + intercept);
-    }
-
-    // DFT for lower frequencies (Periods 10 to N/2)
-    double maxPower = 0.0;
-    int dominantPeriod = 0;
-
-    // We check periods from 5 to 60 days
-    for (int P = 5; P <= 60 && P < (int)N/2; ++P) {
-        double real = 0.0;
-        double imag = 0.0;
-        double k = static_cast<double>(N) / P; // Frequency index approx
-
-        for (size_t n = 0; n < N; ++n) {
-            double angle = 2.0 * PI * k * n / N;
-            real += detrended[n] * std::cos(angle);
-            imag -= detrended[n] * std::sin(angle);
-        }
-        double power = std::sqrt(real*real + imag*imag);
-        if (power > maxPower) {
-            maxPower = power;
-            dominantPeriod = P;
-        }
-    }
-
-    return dominantPeriod;
+// The probed frequencies 1/P sit between FFT bins (k/N), so the spectrum is
+// accumulated per period with table twiddles by the streaming detector
+// (RollingCycle): O(periods) multiply-adds per bar and no trig calls.
+int detectCycle(std::span<const double> prices) {
+    if (prices.size() < RollingCycle::kMinBars) return 0; // Need enough data
+
+    RollingCycle cycle;
+    for (double price : prices) cycle.update(price);
+    return cycle.value();
 }
 
 
+// --- Helper: Bar Accessors ---
+// The candle-based indicators are written once against this small interface
+// and instantiated for both row (CandleView) and column (BarColumnsView) input,
+// so the two overloads run the same arithmetic in the same order.
+namespace {
+
+struct OHLC {
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+struct CandleBars {
+    CandleView bars;
+    size_t size() const { return bars.size(); }
+    bool empty() const { return bars.empty(); }
+    double open(size_t i) const { return bars[i].open; }
+    double high(size_t i) const { return bars[i].high; }
+    double low(size_t i) const { return bars[i].low; }
+    double close(size_t i) const { return bars[i].close; }
+    int64_t volume(size_t i) const { return bars[i].volume; }
+    OHLC ohlc(size_t i) const { return {bars[i].open, bars[i].high, bars[i].low, bars[i].close}; }
+};
+
+struct ColumnBars {
+    BarColumnsView bars;
+    size_t size() const { return bars.size(); }
+    bool empty() const { return bars.empty(); }
+    double open(size_t i) const { return bars.open[i]; }
+    double high(size_t i) const { return bars.high[i]; }
+    double low(size_t i) const { return bars.low[i]; }
+    double close(size_t i) const { return bars.close[i]; }
+    int64_t volume(size_t i) const { return bars.volume[i]; }
+    OHLC ohlc(size_t i) const { return {bars.open[i], bars.high[i], bars.low[i], bars.close[i]}; }
+};
+
+} // namespace
+
 // --- Legacy Helpers (EMA/RSI/MACD/ATR) ---
 
-std::vector<double> computeEMA(const std::vector<double>& data, int period) {
+std::vector<double> computeEMA(std::span<const double> data, int period) {
     std::vector<double> ema;
     if (data.empty() || (int)data.size() < period) return ema;
     ema.resize(data.size());
@@ -208,74 +216,196 @@ std::vector<double> computeEMA(const std::vector<double>& data, int period) {
     return ema;
 }
 
-double computeRSI(const std::vector<double>& prices, int period) {
-    if (prices.size() <= (size_t)period) return 50.0;
+// --- Indicator kernels ---
+// Each recursion is written once and reports the indicator's value at every
+// bar through emit(i, ...). The ...Series functions keep every value and the
+// scalar functions only the last, so both run the same arithmetic in the same
+// order.
+
+template <typename Emit>
+void rsiKernel(std::span<const double> prices, int period, Emit&& emit) {
+    size_t n = prices.size();
+    for (size_t i = 0; i < std::min(n, (size_t)period); ++i) emit(i, 50.0);
+    if (n <= (size_t)period) return;
+
     double avgUp = 0.0, avgDown = 0.0;
+    auto value = [&]() {
+        if (avgDown == 0.0) return 100.0;
+        double rs = avgUp / avgDown;
+        return 100.0 - (100.0 / (1.0 + rs));
+    };
+
     for (int i = 1; i <= period; ++i) {
         double diff = prices[i] - prices[i - 1];
         if (diff > 0) avgUp += diff; else avgDown -= diff;
     }
     avgUp /= period; avgDown /= period;
-    for (size_t i = period + 1; i < prices.size(); ++i) {
+    emit(period, value());
+
+    for (size_t i = period + 1; i < n; ++i) {
         double diff = prices[i] - prices[i - 1];
         double up = (diff > 0) ? diff : 0.0;
         double down = (diff < 0) ? -diff : 0.0;
         avgUp = (avgUp * (period - 1) + up) / period;
         avgDown = (avgDown * (period - 1) + down) / period;
+        emit(i, value());
     }
-    if (avgDown == 0.0) return 100.0;
-    double rs = avgUp / avgDown;
-    return 100.0 - (100.0 / (1.0 + rs));
 }
 
-std::pair<double, double> computeMACD(const std::vector<double>& prices) {
-    if (prices.size() < 26) return {0.0, 0.0};
-    std::vector<double> ema12 = computeEMA(prices, 12);
-    std::vector<double> ema26 = computeEMA(prices, 26);
-    std::vector<double> macdLine;
-    macdLine.resize(prices.size());
-    for (size_t i = 25; i < prices.size(); ++i) macdLine[i] = ema12[i] - ema26[i];
-    std::vector<double> validMacd;
-    for (size_t i = 25; i < macdLine.size(); ++i) validMacd.push_back(macdLine[i]);
-    if (validMacd.empty()) return {0.0, 0.0};
-    std::vector<double> signalLine = computeEMA(validMacd, 9);
-    if (signalLine.empty()) return {0.0, 0.0};
-    return {validMacd.back(), signalLine.back()};
-}
-
-double computeATR(const std::vector<Candle>& candles, int period) {
-    if (candles.size() <= (size_t)period) return 0.0;
-    std::vector<double> trs;
-    trs.push_back(candles[0].high - candles[0].low);
-    for (size_t i = 1; i < candles.size(); ++i) {
-        double hl = candles[i].high - candles[i].low;
-        double hpc = std::abs(candles[i].high - candles[i-1].close);
-        double lpc = std::abs(candles[i].low - candles[i-1].close);
-        trs.push_back(std::max({hl, hpc, lpc}));
+// MACD(12, 26, 9): emit(i, macd, signal), zeros until the signal line has
+// 9 MACD values
+template <typename Emit>
+void macdKernel(std::span<const double> prices, Emit&& emit) {
+    const double mult12 = 2.0 / (12 + 1.0);
+    const double mult26 = 2.0 / (26 + 1.0);
+    const double mult9 = 2.0 / (9 + 1.0);
+    double sum12 = 0.0, sum26 = 0.0, signalSum = 0.0;
+    double ema12 = 0.0, ema26 = 0.0, signal = 0.0;
+
+    for (size_t i = 0; i < prices.size(); ++i) {
+        double x = prices[i];
+        if (i < 12) {
+            sum12 += x;
+            if (i == 11) ema12 = sum12 / 12;
+        } else {
+            ema12 = (x - ema12) * mult12 + ema12;
+        }
+        if (i < 26) {
+            sum26 += x;
+            if (i == 25) ema26 = sum26 / 26;
+        } else {
+            ema26 = (x - ema26) * mult26 + ema26;
+        }
+        if (i < 25) {
+            emit(i, 0.0, 0.0);
+            continue;
+        }
+
+        double macd = ema12 - ema26;
+        size_t k = i - 25;  // Index into the valid MACD values
+        if (k < 9) {
+            signalSum += macd;
+            if (k == 8) signal = signalSum / 9;
+        } else {
+            signal = (macd - signal) * mult9 + signal;
+        }
+        if (k < 8) emit(i, 0.0, 0.0);
+        else emit(i, macd, signal);
     }
+}
+
+double computeRSI(std::span<const double> prices, int period) {
+    double rsi = 50.0;
+    rsiKernel(prices, period, [&](size_t, double v) { rsi = v; });
+    return rsi;
+}
+
+std::vector<double> computeRSISeries(std::span<const double> prices, int period) {
+    std::vector<double> out(prices.size());
+    rsiKernel(prices, period, [&](size_t i, double v) { out[i] = v; });
+    return out;
+}
+
+std::pair<double, double> computeMACD(std::span<const double> prices) {
+    std::pair<double, double> result = {0.0, 0.0};
+    macdKernel(prices, [&](size_t, double macd, double signal) { result = {macd, signal}; });
+    return result;
+}
+
+MACDSeries computeMACDSeries(std::span<const double> prices) {
+    MACDSeries out;
+    out.macd.resize(prices.size());
+    out.signal.resize(prices.size());
+    macdKernel(prices, [&](size_t i, double macd, double signal) {
+        out.macd[i] = macd;
+        out.signal[i] = signal;
+    });
+    return out;
+}
+
+// Wilder ATR: 0 until period + 1 bars
+template <typename Bars, typename Emit>
+void atrKernel(const Bars& candles, int period, Emit&& emit) {
+    size_t n = candles.size();
+    for (size_t i = 0; i < std::min(n, (size_t)period); ++i) emit(i, 0.0);
+    if (n <= (size_t)period) return;
+
+    auto trueRange = [&](size_t i) {
+        if (i == 0) return candles.high(0) - candles.low(0);
+        double hl = candles.high(i) - candles.low(i);
+        double hpc = std::abs(candles.high(i) - candles.close(i-1));
+        double lpc = std::abs(candles.low(i) - candles.close(i-1));
+        return std::max({hl, hpc, lpc});
+    };
+
     double atr = 0.0;
-    for (int i = 0; i < period; ++i) atr += trs[i];
+    for (int i = 0; i < period; ++i) atr += trueRange(i);
     atr /= period;
-    for (size_t i = period; i < trs.size(); ++i) {
-        atr = (atr * (period - 1) + trs[i]) / period;
+    for (size_t i = period; i < n; ++i) {
+        atr = (atr * (period - 1) + trueRange(i)) / period;
+        emit(i, atr);
     }
+}
+
+template <typename Bars>
+double atrImpl(const Bars& candles, int period) {
+    double atr = 0.0;
+    atrKernel(candles, period, [&](size_t, double v) { atr = v; });
     return atr;
 }
 
+template <typename Bars>
+std::vector<double> atrSeriesImpl(const Bars& candles, int period) {
+    std::vector<double> out(candles.size());
+    atrKernel(candles, period, [&](size_t i, double v) { out[i] = v; });
+    return out;
+}
+
+double computeATR(CandleView candles, int period) {
+    return atrImpl(CandleBars{candles}, period);
+}
+
+double computeATR(const BarColumnsView& bars, int period) {
+    return atrImpl(ColumnBars{bars}, period);
+}
+
+std::vector<double> computeATRSeries(CandleView candles, int period) {
+    return atrSeriesImpl(CandleBars{candles}, period);
+}
+
+// Columns are contiguous, so the true ranges go through the vectorised kernel
+std::vector<double> computeATRSeries(const BarColumnsView& bars, int period) {
+    std::vector<double> out(bars.size());
+    RollingKernels::averageTrueRange(bars.high, bars.low, bars.close, period, out);
+    return out;
+}
+
+// Fixed-degree fit (stack-only, centered positions) evaluated `horizon` bars
+// past the last price
+template <int Degree>
+static double forecastFixedDegree(const std::vector<double>& prices, int horizon) {
+    PolyRegression::Fit<Degree> fit = PolyRegression::fit<Degree>(prices);
+    if (!fit.valid) return prices.back();
+    return fit.at(static_cast<double>(prices.size() - 1 + horizon));
+}
+
 double forecastPrice(const std::vector<double>& prices, int horizon) {
     if (prices.size() < 2) return prices.empty() ? 0.0 : prices.back();
     // Linear is Poly degree 1
-    std::vector<double> coeffs = polyFit(prices, 1);
-    if (coeffs.empty()) return prices.back();
-
-    double x = static_cast<double>(prices.size() - 1 + horizon);
-    return coeffs[0] + coeffs[1] * x;
+    return forecastFixedDegree<1>(prices, horizon);
 }
 
 // Polynomial Regression (Degree 2 = Parabola)
 double forecastPricePoly(const std::vector<double>& prices, int horizon, int degree) {
     if (prices.size() < (size_t)degree + 1) return prices.empty() ? 0.0 : prices.back();
 
+    switch (degree) {
+        case 1: return forecastFixedDegree<1>(prices, horizon);
+        case 2: return forecastFixedDegree<2>(prices, horizon);
+        case 3: return forecastFixedDegree<3>(prices, horizon);
+        default: break;
+    }
+
     std::vector<double> coeffs = polyFit(prices, degree);
     if (coeffs.empty()) return prices.back();
 
@@ -291,7 +421,7 @@ double forecastPricePoly(const std::vector<double>& prices, int horizon, int deg
 }
 
 // Support/Resistance (Min/Max of last Period)
-SupportResistance identifyLevels(const std::vector<double>& prices, int period) {
+SupportResistance identifyLevels(std::span<const double> prices, int period) {
     SupportResistance levels = {0.0, 0.0};
     if (prices.empty()) return levels;
 
@@ -309,269 +439,378 @@ SupportResistance identifyLevels(const std::vector<double>& prices, int period)
     return levels;
 }
 
-// Find Local Extrema (Peaks and Valleys)
-std::vector<double> findLocalExtrema(const std::vector<double>& prices, int period, bool findMaxima) {
-    std::vector<double> targets;
-    if (prices.size() < 10) return targets;
-
-    int start = std::max(0, (int)prices.size() - period);
-    int window = 5; // Check 5 days left and right to confirm significance
-
-    for (int i = start + window; i < (int)prices.size() - window; ++i) {
-        bool isExtremum = true;
-        double current = prices[i];
+// Find Local Extrema (Peaks and Valleys): bars with no higher (lower) price
+// within 5 days either side, confirmed by streaming the trailing period
+std::vector<double> findLocalExtrema(std::span<const double> prices, int period, bool findMaxima) {
+    if (prices.size() < 10 || period <= 0) return {};
 
-        for (int k = 1; k <= window; ++k) {
-            if (findMaxima) {
-                if (prices[i - k] > current || prices[i + k] > current) {
-                    isExtremum = false; break;
-                }
-            } else {
-                if (prices[i - k] < current || prices[i + k] < current) {
-                    isExtremum = false; break;
-                }
-            }
-        }
+    size_t start = prices.size() > (size_t)period ? prices.size() - period : 0;
+    RollingExtrema extrema(period);
+    for (size_t i = start; i < prices.size(); ++i) extrema.update(prices[i]);
+    return extrema.targets(findMaxima);
+}
 
-        if (isExtremum) {
-            targets.push_back(current);
-        }
+SupportResistanceSeries identifyLevelsSeries(std::span<const double> prices, int period) {
+    SupportResistanceSeries out;
+    out.support.resize(prices.size());
+    out.resistance.resize(prices.size());
+    if (period <= 0) {
+        // Empty windows, as identifyLevels
+        std::fill(out.support.begin(), out.support.end(), 1e18);
+        std::fill(out.resistance.begin(), out.resistance.end(), -1e18);
+        return out;
     }
 
-    // Sort targets
-    std::sort(targets.begin(), targets.end());
-
-    // Filter duplicates/too close values (within 1%)
-    if (targets.empty()) return targets;
+    RollingLevels levels(period);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        levels.update(prices[i]);
+        SupportResistance current = levels.value();
+        out.support[i] = current.support;
+        out.resistance[i] = current.resistance;
+    }
+    return out;
+}
 
-    std::vector<double> uniqueTargets;
-    uniqueTargets.push_back(targets[0]);
+std::vector<std::vector<double>> findLocalExtremaSeries(std::span<const double> prices, int period, bool findMaxima) {
+    std::vector<std::vector<double>> out(prices.size());
+    if (period <= 0) return out;
 
-    for (size_t i = 1; i < targets.size(); ++i) {
-        if (targets[i] > uniqueTargets.back() * 1.01) {
-            uniqueTargets.push_back(targets[i]);
-        }
+    RollingExtrema extrema(period);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        extrema.update(prices[i]);
+        out[i] = extrema.targets(findMaxima);
     }
-
-    return uniqueTargets;
+    return out;
 }
 
 // Bollinger Bands Implementation
-BollingerBands computeBollingerBands(const std::vector<double>& prices, int period, double multiplier) {
+// Bands over the `period` prices ending at each bar, from the vectorised
+// window kernel, every window summed afresh in the scalar definition's order
+// (the series must match computeBollingerBands exactly, and the cross-section
+// engine repeats the same sums).
+BollingerBands computeBollingerBands(std::span<const double> prices, int period, double multiplier) {
     BollingerBands bb = {0.0, 0.0, 0.0, 0.0};
-    size_t n = prices.size();
-    if (n < (size_t)period) return bb;
-
-    // 1. Compute SMA (Middle Band)
-    double sum = 0.0;
-    for (size_t i = n - period; i < n; ++i) sum += prices[i];
-    bb.middle = sum / period;
-
-    // 2. Compute Standard Deviation
-    double varianceSum = 0.0;
-    for (size_t i = n - period; i < n; ++i) {
-        double diff = prices[i] - bb.middle;
-        varianceSum += diff * diff;
-    }
-    double stdDev = std::sqrt(varianceSum / period);
-
-    // 3. Compute Bands
-    bb.upper = bb.middle + (multiplier * stdDev);
-    bb.lower = bb.middle - (multiplier * stdDev);
-
-    if (bb.middle > 0) bb.bandwidth = (bb.upper - bb.lower) / bb.middle;
-
+    if (period <= 0 || prices.size() < (size_t)period) return bb;
+    RollingKernels::rollingBollinger(prices, prices.size() - 1, period, multiplier,
+                                     {&bb.upper, 1}, {&bb.middle, 1}, {&bb.lower, 1}, {&bb.bandwidth, 1},
+                                     RollingKernels::WindowSums::ExactOldestFirst);
     return bb;
 }
 
-// ADX Implementation
-ADXResult computeADX(const std::vector<Candle>& candles, int period) {
-    ADXResult res = {0.0, 0.0, 0.0};
-    if (candles.size() < (size_t)period * 2) return res; // Need warmup
-
-    std::vector<double> tr(candles.size(), 0.0);
-    std::vector<double> plusDM(candles.size(), 0.0);
-    std::vector<double> minusDM(candles.size(), 0.0);
-
-    // 1. Calculate TR, +DM, -DM per candle
-    for (size_t i = 1; i < candles.size(); ++i) {
-        double highDiff = candles[i].high - candles[i-1].high;
-        double lowDiff = candles[i-1].low - candles[i].low;
-
-        if (highDiff > lowDiff && highDiff > 0) plusDM[i] = highDiff;
-        if (lowDiff > highDiff && lowDiff > 0) minusDM[i] = lowDiff;
-
-        double hl = candles[i].high - candles[i].low;
-        double hpc = std::abs(candles[i].high - candles[i-1].close);
-        double lpc = std::abs(candles[i].low - candles[i-1].close);
-        tr[i] = std::max({hl, hpc, lpc});
-    }
+BollingerSeries computeBollingerBandsSeries(std::span<const double> prices, int period, double multiplier) {
+    size_t n = prices.size();
+    BollingerSeries out;
+    out.upper.assign(n, 0.0);
+    out.middle.assign(n, 0.0);
+    out.lower.assign(n, 0.0);
+    out.bandwidth.assign(n, 0.0);
+    if (period <= 0 || n < (size_t)period) return out;
+
+    size_t first = period - 1;
+    size_t count = n - first;
+    RollingKernels::rollingBollinger(prices, first, period, multiplier,
+                                     std::span<double>(out.upper).subspan(first, count),
+                                     std::span<double>(out.middle).subspan(first, count),
+                                     std::span<double>(out.lower).subspan(first, count),
+                                     std::span<double>(out.bandwidth).subspan(first, count),
+                                     RollingKernels::WindowSums::ExactOldestFirst);
+    return out;
+}
 
-    // 2. Initial Smooth (First 'period' sum)
+// ADX Implementation
+// Wilder ADX with +DI/-DI: emit(i, result), zeros until 2 * period bars
+template <typename Bars, typename Emit>
+void adxKernel(const Bars& candles, int period, Emit&& emit) {
+    const ADXResult zero = {0.0, 0.0, 0.0};
+    size_t n = candles.size();
 
     double smoothTR = 0.0;
     double smoothPlusDM = 0.0;
     double smoothMinusDM = 0.0;
+    double pDI = 0.0, mDI = 0.0;
+    double adxSum = 0.0;
+    double adx = 0.0;
+    size_t dxCount = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            // 1. TR, +DM, -DM for this candle
+            double highDiff = candles.high(i) - candles.high(i-1);
+            double lowDiff = candles.low(i-1) - candles.low(i);
+
+            double plusDM = (highDiff > lowDiff && highDiff > 0) ? highDiff : 0.0;
+            double minusDM = (lowDiff > highDiff && lowDiff > 0) ? lowDiff : 0.0;
+
+            double hl = candles.high(i) - candles.low(i);
+            double hpc = std::abs(candles.high(i) - candles.close(i-1));
+            double lpc = std::abs(candles.low(i) - candles.close(i-1));
+            double tr = std::max({hl, hpc, lpc});
+
+            if (i <= (size_t)period) {
+                // 2. Initial Smooth (First 'period' sum)
+                smoothTR += tr;
+                smoothPlusDM += plusDM;
+                smoothMinusDM += minusDM;
+            } else {
+                // 3. Wilder's Smoothing & DX
+                smoothTR = smoothTR - (smoothTR / period) + tr;
+                smoothPlusDM = smoothPlusDM - (smoothPlusDM / period) + plusDM;
+                smoothMinusDM = smoothMinusDM - (smoothMinusDM / period) + minusDM;
+
+                pDI = (smoothTR == 0) ? 0 : (100.0 * smoothPlusDM / smoothTR);
+                mDI = (smoothTR == 0) ? 0 : (100.0 * smoothMinusDM / smoothTR);
+
+                double diSum = pDI + mDI;
+                double dxVal = (diSum == 0) ? 0 : (100.0 * std::abs(pDI - mDI) / diSum);
+
+                // 4. ADX is the SMA of the first 'period' DX values, then smoothed
+                if (dxCount < (size_t)period) {
+                    adxSum += dxVal;
+                    if (dxCount == (size_t)period - 1) adx = adxSum / period;
+                } else {
+                    adx = ((adx * (period - 1)) + dxVal) / period;
+                }
+                ++dxCount;
+            }
+        }
 
-    for (int i = 1; i <= period; ++i) {
-        smoothTR += tr[i];
-        smoothPlusDM += plusDM[i];
-        smoothMinusDM += minusDM[i];
-    }
-
-    // 3. Rolling Smooth & DX Calculation
-    std::vector<double> dx;
-    for (size_t i = period + 1; i < candles.size(); ++i) {
-        // Wilder's Smoothing
-        smoothTR = smoothTR - (smoothTR / period) + tr[i];
-        smoothPlusDM = smoothPlusDM - (smoothPlusDM / period) + plusDM[i];
-        smoothMinusDM = smoothMinusDM - (smoothMinusDM / period) + minusDM[i];
-
-        double pDI = (smoothTR == 0) ? 0 : (100.0 * smoothPlusDM / smoothTR);
-        double mDI = (smoothTR == 0) ? 0 : (100.0 * smoothMinusDM / smoothTR);
-
-        double diSum = pDI + mDI;
-        double dxVal = (diSum == 0) ? 0 : (100.0 * std::abs(pDI - mDI) / diSum);
-        dx.push_back(dxVal);
-
-        // Store last DI for return
-        if (i == candles.size() - 1) {
-            res.plusDI = pDI;
-            res.minusDI = mDI;
+        if (i + 1 < (size_t)period * 2) {
+            emit(i, zero);  // Need warmup
+            continue;
         }
+        ADXResult res = {0.0, pDI, mDI};
+        if (dxCount >= (size_t)period) res.adx = adx;
+        emit(i, res);
     }
+}
 
-    // 4. ADX is SMA of DX
-    if (dx.size() < (size_t)period) return res;
-
-    double adxSum = 0.0;
-    // Initial ADX
-    for(int i=0; i<period; ++i) adxSum += dx[i];
-    double finalADX = adxSum / period;
+template <typename Bars>
+ADXResult adxImpl(const Bars& candles, int period) {
+    ADXResult res = {0.0, 0.0, 0.0};
+    adxKernel(candles, period, [&](size_t, const ADXResult& r) { res = r; });
+    return res;
+}
 
-    // Smoothing ADX
-    for(size_t i=period; i<dx.size(); ++i) {
-         finalADX = ((finalADX * (period - 1)) + dx[i]) / period;
-    }
+template <typename Bars>
+ADXSeries adxSeriesImpl(const Bars& candles, int period) {
+    ADXSeries out;
+    out.adx.resize(candles.size());
+    out.plusDI.resize(candles.size());
+    out.minusDI.resize(candles.size());
+    adxKernel(candles, period, [&](size_t i, const ADXResult& r) {
+        out.adx[i] = r.adx;
+        out.plusDI[i] = r.plusDI;
+        out.minusDI[i] = r.minusDI;
+    });
+    return out;
+}
 
-    res.adx = finalADX;
-    return res;
+ADXResult computeADX(CandleView candles, int period) {
+    return adxImpl(CandleBars{candles}, period);
 }
 
-PatternResult detectCandlestickPattern(const std::vector<Candle>& candles) {
-    PatternResult res = {"", 0.0};
-    if (candles.size() < 3) return res;
+ADXResult computeADX(const BarColumnsView& bars, int period) {
+    return adxImpl(ColumnBars{bars}, period);
+}
 
-    // Get last candle
-    Candle c = candles.back();
-    Candle p = candles[candles.size() - 2]; // Previous
+ADXSeries computeADXSeries(CandleView candles, int period) {
+    return adxSeriesImpl(CandleBars{candles}, period);
+}
 
-    double body = std::abs(c.close - c.open);
-    double range = c.high - c.low;
-    double upperShadow = c.high - std::max(c.open, c.close);
-    double lowerShadow = std::min(c.open, c.close) - c.low;
+ADXSeries computeADXSeries(const BarColumnsView& bars, int period) {
+    return adxSeriesImpl(ColumnBars{bars}, period);
+}
 
-    double avgBody = 0.0;
-    for(int i=1; i<=3; i++) avgBody += std::abs(candles[candles.size()-i].close - candles[candles.size()-i].open);
-    avgBody /= 3.0;
+template <typename Bars>
+PatternMatch patternImpl(const Bars& candles) {
+    if (candles.size() < 3) return {};
+    return CandlePatternSeries::first(patternMaskAt(candles, candles.size() - 1));
+}
 
-    bool isBullish = c.close > c.open;
-    bool isBearish = c.close < c.open;
+static void fillPatternScores(CandlePatternSeries& out) {
+    out.score.resize(out.mask.size());
+    for (size_t i = 0; i < out.mask.size(); ++i) out.score[i] = CandlePatternSeries::first(out.mask[i]).score;
+}
 
-    // 1. Hammer
-    if (lowerShadow > 2.0 * body && upperShadow < body * 0.5 && isBullish) {
-        res.name = "Hammer";
-        res.score = 0.5;
-        return res;
+const char* candlePatternName(CandlePattern pattern) {
+    switch (pattern) {
+        case CandlePattern::Hammer: return "Hammer";
+        case CandlePattern::ShootingStar: return "Shooting Star";
+        case CandlePattern::BullishEngulfing: return "Bullish Engulfing";
+        case CandlePattern::BearishEngulfing: return "Bearish Engulfing";
+        case CandlePattern::Doji: return "Doji";
+        case CandlePattern::None: break;
     }
+    return "";
+}
 
-    // 2. Shooting Star
-    if (upperShadow > 2.0 * body && lowerShadow < body * 0.5 && isBearish) {
-        res.name = "Shooting Star";
-        res.score = -0.5;
-        return res;
-    }
+static PatternResult toPatternResult(const PatternMatch& match) {
+    return {candlePatternName(match.pattern), match.score, match.pattern};
+}
 
-    // 3. Bullish Engulfing
-    bool pBearish = p.close < p.open;
-    if (pBearish && isBullish && c.close > p.open && c.open < p.close) {
-         res.name = "Bullish Engulfing";
-         res.score = 0.6;
-         return res;
-    }
+PatternMatch matchCandlestickPattern(CandleView candles) {
+    return patternImpl(CandleBars{candles});
+}
 
-    // 4. Bearish Engulfing
-    bool pBullish = p.close > p.open;
-    if (pBullish && isBearish && c.close < p.open && c.open > p.close) {
-        res.name = "Bearish Engulfing";
-        res.score = -0.6;
-        return res;
-    }
+PatternMatch matchCandlestickPattern(const BarColumnsView& bars) {
+    return patternImpl(ColumnBars{bars});
+}
 
-    // 5. Doji
-    if (body < 0.1 * range && range > avgBody) {
-        res.name = "Doji";
-        res.score = 0.0;
-        return res;
-    }
+PatternResult detectCandlestickPattern(CandleView candles) {
+    return toPatternResult(matchCandlestickPattern(candles));
+}
 
-    return res;
+PatternResult detectCandlestickPattern(const BarColumnsView& bars) {
+    return toPatternResult(matchCandlestickPattern(bars));
 }
 
-double computeVWAP(const std::vector<Candle>& candles) {
-    return computeVWAP(candles, static_cast<int>(candles.size()));
+CandlePatternSeries scanCandlestickPatterns(CandleView candles) {
+    CandlePatternSeries out;
+    out.mask.assign(candles.size(), 0);
+    for (size_t i = 2; i < candles.size(); ++i) out.mask[i] = patternMaskAt(CandleBars{candles}, i);
+    fillPatternScores(out);
+    return out;
 }
 
-double computeVWAP(const std::vector<Candle>& candles, int lookback) {
-    if (candles.empty()) return 0.0;
+CandlePatternSeries scanCandlestickPatterns(const BarColumnsView& bars) {
+    // Column data: the comparisons run as SIMD lane masks
+    CandlePatternSeries out;
+    out.mask.resize(bars.size());
+    RollingKernels::candlePatterns(bars.open, bars.high, bars.low, bars.close, out.mask);
+    fillPatternScores(out);
+    return out;
+}
+
+size_t CandlePatternSeries::count(CandlePattern pattern) const {
+    uint8_t b = bit(pattern);
+    size_t total = 0;
+    for (uint8_t m : mask) total += (m & b) != 0;
+    return total;
+}
 
-    int start = std::max(0, static_cast<int>(candles.size()) - lookback);
+// VWAP over bars [start, end); the last close when there is no volume
+template <typename Bars>
+double vwapWindow(const Bars& candles, size_t start, size_t end) {
     double cumTPV = 0.0;  // cumulative(typicalPrice * volume)
     double cumVol = 0.0;
 
-    for (int i = start; i < static_cast<int>(candles.size()); ++i) {
-        double typicalPrice = (candles[i].high + candles[i].low + candles[i].close) / 3.0;
-        double vol = static_cast<double>(candles[i].volume);
+    for (size_t i = start; i < end; ++i) {
+        double typicalPrice = (candles.high(i) + candles.low(i) + candles.close(i)) / 3.0;
+        double vol = static_cast<double>(candles.volume(i));
         cumTPV += typicalPrice * vol;
         cumVol += vol;
     }
 
     // Fall back to close price if no volume data
     if (cumVol < 1.0) {
-        return candles.back().close;
+        return candles.close(end - 1);
     }
 
     return cumTPV / cumVol;
 }
 
-bool checkVolatilitySqueeze(const std::vector<double>& prices, int lookback, double percentile) {
-    if (prices.size() < (size_t)lookback) return false;
-
-    std::vector<double> history;
-    int bbPeriod = 20;
+template <typename Bars>
+double vwapImpl(const Bars& candles, int lookback) {
+    if (candles.empty()) return 0.0;
 
-    for (int i = 0; i < lookback; ++i) {
-        int endIdx = (int)prices.size() - 1 - i;
-        if (endIdx < bbPeriod) break;
+    size_t start = static_cast<size_t>(std::max(0, static_cast<int>(candles.size()) - lookback));
+    return vwapWindow(candles, start, candles.size());
+}
 
-        // Compute BB for this index
-        double sum = 0.0;
-        for(int k=0; k<bbPeriod; ++k) sum += prices[endIdx - k];
-        double sma = sum / bbPeriod;
+// Entry i: VWAP over the (up to) `lookback` bars ending at i. Windows that
+// start at bar 0 come from running sums (same order as a fresh sum); later
+// windows are summed afresh so values match the scalar function exactly.
+template <typename Bars>
+std::vector<double> vwapSeriesImpl(const Bars& candles, int lookback) {
+    size_t n = candles.size();
+    std::vector<double> out(n, 0.0);
+    size_t window = static_cast<size_t>(std::max(0, lookback));
 
-        double varSum = 0.0;
-        for(int k=0; k<bbPeriod; ++k) {
-            double d = prices[endIdx - k] - sma;
-            varSum += d*d;
+    double cumTPV = 0.0;
+    double cumVol = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i < window) {
+            double typicalPrice = (candles.high(i) + candles.low(i) + candles.close(i)) / 3.0;
+            double vol = static_cast<double>(candles.volume(i));
+            cumTPV += typicalPrice * vol;
+            cumVol += vol;
+            out[i] = (cumVol < 1.0) ? candles.close(i) : cumTPV / cumVol;
+        } else {
+            out[i] = vwapWindow(candles, i + 1 - window, i + 1);
         }
-        double stdDev = std::sqrt(varSum / bbPeriod);
-        double upper = sma + 2*stdDev;
-        double lower = sma - 2*stdDev;
+    }
+    return out;
+}
 
-        if (sma > 0) {
-            double bw = (upper - lower) / sma;
-            history.push_back(bw);
-        }
+double computeVWAP(CandleView candles) {
+    return computeVWAP(candles, static_cast<int>(candles.size()));
+}
+
+double computeVWAP(CandleView candles, int lookback) {
+    return vwapImpl(CandleBars{candles}, lookback);
+}
+
+double computeVWAP(const BarColumnsView& bars) {
+    return computeVWAP(bars, static_cast<int>(bars.size()));
+}
+
+double computeVWAP(const BarColumnsView& bars, int lookback) {
+    return vwapImpl(ColumnBars{bars}, lookback);
+}
+
+std::vector<double> computeVWAPSeries(CandleView candles) {
+    return computeVWAPSeries(candles, static_cast<int>(candles.size()));
+}
+
+std::vector<double> computeVWAPSeries(CandleView candles, int lookback) {
+    return vwapSeriesImpl(CandleBars{candles}, lookback);
+}
+
+std::vector<double> computeVWAPSeries(const BarColumnsView& bars) {
+    return computeVWAPSeries(bars, static_cast<int>(bars.size()));
+}
+
+std::vector<double> computeVWAPSeries(const BarColumnsView& bars, int lookback) {
+    return vwapSeriesImpl(ColumnBars{bars}, lookback);
+}
+
+// 20-bar BB windows ending at bars firstEnd.. (count of them), summed
+// newest-first as the squeeze has always done, so the single-bar check and
+// the series rank identical bandwidths. middle[j] > 0 marks a usable
+// bandwidth[j].
+static const int kSqueezeBBPeriod = 20;
+
+static void squeezeBandwidths(std::span<const double> prices, size_t firstEnd, size_t count,
+                              std::vector<double>& bands, std::span<double>& middle,
+                              std::span<double>& bandwidth) {
+    bands.assign(4 * count, 0.0);
+    std::span<double> columns(bands);
+    middle = columns.subspan(count, count);
+    bandwidth = columns.subspan(3 * count, count);
+    RollingKernels::rollingBollinger(prices, firstEnd, kSqueezeBBPeriod, 2.0,
+                                     columns.first(count), middle, columns.subspan(2 * count, count),
+                                     bandwidth, RollingKernels::WindowSums::ExactNewestFirst);
+}
+
+bool checkVolatilitySqueeze(std::span<const double> prices, int lookback, double percentile) {
+    if (lookback <= 0 || prices.size() < (size_t)lookback) return false;
+
+    // Bandwidths at each of the last `lookback` bars, stopping short of index
+    // kSqueezeBBPeriod
+    size_t n = prices.size();
+    size_t oldest = std::max(n - lookback, (size_t)kSqueezeBBPeriod);
+    if (oldest >= n) return false;
+    size_t count = n - oldest;
+
+    std::vector<double> bands;
+    std::span<double> middle, bandwidth;
+    squeezeBandwidths(prices, oldest, count, bands, middle, bandwidth);
+
+    // Newest first; windows with a non-positive SMA are skipped
+    std::vector<double> history;
+    history.reserve(count);
+    for (size_t j = count; j-- > 0;) {
+        if (middle[j] > 0) history.push_back(bandwidth[j]);
     }
 
     if (history.empty()) return false;
@@ -579,14 +818,71 @@ bool checkVolatilitySqueeze(const std::vector<double>& prices, int lookback, dou
     // Current bandwidth is history[0]
     double currentBW = history[0];
 
-    // Sort history to find percentile
-    std::sort(history.begin(), history.end());
-
     // If current is in the bottom 'percentile' portion
     size_t thresholdIdx = static_cast<size_t>(history.size() * percentile);
     if (thresholdIdx >= history.size()) thresholdIdx = history.size() - 1;
 
+    std::nth_element(history.begin(), history.begin() + thresholdIdx, history.end());
     double thresholdBW = history[thresholdIdx];
 
     return currentBW <= thresholdBW;
 }
+
+std::vector<bool> checkVolatilitySqueezeSeries(std::span<const double> prices, int lookback, double percentile) {
+    size_t n = prices.size();
+    std::vector<bool> out(n, false);
+    if (lookback <= 0 || n <= (size_t)kSqueezeBBPeriod) return out;
+
+    // All bandwidths in one vectorised pass, then ranked as they stream in
+    size_t count = n - kSqueezeBBPeriod;
+    std::vector<double> bands;
+    std::span<double> middle, bandwidth;
+    squeezeBandwidths(prices, kSqueezeBBPeriod, count, bands, middle, bandwidth);
+
+    RollingSqueeze squeeze(lookback, percentile);
+    for (size_t i = 0; i < n; ++i) {
+        if (i < (size_t)kSqueezeBBPeriod) {
+            squeeze.updateBandwidth(false, 0.0);
+        } else {
+            size_t j = i - kSqueezeBBPeriod;
+            squeeze.updateBandwidth(middle[j] > 0, bandwidth[j]);
+        }
+        out[i] = squeeze.value();
+    }
+    return out;
+}
+
+// --- std::vector<double> overloads ---
+// Forward to the span implementations above (no copies).
+
+double computeRSI(const std::vector<double>& prices, int period) {
+    return computeRSI(std::span<const double>(prices), period);
+}
+
+double computeAdaptiveRSI(const std::vector<double>& prices, int basePeriod) {
+    return computeAdaptiveRSI(std::span<const double>(prices), basePeriod);
+}
+
+std::pair<double, double> computeMACD(const std::vector<double>& prices) {
+    return computeMACD(std::span<const double>(prices));
+}
+
+int detectCycle(const std::vector<double>& prices) {
+    return detectCycle(std::span<const double>(prices));
+}
+
+SupportResistance identifyLevels(const std::vector<double>& prices, int period) {
+    return identifyLevels(std::span<const double>(prices), period);
+}
+
+std::vector<double> findLocalExtrema(const std::vector<double>& prices, int period, bool findMaxima) {
+    return findLocalExtrema(std::span<const double>(prices), period, findMaxima);
+}
+
+BollingerBands computeBollingerBands(const std::vector<double>& prices, int period, double multiplier) {
+    return computeBollingerBands(std::span<const double>(prices), period, multiplier);
+}
+
+bool checkVolatilitySqueeze(const std::vector<double>& prices, int lookback, double percentile) {
+    return checkVolatilitySqueeze(std::span<const double>(prices), lookback, percentile);
+}
@@ -2,7 +2,13 @@
 #include <vector>
 #include <utility>
 #include <string>
+#include <span>
+#include <cstdint>
+#include <bit>
+#include <cmath>
+#include <algorithm>
 #include "MarketData.h"
+#include "BarColumns.h"
 
 // --- Original ---
 // Updated RSI for Adaptive Logic
@@ -10,7 +16,7 @@ double computeRSI(const std::vector<double>& prices, int period = 14);
 double computeAdaptiveRSI(const std::vector<double>& prices, int basePeriod = 14);
 
 std::pair<double, double> computeMACD(const std::vector<double>& prices);
-double computeATR(const std::vector<Candle>& candles, int period = 14);
+double computeATR(CandleView candles, int period = 14);
 
 // Updated Cycle Detection (Fourier)
 int detectCycle(const std::vector<double>& prices);
@@ -52,18 +58,184 @@ struct ADXResult {
     double plusDI;
     double minusDI;
 };
-ADXResult computeADX(const std::vector<Candle>& candles, int period = 14);
+ADXResult computeADX(CandleView candles, int period = 14);
 
 // 8. Candlestick Patterns
+enum class CandlePattern : uint8_t {
+    None,
+    Hammer,
+    ShootingStar,
+    BullishEngulfing,
+    BearishEngulfing,
+    Doji
+};
+const char* candlePatternName(CandlePattern pattern);  // "" for None
+
 struct PatternResult {
     std::string name;
     double score;
+    CandlePattern pattern = CandlePattern::None;
 };
-PatternResult detectCandlestickPattern(const std::vector<Candle>& candles);
+PatternResult detectCandlestickPattern(CandleView candles);
+
+// Same detection without building the name string (for per-bar use)
+struct PatternMatch {
+    CandlePattern pattern = CandlePattern::None;
+    double score = 0.0;
+};
+PatternMatch matchCandlestickPattern(CandleView candles);
 
 // 9. Volatility Squeeze
 bool checkVolatilitySqueeze(const std::vector<double>& prices, int lookback = 120, double percentile = 0.10);
 
 // 10. VWAP (Volume Weighted Average Price)
-double computeVWAP(const std::vector<Candle>& candles);
-double computeVWAP(const std::vector<Candle>& candles, int lookback);
\ No newline at end of file
+double computeVWAP(CandleView candles);
+double computeVWAP(CandleView candles, int lookback);
+
+// --- Column Overloads ---
+// Same indicators computed in place on a BarColumns store (pass closes() or
+// the columns themselves, or a first(n)/last(n) window of them) instead of
+// first extracting prices into a std::vector<double>. Results are identical
+// to the overloads above.
+double computeRSI(std::span<const double> prices, int period = 14);
+double computeAdaptiveRSI(std::span<const double> prices, int basePeriod = 14);
+std::pair<double, double> computeMACD(std::span<const double> prices);
+int detectCycle(std::span<const double> prices);
+SupportResistance identifyLevels(std::span<const double> prices, int period = 60);
+std::vector<double> findLocalExtrema(std::span<const double> prices, int period = 60, bool findMaxima = true);
+BollingerBands computeBollingerBands(std::span<const double> prices, int period = 20, double multiplier = 2.0);
+bool checkVolatilitySqueeze(std::span<const double> prices, int lookback = 120, double percentile = 0.10);
+
+double computeATR(const BarColumnsView& bars, int period = 14);
+ADXResult computeADX(const BarColumnsView& bars, int period = 14);
+PatternResult detectCandlestickPattern(const BarColumnsView& bars);
+PatternMatch matchCandlestickPattern(const BarColumnsView& bars);
+double computeVWAP(const BarColumnsView& bars);
+double computeVWAP(const BarColumnsView& bars, int lookback);
+
+// --- Full-Series Variants ---
+// The indicator at every bar in one pass: entry i is exactly what the scalar
+// function returns for the first i + 1 bars (the scalar functions are
+// wrappers over the same code). Use these instead of calling a scalar
+// function once per bar prefix, which is O(N^2).
+std::vector<double> computeRSISeries(std::span<const double> prices, int period = 14);
+std::vector<double> computeATRSeries(CandleView candles, int period = 14);
+std::vector<double> computeATRSeries(const BarColumnsView& bars, int period = 14);
+
+struct MACDSeries {
+    std::vector<double> macd;
+    std::vector<double> signal;
+
+    std::pair<double, double> at(size_t i) const { return {macd[i], signal[i]}; }
+};
+MACDSeries computeMACDSeries(std::span<const double> prices);
+
+// Rolling min/max through monotonic deques (amortised O(1) per bar)
+struct SupportResistanceSeries {
+    std::vector<double> support;
+    std::vector<double> resistance;
+
+    SupportResistance at(size_t i) const { return {support[i], resistance[i]}; }
+};
+SupportResistanceSeries identifyLevelsSeries(std::span<const double> prices, int period = 60);
+
+// Price targets at every bar; pivots are confirmed as they stream in
+std::vector<std::vector<double>> findLocalExtremaSeries(std::span<const double> prices, int period = 60, bool findMaxima = true);
+
+// Each window is summed afresh (O(N * period)) to keep the scalar numerics
+struct BollingerSeries {
+    std::vector<double> upper;
+    std::vector<double> middle;
+    std::vector<double> lower;
+    std::vector<double> bandwidth;
+
+    BollingerBands at(size_t i) const { return {upper[i], middle[i], lower[i], bandwidth[i]}; }
+};
+BollingerSeries computeBollingerBandsSeries(std::span<const double> prices, int period = 20, double multiplier = 2.0);
+
+// Squeeze flag at every bar, streaming the bandwidth ranks (O(N log lookback))
+std::vector<bool> checkVolatilitySqueezeSeries(std::span<const double> prices, int lookback = 120, double percentile = 0.10);
+
+struct ADXSeries {
+    std::vector<double> adx;
+    std::vector<double> plusDI;
+    std::vector<double> minusDI;
+
+    ADXResult at(size_t i) const { return {adx[i], plusDI[i], minusDI[i]}; }
+};
+ADXSeries computeADXSeries(CandleView candles, int period = 14);
+ADXSeries computeADXSeries(const BarColumnsView& bars, int period = 14);
+
+// Every candlestick pattern at every bar in one pass. mask[i] has bit
+// (1 << pattern) set for each pattern the first i + 1 bars end with; at(i) is
+// the one matchCandlestickPattern reports (the first in enum order) and
+// score[i] its score. Names are only resolved through candlePatternName.
+struct CandlePatternSeries {
+    std::vector<uint8_t> mask;
+    std::vector<double> score;
+
+    static constexpr uint8_t bit(CandlePattern pattern) { return (uint8_t)(1u << (unsigned)pattern); }
+
+    // Pattern reported for a mask, with its score
+    static PatternMatch first(uint8_t bits) {
+        static constexpr double kScore[] = {0.0, 0.5, -0.5, 0.6, -0.6, 0.0};
+        if (bits == 0) return {};
+        int pattern = std::countr_zero(bits);
+        return {(CandlePattern)pattern, kScore[pattern]};
+    }
+
+    bool has(size_t i, CandlePattern pattern) const { return (mask[i] & bit(pattern)) != 0; }
+    PatternMatch at(size_t i) const { return first(mask[i]); }
+
+    // Bars at which the pattern occurs
+    size_t count(CandlePattern pattern) const;
+};
+CandlePatternSeries scanCandlestickPatterns(CandleView candles);
+CandlePatternSeries scanCandlestickPatterns(const BarColumnsView& bars);
+
+// Bit (1 << pattern) for every pattern bar i (i >= 2) completes; the reported
+// pattern is the lowest set bit, i.e. the first rule in enum order. Bars is any
+// accessor with open/high/low/close(i). This is the one definition of the
+// rules: the scalar RollingKernels::candlePatterns path calls it, and the SIMD
+// paths mirror it comparison for comparison (tests/test_rolling_kernels.cpp
+// checks them against it).
+template <typename Bars>
+inline uint8_t patternMaskAt(const Bars& candles, size_t i) {
+    double open = candles.open(i), high = candles.high(i), low = candles.low(i), close = candles.close(i);
+    double prevOpen = candles.open(i - 1), prevClose = candles.close(i - 1);
+
+    double body = std::abs(close - open);
+    double range = high - low;
+    double upperShadow = high - std::max(open, close);
+    double lowerShadow = std::min(open, close) - low;
+
+    // Mean body of the last 3 candles, newest first
+    double avgBody = 0.0;
+    avgBody += body;
+    avgBody += std::abs(prevClose - prevOpen);
+    avgBody += std::abs(candles.close(i - 2) - candles.open(i - 2));
+    avgBody /= 3.0;
+
+    bool isBullish = close > open;
+    bool isBearish = close < open;
+    bool pBullish = prevClose > prevOpen;
+    bool pBearish = prevClose < prevOpen;
+
+    bool hammer = (lowerShadow > 2.0 * body) & (upperShadow < body * 0.5) & isBullish;
+    bool shootingStar = (upperShadow > 2.0 * body) & (lowerShadow < body * 0.5) & isBearish;
+    bool bullishEngulfing = pBearish & isBullish & (close > prevOpen) & (open < prevClose);
+    bool bearishEngulfing = pBullish & isBearish & (close < prevOpen) & (open > prevClose);
+    bool doji = (body < 0.1 * range) & (range > avgBody);
+
+    return (uint8_t)((hammer << (int)CandlePattern::Hammer) |
+                     (shootingStar << (int)CandlePattern::ShootingStar) |
+                     (bullishEngulfing << (int)CandlePattern::BullishEngulfing) |
+                     (bearishEngulfing << (int)CandlePattern::BearishEngulfing) |
+                     (doji << (int)CandlePattern::Doji));
+}
+
+// Anchored VWAP from bar 0, or over the (up to) lookback bars ending at each bar
+std::vector<double> computeVWAPSeries(CandleView candles);
+std::vector<double> computeVWAPSeries(CandleView candles, int lookback);
+std::vector<double> computeVWAPSeries(const BarColumnsView& bars);
+std::vector<double> computeVWAPSeries(const BarColumnsView& bars, int lookback);
@@ -75,6 +75,19 @@ Signal generateSignal(const std::string& symbol,
                       const SupportResistance& levels,
                       MLPredictor& mlModel,
                       const VIXData& vix)
+{
+    IndicatorContext indicators(candles);
+    return generateSignal(symbol, indicators, sentimentScore, fund, onChain, levels, mlModel, vix);
+}
+
+Signal generateSignal(const std::string& symbol,
+                      IndicatorContext& indicators,
+                      double sentimentScore,
+                      const Fundamentals& fund,
+                      const OnChainData& onChain,
+                      const SupportResistance& levels,
+                      MLPredictor& mlModel,
+                      const VIXData& vix)
 {
     Signal sig;
     sig.action = "hold";
@@ -85,10 +98,11 @@ Signal generateSignal(const std::string& symbol,
     sig.takeProfit = 0.0;
     sig.mlForecast = 0.0;
 
-    if (candles.empty()) return sig;
+    if (indicators.size() == 0) return sig;
 
-    std::vector<double> closes;
-    for(const auto& c : candles) closes.push_back(c.close);
+    CandleView candles = indicators.candles();
+    const std::vector<double>& closes = indicators.closes();
+    size_t last = closes.size() - 1;
 
     double currentPrice = closes.back();
     sig.entry = currentPrice;
@@ -101,7 +115,7 @@ Signal generateSignal(const std::string& symbol,
     double garchVol = computeGARCHVolatility(returns);
     int cyclePeriod = detectCycle(closes);
     
-    std::pair<double, double> macd = computeMACD(closes);
+    std::pair<double, double> macd = indicators.macd().at(last);
     double rsi = computeAdaptiveRSI(closes, 14); 
     
     std::vector<double> features = mlModel.extractFeatures(
@@ -132,8 +146,8 @@ Signal generateSignal(const std::string& symbol,
     stat_score += std::clamp(forecast_diff * 5.0, -0.5, 0.5);
     
     // Indicators
-    ADXResult adx = computeADX(candles);
-    BollingerBands bb = computeBollingerBands(closes);
+    ADXResult adx = indicators.adx(14).at(last);
+    BollingerBands bb = indicators.bollinger(20, 2.0).at(last);
     
     // Regime-aware Logic
     if (regime == "Bull") {
@@ -259,7 +273,7 @@ Signal generateSignal(const std::string& symbol,
             if (!above && t < currentPrice * 0.995) filtered.push_back(t);
         }
         if (filtered.empty()) {
-             double atr = computeATR(candles, 14); 
+             double atr = indicators.atr(14)[last];
              if (atr == 0) atr = currentPrice * 0.02; // Fallback 2%
              filtered.push_back(above ? currentPrice + 2*atr : currentPrice - 2*atr);
         }
@@ -4,6 +4,7 @@
 #include <optional>
 #include "MarketData.h"
 #include "TechnicalAnalysis.h" // For SupportResistance struct
+#include "IndicatorContext.h"
 #include "MLPredictor.h"      // New ML integration
 #include "FundamentalScorer.h" // For comprehensive fundamental scoring
 
@@ -51,4 +52,16 @@ Signal generateSignal(const std::string& symbol,
                       const OnChainData& onChain,
                       const SupportResistance& levels,
                       MLPredictor& mlModel,
-                      const VIXData& vix);
\ No newline at end of file
+                      const VIXData& vix);
+
+// Same signal with the indicators read from a shared IndicatorContext over
+// the candles (e.g. one also handed to the symbol's strategy), so series
+// already computed there are not computed again
+Signal generateSignal(const std::string& symbol,
+                      IndicatorContext& indicators,
+                      double sentimentScore,
+                      const Fundamentals& fund,
+                      const OnChainData& onChain,
+                      const SupportResistance& levels,
+                      MLPredictor& mlModel,
+                      const VIXData& vix);
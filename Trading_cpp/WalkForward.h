@@ -157,7 +157,10 @@ public:
         double bestObjective = -1e18;
         std::vector<StrategyParams> bestParams = baseParams;
 
-        Backtester backtester(backtestConfig_);
+        // Only the objective is read from each trial run
+        BacktestConfig trialConfig = backtestConfig_;
+        trialConfig.resultDetail = ResultDetail::SummaryOnly;
+        Backtester backtester(trialConfig);
 
         // Test each combination
         for (const auto& paramSet : allCombinations) {
@@ -359,7 +362,10 @@ public:
         Result result;
         result.returnDistribution.reserve(numSimulations);
 
-        Backtester backtester(config);
+        // Only totalReturn is kept from each simulation
+        BacktestConfig simConfig = config;
+        simConfig.resultDetail = ResultDetail::SummaryOnly;
+        Backtester backtester(simConfig);
 
         for (int sim = 0; sim < numSimulations; ++sim) {
             // Create noisy version of data
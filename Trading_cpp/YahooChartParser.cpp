@@ -0,0 +1,233 @@
+#include "YahooChartParser.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace YahooChart {
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr double kNullPrice = std::numeric_limits<double>::quiet_NaN();
+constexpr TimePoint kNullTime = TimePoint::min();
+
+// Keys on the paths we keep; everything else is Other
+enum class Field : uint8_t { Other, Chart, Result, Timestamp, Indicators, Quote, Open, High, Low, Close, Volume };
+
+Field fieldFor(const std::string& key) {
+    static const std::array<std::pair<const char*, Field>, 10> kFields = {{
+        {"chart", Field::Chart}, {"result", Field::Result}, {"timestamp", Field::Timestamp},
+        {"indicators", Field::Indicators}, {"quote", Field::Quote}, {"open", Field::Open},
+        {"high", Field::High}, {"low", Field::Low}, {"close", Field::Close}, {"volume", Field::Volume},
+    }};
+    for (const auto& [name, field] : kFields) {
+        if (key == name) return field;
+    }
+    return Field::Other;
+}
+
+// Timestamps in the payload: the commas of the "timestamp" array, counted
+// without parsing. Only sizes the columns; the parse itself decides.
+size_t countTimestamps(std::string_view response) {
+    size_t key = response.find("\"timestamp\"");
+    if (key == std::string_view::npos) return 0;
+    size_t open = response.find('[', key);
+    size_t close = response.find(']', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) return 0;
+
+    std::string_view items = response.substr(open + 1, close - open - 1);
+    if (items.find_first_not_of(" \t\r\n") == std::string_view::npos) return 0;
+    return (size_t)std::count(items.begin(), items.end(), ',') + 1;
+}
+
+// SAX handler: tracks the container path and appends the values of the
+// timestamp and quote arrays to their columns
+class ChartHandler {
+public:
+    enum Column { kTimestamp, kOpen, kHigh, kLow, kClose, kVolume, kColumns, kNone = kColumns };
+
+    explicit ChartHandler(size_t expectedBars) {
+        ts_.reserve(expectedBars);
+        for (Column c : {kOpen, kHigh, kLow, kClose}) prices(c).reserve(expectedBars);
+        volume_.reserve(expectedBars);
+    }
+
+    // --- nlohmann::json_sax interface ---
+    bool null() { return value(kNullPrice, kNullTime, 0); }
+    bool boolean(bool) { return value(kNullPrice, kNullTime, 0); }
+    bool number_integer(json::number_integer_t v) { return number((double)v, v); }
+    bool number_unsigned(json::number_unsigned_t v) { return number((double)v, (int64_t)v); }
+    bool number_float(json::number_float_t v, const json::string_t&) {
+        return number(v, std::abs(v) < 9.0e18 ? (int64_t)v : 0);
+    }
+    bool string(json::string_t&) { return value(kNullPrice, kNullTime, 0); }
+    bool binary(json::binary_t&) { return value(kNullPrice, kNullTime, 0); }
+    bool start_object(std::size_t) { return push(false); }
+    bool end_object() { return pop(); }
+    bool start_array(std::size_t) { return push(true); }
+    bool end_array() { return pop(); }
+    bool key(json::string_t& key) {
+        pendingKey_ = fieldFor(key);
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
+        error_ = e.what();
+        return false;
+    }
+
+    const std::string& error() const { return error_; }
+
+    // Resolve nulls in place and hand the columns over
+    BarColumns finish(NullPrices nulls) {
+        // Short (or missing) columns read as null
+        size_t n = ts_.size();
+        for (Column c : {kOpen, kHigh, kLow, kClose}) prices(c).resize(n, kNullPrice);
+        volume_.resize(n, 0);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (ts_[i] == kNullTime || std::isnan(close_[i])) continue;
+
+            double o = present_[kOpen] ? open_[i] : close_[i];
+            double h = present_[kHigh] ? high_[i] : close_[i];
+            double l = present_[kLow] ? low_[i] : close_[i];
+            if (nulls == NullPrices::SkipBar && (std::isnan(o) || std::isnan(h) || std::isnan(l))) continue;
+
+            ts_[kept] = ts_[i];
+            open_[kept] = std::isnan(o) ? close_[i] : o;
+            high_[kept] = std::isnan(h) ? close_[i] : h;
+            low_[kept] = std::isnan(l) ? close_[i] : l;
+            close_[kept] = close_[i];
+            volume_[kept] = volume_[i];
+            ++kept;
+        }
+
+        ts_.resize(kept);
+        for (Column c : {kOpen, kHigh, kLow, kClose}) prices(c).resize(kept);
+        volume_.resize(kept);
+        return BarColumns(std::move(ts_), std::move(open_), std::move(high_), std::move(low_), std::move(close_),
+                          std::move(volume_));
+    }
+
+private:
+    struct Frame {
+        Field field;     // Key of this container in its parent object (Other in an array)
+        bool array;
+        size_t index;    // Position in the parent array
+        size_t count;    // Values seen so far (arrays)
+        Column column;   // Column an array feeds, or kNone
+    };
+
+    // Yahoo's quote arrays sit 8 levels deep; deeper levels are only counted
+    static constexpr size_t kMaxDepth = 16;
+
+    Frame* top() { return depth_ > 0 && depth_ <= kMaxDepth ? &stack_[depth_ - 1] : nullptr; }
+
+    // chart.result[0] (and, for quotes, .indicators.quote[0]) above an array
+    // opened under `key`
+    Column columnFor(Field key) const {
+        auto isResult0 = [this] {
+            return !stack_[0].array && stack_[1].field == Field::Chart && !stack_[1].array &&
+                   stack_[2].field == Field::Result && stack_[2].array && stack_[3].index == 0 && !stack_[3].array;
+        };
+        if (depth_ == 4 && key == Field::Timestamp && isResult0()) return kTimestamp;
+        if (depth_ == 7 && isResult0() && stack_[4].field == Field::Indicators && !stack_[4].array &&
+            stack_[5].field == Field::Quote && stack_[5].array && stack_[6].index == 0 && !stack_[6].array) {
+            switch (key) {
+                case Field::Open: return kOpen;
+                case Field::High: return kHigh;
+                case Field::Low: return kLow;
+                case Field::Close: return kClose;
+                case Field::Volume: return kVolume;
+                default: break;
+            }
+        }
+        return kNone;
+    }
+
+    bool push(bool array) {
+        Frame* parent = top();
+        Frame frame{Field::Other, array, 0, 0, kNone};
+        if (parent && parent->array) {
+            frame.index = parent->count;
+        } else if (parent) {
+            frame.field = pendingKey_;
+        }
+        if (array && depth_ < kMaxDepth) frame.column = columnFor(frame.field);
+        if (frame.column != kNone) present_[frame.column] = true;
+
+        if (depth_ < kMaxDepth) stack_[depth_] = frame;
+        ++depth_;
+        return true;
+    }
+
+    bool pop() {
+        --depth_;
+        if (Frame* parent = top(); parent && parent->array) ++parent->count;
+        return true;
+    }
+
+    bool number(double price, int64_t integer) {
+        return value(price, TimeUtils::fromUnixSeconds(integer), integer);
+    }
+
+    // A scalar: appended when it is the next element of a column array
+    bool value(double price, TimePoint time, int64_t volume) {
+        Frame* frame = top();
+        if (!frame || !frame->array) return true;
+        size_t index = frame->count++;
+        switch (frame->column) {
+            case kTimestamp:
+                if (index == ts_.size()) ts_.push_back(time);
+                break;
+            case kOpen:
+            case kHigh:
+            case kLow:
+            case kClose:
+                if (index == prices(frame->column).size()) prices(frame->column).push_back(price);
+                break;
+            case kVolume:
+                if (index == volume_.size()) volume_.push_back(volume);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    std::array<Frame, kMaxDepth> stack_{};
+    size_t depth_ = 0;
+    Field pendingKey_ = Field::Other;
+
+    std::vector<double>& prices(Column column) {
+        switch (column) {
+            case kOpen: return open_;
+            case kHigh: return high_;
+            case kLow: return low_;
+            default: return close_;
+        }
+    }
+
+    std::vector<TimePoint> ts_;
+    std::vector<double> open_, high_, low_, close_;
+    std::vector<int64_t> volume_;
+    std::array<bool, kColumns> present_{};
+    std::string error_;
+};
+
+}  // namespace
+
+Result<BarColumns> parse(std::string_view response, NullPrices nulls) {
+    ChartHandler handler(countTimestamps(response));
+    if (!json::sax_parse(response.begin(), response.end(), &handler)) {
+        return Error::parse("Yahoo chart: " + handler.error());
+    }
+    return handler.finish(nulls);
+}
+
+}  // namespace YahooChart
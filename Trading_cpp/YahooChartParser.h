@@ -0,0 +1,35 @@
+#pragma once
+#include <string_view>
+#include "BarColumns.h"
+#include "Result.h"
+
+// Streaming parser for Yahoo Finance chart v8 responses.
+//
+// The response is walked once with nlohmann's SAX interface, without
+// building a DOM: values under chart.result[0].timestamp and
+// chart.result[0].indicators.quote[0].{open,high,low,close,volume} are
+// appended straight to their columns, and everything else (meta, events,
+// adjclose) is skipped as it streams past. A pre-scan counts the timestamps
+// so every column is allocated once at its final size.
+//
+// Null prices are stored as NaN while parsing and resolved in one in-place
+// pass at the end, per NullPrices; a null volume is 0.
+namespace YahooChart {
+
+// What to do with a bar whose prices are null (or whose column is missing)
+enum class NullPrices {
+    FillFromClose,  // Skip bars without a close; other null prices take the close
+    SkipBar,        // Skip bars with any null price; a missing column takes the close
+};
+
+// Policy for bars kept in the history archive (HistoryStore.h). The archive
+// of a symbol is shared by every caller, and a delta merge expects the
+// anchor bar back unchanged, so they must all parse it the same way.
+constexpr NullPrices kArchivedNullPrices = NullPrices::FillFromClose;
+
+// Bars of the first result's first quote, in payload order. A payload
+// without a result (e.g. an unknown symbol) gives empty columns; malformed
+// JSON gives a parse error.
+Result<BarColumns> parse(std::string_view response, NullPrices nulls = NullPrices::FillFromClose);
+
+}  // namespace YahooChart
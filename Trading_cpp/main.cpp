@@ -351,6 +351,12 @@ int main() {
     Logger::getInstance().log("ONNX Runtime not compiled in. Set USE_ONNXRUNTIME to enable.");
 #endif
 
+    // 0. Fetch every ticker's history concurrently up front (one I/O thread);
+    // processTicker then reads it from the bar archive
+    std::vector<std::pair<std::string, std::string>> symbols;
+    for (const auto& t : tickers) symbols.emplace_back(t.symbol, t.type);
+    prefetchBarColumns(symbols);
+
     // 1. Parallel Execution (Throttled in batches of 4)
     const size_t batchSize = 4;
     for (size_t i = 0; i < tickers.size(); i += batchSize) {
@@ -0,0 +1,104 @@
+// Microbenchmark for the rolling-window kernels on 1M-bar arrays.
+//
+// Times each kernel at every SIMD level the CPU supports and prints the
+// speedup over the scalar path. Build with optimisation, e.g.
+//   g++ -std=c++20 -O2 -I. tests/bench_rolling_kernels.cpp RollingKernels.cpp TechnicalAnalysis.cpp
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../RollingKernels.h"
+#include "../TechnicalAnalysis.h"
+
+using RollingKernels::SimdLevel;
+
+namespace {
+
+constexpr size_t kBars = 1000000;
+constexpr int kRepeats = 5;
+
+// Best of kRepeats, in milliseconds
+double timeMs(const std::function<void()>& run) {
+    double best = 1e300;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> move(0.0, 0.01);
+    std::vector<double> close(kBars), high(kBars), low(kBars);
+    double price = 100.0;
+    for (size_t i = 0; i < kBars; ++i) {
+        price *= 1.0 + move(rng);
+        close[i] = price;
+        high[i] = price * 1.005;
+        low[i] = price * 0.995;
+    }
+
+    std::vector<double> a(kBars), b(kBars), c(kBars), d(kBars);
+    volatile double sink = 0.0;
+
+    struct Case {
+        const char* name;
+        std::function<void()> run;
+    };
+    std::vector<Case> cases = {
+        {"SMA(20)", [&] { RollingKernels::rollingMean(close, 19, 20, std::span<double>(a).first(kBars - 19)); }},
+        {"SMA(200)", [&] { RollingKernels::rollingMean(close, 199, 200, std::span<double>(a).first(kBars - 199)); }},
+        {"SMA(200) exact", [&] {
+             RollingKernels::rollingMean(close, 199, 200, std::span<double>(a).first(kBars - 199),
+                                         RollingKernels::WindowSums::ExactOldestFirst);
+         }},
+        {"StdDev(20)", [&] {
+             RollingKernels::rollingStdDev(close, 19, 20, std::span<double>(a).first(kBars - 19),
+                                           std::span<double>(b).first(kBars - 19));
+         }},
+        {"StdDev(20) exact", [&] {
+             RollingKernels::rollingStdDev(close, 19, 20, std::span<double>(a).first(kBars - 19),
+                                           std::span<double>(b).first(kBars - 19),
+                                           RollingKernels::WindowSums::ExactOldestFirst);
+         }},
+        {"Bollinger series(20)", [&] { sink = sink + computeBollingerBandsSeries(close, 20, 2.0).bandwidth.back(); }},
+        {"TrueRange", [&] { RollingKernels::trueRange(high, low, close, d); }},
+        {"ATR(14)", [&] { RollingKernels::averageTrueRange(high, low, close, 14, d); }},
+        {"Squeeze(120) x 10k", [&] {
+             for (size_t end = kBars - 10000; end < kBars; ++end) {
+                 sink = sink + checkVolatilitySqueeze(std::span<const double>(close).first(end), 120, 0.10);
+             }
+         }},
+    };
+
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (RollingKernels::detectedSimdLevel() >= SimdLevel::SSE2) levels.push_back(SimdLevel::SSE2);
+    if (RollingKernels::detectedSimdLevel() >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+
+    std::printf("%zu bars, best of %d runs (ms)\n", kBars, kRepeats);
+    std::printf("%-22s", "kernel");
+    for (SimdLevel level : levels) std::printf("%12s", RollingKernels::toString(level));
+    std::printf("%12s\n", "speedup");
+
+    for (const auto& test : cases) {
+        std::printf("%-22s", test.name);
+        double scalar = 0.0, best = 0.0;
+        for (SimdLevel level : levels) {
+            RollingKernels::setSimdLevel(level);
+            double ms = timeMs(test.run);
+            if (level == SimdLevel::Scalar) scalar = ms;
+            best = ms;
+            std::printf("%12.2f", ms);
+        }
+        std::printf("%11.2fx\n", scalar / best);
+    }
+    RollingKernels::setSimdLevel(RollingKernels::detectedSimdLevel());
+    return 0;
+}
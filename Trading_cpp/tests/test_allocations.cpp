@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "../AllocationCounter.h"
+#include "../Backtester.h"
+#include "../IStrategy.h"
+#include "../Strategies/EnsembleStrategy.h"
+#include "../Strategies/MeanReversionStrategy.h"
+#include "../Strategies/TrendFollowingStrategy.h"
+
+// Build with TRADING_COUNT_ALLOCATIONS defined and AllocationCounter.cpp
+// linked in; otherwise every test here is skipped.
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Trending and ranging stretches so the strategies open and close trades
+std::vector<Candle> makeCandles(size_t count) {
+    std::vector<Candle> candles;
+    candles.reserve(count);
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        double drift = (i / 150) % 2 == 0 ? 0.004 : -0.004;
+        double change = price * (drift + 0.02 * std::sin(i * 0.7));
+        Candle c;
+        c.ts = TimeUtils::fromUnixSeconds(1600000000 + 86400 * static_cast<int64_t>(i));
+        c.date = std::to_string(TimeUtils::toUnixSeconds(c.ts));
+        c.open = price;
+        c.close = price + change;
+        c.high = std::max(c.open, c.close) * 1.01;
+        c.low = std::min(c.open, c.close) * 0.99;
+        c.volume = (i % 3 == 0 ? 2000000 : 800000) + static_cast<int64_t>((i * 7919) % 100000);
+        price = c.close;
+        candles.push_back(c);
+    }
+    return candles;
+}
+
+// Alternating entries and exits every few bars
+SignalArray makeSignals(size_t bars, size_t firstBar) {
+    SignalArray signals(bars, firstBar);
+    for (size_t i = firstBar; i < bars; ++i) {
+        if (i % 10 == 0) signals.set(i, StrategySignal::buy(0.8));
+        else if (i % 10 == 5) signals.set(i, StrategySignal::sell(0.8));
+    }
+    return signals;
+}
+
+// Allocations made by onBar()/currentSignal() over bars [warmup, end)
+uint64_t allocationsAfterWarmup(IStrategy& strategy, const std::vector<Candle>& candles, size_t warmup) {
+    strategy.reset();
+    for (size_t i = 0; i < warmup; ++i) strategy.onBar(candles[i]);
+
+    AllocationScope scope;
+    int actionable = 0;
+    for (size_t i = warmup; i < candles.size(); ++i) {
+        strategy.onBar(candles[i]);
+        if (strategy.currentSignal().isActionable()) ++actionable;
+    }
+    uint64_t allocations = scope.allocations();
+    EXPECT_GT(actionable, 0) << strategy.getName() << " never signalled";
+    return allocations;
+}
+
+}  // namespace
+
+// ============================================================================
+// Counter Tests
+// ============================================================================
+
+TEST(AllocationCounterTest, CountsHeapAllocations) {
+    if (!AllocationCounter::enabled()) GTEST_SKIP() << "TRADING_COUNT_ALLOCATIONS not defined";
+
+    AllocationScope scope;
+    auto buffer = std::make_unique<std::vector<double>>(1000, 1.0);
+    EXPECT_EQ(buffer->size(), 1000u);
+    EXPECT_EQ(scope.allocations(), 2u);
+}
+
+// ============================================================================
+// Hot Loop Tests
+// ============================================================================
+
+TEST(AllocationFreeTest, SimulationKernelCostDoesNotGrowWithBars) {
+    if (!AllocationCounter::enabled()) GTEST_SKIP() << "TRADING_COUNT_ALLOCATIONS not defined";
+
+    auto allocationsFor = [](size_t bars) {
+        BarColumns columns(makeCandles(bars));
+        SignalArray signals = makeSignals(bars, 50);
+        Backtester backtester;
+
+        AllocationScope scope;
+        BacktestResult result = backtester.run(columns.view(), signals);
+        uint64_t allocations = scope.allocations();
+        EXPECT_GT(result.trades, 10);
+        return allocations;
+    };
+
+    // Setup allocations only (result buffers, metrics); none per bar or per trade
+    EXPECT_EQ(allocationsFor(1000), allocationsFor(4000));
+}
+
+TEST(AllocationFreeTest, IncrementalStrategiesDoNotAllocatePerBar) {
+    if (!AllocationCounter::enabled()) GTEST_SKIP() << "TRADING_COUNT_ALLOCATIONS not defined";
+
+    auto candles = makeCandles(1200);
+
+    TrendFollowingStrategy trend;
+    EXPECT_EQ(allocationsAfterWarmup(trend, candles, 200), 0u);
+
+    MeanReversionStrategy meanReversion;
+    EXPECT_EQ(allocationsAfterWarmup(meanReversion, candles, 200), 0u);
+
+    EnhancedMeanReversionStrategy enhanced;
+    EXPECT_EQ(allocationsAfterWarmup(enhanced, candles, 200), 0u);
+
+    std::vector<std::unique_ptr<IStrategy>> children;
+    children.push_back(std::make_unique<MeanReversionStrategy>());
+    children.push_back(std::make_unique<TrendFollowingStrategy>());
+    EnsembleStrategy ensemble(std::move(children));
+    EXPECT_EQ(allocationsAfterWarmup(ensemble, candles, 200), 0u);
+}
+
+TEST(AllocationFreeTest, StrategyBacktestCostDoesNotGrowWithBars) {
+    if (!AllocationCounter::enabled()) GTEST_SKIP() << "TRADING_COUNT_ALLOCATIONS not defined";
+
+    auto allocationsFor = [](size_t bars) {
+        auto candles = makeCandles(bars);
+        TrendFollowingStrategy strategy;
+        Backtester backtester;
+
+        AllocationScope scope;
+        BacktestResult result = backtester.run(candles, strategy);
+        uint64_t allocations = scope.allocations();
+        EXPECT_GT(result.trades, 0);
+        return allocations;
+    };
+
+    EXPECT_EQ(allocationsFor(1000), allocationsFor(4000));
+}
+
+// ============================================================================
+// Reason Text Tests
+// ============================================================================
+
+TEST(SignalReasonTest, CodedReasonsRenderLazily) {
+    StrategySignal sig = StrategySignal::buy(0.8, SignalReason::BelowBBLower, 27.6);
+    EXPECT_TRUE(sig.reason.empty());
+    sig.reasonFlags = SignalReasonFlag::Squeeze |
+                      SignalReasonFlag::pattern(CandlePattern::BullishEngulfing) |
+                      SignalReasonFlag::ReducedDowntrend;
+    EXPECT_EQ(sig.reasonText(), "RSI: 27, Below BB Lower, Squeeze, Bullish Engulfing (reduced: downtrend)");
+
+    StrategySignal cross = StrategySignal::sell(0.5, SignalReason::MACrossDown, 31.2, 24.9);
+    EXPECT_EQ(cross.reasonText(), "MA Cross Down, ADX: 31, -DI: 24");
+
+    // Free text wins over the code
+    cross.reason = "custom";
+    EXPECT_EQ(cross.reasonText(), "custom");
+
+    EXPECT_EQ(toString(TradeSide::Short), std::string("short"));
+    EXPECT_EQ(toString(ExitReason::StopLoss), std::string("stop_loss"));
+}
+
+TEST(SignalReasonTest, EnsembleNamesAgreeingChildren) {
+    std::vector<std::unique_ptr<IStrategy>> children;
+    children.push_back(std::make_unique<MeanReversionStrategy>());
+    children.push_back(std::make_unique<TrendFollowingStrategy>());
+    EnsembleStrategy ensemble(std::move(children));
+
+    StrategySignal sig = StrategySignal::buy(0.7, SignalReason::EnsembleConsensus, 1, 2);
+    sig.reasonFlags = 1u << 1;
+    EXPECT_EQ(ensemble.describeSignal(sig), "Ensemble(1/2): TrendFollowing");
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -5,6 +5,7 @@
 #include <numeric>
 
 #include "../Backtester.h"
+#include "../BatchBacktester.h"
 #include "../BacktestConfig.h"
 #include "../IStrategy.h"
 #include "../Strategies/MeanReversionStrategy.h"
@@ -315,7 +316,7 @@ TEST(BacktesterTest, StopLossRecordsExitReason) {
     // Check that at least one trade was closed by stop-loss
     bool hasStopLossExit = false;
     for (const auto& trade : result.tradeLog) {
-        if (trade.exitReason == "stop_loss") {
+        if (trade.exitReason == ExitReason::StopLoss) {
             hasStopLossExit = true;
             break;
         }
@@ -337,7 +338,7 @@ TEST(BacktesterTest, TakeProfitTriggersOnUptrend) {
     // Check that at least one trade was closed by take-profit
     bool hasTakeProfitExit = false;
     for (const auto& trade : result.tradeLog) {
-        if (trade.exitReason == "take_profit") {
+        if (trade.exitReason == ExitReason::TakeProfit) {
             hasTakeProfitExit = true;
             break;
         }
@@ -346,7 +347,7 @@ TEST(BacktesterTest, TakeProfitTriggersOnUptrend) {
     EXPECT_TRUE(hasTakeProfitExit);
 }
 
-TEST(BacktesterTest, TrailingStopLocks profits) {
+TEST(BacktesterTest, TrailingStopLocksProfits) {
     auto candles = TestData::generateUptrend(150, 100.0f, 0.003f);
     // Add a reversal
     for (size_t i = 0; i < 50; ++i) {
@@ -372,7 +373,7 @@ TEST(BacktesterTest, TrailingStopLocks profits) {
     // Check trade log for trailing_stop exit
     bool hasTrailingStopExit = false;
     for (const auto& trade : result.tradeLog) {
-        if (trade.exitReason == "trailing_stop") {
+        if (trade.exitReason == ExitReason::TrailingStop) {
             hasTrailingStopExit = true;
             EXPECT_GT(trade.pnl, 0.0f);  // Should have locked in profit
             break;
@@ -466,7 +467,7 @@ TEST(BacktesterTest, FixedFractionPositionSizing) {
     auto candles = TestData::generateUptrend(200);
 
     BacktestConfig config = BacktestConfig::zeroCostConfig();
-    config.sizing.method = PositionSizing::FixedFraction;
+    config.sizing.method = PositionSizing::Method::FixedFraction;
     config.sizing.fixedFraction = 0.2f;  // 20% per trade
 
     Backtester backtester(config);
@@ -616,6 +617,223 @@ TEST(BacktesterTest, StaticAndInstanceMethodsComparable) {
     EXPECT_FALSE(std::isnan(instanceResult.totalReturn));
 }
 
+// ============================================================================
+// History View Tests
+// ============================================================================
+
+// Vector-only strategy that checks the history it is handed
+class HistoryCheckingStrategy : public IStrategy {
+public:
+    explicit HistoryCheckingStrategy(const std::vector<Candle>& source) : source_(source) {}
+
+    StrategySignal generateSignal(const std::vector<Candle>& history, size_t idx) override {
+        if (history.size() != idx + 1 || history.back().close != source_[idx].close) {
+            mismatches++;
+        }
+        return (idx % 15 == 0) ? StrategySignal::buy(1.0) :
+               (idx % 15 == 7) ? StrategySignal::sell(1.0) : StrategySignal::hold();
+    }
+
+    std::string getName() const override { return "HistoryChecking"; }
+    int getWarmupPeriod() const override { return 60; }
+    std::unique_ptr<IStrategy> clone() const override {
+        return std::make_unique<HistoryCheckingStrategy>(*this);
+    }
+
+    int mismatches = 0;
+
+private:
+    const std::vector<Candle>& source_;
+};
+
+TEST(BacktesterTest, VectorStrategySeesFullPrefixThroughView) {
+    auto candles = TestData::generateVolatile(300);
+
+    Backtester backtester(BacktestConfig::zeroCostConfig());
+    HistoryCheckingStrategy strategy(candles);
+    BacktestResult result = backtester.run(candles, strategy);
+
+    EXPECT_EQ(strategy.mismatches, 0);
+    EXPECT_GT(result.trades, 0);
+}
+
+TEST(BacktesterTest, StrategyAndSignalFunctionPathsAgree) {
+    auto candles = TestData::generateMeanReverting(400);
+    Backtester backtester(BacktestConfig::realisticConfig());
+
+    MeanReversionStrategy viewStrategy;
+    BacktestResult viaView = backtester.run(candles, viewStrategy);
+
+    MeanReversionStrategy vectorStrategy;
+    BacktestResult viaVector = backtester.run(candles,
+        [&vectorStrategy](const std::vector<Candle>& h, size_t idx) {
+            return vectorStrategy.generateSignal(h, idx);
+        }, vectorStrategy.getWarmupPeriod());
+
+    EXPECT_EQ(viaView.trades, viaVector.trades);
+    EXPECT_DOUBLE_EQ(viaView.totalReturn, viaVector.totalReturn);
+    EXPECT_EQ(viaView.equityCurve, viaVector.equityCurve);
+}
+
+// ============================================================================
+// Precomputed Signal Tests
+// ============================================================================
+
+TEST(BacktesterTest, PrecomputedSignalsMatchStrategyRun) {
+    auto candles = TestData::generateMeanReverting(400);
+    Backtester backtester(BacktestConfig::realisticConfig());
+
+    MeanReversionStrategy strategy;
+    BacktestResult direct = backtester.run(candles, strategy);
+
+    MeanReversionStrategy bulk;
+    SignalArray signals = bulk.generateSignals(candles, bulk.getWarmupPeriod());
+    ASSERT_EQ(signals.size(), candles.size());
+    BacktestResult replayed = backtester.run(candles, signals);
+
+    EXPECT_EQ(direct.trades, replayed.trades);
+    EXPECT_DOUBLE_EQ(direct.totalReturn, replayed.totalReturn);
+    EXPECT_EQ(direct.equityCurve, replayed.equityCurve);
+    ASSERT_EQ(direct.tradeLog.size(), replayed.tradeLog.size());
+    for (size_t i = 0; i < direct.tradeLog.size(); ++i) {
+        EXPECT_EQ(direct.tradeLog[i].entryIndex, replayed.tradeLog[i].entryIndex);
+        EXPECT_EQ(direct.tradeLog[i].exitReason, replayed.tradeLog[i].exitReason);
+    }
+}
+
+TEST(BacktesterTest, SignalArrayReplaysUnderDifferentCosts) {
+    auto candles = TestData::generateVolatile(300);
+    SignalArray signals(candles.size(), 60);
+    for (size_t i = 60; i < candles.size(); ++i) {
+        if (i % 20 == 0) signals.set(i, StrategySignal::buy(1.0));
+        else if (i % 20 == 10) signals.set(i, StrategySignal::sell(1.0));
+    }
+
+    Backtester backtester(BacktestConfig::zeroCostConfig());
+    BacktestResult cheap = backtester.run(candles, signals);
+
+    BacktestConfig costly = BacktestConfig::zeroCostConfig();
+    costly.costs.commissionPercent = 0.01;
+    backtester.setConfig(costly);
+    BacktestResult expensive = backtester.run(candles, signals);
+
+    // Same entries and exits, only the costs differ
+    EXPECT_EQ(cheap.trades, expensive.trades);
+    EXPECT_GT(expensive.totalCommissions, cheap.totalCommissions);
+    EXPECT_LT(expensive.totalReturn, cheap.totalReturn);
+}
+
+TEST(BacktesterTest, ColumnRunMatchesCandleRun) {
+    auto candles = TestData::generateVolatile(300);
+    TrendFollowingStrategy strategy;
+    SignalArray signals = strategy.generateSignals(candles, strategy.getWarmupPeriod());
+
+    Backtester backtester(BacktestConfig::realisticConfig());
+    BarColumns bars(candles);
+    BacktestResult fromColumns = backtester.run(bars, signals);
+    BacktestResult fromCandles = backtester.run(candles, signals);
+
+    EXPECT_EQ(fromColumns.trades, fromCandles.trades);
+    EXPECT_EQ(fromColumns.equityCurve, fromCandles.equityCurve);
+    EXPECT_DOUBLE_EQ(fromColumns.sharpeRatio, fromCandles.sharpeRatio);
+}
+
+// ============================================================================
+// Batch Backtester Tests
+// ============================================================================
+
+TEST(BatchBacktesterTest, MatchesIndividualRunsPerConfig) {
+    auto candles = TestData::generateVolatile(400);
+
+    std::vector<BacktestConfig> configs;
+    configs.push_back(BacktestConfig::zeroCostConfig());
+    configs.push_back(BacktestConfig::realisticConfig());
+    for (double stop : {0.01, 0.03}) {
+        BacktestConfig c = BacktestConfig::realisticConfig();
+        c.allowShort = true;
+        c.risk.enableStopLoss = true;
+        c.risk.stopLossPercent = stop;
+        c.risk.enableTrailingStop = true;
+        configs.push_back(c);
+    }
+    BacktestConfig breaker = BacktestConfig::defaultConfig();
+    breaker.risk.enableMaxDrawdownStop = true;
+    breaker.risk.maxDrawdownPercent = 0.02;  // Trips early
+    configs.push_back(breaker);
+
+    MeanReversionStrategy strategy;
+    BatchBacktester batch(configs);
+    std::vector<BacktestResult> results = batch.run(candles, strategy);
+    ASSERT_EQ(results.size(), configs.size());
+
+    for (size_t k = 0; k < configs.size(); ++k) {
+        Backtester single(configs[k]);
+        MeanReversionStrategy fresh;
+        BacktestResult expected = single.run(candles, fresh);
+
+        EXPECT_EQ(results[k].trades, expected.trades) << "config " << k;
+        EXPECT_EQ(results[k].totalReturn, expected.totalReturn) << "config " << k;
+        EXPECT_EQ(results[k].sharpeRatio, expected.sharpeRatio) << "config " << k;
+        EXPECT_EQ(results[k].maxDrawdown, expected.maxDrawdown) << "config " << k;
+        EXPECT_EQ(results[k].equityCurve, expected.equityCurve) << "config " << k;
+        ASSERT_EQ(results[k].tradeLog.size(), expected.tradeLog.size()) << "config " << k;
+        for (size_t t = 0; t < expected.tradeLog.size(); ++t) {
+            EXPECT_EQ(results[k].tradeLog[t].exitReason, expected.tradeLog[t].exitReason);
+            EXPECT_EQ(results[k].tradeLog[t].pnl, expected.tradeLog[t].pnl);
+        }
+    }
+}
+
+TEST(BatchBacktesterTest, HandlesInsufficientData) {
+    auto candles = TestData::generateUptrend(30);
+    BatchBacktester batch({BacktestConfig::defaultConfig(), BacktestConfig::realisticConfig()});
+    AlwaysBuyStrategy strategy;
+
+    std::vector<BacktestResult> results = batch.run(candles, strategy);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].trades, 0);
+    EXPECT_EQ(results[1].trades, 0);
+}
+
+// ============================================================================
+// Result Detail Tests
+// ============================================================================
+
+TEST(BacktesterTest, SummaryOnlyMatchesFullWithoutCurves) {
+    auto candles = TestData::generateVolatile(600);
+
+    BacktestConfig full = BacktestConfig::realisticConfig();
+    full.allowShort = true;
+    BacktestConfig summary = full;
+    summary.resultDetail = ResultDetail::SummaryOnly;
+
+    MeanReversionStrategy a;
+    MeanReversionStrategy b;
+    BacktestResult expected = Backtester(full).run(candles, a);
+    BacktestResult result = Backtester(summary).run(candles, b);
+
+    EXPECT_TRUE(result.tradeLog.empty());
+    EXPECT_TRUE(result.equityCurve.empty());
+    EXPECT_TRUE(result.dailyReturns.empty());
+    EXPECT_TRUE(result.drawdownCurve.empty());
+
+    // Trade and drawdown accounting is identical
+    ASSERT_GT(expected.trades, 0);
+    EXPECT_EQ(result.trades, expected.trades);
+    EXPECT_EQ(result.totalReturn, expected.totalReturn);
+    EXPECT_EQ(result.maxDrawdown, expected.maxDrawdown);
+    EXPECT_EQ(result.maxDrawdownDuration, expected.maxDrawdownDuration);
+    EXPECT_EQ(result.avgHoldingPeriod, expected.avgHoldingPeriod);
+
+    // Online moments agree to rounding; tail risk is a streaming estimate
+    EXPECT_NEAR(result.sharpeRatio, expected.sharpeRatio, 1e-9);
+    EXPECT_NEAR(result.sortinoRatio, expected.sortinoRatio, 1e-9);
+    EXPECT_NEAR(result.volatility, expected.volatility, 1e-9);
+    EXPECT_NEAR(result.downsideDeviation, expected.downsideDeviation, 1e-9);
+    EXPECT_NEAR(result.valueAtRisk95, expected.valueAtRisk95, expected.valueAtRisk95 * 0.5 + 1e-6);
+    EXPECT_NEAR(result.cvar95, expected.cvar95, expected.cvar95 * 0.5 + 1e-6);
+}
+
 // ============================================================================
 // Edge Case Tests
 // ============================================================================
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "../BarArchive.h"
+#include "../BarColumns.h"
+#include "../MarketData.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+std::vector<Candle> makeCandles(size_t count) {
+    std::vector<Candle> candles;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        Candle c;
+        c.ts = TimeUtils::fromUnixSeconds(1700000000 + 86400 * static_cast<int64_t>(i));
+        c.date = std::to_string(TimeUtils::toUnixSeconds(c.ts));
+        c.open = price;
+        c.close = price + ((i % 3 == 0) ? -0.75 : 1.25);
+        c.high = std::max(c.open, c.close) + 0.5;
+        c.low = std::min(c.open, c.close) - 0.5;
+        c.volume = 1000000 + static_cast<int64_t>(i) * 17;
+        price = c.close;
+        candles.push_back(c);
+    }
+    return candles;
+}
+
+class BarArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               ("bar_archive_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    std::string path(const std::string& name) const { return (dir_ / name).string(); }
+
+    std::filesystem::path dir_;
+};
+
+}  // namespace
+
+// ============================================================================
+// Round Trip Tests
+// ============================================================================
+
+TEST_F(BarArchiveTest, RoundTripPreservesEveryColumn) {
+    auto candles = makeCandles(250);
+    BarColumns cols(candles);
+    std::string file = path("AAPL_1d.bars");
+
+    ASSERT_TRUE(BarArchive::write(file, cols, "AAPL").isOk());
+
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isOk()) << mapped.error().toString();
+    const MappedBarFile& archive = mapped.value();
+
+    EXPECT_EQ(archive.symbol(), "AAPL");
+    EXPECT_EQ(archive.intervalSeconds(), BarArchive::kDailySeconds);
+    ASSERT_EQ(archive.size(), candles.size());
+
+    BarColumnsView view = archive.view();
+    for (size_t i = 0; i < candles.size(); ++i) {
+        EXPECT_EQ(view.ts[i], candles[i].ts);
+        EXPECT_EQ(view.open[i], candles[i].open);
+        EXPECT_EQ(view.high[i], candles[i].high);
+        EXPECT_EQ(view.low[i], candles[i].low);
+        EXPECT_EQ(view.close[i], candles[i].close);
+        EXPECT_EQ(view.volume[i], candles[i].volume);
+    }
+    EXPECT_EQ(view.candle(10).date, candles[10].date);
+
+    BarColumns copy = archive.toColumns();
+    EXPECT_EQ(copy.size(), candles.size());
+    EXPECT_EQ(copy.closes().back(), candles.back().close);
+}
+
+TEST_F(BarArchiveTest, EmptySeriesRoundTrips) {
+    std::string file = path("EMPTY_1d.bars");
+    ASSERT_TRUE(BarArchive::write(file, BarColumns(), "EMPTY").isOk());
+
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isOk());
+    EXPECT_EQ(mapped.value().size(), 0u);
+}
+
+TEST_F(BarArchiveTest, RewriteReplacesContents) {
+    std::string file = path("MSFT_1d.bars");
+    ASSERT_TRUE(BarArchive::write(file, BarColumns(makeCandles(20)), "MSFT").isOk());
+    ASSERT_TRUE(BarArchive::write(file, BarColumns(makeCandles(40)), "MSFT").isOk());
+
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isOk());
+    EXPECT_EQ(mapped.value().size(), 40u);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir_), std::filesystem::directory_iterator()), 1);
+}
+
+TEST_F(BarArchiveTest, ConcurrentWritersEachLeaveAWholeArchive) {
+    // Writers of different lengths racing for one archive (e.g. the provider
+    // and fetchBarColumns refreshing the same symbol)
+    std::string file = path("QQQ_1d.bars");
+    std::vector<std::thread> writers;
+    for (size_t w = 0; w < 4; ++w) {
+        writers.emplace_back([&, w] {
+            BarColumns bars(makeCandles(100 + 50 * w));
+            for (int round = 0; round < 25; ++round) ASSERT_TRUE(BarArchive::write(file, bars, "QQQ").isOk());
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    // Whichever write landed last, header and columns agree
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isOk()) << mapped.error().toString();
+    size_t size = mapped.value().size();
+    ASSERT_TRUE(size == 100 || size == 150 || size == 200 || size == 250) << size;
+    auto candles = makeCandles(size);
+    BarColumnsView view = mapped.value().view();
+    for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(view.ts[i], candles[i].ts) << "bar " << i;
+        ASSERT_EQ(view.close[i], candles[i].close) << "bar " << i;
+        ASSERT_EQ(view.volume[i], candles[i].volume) << "bar " << i;
+    }
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir_), std::filesystem::directory_iterator()), 1);
+}
+
+// ============================================================================
+// Validation Tests
+// ============================================================================
+
+TEST_F(BarArchiveTest, MissingFileIsNotFound) {
+    auto mapped = MappedBarFile::open(path("missing.bars"));
+    ASSERT_TRUE(mapped.isError());
+    EXPECT_EQ(mapped.error().code, Error::NotFoundError);
+}
+
+TEST_F(BarArchiveTest, RejectsForeignFile) {
+    std::string file = path("foreign.bars");
+    std::ofstream(file) << std::string(128, 'x');
+
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isError());
+    EXPECT_EQ(mapped.error().code, Error::ParseError);
+}
+
+TEST_F(BarArchiveTest, RejectsTruncatedFile) {
+    std::string file = path("SPY_1d.bars");
+    ASSERT_TRUE(BarArchive::write(file, BarColumns(makeCandles(30)), "SPY").isOk());
+    std::filesystem::resize_file(file, std::filesystem::file_size(file) - 8);
+
+    auto mapped = MappedBarFile::open(file);
+    ASSERT_TRUE(mapped.isError());
+    EXPECT_EQ(mapped.error().code, Error::ParseError);
+}
+
+TEST(BarArchivePathTest, SanitizesSymbolAndLabelsInterval) {
+    EXPECT_EQ(BarArchive::pathFor("^VIX"), ".cache/bars/_VIX_1d.bars");
+    EXPECT_EQ(BarArchive::pathFor("BTC-USD", 300, "data"), "data/BTC-USD_5m.bars");
+    EXPECT_EQ(BarArchive::pathFor("EUR=X", 3600, "data"), "data/EUR_X_1h.bars");
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Cache.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Starts `count` threads that call `body(i)` as close together as possible
+template<typename F>
+void runTogether(int count, F body) {
+    std::atomic<int> ready{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < count; ++i) {
+        threads.emplace_back([&, i] {
+            ++ready;
+            while (ready.load() < count) std::this_thread::yield();
+            body(i);
+        });
+    }
+    for (auto& t : threads) t.join();
+}
+
+}  // namespace
+
+// ============================================================================
+// LRUCache
+// ============================================================================
+
+TEST(LRUCacheTest, EvictsLeastRecentlyUsed) {
+    // One shard, so recency is global
+    LRUCache<int, std::string> cache(3, std::chrono::seconds(60), 1);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    ASSERT_TRUE(cache.get(1));  // 2 is now the oldest
+    cache.put(4, "four");
+
+    EXPECT_FALSE(cache.get(2));
+    EXPECT_EQ(*cache.get(1), "one");
+    EXPECT_EQ(*cache.get(3), "three");
+    EXPECT_EQ(*cache.get(4), "four");
+    EXPECT_EQ(cache.size(), 3u);
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.8);
+
+    cache.setCapacity(1);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.contains(4));
+}
+
+TEST(LRUCacheTest, SharesValuesWithoutCopying) {
+    LRUCache<std::string, std::string> cache(100);
+    cache.put("big", std::string(1 << 20, 'x'));
+
+    auto first = cache.get("big");
+    auto second = cache.get("big");
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.get(), second.get());
+
+    // A replaced value stays alive for holders of the old one
+    cache.put("big", std::string("small"));
+    EXPECT_EQ(first->size(), 1u << 20);
+    EXPECT_EQ(*cache.get("big"), "small");
+
+    int computed = 0;
+    auto a = cache.getOrCompute("lazy", [&] { ++computed; return std::string("v"); });
+    auto b = cache.getOrCompute("lazy", [&] { ++computed; return std::string("w"); });
+    EXPECT_EQ(computed, 1);
+    EXPECT_EQ(a.get(), b.get());
+}
+
+TEST(LRUCacheTest, ExpiresEntriesThroughTheWheel) {
+    LRUCache<int, int> cache(1000, std::chrono::seconds(60));
+    for (int i = 0; i < 100; ++i) cache.put(i, i, std::chrono::seconds(0));
+    for (int i = 100; i < 150; ++i) cache.put(i, i);
+
+    // Lookups of an expired entry miss and drop it
+    EXPECT_FALSE(cache.get(0));
+    EXPECT_EQ(cache.getStats().expirations, 1u);
+
+    // The rest go when their second's slot is swept
+    std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+    cache.cleanup();
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.size, 50u);
+    EXPECT_EQ(stats.expirations, 100u);
+    EXPECT_EQ(stats.evictions, 0u);
+
+    // A refreshed entry is not expired by its stale slot
+    cache.put(7, 7, std::chrono::seconds(0));
+    cache.put(7, 8, std::chrono::seconds(60));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+    cache.cleanup();
+    ASSERT_TRUE(cache.get(7));
+    EXPECT_EQ(*cache.get(7), 8);
+}
+
+TEST(LRUCacheTest, ConcurrentAccessAcrossShards) {
+    LRUCache<int, int> cache(4096, std::chrono::seconds(60), 16);
+    runTogether(8, [&](int t) {
+        for (int i = 0; i < 20000; ++i) {
+            int key = (i * 7 + t) % 8192;
+            if (auto v = cache.get(key)) {
+                EXPECT_EQ(*v, key * 3);
+            } else {
+                cache.put(key, key * 3);
+            }
+        }
+    });
+
+    auto stats = cache.getStats();
+    EXPECT_LE(stats.size, 4096u);
+    EXPECT_EQ(stats.hits + stats.misses, 8u * 20000u);
+    EXPECT_GT(stats.evictions, 0u);
+}
+
+// ============================================================================
+// SingleFlight
+// ============================================================================
+
+TEST(SingleFlightTest, ConcurrentCallersShareOneCall) {
+    SingleFlight<std::string, int> flight;
+    std::atomic<int> calls{0};
+    std::vector<int> results(16, 0);
+
+    runTogether(16, [&](int i) {
+        results[i] = flight.run("key", [&] {
+            ++calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            return 42;
+        });
+    });
+
+    EXPECT_EQ(calls.load(), 1);
+    for (int r : results) EXPECT_EQ(r, 42);
+    auto stats = flight.stats();
+    EXPECT_EQ(stats.calls, 1u);
+    EXPECT_EQ(stats.coalesced, 15u);
+}
+
+TEST(SingleFlightTest, KeysAreIndependentAndReleasedAfterTheCall) {
+    SingleFlight<std::string, int> flight;
+    std::atomic<int> calls{0};
+
+    runTogether(8, [&](int i) {
+        flight.run(i % 2 ? "odd" : "even", [&] {
+            ++calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            return i;
+        });
+    });
+    EXPECT_EQ(calls.load(), 2);
+
+    // Finished calls are not reused
+    EXPECT_EQ(flight.run("odd", [] { return 7; }), 7);
+    EXPECT_EQ(flight.stats().calls, 3u);
+
+    flight.resetStats();
+    EXPECT_EQ(flight.stats().calls, 0u);
+    EXPECT_EQ(flight.stats().coalesced, 0u);
+}
+
+TEST(SingleFlightTest, ExceptionsReachEveryWaiter) {
+    SingleFlight<int, int> flight;
+    std::atomic<int> thrown{0};
+
+    runTogether(6, [&](int) {
+        try {
+            flight.run(1, []() -> int {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                throw std::runtime_error("upstream down");
+            });
+        } catch (const std::runtime_error&) {
+            ++thrown;
+        }
+    });
+
+    EXPECT_EQ(thrown.load(), 6);
+    EXPECT_EQ(flight.run(1, [] { return 5; }), 5);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../CrossSectionEngine.h"
+#include "../RollingKernels.h"
+#include "../TechnicalAnalysis.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// One random-walk history per symbol, of varying lengths
+std::vector<BarColumns> makeUniverse(size_t symbols, size_t minBars, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> move(0.0, 0.02);
+    std::vector<BarColumns> universe;
+    for (size_t s = 0; s < symbols; ++s) {
+        std::vector<Candle> candles;
+        double price = 20.0 + 10.0 * s;
+        size_t bars = minBars + (s * 7) % 50;
+        for (size_t i = 0; i < bars; ++i) {
+            Candle c;
+            c.open = price;
+            // A flat stretch for one symbol (zero ranges, zero DM)
+            c.close = s == 3 && i > 100 && i < 140 ? price : price * (1.0 + move(rng));
+            c.high = std::max(c.open, c.close) * (s == 3 && i > 100 && i < 140 ? 1.0 : 1.01);
+            c.low = std::min(c.open, c.close) * (s == 3 && i > 100 && i < 140 ? 1.0 : 0.985);
+            c.volume = 1000;
+            price = c.close;
+            candles.push_back(c);
+        }
+        universe.emplace_back(candles);
+    }
+    return universe;
+}
+
+std::vector<std::pair<std::string, BarColumnsView>> views(const std::vector<BarColumns>& universe) {
+    std::vector<std::pair<std::string, BarColumnsView>> out;
+    for (size_t s = 0; s < universe.size(); ++s) out.emplace_back("SYM" + std::to_string(s), universe[s].view());
+    return out;
+}
+
+void expectColumn(const PanelMatrix& m, size_t symbol, const std::vector<double>& expected, const char* name) {
+    ASSERT_EQ(m.bars(), expected.size());
+    for (size_t t = 0; t < expected.size(); ++t) {
+        ASSERT_EQ(m.at(t, symbol), expected[t]) << name << " symbol " << symbol << " bar " << t;
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Panel Tests
+// ============================================================================
+
+TEST(CrossSectionTest, PanelKeepsLastBarsOfLongEnoughSeries) {
+    auto universe = makeUniverse(5, 100, 1);
+    auto panel = CrossSectionPanel::fromSeries(views(universe), 120);
+
+    // Symbols 0-2 have 100, 107 and 114 bars
+    ASSERT_EQ(panel.symbols, (std::vector<std::string>{"SYM3", "SYM4"}));
+    ASSERT_EQ(panel.bars(), 120u);
+    BarColumnsView sym4 = universe[4].view();
+    EXPECT_EQ(panel.close.lastRow()[1], sym4.close.back());
+    EXPECT_EQ(panel.high.at(0, 1), sym4.high[sym4.size() - 120]);
+}
+
+// ============================================================================
+// Indicator Tests
+// ============================================================================
+
+TEST(CrossSectionTest, EveryColumnMatchesSeriesFunctions) {
+    auto universe = makeUniverse(150, 260, 2);
+    auto panel = CrossSectionPanel::fromSeries(views(universe), 250);
+    ASSERT_EQ(panel.size(), universe.size());
+
+    ThreadPool pool(4);
+    CrossSectionConfig config;
+    config.symbolsPerTask = 16;
+    CrossSectionIndicators pooled = CrossSectionEngine(config, &pool).compute(panel);
+    RollingKernels::setSimdLevel(RollingKernels::SimdLevel::Scalar);
+    CrossSectionIndicators scalar = CrossSectionEngine(config).compute(panel);
+    RollingKernels::setSimdLevel(RollingKernels::detectedSimdLevel());
+
+    for (size_t s = 0; s < panel.size(); ++s) {
+        BarColumnsView bars = universe[s].view().last(250);
+        std::vector<double> close(bars.close.begin(), bars.close.end());
+
+        for (const CrossSectionIndicators* result : {&pooled, &scalar}) {
+            expectColumn(result->rsi, s, computeRSISeries(close, 14), "rsi");
+            expectColumn(result->atr, s, computeATRSeries(bars, 14), "atr");
+
+            BollingerSeries bollinger = computeBollingerBandsSeries(close, 20, 2.0);
+            expectColumn(result->bollingerUpper, s, bollinger.upper, "upper");
+            expectColumn(result->bollingerMiddle, s, bollinger.middle, "middle");
+            expectColumn(result->bollingerLower, s, bollinger.lower, "lower");
+            expectColumn(result->bollingerBandwidth, s, bollinger.bandwidth, "bandwidth");
+
+            ADXSeries adx = computeADXSeries(bars, 14);
+            expectColumn(result->adx, s, adx.adx, "adx");
+            expectColumn(result->plusDI, s, adx.plusDI, "plusDI");
+            expectColumn(result->minusDI, s, adx.minusDI, "minusDI");
+        }
+    }
+}
+
+TEST(CrossSectionTest, ShortPanelsStayInWarmup) {
+    auto universe = makeUniverse(3, 10, 3);
+    auto panel = CrossSectionPanel::fromSeries(views(universe), 10);
+    CrossSectionIndicators result = CrossSectionEngine().compute(panel);
+
+    for (size_t s = 0; s < panel.size(); ++s) {
+        EXPECT_EQ(result.rsi.at(9, s), 50.0);
+        EXPECT_EQ(result.atr.at(9, s), 0.0);
+        EXPECT_EQ(result.bollingerMiddle.at(9, s), 0.0);
+        EXPECT_EQ(result.adx.at(9, s), 0.0);
+    }
+}
+
+// ============================================================================
+// Ranking Tests
+// ============================================================================
+
+TEST(CrossSectionTest, TopKOrdersLargestFirstWithStableTies) {
+    std::vector<double> scores = {0.5, 2.0, 1.0, 2.0, -1.0};
+    EXPECT_EQ(CrossSection::topK(scores, 3), (std::vector<size_t>{1, 3, 2}));
+    EXPECT_EQ(CrossSection::topK(scores, 10).size(), scores.size());
+    EXPECT_TRUE(CrossSection::topK(scores, 0).empty());
+}
+
+TEST(CrossSectionTest, MeanRangeAveragesTrailingWindow) {
+    auto universe = makeUniverse(4, 30, 4);
+    auto panel = CrossSectionPanel::fromSeries(views(universe), 30);
+    std::vector<double> range = CrossSection::meanRange(panel, 14);
+
+    for (size_t s = 0; s < panel.size(); ++s) {
+        BarColumnsView bars = universe[s].view();
+        double sum = 0.0;
+        for (size_t i = bars.size() - 14; i < bars.size(); ++i) sum += bars.high[i] - bars.low[i];
+        EXPECT_EQ(range[s], sum / 14.0);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include "../HistoryStore.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+constexpr int64_t kDay = BarArchive::kDailySeconds;
+constexpr int64_t kFirstBar = 1700000000;
+
+TimePoint dayTs(int64_t i) {
+    return TimeUtils::fromUnixSeconds(kFirstBar + kDay * i);
+}
+
+// Daily bars [from, to) whose close encodes the bar index
+BarColumns makeBars(int64_t from, int64_t to) {
+    BarColumns bars;
+    for (int64_t i = from; i < to; ++i) {
+        Candle c;
+        c.ts = dayTs(i);
+        c.open = 100.0 + static_cast<double>(i);
+        c.high = c.open + 1.0;
+        c.low = c.open - 1.0;
+        c.close = c.open + 0.5;
+        c.volume = 1000 + i;
+        bars.push_back(c);
+    }
+    return bars;
+}
+
+class HistoryStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = (std::filesystem::temp_directory_path() /
+                ("history_store_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+                   .string();
+        std::filesystem::remove_all(dir_);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    HistoryStore::Plan plan(TimePoint coverFrom = dayTs(0)) const {
+        return HistoryStore::plan("AAPL", kDay, coverFrom, dir_);
+    }
+
+    std::string dir_;
+};
+
+}  // namespace
+
+// ============================================================================
+// BarColumns Merging
+// ============================================================================
+
+TEST(BarColumnsMergeTest, AppendNewerRejectsDuplicatesAndOlderBars) {
+    BarColumns bars = makeBars(0, 5);
+    EXPECT_EQ(bars.appendNewer(makeBars(3, 8)), 3u);
+    EXPECT_EQ(bars.size(), 8u);
+    EXPECT_EQ(bars.appendNewer(makeBars(0, 8)), 0u);
+
+    bars.pop_back();
+    EXPECT_EQ(bars.timestamps().back(), dayTs(6));
+    bars.trimBefore(dayTs(2));
+    EXPECT_EQ(bars.size(), 5u);
+    EXPECT_EQ(bars.timestamps().front(), dayTs(2));
+}
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+TEST_F(HistoryStoreTest, FetchesEverythingWithoutAUsableArchive) {
+    EXPECT_FALSE(plan().isDelta());
+
+    // Too short to anchor a delta
+    HistoryStore::replace("AAPL", kDay, makeBars(0, 1), dayTs(0), dir_);
+    EXPECT_FALSE(plan().isDelta());
+
+    // Does not reach back far enough
+    HistoryStore::replace("AAPL", kDay, makeBars(0, 100), dayTs(0), dir_);
+    EXPECT_FALSE(plan(dayTs(-30)).isDelta());
+    EXPECT_TRUE(plan(dayTs(-5)).isDelta());
+}
+
+TEST_F(HistoryStoreTest, PlansADeltaFromTheLastCompleteBar) {
+    HistoryStore::replace("AAPL", kDay, makeBars(0, 100), dayTs(0), dir_);
+
+    auto p = plan();
+    ASSERT_TRUE(p.isDelta());
+    EXPECT_EQ(p.stored.size(), 100u);
+    EXPECT_EQ(p.anchor, dayTs(98));
+    EXPECT_EQ(*p.fetchFrom, dayTs(98) - std::chrono::hours(12));
+}
+
+// ============================================================================
+// Merging
+// ============================================================================
+
+TEST_F(HistoryStoreTest, MergesNewBarsAndRevisesTheFormingOne) {
+    HistoryStore::replace("AAPL", kDay, makeBars(0, 100), dayTs(0), dir_);
+
+    // Bar 99 was stored mid-session; the delta has its final values
+    BarColumns delta = makeBars(98, 103);
+    std::vector<Candle> candles = delta.toCandles();
+    candles[1].close = 250.0;
+    delta = BarColumns(candles);
+
+    auto merged = HistoryStore::merge("AAPL", kDay, plan(), delta, dayTs(10), dir_);
+    ASSERT_TRUE(merged);
+    EXPECT_EQ(merged->size(), 93u);  // Bars 10..102
+    EXPECT_EQ(merged->timestamps().front(), dayTs(10));
+    EXPECT_EQ(merged->timestamps().back(), dayTs(102));
+    EXPECT_DOUBLE_EQ(merged->closes()[89], 250.0);
+
+    // Archived: the next refresh starts from bar 101
+    auto next = plan(dayTs(10));
+    ASSERT_TRUE(next.isDelta());
+    EXPECT_EQ(next.stored.size(), 93u);
+    EXPECT_EQ(next.anchor, dayTs(101));
+}
+
+TEST_F(HistoryStoreTest, RevisedHistoryNeedsAFullFetch) {
+    HistoryStore::replace("AAPL", kDay, makeBars(0, 100), dayTs(0), dir_);
+
+    // Anchor missing from the delta
+    EXPECT_FALSE(HistoryStore::merge("AAPL", kDay, plan(), makeBars(99, 101), dayTs(0), dir_));
+
+    // Anchor repriced (e.g. split-adjusted)
+    std::vector<Candle> candles = makeBars(98, 101).toCandles();
+    candles[0].close /= 2.0;
+    EXPECT_FALSE(HistoryStore::merge("AAPL", kDay, plan(), BarColumns(candles), dayTs(0), dir_));
+
+    // The archive is untouched
+    EXPECT_EQ(plan().stored.size(), 100u);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,396 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../HttpEngine.h"
+#include "../NetworkUtils.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+std::string gzipString(const std::string& text) {
+    z_stream zs{};
+    deflateInit2(&zs, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);  // +16: gzip wrapper
+    std::string out(deflateBound(&zs, text.size()) + 32, '\0');
+    zs.next_in = (Bytef*)text.data();
+    zs.avail_in = (uInt)text.size();
+    zs.next_out = (Bytef*)out.data();
+    zs.avail_out = (uInt)out.size();
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// Keep-alive HTTP/1.1 stand-in for the remote APIs, on 127.0.0.1:
+//   GET /echo/<text>     -> 200 <text>
+//   GET /delay/<ms>      -> 200 "ok" after <ms>
+//   GET /status/<code>   -> <code>
+//   GET /gzip            -> 200, gzip-encoded when the request accepts it
+//   GET /headers         -> 200 with the request's header block
+//   POST /post           -> 200 with the request body
+class LocalHttpServer {
+public:
+    LocalHttpServer() {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listenFd_, (sockaddr*)&addr, sizeof(addr));
+        listen(listenFd_, 128);
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd_, (sockaddr*)&addr, &len);
+        port_ = ntohs(addr.sin_port);
+        acceptThread_ = std::thread([this] { acceptLoop(); });
+    }
+
+    ~LocalHttpServer() {
+        shutdown(listenFd_, SHUT_RDWR);
+        close(listenFd_);
+        acceptThread_.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int fd : clients_) shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& t : handlers_) t.join();
+    }
+
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+    int connectionsAccepted() const { return accepted_.load(); }
+    int peakInFlight() const { return peak_.load(); }
+    int requestsServed() const { return served_.load(); }
+
+private:
+    void acceptLoop() {
+        while (true) {
+            int fd = accept(listenFd_, nullptr, nullptr);
+            if (fd < 0) return;
+            ++accepted_;
+            std::lock_guard<std::mutex> lock(mutex_);
+            clients_.push_back(fd);
+            handlers_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        while (true) {
+            size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) return close(fd), void();
+                buffer.append(chunk, (size_t)n);
+            }
+            std::string head = buffer.substr(0, headerEnd + 4);
+            size_t bodyLength = 0;
+            std::string lower = head;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            if (size_t cl = lower.find("content-length:"); cl != std::string::npos) {
+                bodyLength = std::stoul(head.substr(cl + 15));
+            }
+            while (buffer.size() < headerEnd + 4 + bodyLength) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) return close(fd), void();
+                buffer.append(chunk, (size_t)n);
+            }
+            std::string body = buffer.substr(headerEnd + 4, bodyLength);
+            buffer.erase(0, headerEnd + 4 + bodyLength);
+
+            int inFlight = ++inFlight_;
+            for (int peak = peak_.load(); inFlight > peak && !peak_.compare_exchange_weak(peak, inFlight);) {
+            }
+            std::string response = respond(head, lower, body);
+            --inFlight_;
+            ++served_;
+            if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) return close(fd), void();
+        }
+    }
+
+    static std::string respond(const std::string& head, const std::string& lower, const std::string& body) {
+        std::string path = head.substr(head.find(' ') + 1);
+        path = path.substr(0, path.find(' '));
+
+        int status = 200;
+        std::string content;
+        std::string extraHeaders;
+        if (path.rfind("/echo/", 0) == 0) {
+            content = path.substr(6);
+        } else if (path.rfind("/delay/", 0) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::stoi(path.substr(7))));
+            content = "ok";
+        } else if (path.rfind("/status/", 0) == 0) {
+            status = std::stoi(path.substr(8));
+            content = "status";
+        } else if (path == "/gzip") {
+            content = std::string(2000, 'a') + "compressed payload";
+            if (lower.find("accept-encoding:") != std::string::npos && lower.find("gzip") != std::string::npos) {
+                content = gzipString(content);
+                extraHeaders = "Content-Encoding: gzip\r\n";
+            }
+        } else if (path == "/headers") {
+            content = head;
+        } else if (path == "/post") {
+            content = body;
+        } else {
+            status = 404;
+        }
+
+        return "HTTP/1.1 " + std::to_string(status) + " X\r\nContent-Length: " + std::to_string(content.size()) +
+               "\r\n" + extraHeaders + "Connection: keep-alive\r\n\r\n" + content;
+    }
+
+    int listenFd_ = -1;
+    int port_ = 0;
+    std::thread acceptThread_;
+    std::mutex mutex_;
+    std::vector<int> clients_;
+    std::vector<std::thread> handlers_;
+    std::atomic<int> accepted_{0};
+    std::atomic<int> inFlight_{0};
+    std::atomic<int> peak_{0};
+    std::atomic<int> served_{0};
+};
+
+class HttpEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+#ifndef ENABLE_CURL
+        GTEST_SKIP() << "built without ENABLE_CURL";
+#endif
+    }
+
+    LocalHttpServer server;
+};
+
+HttpRequest get(const std::string& url) {
+    HttpRequest request;
+    request.url = url;
+    return request;
+}
+
+}  // namespace
+
+// ============================================================================
+// Responses
+// ============================================================================
+
+TEST_F(HttpEngineTest, FetchesBodiesAndMapsStatusCodes) {
+    HttpEngine engine;
+    auto ok = engine.fetch(get(server.url("/echo/hello"))).get();
+    ASSERT_TRUE(ok.isOk());
+    EXPECT_EQ(ok.value(), "hello");
+
+    EXPECT_EQ(engine.fetch(get(server.url("/status/429"))).get().error().code, Error::RateLimitError);
+    EXPECT_EQ(engine.fetch(get(server.url("/status/403"))).get().error().code, Error::AuthError);
+    EXPECT_EQ(engine.fetch(get(server.url("/status/500"))).get().error().code, Error::NetworkError);
+
+    // Nothing listens on port 1
+    EXPECT_EQ(engine.fetch(get("http://127.0.0.1:1/")).get().error().code, Error::NetworkError);
+}
+
+TEST_F(HttpEngineTest, DecodesCompressedResponses) {
+    HttpEngine engine;
+    auto result = engine.fetch(get(server.url("/gzip"))).get();
+    ASSERT_TRUE(result.isOk());
+    EXPECT_EQ(result.value(), std::string(2000, 'a') + "compressed payload");
+
+    auto headers = engine.fetch(get(server.url("/headers"))).get();
+    ASSERT_TRUE(headers.isOk());
+    EXPECT_NE(headers.value().find("gzip"), std::string::npos);
+}
+
+TEST_F(HttpEngineTest, PostsPayloadWithHeaders) {
+    HttpEngine engine;
+    HttpRequest post = get(server.url("/post"));
+    post.post = true;
+    post.payload = R"({"text":"hi"})";
+    post.headers = {"Content-Type: application/json"};
+    auto result = engine.fetch(post).get();
+    ASSERT_TRUE(result.isOk());
+    EXPECT_EQ(result.value(), post.payload);
+
+    HttpRequest custom = get(server.url("/headers"));
+    custom.headers = {"X-Api-Key: secret"};
+    EXPECT_NE(engine.fetch(custom).get().value().find("X-Api-Key: secret"), std::string::npos);
+}
+
+// ============================================================================
+// Connections and Concurrency
+// ============================================================================
+
+TEST_F(HttpEngineTest, ReusesConnectionAcrossRequests) {
+    HttpEngine engine;
+    for (int i = 0; i < 30; ++i) {
+        auto result = engine.fetch(get(server.url("/echo/" + std::to_string(i)))).get();
+        ASSERT_TRUE(result.isOk());
+        EXPECT_EQ(result.value(), std::to_string(i));
+    }
+    EXPECT_EQ(server.connectionsAccepted(), 1);
+
+    HttpEngineStats stats = engine.stats();
+    EXPECT_EQ(stats.submitted, 30u);
+    EXPECT_EQ(stats.completed, 30u);
+    EXPECT_EQ(stats.connectionsOpened, 1u);
+}
+
+TEST_F(HttpEngineTest, RunsRequestsConcurrentlyFromOneThread) {
+    HttpEngineConfig config;
+    config.maxHostConnections = 32;
+    HttpEngine engine(config);
+
+    std::vector<HttpRequest> requests;
+    for (int i = 0; i < 32; ++i) requests.push_back(get(server.url("/delay/200")));
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = engine.fetchAll(requests);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(results.size(), 32u);
+    for (const auto& r : results) EXPECT_TRUE(r.isOk());
+    // One at a time this would take 6.4 s
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+    EXPECT_GT(server.peakInFlight(), 8);
+}
+
+TEST_F(HttpEngineTest, CapsConnectionsPerHostAndRunsCallbacks) {
+    HttpEngineConfig config;
+    config.maxHostConnections = 2;
+    HttpEngine engine(config);
+
+    std::atomic<int> done{0};
+    std::atomic<int> ok{0};
+    for (int i = 0; i < 12; ++i) {
+        engine.submit(get(server.url("/delay/20")), [&](Result<std::string> result) {
+            if (result.isOk() && result.value() == "ok") ++ok;
+            ++done;
+        });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 12 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_EQ(ok.load(), 12);
+    EXPECT_LE(server.connectionsAccepted(), 2);
+    EXPECT_LE(server.peakInFlight(), 2);
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST_F(HttpEngineTest, SpacesRequestsToARateLimitedDomain) {
+    HttpEngine engine;
+    engine.setRateLimit("127.0.0.1", {20.0, 2.0});
+
+    std::vector<HttpRequest> requests;
+    for (int i = 0; i < 8; ++i) {
+        requests.push_back(get(server.url("/echo/" + std::to_string(i))));
+        requests.back().rateDomain = "127.0.0.1";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = engine.fetchAll(requests);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(results.size(), 8u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_TRUE(results[i].isOk());
+        EXPECT_EQ(results[i].value(), std::to_string(i));
+    }
+    // Two go at once, the other six one token (50 ms) apart
+    EXPECT_GE(elapsed, std::chrono::milliseconds(280));
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
+
+TEST_F(HttpEngineTest, RetriesTransientFailuresWithBackoff) {
+    HttpEngineConfig config;
+    config.retryBackoff = std::chrono::milliseconds(20);
+    HttpEngine engine(config);
+
+    HttpRequest failing = get(server.url("/status/500"));
+    failing.maxAttempts = 3;
+    auto start = std::chrono::steady_clock::now();
+    auto result = engine.fetch(failing).get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(result.error().code, Error::NetworkError);
+    EXPECT_EQ(server.requestsServed(), 3);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(60));  // 20 ms, then 40 ms
+    EXPECT_EQ(engine.stats().retries, 2u);
+
+    // Auth failures are final
+    HttpRequest denied = get(server.url("/status/403"));
+    denied.maxAttempts = 3;
+    EXPECT_EQ(engine.fetch(denied).get().error().code, Error::AuthError);
+    EXPECT_EQ(server.requestsServed(), 4);
+}
+
+// ============================================================================
+// NetworkUtils
+// ============================================================================
+
+TEST_F(HttpEngineTest, NetworkUtilsCoalescesConcurrentMisses) {
+    NetworkUtils::resetCoalescingStats();
+    std::string url = server.url("/delay/300");
+
+    std::atomic<int> ready{0};
+    std::atomic<int> ok{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 12; ++i) {
+        callers.emplace_back([&] {
+            ++ready;
+            while (ready.load() < 12) std::this_thread::yield();
+            // No caching: only the overlap is shared
+            auto result = NetworkUtils::fetchDataWithResult(url, 0);
+            if (result.isOk() && result.value() == "ok") ++ok;
+        });
+    }
+    for (auto& t : callers) t.join();
+
+    EXPECT_EQ(ok.load(), 12);
+    EXPECT_EQ(server.requestsServed(), 1);
+    auto stats = NetworkUtils::coalescingStats();
+    EXPECT_EQ(stats.upstreamFetches, 1u);
+    EXPECT_EQ(stats.coalescedHits, 11u);
+}
+
+TEST_F(HttpEngineTest, NetworkUtilsServesPersistedResponses) {
+    // The port makes the URL unique to this run
+    std::string url = server.url("/echo/persisted");
+    ASSERT_EQ(NetworkUtils::fetchDataWithResult(url, 60).value(), "persisted");
+
+    // Not in memory any more, but still in the response store
+    NetworkUtils::clearCache();
+    ASSERT_EQ(NetworkUtils::fetchDataWithResult(url, 60).value(), "persisted");
+    EXPECT_EQ(server.requestsServed(), 1);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
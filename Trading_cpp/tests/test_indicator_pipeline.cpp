@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../IndicatorPipeline.h"
+#include "../IndicatorContext.h"
+#include "../RollingIndicators.h"
+#include "../BarColumns.h"
+#include "../Strategies/TrendFollowingStrategy.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Random walk with trending and choppy stretches
+std::vector<Candle> makeCandles(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> move(0.0, 0.015);
+    std::vector<Candle> candles;
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        double drift = (i / 150) % 2 == 0 ? 0.002 : -0.0015;
+        Candle c;
+        c.open = price;
+        c.close = price * (1.0 + drift + move(rng));
+        c.high = std::max(c.open, c.close) * 1.004;
+        c.low = std::min(c.open, c.close) * 0.996;
+        c.volume = 1000000;
+        price = c.close;
+        candles.push_back(c);
+    }
+    return candles;
+}
+
+}  // namespace
+
+// ============================================================================
+// Stage Tests
+// ============================================================================
+
+TEST(IndicatorPipelineTest, StagesMatchRuntimeClassesBitForBit) {
+    auto candles = makeCandles(600, 1);
+
+    Fused::Pipeline<Fused::SMA<10>, Fused::SMA<30>, Fused::ADX<14>, Fused::ATR<14>, Fused::MACD<>> pipeline;
+    RollingSMA fast(10), slow(30);
+    RollingADX adx(14);
+    RollingATR atr(14);
+    RollingMACD macd;
+
+    for (size_t i = 0; i < candles.size(); ++i) {
+        pipeline.update(candles[i]);
+        fast.update(candles[i].close);
+        slow.update(candles[i].close);
+        adx.update(candles[i]);
+        atr.update(candles[i]);
+        macd.update(candles[i].close);
+
+        ASSERT_EQ(pipeline.get<0>().value(), fast.value()) << "bar " << i;
+        ASSERT_EQ(pipeline.get<0>().previous(), fast.previous()) << "bar " << i;
+        ASSERT_EQ(pipeline.get<1>().value(), slow.value()) << "bar " << i;
+        ASSERT_EQ(pipeline.get<2>().value().adx, adx.value().adx) << "bar " << i;
+        ASSERT_EQ(pipeline.get<2>().value().plusDI, adx.value().plusDI) << "bar " << i;
+        ASSERT_EQ(pipeline.get<2>().value().minusDI, adx.value().minusDI) << "bar " << i;
+        ASSERT_EQ(pipeline.get<3>().value(), atr.value()) << "bar " << i;
+        ASSERT_EQ(pipeline.get<4>().value(), macd.value()) << "bar " << i;
+    }
+}
+
+TEST(IndicatorPipelineTest, ColumnAndCandlePassesAgree) {
+    auto candles = makeCandles(300, 2);
+    BarColumns columns(candles);
+
+    using Trend = Fused::Pipeline<Fused::SMA<5>, Fused::ADX<7>>;
+    static_assert(Trend::kStages == 2);
+    static_assert(Trend::kWarmup == 14);
+
+    std::vector<double> fromCandles, fromColumns;
+    Trend a, b;
+    a.run(CandleView(candles), [&](size_t, const Trend& p) {
+        fromCandles.push_back(p.get<0>().value() + p.get<1>().value().adx);
+    });
+    b.run(columns.view(), [&](size_t, const Trend& p) {
+        fromColumns.push_back(p.get<0>().value() + p.get<1>().value().adx);
+    });
+    EXPECT_EQ(fromCandles, fromColumns);
+}
+
+// ============================================================================
+// Strategy Tests
+// ============================================================================
+
+TEST(IndicatorPipelineTest, FusedTrendFollowingMatchesContextSignals) {
+    auto candles = makeCandles(800, 3);
+
+    for (bool useMACD : {false, true}) {
+        TrendFollowingStrategy strategy;
+        strategy.setUseMACD(useMACD);
+
+        IndicatorContext context(candles);
+        SignalArray fused = strategy.generateSignals(context, 60);
+        EXPECT_GT(fused.actionableCount(), 0u);
+
+        for (size_t i = 60; i < candles.size(); ++i) {
+            StrategySignal expected = strategy.generateSignal(context, i);
+            ASSERT_EQ(fused.type[i], expected.type) << "bar " << i;
+            ASSERT_EQ(fused.strength[i], expected.strength) << "bar " << i;
+            ASSERT_EQ(fused.stopLossPrice[i], expected.stopLossPrice) << "bar " << i;
+            ASSERT_EQ(fused.confidence[i], expected.confidence) << "bar " << i;
+        }
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../MetricsAccumulator.h"
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Fat-ish tailed daily returns: mostly small moves with occasional shocks
+std::vector<double> makeReturns(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> normal(0.0005, 0.01);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> returns;
+    returns.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        double r = normal(rng);
+        if (uniform(rng) < 0.03) r *= 4.0;
+        returns.push_back(r);
+    }
+    return returns;
+}
+
+double exactQuantile(std::vector<double> values, double p) {
+    std::sort(values.begin(), values.end());
+    size_t idx = std::min(static_cast<size_t>(p * values.size()), values.size() - 1);
+    return values[idx];
+}
+
+}  // namespace
+
+// ============================================================================
+// P2Quantile Tests
+// ============================================================================
+
+TEST(P2QuantileTest, ExactForSmallSamples) {
+    P2Quantile q(0.5);
+    EXPECT_EQ(q.value(), 0.0);
+
+    std::vector<double> values = {3.0, -1.0, 7.0, 2.0};
+    for (double v : values) q.add(v);
+    EXPECT_EQ(q.count(), 4u);
+    EXPECT_EQ(q.value(), exactQuantile(values, 0.5));
+}
+
+TEST(P2QuantileTest, TracksTailQuantileOfLongStream) {
+    auto returns = makeReturns(20000, 7);
+    P2Quantile q(0.05);
+    for (double r : returns) q.add(r);
+
+    double exact = exactQuantile(returns, 0.05);
+    EXPECT_NEAR(q.value(), exact, std::abs(exact) * 0.05);
+}
+
+// ============================================================================
+// MetricsAccumulator Tests
+// ============================================================================
+
+TEST(MetricsAccumulatorTest, WelfordMatchesTwoPassStatistics) {
+    auto returns = makeReturns(5000, 11);
+    double riskFree = 0.04 / 252;
+
+    MetricsAccumulator acc;
+    acc.reset(riskFree);
+    for (double r : returns) acc.addReturn(r);
+    ReturnStats stats = acc.returnStats();
+
+    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+    double sumSq = 0.0;
+    double downside = 0.0;
+    int downsideCount = 0;
+    for (double r : returns) {
+        sumSq += (r - mean) * (r - mean);
+        if (r < riskFree) {
+            downside += (r - riskFree) * (r - riskFree);
+            downsideCount++;
+        }
+    }
+
+    EXPECT_EQ(stats.count, returns.size());
+    EXPECT_NEAR(stats.mean, mean, 1e-12);
+    EXPECT_NEAR(stats.sampleVariance(), sumSq / (returns.size() - 1), 1e-12);
+    EXPECT_EQ(stats.downsideCount, downsideCount);
+    EXPECT_NEAR(stats.downsideSumSquared, downside, 1e-12);
+}
+
+TEST(MetricsAccumulatorTest, StreamingVaRAndCVaRApproximateExact) {
+    auto returns = makeReturns(20000, 23);
+    MetricsAccumulator acc;
+    acc.reset(0.0);
+    for (double r : returns) acc.addReturn(r);
+    ReturnStats stats = acc.returnStats();
+
+    std::vector<double> sorted = returns;
+    std::sort(sorted.begin(), sorted.end());
+    size_t cutoff = static_cast<size_t>(0.05 * sorted.size());
+    double exactVaR = -sorted[cutoff];
+    double exactCVaR = -std::accumulate(sorted.begin(), sorted.begin() + cutoff, 0.0) / cutoff;
+
+    EXPECT_NEAR(stats.valueAtRisk, exactVaR, exactVaR * 0.05);
+    EXPECT_NEAR(stats.conditionalVaR, exactCVaR, exactCVaR * 0.10);
+    EXPECT_GT(stats.conditionalVaR, stats.valueAtRisk);
+}
+
+TEST(MetricsAccumulatorTest, TracksDrawdownDepthAndDuration) {
+    MetricsAccumulator acc;
+    acc.startEquity(100.0f);
+
+    // Peak at 110, trough at 88 (20% down), recovered on bar 6
+    float equity[] = {105.0f, 110.0f, 99.0f, 88.0f, 95.0f, 110.0f, 112.0f};
+    for (int i = 0; i < 7; ++i) acc.addEquity(equity[i], i);
+
+    EXPECT_NEAR(acc.maxDrawdown(), 0.2, 1e-6);
+    EXPECT_EQ(acc.longestDrawdown(), 3.0f);  // Bars 2..5
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../Cache.h"
+#include "../RequestScheduler.h"
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Token Bucket
+// ============================================================================
+
+TEST(RateLimiterTest, BurstThenExactWaits) {
+    RateLimiter limiter(RateLimiter::Limit{10.0, 3.0});  // 10/s, bursts of 3
+    Clock::time_point t0 = Clock::now();
+
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(limiter.tryAcquire("a", t0), Clock::duration::zero());
+
+    // Empty: the next token is 100 ms away, and asking does not take it
+    EXPECT_EQ(limiter.tryAcquire("a", t0), Clock::duration(100ms));
+    EXPECT_EQ(limiter.tryAcquire("a", t0 + 40ms), Clock::duration(60ms));
+    EXPECT_EQ(limiter.getWaitTime("a", t0 + 40ms), 60ms);
+    EXPECT_EQ(limiter.tryAcquire("a", t0 + 100ms), Clock::duration::zero());
+
+    // Refill caps at the burst
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(limiter.tryAcquire("a", t0 + 10s), Clock::duration::zero());
+    EXPECT_GT(limiter.tryAcquire("a", t0 + 10s), Clock::duration::zero());
+
+    // Domains are independent
+    EXPECT_EQ(limiter.tryAcquire("b", t0), Clock::duration::zero());
+}
+
+TEST(RateLimiterTest, PerDomainLimitsAndWindowForm) {
+    RateLimiter limiter(60, std::chrono::seconds(60), std::chrono::milliseconds(100));  // 1/s, bursts of 10
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(limiter.tryAcquire("yahoo.com", t0), Clock::duration::zero());
+    EXPECT_EQ(limiter.tryAcquire("yahoo.com", t0), Clock::duration(1s));
+
+    limiter.setLimit("slow.example", {0.5, 1.0});
+    EXPECT_EQ(limiter.tryAcquire("slow.example", t0), Clock::duration::zero());
+    EXPECT_EQ(limiter.tryAcquire("slow.example", t0), Clock::duration(2s));
+
+    limiter.reset("yahoo.com");
+    EXPECT_EQ(limiter.tryAcquire("yahoo.com", t0), Clock::duration::zero());
+}
+
+// ============================================================================
+// RequestScheduler
+// ============================================================================
+
+TEST(RequestSchedulerTest, ReleasesInOrderAsTokensAllow) {
+    RateLimiter limiter(RateLimiter::Limit{2.0, 2.0});
+    RequestScheduler<int> scheduler(limiter);
+    Clock::time_point t0 = Clock::now();
+
+    for (int i = 0; i < 5; ++i) scheduler.push("yahoo.com", i);
+    scheduler.push("", 100);  // Not limited
+    EXPECT_EQ(scheduler.pending(), 6u);
+
+    std::vector<int> ready;
+    auto wait = scheduler.release(t0, ready);
+    EXPECT_EQ(ready, (std::vector<int>{100, 0, 1}));
+    EXPECT_EQ(wait, Clock::duration(500ms));
+
+    ready.clear();
+    EXPECT_EQ(scheduler.release(t0 + 200ms, ready), Clock::duration(300ms));
+    EXPECT_TRUE(ready.empty());
+
+    scheduler.release(t0 + 1s, ready);
+    EXPECT_EQ(ready, (std::vector<int>{2, 3}));
+
+    ready.clear();
+    EXPECT_EQ(scheduler.release(t0 + 1500ms, ready), Clock::duration::max());
+    EXPECT_EQ(ready, (std::vector<int>{4}));
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
+
+TEST(RequestSchedulerTest, DeferredItemsWaitForTheirTime) {
+    RateLimiter limiter(RateLimiter::Limit{100.0, 100.0});
+    RequestScheduler<std::string> scheduler(limiter);
+    Clock::time_point t0 = Clock::now();
+
+    scheduler.push("a", "retry-late", t0 + 2s);
+    scheduler.push("a", "retry-early", t0 + 1s);
+    scheduler.push("b", "now");
+
+    std::vector<std::string> ready;
+    EXPECT_EQ(scheduler.release(t0, ready), Clock::duration(1s));
+    EXPECT_EQ(ready, (std::vector<std::string>{"now"}));
+
+    ready.clear();
+    EXPECT_EQ(scheduler.release(t0 + 1s, ready), Clock::duration(1s));
+    EXPECT_EQ(ready, (std::vector<std::string>{"retry-early"}));
+
+    // Shutdown hands back whatever is left
+    ready.clear();
+    scheduler.push("c", "queued");
+    scheduler.drain(ready);
+    EXPECT_EQ(ready, (std::vector<std::string>{"queued", "retry-late"}));
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
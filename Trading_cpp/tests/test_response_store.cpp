@@ -0,0 +1,396 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "../ResponseStore.h"
+
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Something shaped like a chart response
+std::string makeResponse(int seed, size_t bars = 200) {
+    std::string json = "{\"chart\":{\"result\":[{\"meta\":{\"symbol\":\"S" + std::to_string(seed) +
+                       "\"},\"timestamp\":[";
+    for (size_t i = 0; i < bars; ++i) {
+        json += (i ? "," : "") + std::to_string(1700000000 + 86400 * static_cast<int64_t>(i));
+    }
+    json += "],\"close\":[";
+    for (size_t i = 0; i < bars; ++i) {
+        json += (i ? "," : "") + std::to_string(100.0 + static_cast<double>((i * 7 + seed) % 50) / 4.0);
+    }
+    return json + "]}]}}";
+}
+
+ResponseStoreOptions manualCompaction() {
+    ResponseStoreOptions options;
+    options.backgroundCompaction = false;
+    return options;
+}
+
+class ResponseStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() /
+               ("response_store_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(dir_, ec);
+    }
+
+    std::string path(const std::string& name = "responses.store") const { return (dir_ / name).string(); }
+
+    std::filesystem::path dir_;
+};
+
+}  // namespace
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+TEST_F(ResponseStoreTest, PersistsAcrossInstances) {
+    {
+        ResponseStore store(path("nested/responses.store"));
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(store.put("https://example.com/" + std::to_string(i), makeResponse(i), 1h).isOk());
+        }
+        ASSERT_TRUE(store.put("https://example.com/7", "replaced", 1h).isOk());
+        EXPECT_EQ(store.stats().entries, 50u);
+    }
+
+    // A new instance rebuilds its index from the one file
+    ResponseStore store(path("nested/responses.store"));
+    EXPECT_EQ(store.get("https://example.com/7"), "replaced");
+    EXPECT_EQ(store.get("https://example.com/42"), makeResponse(42));
+    EXPECT_FALSE(store.get("https://example.com/missing"));
+
+    auto stats = store.stats();
+    EXPECT_EQ(stats.entries, 50u);
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(std::filesystem::file_size(path("nested/responses.store")), stats.fileBytes);
+}
+
+TEST_F(ResponseStoreTest, HonoursTtlMaxAgeAndErase) {
+    ResponseStore store(path(), manualCompaction());
+    ASSERT_TRUE(store.put("expired", "x", 0s).isOk());
+    ASSERT_TRUE(store.put("fresh", "y", 1h).isOk());
+
+    EXPECT_FALSE(store.get("expired"));
+    EXPECT_EQ(store.get("fresh"), "y");
+    EXPECT_EQ(store.get("fresh", 60s), "y");
+    EXPECT_FALSE(store.get("fresh", 0s));  // Older than the caller accepts
+
+    ASSERT_TRUE(store.erase("fresh").isOk());
+    EXPECT_FALSE(store.get("fresh"));
+    ResponseStore reopened(path(), manualCompaction());
+    EXPECT_FALSE(reopened.get("fresh"));
+    EXPECT_EQ(reopened.stats().entries, 1u);  // Only "expired", until compaction
+}
+
+#ifdef ENABLE_ZLIB
+TEST_F(ResponseStoreTest, CompressesLargeValues) {
+    ResponseStore store(path(), manualCompaction());
+    std::string response = makeResponse(1, 2000);
+    ASSERT_TRUE(store.put("big", response, 1h).isOk());
+    ASSERT_TRUE(store.put("small", "{}", 1h).isOk());
+
+    EXPECT_LT(store.stats().fileBytes, response.size() / 2);
+    EXPECT_EQ(store.get("big"), response);
+    EXPECT_EQ(store.get("small"), "{}");
+}
+#endif
+
+// ============================================================================
+// Sharing and Recovery
+// ============================================================================
+
+TEST_F(ResponseStoreTest, InstancesSeeEachOthersWrites) {
+    ResponseStore a(path(), manualCompaction());
+    ResponseStore b(path(), manualCompaction());
+
+    ASSERT_TRUE(a.put("k", "from a", 1h).isOk());
+    EXPECT_EQ(b.get("k"), "from a");
+    ASSERT_TRUE(b.put("k", "from b", 1h).isOk());
+    EXPECT_EQ(a.get("k"), "from b");
+
+    std::thread writerA([&] {
+        for (int i = 0; i < 300; ++i) a.put("a" + std::to_string(i), makeResponse(i, 20), 1h);
+    });
+    std::thread writerB([&] {
+        for (int i = 0; i < 300; ++i) b.put("b" + std::to_string(i), makeResponse(i, 20), 1h);
+    });
+    writerA.join();
+    writerB.join();
+
+    ResponseStore reader(path(), manualCompaction());
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(reader.get("a" + std::to_string(i)), makeResponse(i, 20));
+        ASSERT_EQ(reader.get("b" + std::to_string(i)), makeResponse(i, 20));
+    }
+    EXPECT_EQ(reader.stats().entries, 601u);
+}
+
+#ifndef _WIN32
+TEST_F(ResponseStoreTest, ProcessesShareOneFile) {
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ResponseStore store(path(), manualCompaction());
+        for (int i = 0; i < 200; ++i) store.put("child" + std::to_string(i), makeResponse(i, 30), 1h);
+        _exit(0);
+    }
+
+    {
+        ResponseStore store(path(), manualCompaction());
+        for (int i = 0; i < 200; ++i) store.put("parent" + std::to_string(i), makeResponse(i, 30), 1h);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    ResponseStore store(path(), manualCompaction());
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(store.get("child" + std::to_string(i)), makeResponse(i, 30));
+        ASSERT_EQ(store.get("parent" + std::to_string(i)), makeResponse(i, 30));
+    }
+}
+
+TEST_F(ResponseStoreTest, ProcessesCompactOneFileConcurrently) {
+    ResponseStoreOptions options = manualCompaction();
+    options.compactMinBytes = 0;
+    {
+        ResponseStore store(path(), options);
+        for (int i = 0; i < 3000; ++i) store.put("k" + std::to_string(i), makeResponse(i, 20), 1h);
+    }
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ResponseStore store(path(), options);
+        bool ok = true;
+        for (int round = 0; round < 20; ++round) ok = store.compact().isOk() && ok;
+        _exit(ok ? 0 : 1);
+    }
+
+    // Overwrite a few keys while both processes compact
+    {
+        ResponseStore store(path(), options);
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 50; ++i) store.put("k" + std::to_string(i), makeResponse(i + round, 20), 1h);
+            EXPECT_TRUE(store.compact().isOk());
+        }
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    ResponseStore reader(path(), options);
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_EQ(reader.get("k" + std::to_string(i)), makeResponse(i < 50 ? i + 19 : i, 20)) << "k" << i;
+    }
+    EXPECT_EQ(reader.stats().entries, 3000u);
+    // No temporary files left behind
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir_), std::filesystem::directory_iterator()), 1);
+}
+#endif
+
+TEST_F(ResponseStoreTest, ReadersFollowAnotherInstancesCompaction) {
+    ResponseStoreOptions options = manualCompaction();
+    options.compactMinBytes = 0;
+    ResponseStore writer(path(), options);
+    ResponseStore reader(path(), options);
+
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 10; ++i) writer.put("k" + std::to_string(i), makeResponse(i + round, 50), 1h);
+    }
+    EXPECT_EQ(reader.get("k1"), makeResponse(5, 50));
+
+    // The reader only reads, so it finds the new file through the mark on the old one
+    ASSERT_TRUE(writer.compact().isOk());
+    ASSERT_TRUE(writer.put("k1", "after compaction", 1h).isOk());
+    EXPECT_EQ(reader.get("k1"), "after compaction");
+    EXPECT_EQ(reader.get("k9"), makeResponse(13, 50));
+    EXPECT_EQ(reader.stats().fileBytes, writer.stats().fileBytes);
+}
+
+TEST_F(ResponseStoreTest, RecoversFromACompactionThatDiedBeforeItsRename) {
+    {
+        ResponseStore store(path(), manualCompaction());
+        ASSERT_TRUE(store.put("k", "value", 1h).isOk());
+    }
+    // Marked as replaced, but nothing was renamed over it
+    {
+        std::fstream fs(path(), std::ios::binary | std::ios::in | std::ios::out);
+        int64_t replacedAt = 1700000000;
+        fs.seekp(offsetof(ResponseStoreHeader, replacedAt));
+        fs.write(reinterpret_cast<const char*>(&replacedAt), sizeof(replacedAt));
+    }
+
+    ResponseStore store(path(), manualCompaction());
+    EXPECT_FALSE(store.get("k"));  // Looks mid-rename
+
+    // The next writer holds the lock, sees the file is still current and clears the mark
+    ASSERT_TRUE(store.put("other", "value", 1h).isOk());
+    EXPECT_EQ(store.get("k"), "value");
+    EXPECT_EQ(ResponseStore(path(), manualCompaction()).get("other"), "value");
+}
+
+TEST_F(ResponseStoreTest, CutsOffATornRecord) {
+    {
+        ResponseStore store(path(), manualCompaction());
+        ASSERT_TRUE(store.put("kept", "value", 1h).isOk());
+    }
+    // A crash in the middle of an append
+    {
+        std::ofstream ofs(path(), std::ios::binary | std::ios::app);
+        ofs << "TREC partial record";
+    }
+
+    ResponseStore store(path(), manualCompaction());
+    EXPECT_EQ(store.get("kept"), "value");
+    ASSERT_TRUE(store.put("after", "crash", 1h).isOk());
+
+    ResponseStore reopened(path(), manualCompaction());
+    EXPECT_EQ(reopened.get("kept"), "value");
+    EXPECT_EQ(reopened.get("after"), "crash");
+}
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+TEST_F(ResponseStoreTest, CompactionKeepsOnlyLiveRecords) {
+    ResponseStoreOptions options = manualCompaction();
+    options.compactMinBytes = 0;
+    ResponseStore store(path(), options);
+    ResponseStore other(path(), options);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 20; ++i) store.put("k" + std::to_string(i), makeResponse(i + round, 50), 1h);
+    }
+    store.put("gone", "soon", 0s);
+    EXPECT_EQ(other.get("k3"), makeResponse(12, 50));
+
+    uint64_t before = store.stats().fileBytes;
+    ASSERT_TRUE(store.compact().isOk());
+    auto stats = store.stats();
+    EXPECT_EQ(stats.compactions, 1u);
+    EXPECT_EQ(stats.entries, 20u);
+    EXPECT_EQ(stats.fileBytes, stats.liveBytes + sizeof(ResponseStoreHeader));
+    EXPECT_LT(stats.fileBytes, before / 5);
+    EXPECT_EQ(store.get("k5"), makeResponse(14, 50));
+
+    // The other instance follows the replaced file on its next write
+    ASSERT_TRUE(other.put("k0", "after compaction", 1h).isOk());
+    EXPECT_EQ(store.get("k0"), "after compaction");
+    EXPECT_EQ(other.get("k19"), makeResponse(28, 50));
+    EXPECT_EQ(other.stats().entries, 20u);
+}
+
+TEST_F(ResponseStoreTest, CompactsInTheBackground) {
+    ResponseStoreOptions options;
+    options.compactMinBytes = 64 << 10;
+    ResponseStore store(path(), options);
+
+    for (int round = 0; round < 40; ++round) {
+        for (int i = 0; i < 10; ++i) store.put("k" + std::to_string(i), makeResponse(i + round, 100), 1h);
+    }
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (store.stats().compactions == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    EXPECT_GT(store.stats().compactions, 0u);
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(store.get("k" + std::to_string(i)), makeResponse(i + 39, 100));
+}
+
+TEST_F(ResponseStoreTest, ExpiredRecordsCountAsDead) {
+    ResponseStoreOptions options;
+    options.compactMinBytes = 16 << 10;
+    ResponseStore store(path(), options);
+
+    // Every key written once, so nothing is superseded; all but one expire at once
+    ASSERT_TRUE(store.put("kept", "value", 1h).isOk());
+    for (int i = 0; i < 200; ++i) store.put("k" + std::to_string(i), makeResponse(i, 100), 0s);
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (store.stats().compactions == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    auto stats = store.stats();
+    EXPECT_GT(stats.compactions, 0u);
+    EXPECT_LT(stats.entries, 200u);
+    EXPECT_EQ(store.get("kept"), "value");
+}
+
+TEST_F(ResponseStoreTest, WritesDuringCompactionSurvive) {
+    ResponseStoreOptions options = manualCompaction();
+    options.compactMinBytes = 0;
+    ResponseStore store(path(), options);
+    for (int i = 0; i < 100; ++i) store.put("k" + std::to_string(i), makeResponse(i, 100), 1h);
+
+    // Puts, erases and gets race the copy; the tail copy must keep them all
+    std::atomic<bool> done{false};
+    std::thread compactor([&] {
+        while (!done) ASSERT_TRUE(store.compact().isOk());
+    });
+    for (int round = 1; round <= 20; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            std::string key = "k" + std::to_string(i);
+            if (i % 10 == 0) {
+                store.erase(key);
+            } else {
+                store.put(key, makeResponse(i + round, 100), 1h);
+            }
+            store.get(key);
+        }
+    }
+    done = true;
+    compactor.join();
+
+    ResponseStore reopened(path(), options);
+    for (ResponseStore* s : {&store, &reopened}) {
+        for (int i = 0; i < 100; ++i) {
+            std::string key = "k" + std::to_string(i);
+            if (i % 10 == 0) {
+                EXPECT_FALSE(s->get(key)) << key;
+            } else {
+                EXPECT_EQ(s->get(key), makeResponse(i + 20, 100)) << key;
+            }
+        }
+        EXPECT_EQ(s->stats().entries, 90u);
+    }
+    EXPECT_GT(store.stats().compactions, 0u);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
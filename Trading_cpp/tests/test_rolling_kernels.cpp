@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../RollingKernels.h"
+#include "../TechnicalAnalysis.h"
+
+using RollingKernels::SimdLevel;
+using RollingKernels::WindowSums;
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// Random walk with a flat stretch and a negative stretch (zero-variance and
+// non-positive-mean windows)
+std::vector<double> makePrices(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> move(0.0, 0.02);
+    std::vector<double> prices;
+    prices.reserve(count);
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i < 300 || i >= 340) price *= 1.0 + move(rng);
+        prices.push_back(i >= 500 && i < 530 ? -price : price);
+    }
+    return prices;
+}
+
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+// Levels this machine can run, scalar first
+std::vector<SimdLevel> availableLevels() {
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (RollingKernels::detectedSimdLevel() >= SimdLevel::SSE2) levels.push_back(SimdLevel::SSE2);
+    if (RollingKernels::detectedSimdLevel() >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    return levels;
+}
+
+// Restores the detected level when a test finishes
+struct LevelGuard {
+    ~LevelGuard() { RollingKernels::setSimdLevel(RollingKernels::detectedSimdLevel()); }
+};
+
+}  // namespace
+
+// ============================================================================
+// Dispatch Tests
+// ============================================================================
+
+TEST(RollingKernelsTest, ForcedLevelIsClampedToCpu) {
+    LevelGuard guard;
+    RollingKernels::setSimdLevel(SimdLevel::AVX2);
+    EXPECT_EQ(RollingKernels::activeSimdLevel(), RollingKernels::detectedSimdLevel());
+
+    RollingKernels::setSimdLevel(SimdLevel::Scalar);
+    EXPECT_EQ(RollingKernels::activeSimdLevel(), SimdLevel::Scalar);
+}
+
+// ============================================================================
+// Bit-Exactness and Accuracy Tests
+// ============================================================================
+
+TEST(RollingKernelsTest, EveryLevelMatchesScalarBitForBit) {
+    LevelGuard guard;
+    auto prices = makePrices(1003, 3);
+
+    for (int period : {1, 3, 20, 50}) {
+        for (WindowSums sums : {WindowSums::Sliding, WindowSums::ExactOldestFirst, WindowSums::ExactNewestFirst}) {
+            size_t first = period - 1;
+            size_t count = prices.size() - first;
+            std::vector<std::vector<double>> reference;
+
+            for (SimdLevel level : availableLevels()) {
+                RollingKernels::setSimdLevel(level);
+                std::vector<double> mean(count), stdDev(count);
+                std::vector<double> upper(count), middle(count), lower(count), bandwidth(count);
+                RollingKernels::rollingStdDev(prices, first, period, mean, stdDev, sums);
+                RollingKernels::rollingBollinger(prices, first, period, 2.0, upper, middle, lower,
+                                                 bandwidth, sums);
+                std::vector<std::vector<double>> outputs = {mean, stdDev, upper, middle, lower, bandwidth};
+
+                if (reference.empty()) {
+                    reference = outputs;
+                    continue;
+                }
+                for (size_t k = 0; k < outputs.size(); ++k) {
+                    EXPECT_TRUE(sameBits(outputs[k], reference[k]))
+                        << RollingKernels::toString(level) << " period " << period << " output " << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(RollingKernelsTest, SlidingSumsMatchExactWithinRounding) {
+    LevelGuard guard;
+    // Far from zero, so anchoring matters for the variance
+    auto prices = makePrices(5003, 7);
+    for (double& p : prices) p += 20000.0;
+
+    for (int period : {1, 2, 20, 200}) {
+        size_t first = period - 1;
+        size_t count = prices.size() - first;
+        std::vector<double> mean(count), stdDev(count), exactMean(count), exactStdDev(count);
+        RollingKernels::rollingStdDev(prices, first, period, exactMean, exactStdDev,
+                                      WindowSums::ExactOldestFirst);
+        for (SimdLevel level : availableLevels()) {
+            RollingKernels::setSimdLevel(level);
+            RollingKernels::rollingStdDev(prices, first, period, mean, stdDev);
+            for (size_t j = 0; j < count; ++j) {
+                ASSERT_NEAR(mean[j], exactMean[j], std::abs(exactMean[j]) * 1e-13)
+                    << RollingKernels::toString(level) << " period " << period << " window " << j;
+                ASSERT_NEAR(stdDev[j], exactStdDev[j], 1e-6)
+                    << RollingKernels::toString(level) << " period " << period << " window " << j;
+            }
+        }
+    }
+}
+
+TEST(RollingKernelsTest, SlidingSumsGiveFlatWindowsExactly) {
+    LevelGuard guard;
+    auto prices = makePrices(1000, 5);
+    const int period = 20;
+    size_t first = period - 1;
+    size_t count = prices.size() - first;
+    for (SimdLevel level : availableLevels()) {
+        RollingKernels::setSimdLevel(level);
+        std::vector<double> mean(count), stdDev(count);
+        RollingKernels::rollingStdDev(prices, first, period, mean, stdDev);
+        // Prices hold still over bars 299..339
+        for (size_t i = 299 + period - 1; i < 340; ++i) {
+            ASSERT_EQ(mean[i - first], prices[i]) << RollingKernels::toString(level) << " bar " << i;
+            ASSERT_EQ(stdDev[i - first], 0.0) << RollingKernels::toString(level) << " bar " << i;
+        }
+        EXPECT_NE(stdDev[340 - first], 0.0);
+    }
+}
+
+TEST(RollingKernelsTest, BollingerSeriesMatchesPerWindowDefinition) {
+    LevelGuard guard;
+    auto prices = makePrices(400, 5);
+    const int period = 20;
+
+    for (SimdLevel level : availableLevels()) {
+        RollingKernels::setSimdLevel(level);
+        BollingerSeries series = computeBollingerBandsSeries(prices, period, 2.0);
+        for (size_t i = period - 1; i < prices.size(); ++i) {
+            double sum = 0.0;
+            for (size_t k = i + 1 - period; k <= i; ++k) sum += prices[k];
+            double middle = sum / period;
+            double varianceSum = 0.0;
+            for (size_t k = i + 1 - period; k <= i; ++k) varianceSum += (prices[k] - middle) * (prices[k] - middle);
+            double stdDev = std::sqrt(varianceSum / period);
+
+            ASSERT_EQ(series.middle[i], middle) << RollingKernels::toString(level) << " bar " << i;
+            ASSERT_EQ(series.upper[i], middle + 2.0 * stdDev) << RollingKernels::toString(level) << " bar " << i;
+            ASSERT_EQ(series.lower[i], middle - 2.0 * stdDev) << RollingKernels::toString(level) << " bar " << i;
+        }
+        EXPECT_EQ(series.middle[period - 2], 0.0);
+    }
+}
+
+TEST(RollingKernelsTest, AverageTrueRangeMatchesWilderRecurrence) {
+    LevelGuard guard;
+    auto close = makePrices(257, 9);
+    std::vector<double> high, low;
+    for (double c : close) {
+        high.push_back(std::abs(c) * 1.01);
+        low.push_back(std::abs(c) * 0.98);
+    }
+
+    const int period = 14;
+    std::vector<double> expected(close.size(), 0.0);
+    double atr = 0.0;
+    for (size_t i = 0; i < close.size(); ++i) {
+        double tr = high[i] - low[i];
+        if (i > 0) {
+            tr = std::max({tr, std::abs(high[i] - close[i - 1]), std::abs(low[i] - close[i - 1])});
+        }
+        if (i < (size_t)period) {
+            atr += tr;
+            if (i == (size_t)period - 1) atr /= period;
+            continue;
+        }
+        atr = (atr * (period - 1) + tr) / period;
+        expected[i] = atr;
+    }
+
+    for (SimdLevel level : availableLevels()) {
+        RollingKernels::setSimdLevel(level);
+        std::vector<double> out(close.size());
+        RollingKernels::averageTrueRange(high, low, close, period, out);
+        EXPECT_TRUE(sameBits(out, expected)) << RollingKernels::toString(level);
+    }
+}
+
+TEST(RollingKernelsTest, CandlePatternScanMatchesMatcherOnEveryPrefix) {
+    LevelGuard guard;
+    // Small random bodies and shadows, so every pattern (and overlaps such
+    // as a hammer that also engulfs) turns up
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Candle> candles;
+    double price = 50.0;
+    for (size_t i = 0; i < 2001; ++i) {
+        Candle c;
+        c.open = price + (unit(rng) - 0.5);  // Gaps allow engulfing bodies
+        c.close = unit(rng) < 0.15 ? c.open : c.open + (unit(rng) - 0.5) * 2.0;
+        c.high = std::max(c.open, c.close) + unit(rng) * unit(rng) * 2.0;
+        c.low = std::min(c.open, c.close) - unit(rng) * unit(rng) * 2.0;
+        price = c.close;
+        candles.push_back(c);
+    }
+    BarColumns columns(candles);
+
+    CandlePatternSeries fromCandles = scanCandlestickPatterns(CandleView(candles));
+    std::vector<size_t> seen(6, 0);
+    for (size_t i = 0; i < candles.size(); ++i) {
+        PatternMatch expected = matchCandlestickPattern(CandleView(candles).first(i + 1));
+        ASSERT_EQ(fromCandles.at(i).pattern, expected.pattern) << "bar " << i;
+        ASSERT_EQ(fromCandles.score[i], expected.score) << "bar " << i;
+        for (int p = 1; p < 6; ++p) seen[p] += fromCandles.has(i, (CandlePattern)p);
+    }
+    for (int p = 1; p < 6; ++p) {
+        EXPECT_GT(seen[p], 0u) << candlePatternName((CandlePattern)p);
+        EXPECT_EQ(fromCandles.count((CandlePattern)p), seen[p]);
+    }
+
+    for (SimdLevel level : availableLevels()) {
+        RollingKernels::setSimdLevel(level);
+        CandlePatternSeries fromColumns = scanCandlestickPatterns(columns.view());
+        EXPECT_EQ(fromColumns.mask, fromCandles.mask) << RollingKernels::toString(level);
+        EXPECT_EQ(fromColumns.score, fromCandles.score) << RollingKernels::toString(level);
+    }
+}
+
+TEST(RollingKernelsTest, CandlePatternLevelsMatchPatternMaskAtOnTies) {
+    LevelGuard guard;
+    // Prices on a coarse tick grid, so equal open/close bars, bars with no
+    // shadow, shadows of exactly 2x or 0.5x the body and bodies touching the
+    // previous open/close all turn up and hit each strict comparison's edge
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> tick(-4, 4), shadow(0, 4);
+    const size_t count = 4003;  // Not a multiple of any lane width
+    std::vector<double> open(count), high(count), low(count), close(count);
+    int level = 400;
+    for (size_t i = 0; i < count; ++i) {
+        int o = level + tick(rng) / 2;
+        int c = rng() % 4 == 0 ? o : o + tick(rng);
+        int h = std::max(o, c) + shadow(rng) * (rng() % 2);
+        int l = std::min(o, c) - shadow(rng) * (rng() % 2);
+        open[i] = o * 0.25;
+        high[i] = h * 0.25;
+        low[i] = l * 0.25;
+        close[i] = c * 0.25;
+        level = c;
+    }
+
+    struct Columns {
+        const std::vector<double>&o, &h, &l, &c;
+        double open(size_t i) const { return o[i]; }
+        double high(size_t i) const { return h[i]; }
+        double low(size_t i) const { return l[i]; }
+        double close(size_t i) const { return c[i]; }
+    } bars{open, high, low, close};
+
+    std::vector<uint8_t> expected(count, 0);
+    size_t flat = 0, edges = 0;
+    std::vector<size_t> seen(6, 0);
+    for (size_t i = 2; i < count; ++i) {
+        expected[i] = patternMaskAt(bars, i);
+        double body = std::abs(close[i] - open[i]);
+        flat += body == 0.0;
+        edges += body > 0.0 && (std::min(open[i], close[i]) - low[i] == 2.0 * body ||
+                                high[i] - std::max(open[i], close[i]) == body * 0.5 ||
+                                close[i] == open[i - 1] || open[i] == close[i - 1]);
+        for (int p = 1; p < 6; ++p) seen[p] += (expected[i] >> p) & 1;
+    }
+    EXPECT_GT(flat, count / 10);
+    EXPECT_GT(edges, count / 10);
+    for (int p = 1; p < 6; ++p) EXPECT_GT(seen[p], 0u) << candlePatternName((CandlePattern)p);
+
+    for (SimdLevel simd : availableLevels()) {
+        RollingKernels::setSimdLevel(simd);
+        std::vector<uint8_t> mask(count, 0xff);
+        RollingKernels::candlePatterns(open, high, low, close, mask);
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(mask[i], expected[i]) << RollingKernels::toString(simd) << " bar " << i;
+        }
+    }
+}
+
+TEST(RollingKernelsTest, ShortInputsGiveZeros) {
+    std::vector<double> prices = {1.0, 2.0, 3.0};
+    std::vector<double> mean(3, 7.0);
+    RollingKernels::rollingMean(prices, 1, 5, mean);
+    EXPECT_EQ(mean, std::vector<double>(3, 0.0));
+
+    std::vector<double> atr(3, 7.0);
+    RollingKernels::averageTrueRange(prices, prices, prices, 14, atr);
+    EXPECT_EQ(atr, std::vector<double>(3, 0.0));
+
+    EXPECT_FALSE(checkVolatilitySqueeze(std::span<const double>(prices), 120, 0.10));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
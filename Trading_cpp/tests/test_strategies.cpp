@@ -6,6 +6,7 @@
 #include "../IStrategy.h"
 #include "../Strategies/MeanReversionStrategy.h"
 #include "../Strategies/TrendFollowingStrategy.h"
+#include "../Strategies/EnsembleStrategy.h"
 #include "../MarketData.h"
 
 // ============================================================================
@@ -221,7 +222,7 @@ TEST(IStrategyTest, ClonedStrategyIsIndependent) {
     auto candles = TestData::generateOversold(100);
     StrategySignal sig = clone->generateSignal(candles, candles.size() - 1);
 
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 // ============================================================================
@@ -254,8 +255,8 @@ TEST(SignalTest, SignalStrengthBounded) {
 
 TEST(SignalTest, SignalHasReason) {
     auto sig = StrategySignal::buy(0.5f, "RSI oversold");
-    EXPECT_FALSE(sig.reason.empty());
-    EXPECT_NE(sig.reason.find("RSI"), std::string::npos);
+    EXPECT_FALSE(sig.reasonText().empty());
+    EXPECT_NE(sig.reasonText().find("RSI"), std::string::npos);
 }
 
 // ============================================================================
@@ -291,7 +292,7 @@ TEST(MeanReversionTest, GeneratesHoldInSidewaysMarket) {
 
     // In balanced sideways market, RSI should be near 50
     // May hold or give weak signals
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(MeanReversionTest, ReturnsHoldForInsufficientData) {
@@ -301,7 +302,7 @@ TEST(MeanReversionTest, ReturnsHoldForInsufficientData) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     EXPECT_EQ(sig.type, SignalType::Hold);
-    EXPECT_NE(sig.reason.find("Insufficient"), std::string::npos);
+    EXPECT_NE(sig.reasonText().find("Insufficient"), std::string::npos);
 }
 
 TEST(MeanReversionTest, SetsStopLossForBuySignal) {
@@ -342,8 +343,8 @@ TEST(MeanReversionTest, ParametersAffectSignal) {
 
     // Aggressive strategy should be more likely to generate signals
     // At minimum, both should produce valid signals
-    EXPECT_FALSE(sigConservative.reason.empty());
-    EXPECT_FALSE(sigAggressive.reason.empty());
+    EXPECT_FALSE(sigConservative.reasonText().empty());
+    EXPECT_FALSE(sigAggressive.reasonText().empty());
 }
 
 TEST(MeanReversionTest, AdaptiveRSICanBeEnabled) {
@@ -354,7 +355,7 @@ TEST(MeanReversionTest, AdaptiveRSICanBeEnabled) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     // Should still generate valid signal
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(MeanReversionTest, SignalStrengthIncreasesWithExtreme) {
@@ -407,7 +408,7 @@ TEST(TrendFollowingTest, HoldsInSidewaysMarket) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     // In sideways market with low ADX, should hold or give weak signals
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(TrendFollowingTest, ReturnsHoldForInsufficientData) {
@@ -445,8 +446,8 @@ TEST(TrendFollowingTest, ADXThresholdFiltersWeakTrends) {
 
     // Higher threshold should be more selective
     // Both should produce valid signals
-    EXPECT_FALSE(sigHigh.reason.empty());
-    EXPECT_FALSE(sigLow.reason.empty());
+    EXPECT_FALSE(sigHigh.reasonText().empty());
+    EXPECT_FALSE(sigLow.reasonText().empty());
 }
 
 TEST(TrendFollowingTest, MAPeriodAffectsSignals) {
@@ -462,8 +463,8 @@ TEST(TrendFollowingTest, MAPeriodAffectsSignals) {
     StrategySignal sigSlow = slowStrategy.generateSignal(candles, candles.size() - 1);
 
     // Both should work without crashing
-    EXPECT_FALSE(sigFast.reason.empty());
-    EXPECT_FALSE(sigSlow.reason.empty());
+    EXPECT_FALSE(sigFast.reasonText().empty());
+    EXPECT_FALSE(sigSlow.reasonText().empty());
 }
 
 TEST(TrendFollowingTest, MACDConfirmationCanBeEnabled) {
@@ -474,7 +475,7 @@ TEST(TrendFollowingTest, MACDConfirmationCanBeEnabled) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     // Should still produce valid signal
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 // ============================================================================
@@ -509,7 +510,7 @@ TEST(TripleMATest, HoldsWhenMAsNotAligned) {
 
     // When MAs are not aligned, should hold
     if (sig.type == SignalType::Hold) {
-        EXPECT_NE(sig.reason.find("not aligned"), std::string::npos);
+        EXPECT_NE(sig.reasonText().find("not aligned"), std::string::npos);
     }
 }
 
@@ -538,7 +539,7 @@ TEST(EnhancedMeanReversionTest, HasVolumeFilter) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     // May filter due to low volume
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(EnhancedMeanReversionTest, HasTrendFilter) {
@@ -550,7 +551,7 @@ TEST(EnhancedMeanReversionTest, HasTrendFilter) {
     StrategySignal sig = strategy.generateSignal(candles, candles.size() - 1);
 
     // Signal may be reduced due to trend filter in downtrend
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 // ============================================================================
@@ -596,8 +597,8 @@ TEST(ParameterTest, ParametersHaveValidRanges) {
 
     for (const auto& param : params) {
         EXPECT_LE(param.minValue, param.maxValue);
-        EXPECT_GE(param.currentValue, param.minValue);
-        EXPECT_LE(param.currentValue, param.maxValue);
+        EXPECT_GE(param.value, param.minValue);
+        EXPECT_LE(param.value, param.maxValue);
         EXPECT_GT(param.step, 0.0f);
     }
 }
@@ -605,10 +606,13 @@ TEST(ParameterTest, ParametersHaveValidRanges) {
 TEST(ParameterTest, SetParameterWorks) {
     MeanReversionStrategy strategy;
 
-    strategy.setParam("rsiBuyThreshold", 25.0f);
-    float value = strategy.getParamValue("rsiBuyThreshold");
+    strategy.setParameters({StrategyParams("rsiBuyThreshold", 25.0, 0.0, 0.0, 0.0)});
 
-    EXPECT_FLOAT_EQ(value, 25.0f);
+    double value = 0.0;
+    for (const auto& param : strategy.getParameters()) {
+        if (param.name == "rsiBuyThreshold") value = param.value;
+    }
+    EXPECT_DOUBLE_EQ(value, 25.0);
 }
 
 // ============================================================================
@@ -661,7 +665,7 @@ TEST(EdgeCaseTest, StrategiesHandleZeroPrices) {
     StrategySignal sig = strategy.generateSignal(zeroPrices, zeroPrices.size() - 1);
 
     // Should not crash
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(EdgeCaseTest, StrategiesHandleConstantPrices) {
@@ -680,8 +684,8 @@ TEST(EdgeCaseTest, StrategiesHandleConstantPrices) {
     StrategySignal tfSig = tf.generateSignal(constant, constant.size() - 1);
 
     // Should not crash, likely hold
-    EXPECT_FALSE(mrSig.reason.empty());
-    EXPECT_FALSE(tfSig.reason.empty());
+    EXPECT_FALSE(mrSig.reasonText().empty());
+    EXPECT_FALSE(tfSig.reasonText().empty());
 }
 
 TEST(EdgeCaseTest, StrategiesHandleNegativePrices) {
@@ -703,7 +707,7 @@ TEST(EdgeCaseTest, StrategiesHandleNegativePrices) {
     StrategySignal sig = strategy.generateSignal(negative, negative.size() - 1);
 
     // Should handle gracefully
-    EXPECT_FALSE(sig.reason.empty());
+    EXPECT_FALSE(sig.reasonText().empty());
 }
 
 TEST(EdgeCaseTest, StrategiesHandleExtremeVolatility) {
@@ -716,8 +720,8 @@ TEST(EdgeCaseTest, StrategiesHandleExtremeVolatility) {
     StrategySignal tfSig = tf.generateSignal(candles, candles.size() - 1);
 
     // Should not crash
-    EXPECT_FALSE(mrSig.reason.empty());
-    EXPECT_FALSE(tfSig.reason.empty());
+    EXPECT_FALSE(mrSig.reasonText().empty());
+    EXPECT_FALSE(tfSig.reasonText().empty());
 }
 
 // ============================================================================
@@ -748,6 +752,183 @@ TEST(ConsistencyTest, ClonedStrategyProducesSameOutput) {
     EXPECT_FLOAT_EQ(origSig.strength, cloneSig.strength);
 }
 
+// ============================================================================
+// Incremental (onBar) Mode Tests
+// ============================================================================
+
+namespace {
+
+// Feeds bars one at a time and checks currentSignal() against a fresh batch
+// call over the same prefix on a twin instance.
+void expectIncrementalMatchesBatch(IStrategy& streaming, IStrategy& batch,
+                                   const std::vector<Candle>& candles) {
+    ASSERT_TRUE(streaming.supportsIncremental());
+    streaming.reset();
+    batch.reset();
+    for (size_t i = 0; i < candles.size(); ++i) {
+        streaming.onBar(candles[i]);
+        StrategySignal inc = streaming.currentSignal();
+        StrategySignal ref = batch.generateSignal(CandleView(candles.data(), i + 1), i);
+
+        ASSERT_EQ(inc.type, ref.type) << "bar " << i;
+        EXPECT_DOUBLE_EQ(inc.strength, ref.strength) << "bar " << i;
+        EXPECT_DOUBLE_EQ(inc.stopLossPrice, ref.stopLossPrice) << "bar " << i;
+        EXPECT_DOUBLE_EQ(inc.takeProfitPrice, ref.takeProfitPrice) << "bar " << i;
+        EXPECT_EQ(inc.reasonText(), ref.reasonText()) << "bar " << i;
+    }
+}
+
+}  // namespace
+
+TEST(IncrementalTest, MeanReversionMatchesBatch) {
+    srand(7);
+    auto candles = TestData::generateVolatile(400);
+    MeanReversionStrategy streaming, batch;
+    expectIncrementalMatchesBatch(streaming, batch, candles);
+}
+
+TEST(IncrementalTest, EnhancedMeanReversionMatchesBatch) {
+    srand(11);
+    auto candles = TestData::generateVolatile(400);
+    EnhancedMeanReversionStrategy streaming, batch;
+    expectIncrementalMatchesBatch(streaming, batch, candles);
+}
+
+TEST(IncrementalTest, TrendFollowingMatchesBatch) {
+    auto candles = TestData::generateMACrossover(60, 40, true);
+    auto down = TestData::generateDowntrend(80, candles.back().close);
+    candles.insert(candles.end(), down.begin(), down.end());
+
+    TrendFollowingStrategy streaming, batch;
+    streaming.setUseMACD(true);
+    batch.setUseMACD(true);
+    expectIncrementalMatchesBatch(streaming, batch, candles);
+}
+
+TEST(IncrementalTest, EnsembleMatchesBatch) {
+    srand(3);
+    auto candles = TestData::generateVolatile(300);
+
+    auto makeEnsemble = []() {
+        std::vector<std::unique_ptr<IStrategy>> children;
+        children.push_back(std::make_unique<MeanReversionStrategy>());
+        children.push_back(std::make_unique<TrendFollowingStrategy>());
+        return EnsembleStrategy(std::move(children));
+    };
+    EnsembleStrategy streaming = makeEnsemble();
+    EnsembleStrategy batch = makeEnsemble();
+    expectIncrementalMatchesBatch(streaming, batch, candles);
+}
+
+TEST(IncrementalTest, AdaptiveRSIDisablesIncrementalMode) {
+    MeanReversionStrategy strategy;
+    EXPECT_TRUE(strategy.supportsIncremental());
+    strategy.setUseAdaptiveRSI(true);
+    EXPECT_FALSE(strategy.supportsIncremental());
+}
+
+TEST(IncrementalTest, ResetRestartsStream) {
+    auto candles = TestData::generateOversold(100);
+    MeanReversionStrategy strategy;
+
+    for (const auto& c : candles) strategy.onBar(c);
+    StrategySignal first = strategy.currentSignal();
+
+    strategy.reset();
+    for (const auto& c : candles) strategy.onBar(c);
+    StrategySignal second = strategy.currentSignal();
+
+    EXPECT_EQ(first.type, second.type);
+    EXPECT_DOUBLE_EQ(first.strength, second.strength);
+}
+
+// ============================================================================
+// Shared Indicator Context Tests
+// ============================================================================
+
+namespace {
+
+// Per-bar signals from the shared-context path must equal the standalone
+// bulk path (incremental or per-prefix)
+void expectContextMatchesStandalone(IStrategy& strategy, const std::vector<Candle>& candles, size_t firstBar) {
+    SignalArray standalone = strategy.generateSignals(CandleView(candles), firstBar);
+    IndicatorContext context(candles);
+    SignalArray shared = strategy.generateSignals(context, firstBar);
+
+    ASSERT_EQ(shared.size(), standalone.size());
+    for (size_t i = firstBar; i < candles.size(); ++i) {
+        ASSERT_EQ(shared.type[i], standalone.type[i]) << "bar " << i;
+        EXPECT_DOUBLE_EQ(shared.strength[i], standalone.strength[i]) << "bar " << i;
+        EXPECT_DOUBLE_EQ(shared.stopLossPrice[i], standalone.stopLossPrice[i]) << "bar " << i;
+        EXPECT_DOUBLE_EQ(shared.takeProfitPrice[i], standalone.takeProfitPrice[i]) << "bar " << i;
+    }
+}
+
+EnsembleStrategy makeThreeWayEnsemble() {
+    std::vector<std::unique_ptr<IStrategy>> children;
+    children.push_back(std::make_unique<MeanReversionStrategy>());
+    children.push_back(std::make_unique<EnhancedMeanReversionStrategy>());
+    children.push_back(std::make_unique<TrendFollowingStrategy>());
+    return EnsembleStrategy(std::move(children));
+}
+
+}  // namespace
+
+TEST(IndicatorContextTest, SeriesMatchBatchIndicators) {
+    srand(5);
+    auto candles = TestData::generateVolatile(200);
+    IndicatorContext context(candles);
+
+    for (size_t n : {1u, 15u, 40u, 200u}) {
+        CandleView history(candles.data(), n);
+        std::vector<double> closes(context.closes().begin(), context.closes().begin() + n);
+        size_t i = n - 1;
+
+        EXPECT_EQ(context.rsi(14)[i], computeRSI(closes, 14));
+        EXPECT_EQ(context.atr(14)[i], computeATR(history, 14));
+        EXPECT_EQ(context.bollinger(20, 2.0).at(i).lower, computeBollingerBands(closes, 20, 2.0).lower);
+        EXPECT_EQ(context.adx(14).at(i).adx, computeADX(history, 14).adx);
+        EXPECT_EQ(context.macd().at(i), computeMACD(closes));
+    }
+}
+
+TEST(IndicatorContextTest, StrategiesMatchStandaloneSignals) {
+    srand(9);
+    auto candles = TestData::generateVolatile(400);
+
+    MeanReversionStrategy meanReversion;
+    expectContextMatchesStandalone(meanReversion, candles, 60);
+
+    EnhancedMeanReversionStrategy enhanced;
+    expectContextMatchesStandalone(enhanced, candles, 100);
+
+    TrendFollowingStrategy trend;
+    trend.setUseMACD(true);
+    expectContextMatchesStandalone(trend, candles, 60);
+
+    EnsembleStrategy ensemble = makeThreeWayEnsemble();
+    expectContextMatchesStandalone(ensemble, candles, 100);
+}
+
+TEST(IndicatorContextTest, EnsembleComputesSharedSeriesOnce) {
+    srand(13);
+    auto candles = TestData::generateVolatile(300);
+
+    IndicatorContext context(candles);
+    EnsembleStrategy ensemble = makeThreeWayEnsemble();
+    ensemble.generateSignals(context, 100);
+
+    // BB(20), RSI(14), ATR(14), squeeze and candlestick patterns; SMA(50) for
+    // the trend filter. The mean reversion set is shared rather than computed
+    // per child; trend following at its default periods runs its own fused pass.
+    EXPECT_EQ(context.computedSeries(), 6u);
+
+    // Asking again is a lookup
+    auto first = context.atr(14);
+    EXPECT_EQ(context.atr(14).data(), first.data());
+    EXPECT_EQ(context.computedSeries(), 6u);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -6,6 +6,10 @@
 
 #include "../TechnicalAnalysis.h"
 #include "../MarketData.h"
+#include "../BarColumns.h"
+#include "../BarSeries.h"
+#include "../RollingIndicators.h"
+#include "../PolynomialRegression.h"
 
 // ============================================================================
 // Test Data Generators
@@ -14,8 +18,8 @@
 namespace TestData {
 
 // Generate price series with known trend
-std::vector<float> generateTrendingPrices(size_t count, float start, float dailyChange) {
-    std::vector<float> prices;
+std::vector<double> generateTrendingPrices(size_t count, float start, float dailyChange) {
+    std::vector<double> prices;
     float price = start;
     for (size_t i = 0; i < count; ++i) {
         prices.push_back(price);
@@ -25,8 +29,8 @@ std::vector<float> generateTrendingPrices(size_t count, float start, float daily
 }
 
 // Generate oscillating prices (for RSI testing)
-std::vector<float> generateOscillatingPrices(size_t count, float center, float amplitude, float period) {
-    std::vector<float> prices;
+std::vector<double> generateOscillatingPrices(size_t count, float center, float amplitude, float period) {
+    std::vector<double> prices;
     for (size_t i = 0; i < count; ++i) {
         float price = center + amplitude * std::sin(2.0f * M_PI * i / period);
         prices.push_back(price);
@@ -35,8 +39,8 @@ std::vector<float> generateOscillatingPrices(size_t count, float center, float a
 }
 
 // Generate prices that only go up (for RSI = 100 testing)
-std::vector<float> generateOnlyUpPrices(size_t count, float start = 100.0f) {
-    std::vector<float> prices;
+std::vector<double> generateOnlyUpPrices(size_t count, float start = 100.0f) {
+    std::vector<double> prices;
     float price = start;
     for (size_t i = 0; i < count; ++i) {
         prices.push_back(price);
@@ -46,8 +50,8 @@ std::vector<float> generateOnlyUpPrices(size_t count, float start = 100.0f) {
 }
 
 // Generate prices that only go down (for RSI = 0 testing)
-std::vector<float> generateOnlyDownPrices(size_t count, float start = 200.0f) {
-    std::vector<float> prices;
+std::vector<double> generateOnlyDownPrices(size_t count, float start = 200.0f) {
+    std::vector<double> prices;
     float price = start;
     for (size_t i = 0; i < count; ++i) {
         prices.push_back(price);
@@ -57,7 +61,7 @@ std::vector<float> generateOnlyDownPrices(size_t count, float start = 200.0f) {
 }
 
 // Generate candles from prices
-std::vector<Candle> generateCandles(const std::vector<float>& prices, float spread = 0.01f) {
+std::vector<Candle> generateCandles(const std::vector<double>& prices, float spread = 0.01f) {
     std::vector<Candle> candles;
     for (size_t i = 0; i < prices.size(); ++i) {
         Candle c;
@@ -90,8 +94,8 @@ std::vector<Candle> generateVolatileCandles(size_t count, float basePrice = 100.
 }
 
 // Generate returns from prices
-std::vector<float> pricesToReturns(const std::vector<float>& prices) {
-    std::vector<float> returns;
+std::vector<double> pricesToReturns(const std::vector<double>& prices) {
+    std::vector<double> returns;
     for (size_t i = 1; i < prices.size(); ++i) {
         returns.push_back((prices[i] - prices[i - 1]) / prices[i - 1]);
     }
@@ -106,7 +110,7 @@ std::vector<float> pricesToReturns(const std::vector<float>& prices) {
 
 TEST(RSITest, RSIBoundedBetween0And100) {
     // Test with various price patterns
-    std::vector<std::vector<float>> testCases = {
+    std::vector<std::vector<double>> testCases = {
         TestData::generateTrendingPrices(100, 100.0f, 1.0f),    // Uptrend
         TestData::generateTrendingPrices(100, 200.0f, -1.0f),   // Downtrend
         TestData::generateOscillatingPrices(100, 100.0f, 10.0f, 20.0f),  // Oscillating
@@ -137,7 +141,7 @@ TEST(RSITest, RSIApproaches0ForOnlyDownMoves) {
 
 TEST(RSITest, RSIAround50ForSidewaysMarket) {
     // Generate alternating up/down of equal magnitude
-    std::vector<float> prices;
+    std::vector<double> prices;
     float price = 100.0f;
     for (int i = 0; i < 100; ++i) {
         prices.push_back(price);
@@ -168,7 +172,7 @@ TEST(RSITest, AdaptiveRSIBounded) {
 }
 
 TEST(RSITest, RSIHandlesShortPriceSeries) {
-    std::vector<float> shortPrices = {100.0f, 101.0f, 102.0f, 101.5f, 103.0f};
+    std::vector<double> shortPrices = {100.0f, 101.0f, 102.0f, 101.5f, 103.0f};
     float rsi = computeRSI(shortPrices, 14);
 
     // Should not crash, may return edge case value
@@ -254,8 +258,8 @@ TEST(BollingerBandsTest, BandwidthPositive) {
 
 TEST(BollingerBandsTest, WideBandsForVolatileMarket) {
     // Generate two sets of prices - one volatile, one stable
-    std::vector<float> volatilePrices;
-    std::vector<float> stablePrices;
+    std::vector<double> volatilePrices;
+    std::vector<double> stablePrices;
 
     float price = 100.0f;
     for (int i = 0; i < 100; ++i) {
@@ -297,6 +301,37 @@ TEST(BollingerBandsTest, MiddleIsMovingAverage) {
     EXPECT_NEAR(bb.middle, expectedSMA, 0.1f);
 }
 
+TEST(BollingerBandsTest, RunningSumsMatchBatchWithinRounding) {
+    // Price level far above the noise (cancellation-prone), level shifts and a
+    // flat run that must read back exactly
+    std::vector<double> prices;
+    for (int i = 0; i < 2000; ++i) {
+        double price = 5000.0 + (i / 300) * 750.0 + std::sin(i * 0.3) * 0.01 + ((i * 7919) % 13) * 0.001;
+        prices.push_back(i >= 900 && i < 960 ? 5123.25 : price);
+    }
+
+    const int period = 20;
+    RollingSMA sma(period);
+    RollingBollinger bands(period, 2.0);
+    for (size_t n = 1; n <= prices.size(); ++n) {
+        sma.update(prices[n - 1]);
+        bands.update(prices[n - 1]);
+        if (n < (size_t)period) continue;
+
+        BollingerBands expected = computeBollingerBands(std::span<const double>(prices).first(n), period, 2.0);
+        BollingerBands actual = bands.value();
+        ASSERT_NEAR(sma.value(), expected.middle, expected.middle * 1e-12) << "bar " << n - 1;
+        ASSERT_NEAR(actual.middle, expected.middle, expected.middle * 1e-12) << "bar " << n - 1;
+        ASSERT_NEAR(actual.upper - actual.middle, expected.upper - expected.middle, 1e-9) << "bar " << n - 1;
+    }
+
+    // Flat window: exact price, zero width
+    RollingBollinger flat(period, 2.0);
+    for (size_t i = 0; i < 959; ++i) flat.update(prices[i]);
+    EXPECT_EQ(flat.value().middle, 5123.25);
+    EXPECT_EQ(flat.value().bandwidth, 0.0);
+}
+
 // ============================================================================
 // ATR Tests
 // ============================================================================
@@ -407,6 +442,20 @@ TEST(SupportResistanceTest, LevelsNotNaN) {
     EXPECT_FALSE(std::isnan(levels.resistance));
 }
 
+TEST(SupportResistanceTest, SeriesMatchesWindowMinMax) {
+    std::vector<double> prices;
+    for (int i = 0; i < 300; ++i) prices.push_back(100.0 + 10.0 * std::sin(i * 0.3) + ((i * 31) % 7));
+
+    const int period = 60;
+    SupportResistanceSeries series = identifyLevelsSeries(prices, period);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        size_t start = i + 1 > (size_t)period ? i + 1 - period : 0;
+        auto window = std::span<const double>(prices).subspan(start, i + 1 - start);
+        ASSERT_EQ(series.support[i], *std::min_element(window.begin(), window.end())) << "bar " << i;
+        ASSERT_EQ(series.resistance[i], *std::max_element(window.begin(), window.end())) << "bar " << i;
+    }
+}
+
 // ============================================================================
 // GARCH Volatility Tests
 // ============================================================================
@@ -430,8 +479,8 @@ TEST(GARCHTest, VolatilityNotNaN) {
 
 TEST(GARCHTest, HigherVolatilityForVolatileReturns) {
     // Generate volatile and stable return series
-    std::vector<float> volatileReturns;
-    std::vector<float> stableReturns;
+    std::vector<double> volatileReturns;
+    std::vector<double> stableReturns;
 
     for (int i = 0; i < 100; ++i) {
         volatileReturns.push_back(((rand() % 1000) / 500.0f - 1.0f) * 0.05f);  // +/- 5%
@@ -473,6 +522,39 @@ TEST(ForecastTest, ForecastPositive) {
     EXPECT_GT(forecast, 0.0f);
 }
 
+TEST(ForecastTest, FixedDegreeFitRecoversExactPolynomial) {
+    // y = 50 + 0.5x - 0.01x^2 + 0.0001x^3
+    std::vector<double> prices;
+    for (int x = 0; x < 300; ++x) prices.push_back(50.0 + 0.5 * x - 0.01 * x * x + 0.0001 * x * x * x);
+
+    double x = 299.0 + 30.0;
+    double expected = 50.0 + 0.5 * x - 0.01 * x * x + 0.0001 * x * x * x;
+    EXPECT_NEAR(forecastPricePoly(prices, 30, 3), expected, std::abs(expected) * 1e-9);
+}
+
+TEST(ForecastTest, RollingFitMatchesBatchOverWindow) {
+    std::vector<double> prices;
+    for (int i = 0; i < 1000; ++i) prices.push_back(100.0 + 10.0 * std::sin(i * 0.05) + ((i * 7919) % 17) * 0.3);
+
+    const int window = 60;
+    RollingPolyFit<1> linear(window);
+    RollingPolyFit<2> quadratic(window);
+    RollingPolyFit<3> cubic(window);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        linear.update(prices[i]);
+        quadratic.update(prices[i]);
+        cubic.update(prices[i]);
+
+        size_t n = std::min<size_t>(i + 1, window);
+        std::vector<double> recent(prices.begin() + (i + 1 - n), prices.begin() + i + 1);
+        for (int degree = 1; degree <= 3; ++degree) {
+            double expected = forecastPricePoly(recent, 30, degree);
+            double actual = degree == 1 ? linear.value(30) : degree == 2 ? quadratic.value(30) : cubic.value(30);
+            ASSERT_NEAR(actual, expected, std::abs(expected) * 1e-9) << "bar " << i << " degree " << degree;
+        }
+    }
+}
+
 // ============================================================================
 // Cycle Detection Tests
 // ============================================================================
@@ -496,6 +578,21 @@ TEST(CycleTest, CyclePositive) {
     EXPECT_GT(cycle, 0);
 }
 
+TEST(CycleTest, StreamingMatchesBatchOnEveryPrefix) {
+    // Noisy cycle of period 18 on a drift
+    std::vector<double> prices;
+    for (int i = 0; i < 400; ++i) {
+        prices.push_back(100.0 + 8.0 * std::sin(2.0 * M_PI * i / 18.0) + 0.1 * i + ((i * 7919) % 13) * 0.2);
+    }
+
+    RollingCycle streaming;
+    for (size_t n = 1; n <= prices.size(); ++n) {
+        streaming.update(prices[n - 1]);
+        ASSERT_EQ(streaming.value(), detectCycle(std::span<const double>(prices).first(n))) << "bar " << n - 1;
+    }
+    EXPECT_EQ(streaming.value(), 18);
+}
+
 // ============================================================================
 // Local Extrema Tests
 // ============================================================================
@@ -527,13 +624,47 @@ TEST(ExtremaTest, MaximaWithinPriceRange) {
     }
 }
 
+TEST(ExtremaTest, StreamingMatchesNeighbourScanOnEveryPrefix) {
+    // Rounded prices so plateaus (ties) occur
+    std::vector<double> prices;
+    for (int i = 0; i < 300; ++i) prices.push_back(std::round(100.0 + 12.0 * std::sin(i * 0.25) + ((i * 17) % 5)));
+
+    const int period = 60;
+    const int window = 5;
+    for (bool findMaxima : {true, false}) {
+        auto series = findLocalExtremaSeries(prices, period, findMaxima);
+        for (size_t n = 10; n <= prices.size(); ++n) {
+            // Bars in the trailing period with no better price within 5 bars
+            int start = std::max(0, (int)n - period);
+            std::vector<double> expected;
+            for (int i = start + window; i < (int)n - window; ++i) {
+                bool isExtremum = true;
+                for (int k = 1; k <= window; ++k) {
+                    double left = prices[i - k], right = prices[i + k];
+                    if (findMaxima ? (left > prices[i] || right > prices[i])
+                                   : (left < prices[i] || right < prices[i])) isExtremum = false;
+                }
+                if (isExtremum) expected.push_back(prices[i]);
+            }
+            std::sort(expected.begin(), expected.end());
+            std::vector<double> unique;
+            for (double v : expected) {
+                if (unique.empty() || v > unique.back() * 1.01) unique.push_back(v);
+            }
+
+            ASSERT_EQ(series[n - 1], unique) << "bar " << n - 1;
+            ASSERT_EQ(findLocalExtrema(std::span<const double>(prices).first(n), period, findMaxima), unique);
+        }
+    }
+}
+
 // ============================================================================
 // Volatility Squeeze Tests
 // ============================================================================
 
 TEST(SqueezeTest, DetectsLowVolatility) {
     // Generate stable prices (low volatility)
-    std::vector<float> stablePrices;
+    std::vector<double> stablePrices;
     for (int i = 0; i < 150; ++i) {
         stablePrices.push_back(100.0f + (i % 2) * 0.1f);  // Very small oscillation
     }
@@ -546,7 +677,7 @@ TEST(SqueezeTest, DetectsLowVolatility) {
 
 TEST(SqueezeTest, NoSqueezeInHighVolatility) {
     // Generate volatile prices
-    std::vector<float> volatilePrices;
+    std::vector<double> volatilePrices;
     for (int i = 0; i < 150; ++i) {
         volatilePrices.push_back(100.0f + std::sin(i * 0.5f) * 20.0f);  // Large swings
     }
@@ -557,6 +688,54 @@ TEST(SqueezeTest, NoSqueezeInHighVolatility) {
     EXPECT_FALSE(squeeze);
 }
 
+TEST(SqueezeTest, SeriesAndStreamingMatchBatchOnEveryPrefix) {
+    // Calm and volatile stretches, a flat run (zero bandwidth) and a
+    // non-positive stretch (skipped windows)
+    std::vector<double> prices;
+    for (int i = 0; i < 500; ++i) {
+        double amplitude = (i / 60) % 2 == 0 ? 0.5 : 6.0;
+        double price = i >= 200 && i < 240 ? 100.0 : 100.0 + std::sin(i * 0.4) * amplitude + i * 0.05;
+        prices.push_back(i >= 300 && i < 320 ? -price : price);
+    }
+
+    for (int lookback : {20, 50, 120}) {
+        std::vector<bool> series = checkVolatilitySqueezeSeries(prices, lookback, 0.10);
+        RollingSqueeze streaming(lookback, 0.10);
+        ASSERT_EQ(series.size(), prices.size());
+
+        int squeezes = 0;
+        for (size_t n = 1; n <= prices.size(); ++n) {
+            bool batch = checkVolatilitySqueeze(std::span<const double>(prices).first(n), lookback, 0.10);
+            streaming.update(prices[n - 1]);
+            ASSERT_EQ(series[n - 1], batch) << "lookback " << lookback << " bar " << n - 1;
+            ASSERT_EQ(streaming.value(), batch) << "lookback " << lookback << " bar " << n - 1;
+            squeezes += batch;
+        }
+        EXPECT_GT(squeezes, 0);
+    }
+}
+
+TEST(SqueezeTest, OrderStatisticsTrackSlidingWindow) {
+    const size_t window = 16;
+    OrderStatisticSlots ranks(window);
+    std::vector<double> values;
+    for (int i = 0; i < 200; ++i) {
+        double value = static_cast<double>((i * 37) % 23);  // Plenty of duplicates
+        values.push_back(value);
+        ranks.insert(i % window, value);
+
+        size_t first = values.size() > window ? values.size() - window : 0;
+        std::vector<double> expected(values.begin() + first, values.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(ranks.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) ASSERT_EQ(ranks.kth(k), expected[k]);
+    }
+
+    ranks.erase(3);
+    EXPECT_EQ(ranks.size(), window - 1);
+    EXPECT_FALSE(ranks.contains(3));
+}
+
 // ============================================================================
 // Candlestick Pattern Tests
 // ============================================================================
@@ -583,7 +762,7 @@ TEST(PatternTest, PatternScoreBounded) {
 // ============================================================================
 
 TEST(EdgeCaseTest, RSIHandlesEmptyPrices) {
-    std::vector<float> emptyPrices;
+    std::vector<double> emptyPrices;
     float rsi = computeRSI(emptyPrices, 14);
 
     // Should not crash, may return 0 or 50
@@ -598,7 +777,7 @@ TEST(EdgeCaseTest, ATRHandlesEmptyCandles) {
 }
 
 TEST(EdgeCaseTest, BollingerHandlesSinglePrice) {
-    std::vector<float> singlePrice = {100.0f};
+    std::vector<double> singlePrice = {100.0f};
     BollingerBands bb = computeBollingerBands(singlePrice, 20, 2.0f);
 
     // Should not crash
@@ -606,7 +785,7 @@ TEST(EdgeCaseTest, BollingerHandlesSinglePrice) {
 }
 
 TEST(EdgeCaseTest, IndicatorsHandleConstantPrices) {
-    std::vector<float> constantPrices(100, 100.0f);
+    std::vector<double> constantPrices(100, 100.0f);
 
     float rsi = computeRSI(constantPrices, 14);
     auto [macd, signal] = computeMACD(constantPrices);
@@ -619,6 +798,146 @@ TEST(EdgeCaseTest, IndicatorsHandleConstantPrices) {
     EXPECT_LE(bb.bandwidth, 0.01f);
 }
 
+// ============================================================================
+// Column (BarColumns) Overload Tests
+// ============================================================================
+
+TEST(BarColumnsTest, ColumnsMatchCandleLayout) {
+    auto candles = TestData::generateVolatileCandles(50);
+    for (size_t i = 0; i < candles.size(); ++i) {
+        candles[i].ts = TimeUtils::fromUnixSeconds(1700000000 + 86400 * (int64_t)i);
+    }
+    BarColumns cols(candles);
+
+    ASSERT_EQ(cols.size(), candles.size());
+    for (size_t i = 0; i < candles.size(); ++i) {
+        EXPECT_EQ(cols.timestamps()[i], candles[i].ts);
+        EXPECT_EQ(cols.opens()[i], candles[i].open);
+        EXPECT_EQ(cols.highs()[i], candles[i].high);
+        EXPECT_EQ(cols.lows()[i], candles[i].low);
+        EXPECT_EQ(cols.closes()[i], candles[i].close);
+        EXPECT_EQ(cols.volumes()[i], candles[i].volume);
+    }
+    EXPECT_EQ(cols.candle(7).close, candles[7].close);
+    EXPECT_EQ(cols.view().last(5).close.front(), candles[45].close);
+}
+
+TEST(BarColumnsTest, ColumnOverloadsMatchVectorOverloads) {
+    srand(42);
+    auto candles = TestData::generateVolatileCandles(300);
+    std::vector<double> closes;
+    for (const auto& c : candles) closes.push_back(c.close);
+    BarColumns cols(candles);
+
+    EXPECT_EQ(computeRSI(cols.closes(), 14), computeRSI(closes, 14));
+    EXPECT_EQ(computeAdaptiveRSI(cols.closes(), 14), computeAdaptiveRSI(closes, 14));
+    EXPECT_EQ(computeMACD(cols.closes()), computeMACD(closes));
+    EXPECT_EQ(detectCycle(cols.closes()), detectCycle(closes));
+    EXPECT_EQ(checkVolatilitySqueeze(cols.closes()), checkVolatilitySqueeze(closes));
+    EXPECT_EQ(findLocalExtrema(cols.closes(), 60, true), findLocalExtrema(closes, 60, true));
+
+    BollingerBands a = computeBollingerBands(cols.closes(), 20, 2.0);
+    BollingerBands b = computeBollingerBands(closes, 20, 2.0);
+    EXPECT_EQ(a.upper, b.upper);
+    EXPECT_EQ(a.lower, b.lower);
+
+    EXPECT_EQ(computeATR(cols, 14), computeATR(candles, 14));
+    EXPECT_EQ(computeVWAP(cols, 20), computeVWAP(candles, 20));
+    ADXResult adxCols = computeADX(cols, 14);
+    ADXResult adxRows = computeADX(candles, 14);
+    EXPECT_EQ(adxCols.adx, adxRows.adx);
+    EXPECT_EQ(adxCols.plusDI, adxRows.plusDI);
+    EXPECT_EQ(adxCols.minusDI, adxRows.minusDI);
+
+    // Prefix windows match the corresponding candle prefix
+    for (size_t n : {3, 30, 150}) {
+        BarColumnsView prefix = cols.view().first(n);
+        CandleView rows(candles.data(), n);
+        EXPECT_EQ(computeATR(prefix, 14), computeATR(rows, 14));
+        EXPECT_EQ(detectCandlestickPattern(prefix).name, detectCandlestickPattern(rows).name);
+        EXPECT_EQ(detectCandlestickPattern(prefix).score, detectCandlestickPattern(rows).score);
+    }
+}
+
+TEST(BarColumnsTest, BarSeriesKeepsColumnsInSync) {
+    std::vector<Candle> candles = TestData::generateVolatileCandles(10);
+    for (size_t i = 0; i < candles.size(); ++i) {
+        candles[i].ts = TimeUtils::fromUnixSeconds(1700000000 + 86400 * (int64_t)i);
+    }
+    BarSeries series(std::vector<Candle>(candles.begin(), candles.end() - 1));
+
+    EXPECT_TRUE(series.tryAppend(candles.back()));
+    EXPECT_FALSE(series.tryAppend(candles.front()));  // Out of order: rejected
+    ASSERT_EQ(series.columns().size(), series.size());
+    EXPECT_EQ(series.columns().closes().back(), candles.back().close);
+
+    series.trimToLast(4);
+    ASSERT_EQ(series.columns().size(), 4u);
+    EXPECT_EQ(series.columns().closes().front(), candles[6].close);
+    EXPECT_EQ(series.closePrices(), std::vector<double>(series.columns().closes().begin(),
+                                                        series.columns().closes().end()));
+}
+
+// ============================================================================
+// Full-Series Tests
+// ============================================================================
+
+TEST(SeriesTest, EveryEntryMatchesScalarOnPrefix) {
+    srand(17);
+    auto candles = TestData::generateVolatileCandles(250);
+    std::vector<double> closes;
+    for (const auto& c : candles) closes.push_back(c.close);
+
+    std::vector<double> rsi = computeRSISeries(closes, 14);
+    std::vector<double> atr = computeATRSeries(candles, 14);
+    std::vector<double> vwap = computeVWAPSeries(candles, 20);
+    MACDSeries macd = computeMACDSeries(closes);
+    BollingerSeries bb = computeBollingerBandsSeries(closes, 20, 2.0);
+    ADXSeries adx = computeADXSeries(candles, 14);
+    ASSERT_EQ(rsi.size(), candles.size());
+
+    for (size_t n = 1; n <= candles.size(); ++n) {
+        size_t i = n - 1;
+        std::span<const double> prices(closes.data(), n);
+        CandleView history(candles.data(), n);
+
+        ASSERT_EQ(rsi[i], computeRSI(prices, 14)) << "bar " << i;
+        ASSERT_EQ(atr[i], computeATR(history, 14)) << "bar " << i;
+        ASSERT_EQ(vwap[i], computeVWAP(history, 20)) << "bar " << i;
+        ASSERT_EQ(macd.at(i), computeMACD(prices)) << "bar " << i;
+
+        BollingerBands expectedBB = computeBollingerBands(prices, 20, 2.0);
+        ASSERT_EQ(bb.at(i).upper, expectedBB.upper) << "bar " << i;
+        ASSERT_EQ(bb.at(i).lower, expectedBB.lower) << "bar " << i;
+
+        ADXResult expectedADX = computeADX(history, 14);
+        ASSERT_EQ(adx.at(i).adx, expectedADX.adx) << "bar " << i;
+        ASSERT_EQ(adx.at(i).plusDI, expectedADX.plusDI) << "bar " << i;
+        ASSERT_EQ(adx.at(i).minusDI, expectedADX.minusDI) << "bar " << i;
+    }
+}
+
+TEST(SeriesTest, ColumnSeriesMatchCandleSeries) {
+    srand(23);
+    auto candles = TestData::generateVolatileCandles(120);
+    BarColumns cols(candles);
+
+    EXPECT_EQ(computeATRSeries(cols, 14), computeATRSeries(candles, 14));
+    EXPECT_EQ(computeVWAPSeries(cols), computeVWAPSeries(candles));
+    EXPECT_EQ(computeADXSeries(cols, 14).adx, computeADXSeries(candles, 14).adx);
+}
+
+TEST(SeriesTest, EmptyInputGivesEmptySeries) {
+    std::vector<double> prices;
+    std::vector<Candle> candles;
+    EXPECT_TRUE(computeRSISeries(prices).empty());
+    EXPECT_TRUE(computeMACDSeries(prices).macd.empty());
+    EXPECT_TRUE(computeBollingerBandsSeries(prices).middle.empty());
+    EXPECT_TRUE(computeATRSeries(candles).empty());
+    EXPECT_TRUE(computeADXSeries(candles).adx.empty());
+    EXPECT_TRUE(computeVWAPSeries(candles).empty());
+}
+
 // ============================================================================
 // Main
 // ============================================================================
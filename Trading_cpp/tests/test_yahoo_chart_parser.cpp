@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../YahooChartParser.h"
+#include "../json.hpp"
+
+using json = nlohmann::json;
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+// A chart v8 response around the given quote object, with the meta, events
+// and adjclose sections the parser has to skip
+std::string chartResponse(const std::string& timestamps, const std::string& quote) {
+    return R"({"chart":{"result":[{"meta":{"currency":"USD","symbol":"TEST","validRanges":["1d","5d"],)"
+           R"("tradingPeriods":[[{"start":1,"end":2}]]},"timestamp":)" + timestamps +
+           R"(,"events":{"dividends":{"1700000000":{"amount":0.5,"date":1700000000}}},)"
+           R"("indicators":{"quote":[)" + quote + R"(],"adjclose":[{"adjclose":[1.0,2.0,3.0]}]}}],"error":null}})";
+}
+
+// Random payload with scattered nulls; prices mix integers and floats
+std::string randomResponse(size_t bars, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto price = [&](double base) -> std::string {
+        if (unit(rng) < 0.03) return "null";
+        if (unit(rng) < 0.05) return std::to_string((int64_t)base);
+        std::ostringstream out;
+        out.precision(17);
+        out << base * (1.0 + 0.01 * (unit(rng) - 0.5));
+        return out.str();
+    };
+
+    std::string ts = "[", open = "[", high = "[", low = "[", close = "[", volume = "[";
+    double base = 100.0;
+    for (size_t i = 0; i < bars; ++i) {
+        std::string sep = i ? "," : "";
+        base *= 1.0 + 0.02 * (unit(rng) - 0.5);
+        ts += sep + (unit(rng) < 0.005 ? "null" : std::to_string(1600000000 + 86400 * (int64_t)i));
+        open += sep + price(base);
+        high += sep + price(base * 1.01);
+        low += sep + price(base * 0.99);
+        close += sep + price(base);
+        volume += sep + (unit(rng) < 0.03 ? "null" : std::to_string(1000 + (int64_t)(unit(rng) * 1e6)));
+    }
+    std::string quote = R"({"open":)" + open + R"(],"high":)" + high + R"(],"low":)" + low +
+                        R"(],"close":)" + close + R"(],"volume":)" + volume + "]}";
+    return chartResponse(ts + "]", quote);
+}
+
+// The DOM walk fetchCandles did before the streaming parser
+// (FillFromClose; null timestamps are skipped rather than throwing)
+std::vector<Candle> domReference(const std::string& response) {
+    std::vector<Candle> candles;
+    json data = json::parse(response);
+    auto result = data["chart"]["result"];
+    if (result.is_null() || result.empty()) return candles;
+    auto quoteData = result[0];
+    auto timestamps = quoteData["timestamp"];
+    auto indicators = quoteData["indicators"]["quote"][0];
+    auto closes = indicators["close"];
+    auto opens = indicators.contains("open") ? indicators["open"] : closes;
+    auto highs = indicators.contains("high") ? indicators["high"] : closes;
+    auto lows = indicators.contains("low") ? indicators["low"] : closes;
+    auto volumes = indicators.contains("volume") ? indicators["volume"] : json::array();
+
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        if (closes[i].is_null() || timestamps[i].is_null()) continue;
+        Candle c;
+        c.ts = TimeUtils::fromUnixSeconds(timestamps[i].get<int64_t>());
+        c.close = closes[i].get<double>();
+        c.open = !opens[i].is_null() ? opens[i].get<double>() : c.close;
+        c.high = !highs[i].is_null() ? highs[i].get<double>() : c.close;
+        c.low = !lows[i].is_null() ? lows[i].get<double>() : c.close;
+        c.volume = i < volumes.size() && !volumes[i].is_null() ? volumes[i].get<int64_t>() : 0;
+        candles.push_back(c);
+    }
+    return candles;
+}
+
+}  // namespace
+
+// ============================================================================
+// Null Handling
+// ============================================================================
+
+TEST(YahooChartParserTest, NullPricesTakeTheClose) {
+    std::string response = chartResponse(
+        "[1700000000,1700086400,1700172800]",
+        R"({"open":[10.0,null,12],"high":[11.5,12.5,null],"low":[9.5,10.5,11.5],)"
+        R"("close":[11.0,null,12.25],"volume":[100,200,null]})");
+
+    auto parsed = YahooChart::parse(response);
+    ASSERT_TRUE(parsed.isOk());
+    const BarColumns& bars = parsed.value();
+
+    // The bar without a close is dropped
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(TimeUtils::toUnixSeconds(bars.timestamps()[0]), 1700000000);
+    EXPECT_EQ(TimeUtils::toUnixSeconds(bars.timestamps()[1]), 1700172800);
+    EXPECT_EQ(bars.opens()[1], 12.0);
+    EXPECT_EQ(bars.highs()[1], 12.25);
+    EXPECT_EQ(bars.lows()[1], 11.5);
+    EXPECT_EQ(bars.volumes()[0], 100);
+    EXPECT_EQ(bars.volumes()[1], 0);
+}
+
+TEST(YahooChartParserTest, SkipBarDropsAnyNullPrice) {
+    std::string response = chartResponse(
+        "[1,2,3,4]",
+        R"({"open":[1,null,3,4],"high":[1,2,3,4],"low":[1,2,null,4],"close":[1,2,3,4],"volume":[5,6,7,null]})");
+
+    auto parsed = YahooChart::parse(response, YahooChart::NullPrices::SkipBar);
+    ASSERT_TRUE(parsed.isOk());
+    const BarColumns& bars = parsed.value();
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars.closes()[0], 1.0);
+    EXPECT_EQ(bars.closes()[1], 4.0);
+    EXPECT_EQ(bars.volumes()[1], 0);
+}
+
+TEST(YahooChartParserTest, MissingAndShortColumns) {
+    // No open/high/low: they take the close under either policy; a short
+    // volume column reads as 0 past its end
+    std::string response = chartResponse("[1,2,3]", R"({"close":[5,6,7],"volume":[9]})");
+
+    for (auto nulls : {YahooChart::NullPrices::FillFromClose, YahooChart::NullPrices::SkipBar}) {
+        auto parsed = YahooChart::parse(response, nulls);
+        ASSERT_TRUE(parsed.isOk());
+        const BarColumns& bars = parsed.value();
+        ASSERT_EQ(bars.size(), 3u);
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_EQ(bars.opens()[i], bars.closes()[i]);
+            EXPECT_EQ(bars.highs()[i], bars.closes()[i]);
+            EXPECT_EQ(bars.lows()[i], bars.closes()[i]);
+        }
+        EXPECT_EQ(bars.volumes()[0], 9);
+        EXPECT_EQ(bars.volumes()[2], 0);
+    }
+
+    // Without a close column there are no bars
+    auto noClose = YahooChart::parse(chartResponse("[1,2]", R"({"open":[1,2]})"));
+    ASSERT_TRUE(noClose.isOk());
+    EXPECT_TRUE(noClose.value().empty());
+}
+
+// ============================================================================
+// Payload Shapes
+// ============================================================================
+
+TEST(YahooChartParserTest, MatchesDomWalkOnLargePayload) {
+    std::string response = randomResponse(5000, 19);
+    std::vector<Candle> expected = domReference(response);
+
+    auto parsed = YahooChart::parse(response);
+    ASSERT_TRUE(parsed.isOk());
+    const BarColumns& bars = parsed.value();
+    ASSERT_EQ(bars.size(), expected.size());
+    ASSERT_GT(bars.size(), 4500u);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        ASSERT_EQ(bars.timestamps()[i], expected[i].ts) << i;
+        ASSERT_EQ(bars.opens()[i], expected[i].open) << i;
+        ASSERT_EQ(bars.highs()[i], expected[i].high) << i;
+        ASSERT_EQ(bars.lows()[i], expected[i].low) << i;
+        ASSERT_EQ(bars.closes()[i], expected[i].close) << i;
+        ASSERT_EQ(bars.volumes()[i], expected[i].volume) << i;
+    }
+}
+
+TEST(YahooChartParserTest, EmptyResultAndMalformedJson) {
+    // Unknown symbol: result is null
+    auto unknown = YahooChart::parse(
+        R"({"chart":{"result":null,"error":{"code":"Not Found","description":"No data found"}}})");
+    ASSERT_TRUE(unknown.isOk());
+    EXPECT_TRUE(unknown.value().empty());
+
+    // Only the first result and the first quote are read
+    std::string two = R"({"chart":{"result":[{"timestamp":[1],"indicators":{"quote":[{"close":[1]},{"close":[2]}]}},)"
+                      R"({"timestamp":[9],"indicators":{"quote":[{"close":[3]}]}}]}})";
+    auto first = YahooChart::parse(two);
+    ASSERT_TRUE(first.isOk());
+    ASSERT_EQ(first.value().size(), 1u);
+    EXPECT_EQ(first.value().closes()[0], 1.0);
+
+    auto truncated = YahooChart::parse(randomResponse(20, 3).substr(0, 300));
+    ASSERT_TRUE(truncated.isError());
+    EXPECT_EQ(truncated.error().code, Error::ParseError);
+    EXPECT_TRUE(YahooChart::parse("").isError());
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}